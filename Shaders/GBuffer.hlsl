@@ -36,8 +36,15 @@ struct VertexAttributes
 	float3 N : NORMAL;
 };
 
+#if PACKED_VERTEX
+// The input assembler converts the half and snorm formats, only the normal needs decoding
+VertexAttributes VSMain(float3 Position : POSITION, float2 TextureCoord : TEXCOORD, float2 OctahedralNormal : NORMAL)
+{
+	float3 Normal = OctahedralDecode(OctahedralNormal);
+#else
 VertexAttributes VSMain(float3 Position : POSITION, float2 TextureCoord : TEXCOORD, float3 Normal : NORMAL)
 {
+#endif
 	VertexAttributes output;
 
 	Mesh mesh = g_Meshes[MeshIndex];
@@ -38,11 +38,17 @@ AppendStructuredBuffer<CommandSignatureParams> g_CommandBuffer : register(u0, sp
 		bool visible = FrustumContainsBoundingBox(g_ConstantBufferParams.Camera.Frustum, aabb) != CONTAINMENT_DISJOINT;
 		if (visible)
 		{
+			// LODs are ranges of the same index buffer
+			uint lod = SelectMeshLod(mesh, aabb, g_ConstantBufferParams.Camera);
+
 			CommandSignatureParams command;
 			command.MeshIndex			 = index;
 			command.VertexBuffer		 = mesh.VertexBuffer;
 			command.IndexBuffer			 = mesh.IndexBuffer;
 			command.DrawIndexedArguments = mesh.DrawIndexedArguments;
+
+			command.DrawIndexedArguments.IndexCountPerInstance = mesh.Lods[lod].IndexCount;
+			command.DrawIndexedArguments.StartIndexLocation	   = mesh.Lods[lod].IndexOffset;
 			g_CommandBuffer.Append(command);
 		}
 	}
@@ -40,13 +40,16 @@ AppendStructuredBuffer<CommandSignatureParams> g_CommandBuffer : register(u0, sp
 		bool visible = FrustumContainsBoundingBox(g_ConstantBufferParams.Camera.Frustum, aabb) != CONTAINMENT_DISJOINT;
 		if (visible)
 		{
+			// Meshlets of a LOD are contiguous, the mesh shader indexes them from the start of the range
+			uint lod = SelectMeshLod(mesh, aabb, g_ConstantBufferParams.Camera);
+
 			CommandSignatureParams command;
 			command.MeshIndex								= index;
 			command.Vertices								= mesh.VertexBuffer.BufferLocation;
-			command.Meshlets								= mesh.Meshlets;
+			command.Meshlets								= OffsetGpuVirtualAddress(mesh.Meshlets, mesh.Lods[lod].MeshletOffset * 16); // sizeof(Meshlet)
 			command.UniqueVertexIndices						= mesh.UniqueVertexIndices;
 			command.PrimitiveIndices						= mesh.PrimitiveIndices;
-			command.DispatchMeshArguments.ThreadGroupCountX = mesh.NumMeshlets;
+			command.DispatchMeshArguments.ThreadGroupCountX = mesh.Lods[lod].MeshletCount;
 			command.DispatchMeshArguments.ThreadGroupCountY = 1;
 			command.DispatchMeshArguments.ThreadGroupCountZ = 1;
 			g_CommandBuffer.Append(command);
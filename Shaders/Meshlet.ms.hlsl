@@ -16,10 +16,10 @@ cbuffer RootConstants : register(b0, space0)
 	uint MeshIndex;
 };
 
-StructuredBuffer<Vertex>  Vertices : register(t0, space0);
-StructuredBuffer<Meshlet> Meshlets : register(t1, space0);
-ByteAddressBuffer		  UniqueVertexIndices : register(t2, space0);
-StructuredBuffer<uint>	  PrimitiveIndices : register(t3, space0);
+StructuredBuffer<VertexData> Vertices : register(t0, space0);
+StructuredBuffer<Meshlet>	 Meshlets : register(t1, space0);
+ByteAddressBuffer			 UniqueVertexIndices : register(t2, space0);
+StructuredBuffer<uint>		 PrimitiveIndices : register(t3, space0);
 
 struct GlobalConstants
 {
@@ -70,7 +70,7 @@ uint GetVertexIndex(Meshlet meshlet, uint localIndex)
 VertexAttributes GetVertexAttributes(uint meshletIndex, uint vertexIndex)
 {
     Mesh mesh = g_Meshes[MeshIndex];
-    Vertex v = Vertices[vertexIndex];
+    Vertex v = DecodeVertex(Vertices[vertexIndex]);
 
     VertexAttributes output;
     output.Position = mul(float4(v.Position, 1.0f), mesh.Transform);
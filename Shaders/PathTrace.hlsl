@@ -18,8 +18,8 @@ cbuffer RootConstants : register(b0, space1)
 	uint MaterialIndex;
 };
 
-StructuredBuffer<Vertex> VertexBuffer : register(t0, space1);
-StructuredBuffer<uint>	 IndexBuffer : register(t1, space1);
+StructuredBuffer<VertexData> VertexBuffer : register(t0, space1);
+StructuredBuffer<uint>		 IndexBuffer : register(t1, space1);
 
 struct VertexAttributes
 {
@@ -37,9 +37,9 @@ VertexAttributes GetVertexAttributes(BuiltInTriangleIntersectionAttributes Attri
 	uint idx2 = IndexBuffer[PrimitiveIndex() * 3 + 2];
 
 	// Fetch vertices
-	Vertex vtx0 = VertexBuffer[idx0];
-	Vertex vtx1 = VertexBuffer[idx1];
-	Vertex vtx2 = VertexBuffer[idx2];
+	Vertex vtx0 = DecodeVertex(VertexBuffer[idx0]);
+	Vertex vtx1 = DecodeVertex(VertexBuffer[idx1]);
+	Vertex vtx2 = DecodeVertex(VertexBuffer[idx2]);
 
 	float3 p0 = vtx0.Position, p1 = vtx1.Position, p2 = vtx2.Position;
 	// Compute 2 edges of the triangle
@@ -67,15 +67,15 @@ struct VertexAttributes
 VertexAttributes GetVertexAttributes(Mesh Mesh, RaytracingAttributes Attributes)
 {
 	// Fetch indices
-	uint3 indices = g_ByteAddressBufferTable[Mesh.IndexView].Load<uint3>(Attributes.PrimitiveIndex * sizeof(uint3));
+	uint3 indices = g_ByteAddressBufferTable[Mesh.IndexView].Load<uint3>(Mesh.IndexOffset + Attributes.PrimitiveIndex * sizeof(uint3));
 	uint  idx0	  = indices[0];
 	uint  idx1	  = indices[1];
 	uint  idx2	  = indices[2];
 
 	// Fetch vertices
-	Vertex vtx0 = g_ByteAddressBufferTable[Mesh.VertexView].Load<Vertex>(idx0 * sizeof(Vertex));
-	Vertex vtx1 = g_ByteAddressBufferTable[Mesh.VertexView].Load<Vertex>(idx1 * sizeof(Vertex));
-	Vertex vtx2 = g_ByteAddressBufferTable[Mesh.VertexView].Load<Vertex>(idx2 * sizeof(Vertex));
+	Vertex vtx0 = DecodeVertex(g_ByteAddressBufferTable[Mesh.VertexView].Load<VertexData>(Mesh.VertexOffset + idx0 * sizeof(VertexData)));
+	Vertex vtx1 = DecodeVertex(g_ByteAddressBufferTable[Mesh.VertexView].Load<VertexData>(Mesh.VertexOffset + idx1 * sizeof(VertexData)));
+	Vertex vtx2 = DecodeVertex(g_ByteAddressBufferTable[Mesh.VertexView].Load<VertexData>(Mesh.VertexOffset + idx2 * sizeof(VertexData)));
 
 	float3 p0 = vtx0.Position, p1 = vtx1.Position, p2 = vtx2.Position;
 	// Compute 2 edges of the triangle
@@ -44,6 +44,19 @@ struct Light
 };
 
 // ==================== Mesh ====================
+#define MAX_MESH_LODS (4)
+
+// Coarsest LOD whose simplification error projects to at most this fraction of the screen height
+#define LOD_ERROR_THRESHOLD (1.0f / 1080.0f)
+
+struct MeshLod
+{
+	uint IndexOffset;
+	uint IndexCount;
+	uint MeshletOffset;
+	uint MeshletCount;
+};
+
 struct Mesh
 {
 	// 64
@@ -67,12 +80,19 @@ struct Mesh
 	// 20
 	D3D12_DRAW_INDEXED_ARGUMENTS DrawIndexedArguments;
 
-	// 20
+	// 28
 	unsigned int MaterialIndex;
 	unsigned int NumMeshlets;
+	// Raw views of the geometry pool buffer holding the mesh and byte offsets into it
 	unsigned int VertexView;
 	unsigned int IndexView;
-	unsigned int DEADBEEF2;
+	unsigned int VertexOffset;
+	unsigned int IndexOffset;
+	unsigned int NumLods;
+
+	// 80
+	MeshLod Lods[MAX_MESH_LODS];
+	float	LodErrors[MAX_MESH_LODS];
 };
 
 // ==================== Camera ====================
@@ -122,3 +142,28 @@ struct Camera
 		return ray;
 	}
 };
+
+// Picks the coarsest LOD whose error stays below LOD_ERROR_THRESHOLD, Bounds is the world space box of the mesh.
+// LOD errors are relative to the box diagonal, the projected size is the diagonal relative to the screen height
+uint SelectMeshLod(Mesh mesh, BoundingBox bounds, Camera camera)
+{
+	float radius   = length(bounds.Extents);
+	float distance = length(bounds.Center - camera.Position.xyz);
+	if (distance <= radius)
+	{
+		return 0;
+	}
+
+	float projectedSize = radius / (distance * tan(radians(camera.FoVY) * 0.5f));
+
+	uint lod = 0;
+	for (uint i = 1; i < mesh.NumLods; ++i)
+	{
+		if (mesh.LodErrors[i] * projectedSize > LOD_ERROR_THRESHOLD)
+		{
+			break;
+		}
+		lod = i;
+	}
+	return lod;
+}
@@ -1,5 +1,10 @@
 #pragma once
 
+// Set by the shader compiler to KAGUYA_PACKED_VERTEX, see World/Vertex.h
+#ifndef PACKED_VERTEX
+#define PACKED_VERTEX 0
+#endif
+
 struct Vertex
 {
 	float3 Position;
@@ -7,6 +12,42 @@ struct Vertex
 	float3 Normal;
 };
 
+// Layout of the vertex buffers, matches MeshVertex
+#if PACKED_VERTEX
+struct VertexData
+{
+	float3 Position;
+	uint   TextureCoord; // half2
+	uint   Normal;       // Octahedral, snorm16x2
+};
+#else
+typedef Vertex VertexData;
+#endif
+
+float3 OctahedralDecode(float2 Encoded)
+{
+	float3 n = float3(Encoded.x, Encoded.y, 1.0f - abs(Encoded.x) - abs(Encoded.y));
+	float  t = saturate(-n.z);
+	n.x += n.x >= 0.0f ? -t : t;
+	n.y += n.y >= 0.0f ? -t : t;
+	return normalize(n);
+}
+
+Vertex DecodeVertex(VertexData Data)
+{
+#if PACKED_VERTEX
+	int2 Normal = asint(uint2(Data.Normal << 16, Data.Normal)) >> 16;
+
+	Vertex vertex;
+	vertex.Position		= Data.Position;
+	vertex.TextureCoord = float2(f16tof32(Data.TextureCoord), f16tof32(Data.TextureCoord >> 16));
+	vertex.Normal		= OctahedralDecode(max(float2(Normal) / 32767.0f, -1.0f));
+	return vertex;
+#else
+	return Data;
+#endif
+}
+
 float BarycentricInterpolation(float v0, float v1, float v2, float3 barycentric)
 {
 	return v0 * barycentric.x + v1 * barycentric.y + v2 * barycentric.z;
@@ -5,6 +5,12 @@
 typedef uint2 D3D12_GPU_VIRTUAL_ADDRESS;
 // typedef uint64_t D3D12_GPU_VIRTUAL_ADDRESS;
 
+D3D12_GPU_VIRTUAL_ADDRESS OffsetGpuVirtualAddress(D3D12_GPU_VIRTUAL_ADDRESS address, uint offset)
+{
+	uint low = address.x + offset;
+	return uint2(low, address.y + (low < address.x ? 1 : 0));
+}
+
 struct D3D12_DRAW_ARGUMENTS
 {
 	uint VertexCountPerInstance;
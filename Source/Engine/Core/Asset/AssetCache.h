@@ -1,5 +1,4 @@
 #pragma once
-#include <Core/ObjectPool.h>
 #include "Asset.h"
 
 template<AssetType Type, typename T>
@@ -7,72 +6,130 @@ class AssetCache
 {
 public:
 	static_assert(std::is_base_of_v<Asset, T>, "Asset is not based of T");
+	static_assert(std::atomic<AssetHandle>::is_always_lock_free);
 
-	// static constexpr size_t NumAssets = 4096;
-	static constexpr size_t NumAssets = 8192;
+	// Assets live in chunks that are allocated as the cache grows and never move, so asset pointers stay valid and
+	// readers don't need a lock. Handle ids index across chunks
+	static constexpr size_t ChunkSize = 1024;
+	static constexpr size_t MaxChunks = 4096;
+	static constexpr size_t MaxAssets = ChunkSize * MaxChunks;
 
-	AssetCache()
-		: Cache(NumAssets)
-		, CachedHandles(NumAssets)
-		, Assets(NumAssets)
+	// Handle of every id handed out so far, ids of destroyed assets yield invalid handles
+	class Iterator
 	{
-	}
+	public:
+		Iterator(const AssetCache* Cache, size_t Id) noexcept
+			: Cache(Cache)
+			, Id(Id)
+		{
+		}
+
+		AssetHandle operator*() const noexcept { return Cache->LoadHandle(Id); }
+		Iterator&	operator++() noexcept
+		{
+			++Id;
+			return *this;
+		}
+		bool operator==(const Iterator& Iterator) const noexcept { return Id == Iterator.Id; }
 
+	private:
+		const AssetCache* Cache;
+		size_t			  Id;
+	};
+
+	AssetCache() = default;
+
+	AssetCache(const AssetCache&)			 = delete;
+	AssetCache& operator=(const AssetCache&) = delete;
+
+	// Handles saved with a world refer to the ids in load order with version 0, so ids and versions start over
 	void DestroyAll()
 	{
-		// Destroy in opposite order
 		RwLockWriteGuard Guard(Mutex);
-		Assets.clear();
-		Assets.resize(NumAssets);
-		CachedHandles.clear();
-		CachedHandles.resize(NumAssets);
-		Cache = ObjectPool<T>(NumAssets);
+		for (auto& Chunk : Chunks)
+		{
+			Chunk.store(nullptr, std::memory_order_release);
+		}
+		OwnedChunks.clear();
+		FreeIds.clear();
+		NumIds.store(0, std::memory_order_release);
 	}
 
-	auto begin() noexcept { return CachedHandles.begin(); }
-	auto end() noexcept { return CachedHandles.end(); }
+	Iterator begin() const noexcept { return Iterator(this, 0); }
+	Iterator end() const noexcept { return Iterator(this, size()); }
 
-	size_t size() const noexcept { return CachedHandles.size(); }
+	size_t size() const noexcept { return NumIds.load(std::memory_order_acquire); }
 
-	static bool ValidateHandle(AssetHandle Handle) noexcept { return Handle.Type == Type && Handle.Id < NumAssets; }
+	static bool ValidateHandle(AssetHandle Handle) noexcept { return Handle.Type == Type && Handle.Id < MaxAssets; }
 
 	template<typename... TArgs>
 	AssetHandle Create(TArgs&&... Args)
 	{
 		RwLockWriteGuard Guard(Mutex);
 
-		std::size_t Index = Cache.Allocate();
+		AssetHandle Handle = AllocateHandle();
+		Construct(Handle, std::forward<TArgs>(Args)...);
+		return Handle;
+	}
 
-		AssetHandle Handle;
-		Handle.Type	   = Type;
-		Handle.State   = false;
-		Handle.Version = 0;
-		Handle.Id	   = Index;
+	// Takes an id for an asset that is created later by CreateAt, the slot stays invalid until then
+	AssetHandle Reserve()
+	{
+		RwLockWriteGuard Guard(Mutex);
+		return AllocateHandle();
+	}
 
-		T* Asset	  = Cache.Construct(Index, std::forward<TArgs>(Args)...);
-		Asset->Handle = Handle;
+	// Creates the asset of a reserved handle, fails if the reservation was released or the cache destroyed since
+	template<typename... TArgs>
+	bool CreateAt(AssetHandle Reserved, TArgs&&... Args)
+	{
+		RwLockWriteGuard Guard(Mutex);
 
-		CachedHandles[Index] = Handle;
-		Assets[Index]		 = Asset;
-		return Handle;
+		if (!IsReserved(Reserved))
+		{
+			return false;
+		}
+		Construct(Reserved, std::forward<TArgs>(Args)...);
+		return true;
+	}
+
+	// Returns the id of a reservation that won't be created, like Destroy the version moves on
+	void Release(AssetHandle Reserved)
+	{
+		RwLockWriteGuard Guard(Mutex);
+
+		if (IsReserved(Reserved))
+		{
+			Chunk* Chunk = Chunks[Reserved.Id / ChunkSize].load(std::memory_order_relaxed);
+
+			AssetHandle Retired = {};
+			Retired.Version		= Reserved.Version + 1;
+			Chunk->Slots[Reserved.Id % ChunkSize].store(Retired, std::memory_order_release);
+			FreeIds.push_back(Reserved.Id);
+		}
 	}
 
 	T* GetAsset(AssetHandle Handle)
 	{
-		return Assets[Handle.Id].get();
+		Chunk* Chunk = Chunks[Handle.Id / ChunkSize].load(std::memory_order_acquire);
+		return Chunk ? Chunk->Assets[Handle.Id % ChunkSize].get() : nullptr;
 	}
 
+	// Wait free, called for every component every frame. The slot is published with a release store after the
+	// asset is constructed, and the storage of a slot never moves
 	T* GetValidAsset(AssetHandle& Handle)
 	{
 		if (Handle.IsValid() && ValidateHandle(Handle))
 		{
-			RwLockReadGuard Guard(Mutex);
-
-			bool State = CachedHandles[Handle.Id].State;
-			if (State)
+			if (Chunk* Chunk = Chunks[Handle.Id / ChunkSize].load(std::memory_order_acquire))
 			{
-				Handle.State = State;
-				return Assets[Handle.Id].get();
+				const size_t Slot	   = Handle.Id % ChunkSize;
+				AssetHandle	 Published = Chunk->Slots[Slot].load(std::memory_order_acquire);
+				if (Published.State && Published.Type == Type && Published.Version == Handle.Version)
+				{
+					Handle.State = Published.State;
+					return Chunk->Get(Slot);
+				}
 			}
 		}
 
@@ -85,9 +142,26 @@ public:
 		{
 			RwLockWriteGuard Guard(Mutex);
 
-			Cache.Deallocate(Handle.Id);
-			CachedHandles[Handle.Id].Invalidate();
-			Assets[Handle.Id].reset();
+			Chunk* Chunk = Chunks[Handle.Id / ChunkSize].load(std::memory_order_relaxed);
+			if (!Chunk)
+			{
+				return;
+			}
+
+			// A stale handle must not destroy the asset that reused the slot
+			const size_t Slot = Handle.Id % ChunkSize;
+			if (Chunk->Slots[Slot].load(std::memory_order_relaxed).Version != Handle.Version || !Chunk->Assets[Slot])
+			{
+				return;
+			}
+
+			// Readers stop seeing the asset before it is destroyed
+			AssetHandle Retired = {};
+			Retired.Version		= Handle.Version + 1;
+			Chunk->Slots[Slot].store(Retired, std::memory_order_release);
+
+			Chunk->Assets[Slot].reset();
+			FreeIds.push_back(Handle.Id);
 		}
 	}
 
@@ -97,7 +171,19 @@ public:
 		{
 			RwLockWriteGuard Guard(Mutex);
 
-			CachedHandles[Handle.Id].State = Handle.State;
+			Chunk* Chunk = Chunks[Handle.Id / ChunkSize].load(std::memory_order_relaxed);
+			if (!Chunk)
+			{
+				return;
+			}
+
+			const size_t Slot	   = Handle.Id % ChunkSize;
+			AssetHandle	 Published = Chunk->Slots[Slot].load(std::memory_order_relaxed);
+			if (Published.Version == Handle.Version)
+			{
+				Published.State = Handle.State;
+				Chunk->Slots[Slot].store(Published, std::memory_order_release);
+			}
 		}
 	}
 
@@ -106,28 +192,101 @@ public:
 	{
 		RwLockReadGuard Guard(Mutex);
 
-		auto begin = CachedHandles.begin();
-		auto end   = CachedHandles.end();
-		while (begin != end)
+		const size_t NumHandles = size();
+		for (size_t Id = 0; Id < NumHandles; ++Id)
 		{
-			auto current = begin++;
-
 			if constexpr (std::is_invocable_v<Functor, AssetHandle, T*>)
 			{
-				if (current->IsValid())
+				if (AssetHandle Handle = LoadHandle(Id); Handle.IsValid())
 				{
-					F(*current, Cache[current->Id]);
+					F(Handle, Chunks[Id / ChunkSize].load(std::memory_order_relaxed)->Get(Id % ChunkSize));
 				}
 			}
 		}
 	}
 
 private:
-	ObjectPool<T> Cache;
-	// CachedHandles are use to update any external handle's states
-	std::vector<AssetHandle> CachedHandles;
-	std::vector<AssetPtr<T>> Assets;
-	mutable RwLock			 Mutex;
+	struct Chunk
+	{
+		[[nodiscard]] T* Get(size_t Slot) noexcept { return std::launder(reinterpret_cast<T*>(Storage[Slot])); }
+
+		alignas(T) std::byte Storage[ChunkSize][sizeof(T)];
+		AssetPtr<T>			 Assets[ChunkSize]; // Destroyed before the storage
+		// Type, state and version of every slot for lock free validation, only written under Mutex
+		std::atomic<AssetHandle> Slots[ChunkSize];
+	};
+
+	// Destroyed ids are reused first, otherwise ids are handed out in order and a chunk is added once one fills up.
+	// The slot keeps the version it was left with by Destroy, so older handles to it no longer validate
+	[[nodiscard]] AssetHandle AllocateHandle()
+	{
+		size_t Index;
+		if (!FreeIds.empty())
+		{
+			Index = FreeIds.back();
+			FreeIds.pop_back();
+		}
+		else
+		{
+			Index = NumIds.load(std::memory_order_relaxed);
+			assert(Index < MaxAssets);
+			if (Index % ChunkSize == 0)
+			{
+				OwnedChunks.push_back(std::make_unique<Chunk>());
+				Chunks[Index / ChunkSize].store(OwnedChunks.back().get(), std::memory_order_release);
+			}
+			NumIds.store(Index + 1, std::memory_order_release);
+		}
+
+		const Chunk* Chunk = Chunks[Index / ChunkSize].load(std::memory_order_relaxed);
+
+		AssetHandle Handle;
+		Handle.Type	   = Type;
+		Handle.State   = false;
+		Handle.Version = Chunk->Slots[Index % ChunkSize].load(std::memory_order_relaxed).Version;
+		Handle.Id	   = static_cast<UINT>(Index);
+		return Handle;
+	}
+
+	// A handed out id whose slot has no asset and was not released since
+	[[nodiscard]] bool IsReserved(AssetHandle Handle) const noexcept
+	{
+		if (!Handle.IsValid() || !ValidateHandle(Handle) || Handle.Id >= NumIds.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		const Chunk* Chunk = Chunks[Handle.Id / ChunkSize].load(std::memory_order_relaxed);
+		const size_t Slot  = Handle.Id % ChunkSize;
+		return !Chunk->Assets[Slot] && Chunk->Slots[Slot].load(std::memory_order_relaxed).Version == Handle.Version;
+	}
+
+	// The slot is published with a release store once the asset is constructed
+	template<typename... TArgs>
+	void Construct(AssetHandle Handle, TArgs&&... Args)
+	{
+		Chunk&		 Chunk = *Chunks[Handle.Id / ChunkSize].load(std::memory_order_relaxed);
+		const size_t Slot  = Handle.Id % ChunkSize;
+
+		T* Asset	  = new (Chunk.Storage[Slot]) T(std::forward<TArgs>(Args)...);
+		Asset->Handle = Handle;
+
+		Chunk.Assets[Slot] = Asset;
+		Chunk.Slots[Slot].store(Handle, std::memory_order_release);
+	}
+
+	[[nodiscard]] AssetHandle LoadHandle(size_t Id) const noexcept
+	{
+		const Chunk* Chunk = Chunks[Id / ChunkSize].load(std::memory_order_acquire);
+		return Chunk ? Chunk->Slots[Id % ChunkSize].load(std::memory_order_acquire) : AssetHandle();
+	}
+
+private:
+	std::atomic<Chunk*>					Chunks[MaxChunks] = {};
+	std::vector<std::unique_ptr<Chunk>> OwnedChunks;
+	std::vector<size_t>					FreeIds;
+	std::atomic<size_t>					NumIds = 0;
+	mutable RwLock						Mutex;
 
 	friend class AssetWindow;
 	friend class SceneParser;
@@ -6,61 +6,35 @@ using Microsoft::WRL::ComPtr;
 
 void AssetManager::Initialize()
 {
+	RequestEvent.create();
+	BatchEvent.create();
+
 	Thread = std::jthread(
 		[&]()
 		{
 			D3D12LinkedDevice* Device = RenderCore::Device->GetDevice();
 
+			// Sleeps until an upload is requested or the oldest batch in flight completes, so assets become valid as
+			// soon as their batch does
+			HANDLE Events[] = { RequestEvent.get(), BatchEvent.get() };
 			while (true)
 			{
-				std::unique_lock Lock(Mutex);
-				ConditionVariable.wait(Lock);
-
+				WaitForMultipleObjects(static_cast<DWORD>(std::size(Events)), Events, FALSE, INFINITE);
 				if (Quit)
 				{
 					break;
 				}
 
-				std::vector<Mesh*>	  Meshes;
-				std::vector<Texture*> Textures;
-
-				Device->BeginResourceUpload();
-
-				// Process Mesh
-				while (!MeshUploadQueue.empty())
-				{
-					Mesh* Mesh = MeshUploadQueue.front();
-					MeshUploadQueue.pop();
-					UploadMesh(Mesh, Device);
-					Meshes.push_back(Mesh);
-				}
-
-				// Process Texture
-				while (!TextureUploadQueue.empty())
+				std::scoped_lock RecordLock(RecordMutex);
+				CompleteUploadBatches();
+				while (UploadBatches.size() < MaxUploadBatchesInFlight && HasPendingUploads())
 				{
-					Texture* Texture = TextureUploadQueue.front();
-					TextureUploadQueue.pop();
-					UploadTexture(Texture, Device);
-					Textures.push_back(Texture);
+					RecordUploadBatch(Device);
 				}
 
-				Device->EndResourceUpload(true);
-
-				for (auto Mesh : Meshes)
+				if (!UploadBatches.empty())
 				{
-					// Release memory
-					Mesh->Release();
-
-					Mesh->Handle.State = true;
-					MeshCache.UpdateHandleState(Mesh->Handle);
-				}
-				for (auto Texture : Textures)
-				{
-					// Release memory
-					Texture->Release();
-
-					Texture->Handle.State = true;
-					TextureCache.UpdateHandleState(Texture->Handle);
+					UploadBatches.front().SyncHandle.SetEventOnCompletion(BatchEvent.get());
 				}
 			}
 		});
@@ -68,11 +42,15 @@ void AssetManager::Initialize()
 
 void AssetManager::Shutdown()
 {
+	CancelPendingLoads();
+
 	Quit = true;
-	ConditionVariable.notify_all();
+	RequestEvent.SetEvent();
+	Thread.join();
 
 	MeshCache.DestroyAll();
 	TextureCache.DestroyAll();
+	MeshGeometryPool.Destroy();
 }
 
 AssetType AssetManager::GetAssetTypeFromExtension(const std::filesystem::path& Path)
@@ -89,17 +67,89 @@ AssetType AssetManager::GetAssetTypeFromExtension(const std::filesystem::path& P
 	return AssetType::Unknown;
 }
 
-void AssetManager::AsyncLoadImage(const TextureImportOptions& Options)
+void AssetManager::AsyncLoadImage(const TextureImportOptions& Options, ImportPriority Priority /*= ImportPriority::Normal*/)
+{
+	TextureImporter.RequestAsyncLoad(Options, Priority);
+}
+
+void AssetManager::AsyncLoadMesh(const MeshImportOptions& Options, ImportPriority Priority /*= ImportPriority::Normal*/)
+{
+	MeshImporter.RequestAsyncLoad(Options, Priority);
+}
+
+void AssetManager::CancelPendingLoads()
 {
-	TextureImporter.RequestAsyncLoad(Options);
+	MeshImporter.CancelPendingLoads();
+	TextureImporter.CancelPendingLoads();
+
+	// Waits for the batch that is being recorded
+	std::scoped_lock RecordLock(RecordMutex);
+	{
+		std::scoped_lock Lock(Mutex);
+		decltype(MeshUploadQueue)().swap(MeshUploadQueue);
+		decltype(TextureUploadQueue)().swap(TextureUploadQueue);
+	}
+
+	// Batches in flight still write into assets that are about to be destroyed
+	for (const auto& Batch : UploadBatches)
+	{
+		Batch.SyncHandle.WaitForCompletion();
+	}
+	UploadBatches.clear();
+	UploadCommands.clear();
+
+	std::scoped_lock StreamLock(StreamMutex);
+	++StreamGeneration;
+	NewStreamingTextures.clear();
+	TextureStreamQueue.clear();
+	StreamedTextures.clear();
+	StreamingTextures.clear();
+	TextureResidency.Clear();
+}
+
+UINT AssetManager::GetTailMip(const TexMetadata& Metadata)
+{
+	if (Metadata.dimension != TEX_DIMENSION_TEXTURE2D || Metadata.arraySize != 1 || Metadata.IsCubemap() || Metadata.mipLevels <= 1)
+	{
+		return 0;
+	}
+
+	UINT TailMip = 0;
+	while (TailMip + 1 < Metadata.mipLevels && std::max(Metadata.width, Metadata.height) >> TailMip > TextureTailSize)
+	{
+		++TailMip;
+	}
+
+	// The top mip of a block compressed texture has to be a multiple of the block size, so every mip above the tail
+	// has to be one for the texture to stream
+	if (IsCompressed(Metadata.format))
+	{
+		size_t Alignment = size_t(4) << TailMip;
+		if (Metadata.width % Alignment != 0 || Metadata.height % Alignment != 0)
+		{
+			return 0;
+		}
+	}
+	return TailMip;
 }
 
-void AssetManager::AsyncLoadMesh(const MeshImportOptions& Options)
+void AssetManager::QueueTextureUpload(Texture* AssetTexture, D3D12LinkedDevice* Device)
 {
-	MeshImporter.RequestAsyncLoad(Options);
+	// Streamed textures start out with only their mip tail
+	AssetTexture->TailMip	  = GetTailMip(AssetTexture->TexImage.GetMetadata());
+	AssetTexture->ResidentMip = AssetTexture->TailMip;
+
+	AssetTexture->DxTexture = QueueMipsUpload(AssetTexture, Device, AssetTexture->ResidentMip);
+	AssetTexture->SRV		= D3D12ShaderResourceView(Device, &AssetTexture->DxTexture, false, std::nullopt, std::nullopt);
+
+	if (AssetTexture->TailMip > 0)
+	{
+		AssetTexture->StreamSource	  = AssetTexture->DxTexture.GetResource();
+		AssetTexture->StreamSourceMip = AssetTexture->ResidentMip;
+	}
 }
 
-void AssetManager::UploadTexture(Texture* AssetTexture, D3D12LinkedDevice* Device)
+D3D12Texture AssetManager::QueueMipsUpload(const Texture* AssetTexture, D3D12LinkedDevice* Device, UINT MostDetailedMip)
 {
 	const auto& Metadata = AssetTexture->TexImage.GetMetadata();
 
@@ -109,6 +159,7 @@ void AssetManager::UploadTexture(Texture* AssetTexture, D3D12LinkedDevice* Devic
 		Format = DirectX::MakeSRGB(Format);
 	}
 
+	// Only 2D textures without array slices stream, MostDetailedMip is 0 for everything else
 	D3D12_RESOURCE_DESC ResourceDesc = {};
 	switch (Metadata.dimension)
 	{
@@ -122,10 +173,10 @@ void AssetManager::UploadTexture(Texture* AssetTexture, D3D12LinkedDevice* Devic
 	case TEX_DIMENSION_TEXTURE2D:
 		ResourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
 			Format,
-			static_cast<UINT64>(Metadata.width),
-			static_cast<UINT>(Metadata.height),
+			static_cast<UINT64>(std::max<size_t>(Metadata.width >> MostDetailedMip, 1)),
+			static_cast<UINT>(std::max<size_t>(Metadata.height >> MostDetailedMip, 1)),
 			static_cast<UINT16>(Metadata.arraySize),
-			static_cast<UINT16>(Metadata.mipLevels));
+			static_cast<UINT16>(Metadata.mipLevels - MostDetailedMip));
 		break;
 
 	case TEX_DIMENSION_TEXTURE3D:
@@ -137,100 +188,264 @@ void AssetManager::UploadTexture(Texture* AssetTexture, D3D12LinkedDevice* Devic
 		break;
 	}
 
-	AssetTexture->DxTexture = D3D12Texture(RenderCore::Device->GetDevice(), ResourceDesc, std::nullopt, AssetTexture->IsCubemap);
-	AssetTexture->SRV		= D3D12ShaderResourceView(RenderCore::Device->GetDevice(), &AssetTexture->DxTexture, false, std::nullopt, std::nullopt);
+	D3D12Texture DxTexture(Device, ResourceDesc, std::nullopt, AssetTexture->IsCubemap);
 
-	std::vector<D3D12_SUBRESOURCE_DATA> Subresources(AssetTexture->TexImage.GetImageCount());
-	const auto							pImages = AssetTexture->TexImage.GetImages();
-	for (size_t i = 0; i < AssetTexture->TexImage.GetImageCount(); ++i)
+	// Images of a 2D texture without array slices are its mips in order. Mips the stream source already holds are
+	// copied from it on the gpu, only the finer ones are uploaded
+	const size_t NumImages = AssetTexture->TexImage.GetImageCount() - MostDetailedMip;
+	const auto	 pImages   = AssetTexture->TexImage.GetImages() + MostDetailedMip;
+	for (size_t i = 0; i < NumImages; ++i)
 	{
-		Subresources[i].RowPitch   = pImages[i].rowPitch;
-		Subresources[i].SlicePitch = pImages[i].slicePitch;
-		Subresources[i].pData	   = pImages[i].pixels;
+		const UINT Mip = MostDetailedMip + static_cast<UINT>(i);
+
+		UploadCommand& Command = UploadCommands.emplace_back();
+		Command.Resource	   = DxTexture.GetResource();
+		Command.Subresource	   = static_cast<UINT>(i);
+		if (AssetTexture->StreamSource && Mip >= AssetTexture->StreamSourceMip)
+		{
+			Command.CopySource			  = AssetTexture->StreamSource;
+			Command.CopySourceSubresource = Mip - AssetTexture->StreamSourceMip;
+			Command.SizeInBytes			  = 0;
+		}
+		else
+		{
+			Command.Data.RowPitch	= pImages[i].rowPitch;
+			Command.Data.SlicePitch = pImages[i].slicePitch;
+			Command.Data.pData		= pImages[i].pixels;
+			Command.SizeInBytes		= pImages[i].slicePitch;
+		}
 	}
 
-	Device->Upload(Subresources, AssetTexture->DxTexture.GetResource());
+	return DxTexture;
 }
 
-void AssetManager::UploadMesh(Mesh* AssetMesh, D3D12LinkedDevice* Device)
+void AssetManager::QueueMeshUpload(Mesh* AssetMesh, D3D12LinkedDevice* Device)
 {
-	UINT64 VertexBufferSizeInBytes			  = AssetMesh->Vertices.size() * sizeof(Vertex);
-	UINT64 IndexBufferSizeInBytes			  = AssetMesh->Indices.size() * sizeof(uint32_t);
-	UINT64 MeshletBufferSizeInBytes			  = AssetMesh->Meshlets.size() * sizeof(Meshlet);
-	UINT64 UniqueVertexIndexBufferSizeInBytes = AssetMesh->UniqueVertexIndices.size() * sizeof(uint8_t);
-	UINT64 PrimitiveIndexBufferSizeInBytes	  = AssetMesh->PrimitiveIndices.size() * sizeof(MeshletTriangle);
-
-	auto VertexBuffer  = D3D12Buffer(Device, VertexBufferSizeInBytes, sizeof(Vertex), D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_FLAG_NONE);
-	auto IndexBuffer   = D3D12Buffer(Device, IndexBufferSizeInBytes, sizeof(uint32_t), D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_FLAG_NONE);
-	auto MeshletBuffer = D3D12Buffer(Device, MeshletBufferSizeInBytes, sizeof(Meshlet), D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_FLAG_NONE);
-	auto UniqueVertexIndexBuffer = D3D12Buffer(Device, UniqueVertexIndexBufferSizeInBytes, sizeof(uint8_t), D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_FLAG_NONE);
-	auto PrimitiveIndexBuffer = D3D12Buffer(Device, PrimitiveIndexBufferSizeInBytes, sizeof(MeshletTriangle), D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_FLAG_NONE);
+	// Either the imported vectors or sections of a memory mapped .khscene, copied straight into upload memory
+	std::span Vertices			  = AssetMesh->GetVertices();
+	std::span Indices			  = AssetMesh->GetIndices();
+	std::span Meshlets			  = AssetMesh->GetMeshlets();
+	std::span UniqueVertexIndices = AssetMesh->GetUniqueVertexIndices();
+	std::span PrimitiveIndices	  = AssetMesh->GetPrimitiveIndices();
+
+	// The streams are sections of one allocation, aligned for the root views that read them
+	UINT64 SizeInBytes = 0;
+	auto   AddSection  = [&](MeshSection& Section, UINT64 SectionSizeInBytes)
+	{
+		Section.Offset		= SizeInBytes;
+		Section.SizeInBytes = SectionSizeInBytes;
+		SizeInBytes			= AlignUp(SizeInBytes + SectionSizeInBytes, MeshSectionAlignment);
+	};
+	AddSection(AssetMesh->VertexSection, Vertices.size() * sizeof(MeshVertex));
+	AddSection(AssetMesh->IndexSection, Indices.size() * sizeof(uint32_t));
+	AddSection(AssetMesh->MeshletSection, Meshlets.size() * sizeof(Meshlet));
+	AddSection(AssetMesh->UniqueVertexIndexSection, UniqueVertexIndices.size() * sizeof(uint8_t));
+	AddSection(AssetMesh->PrimitiveIndexSection, PrimitiveIndices.size() * sizeof(MeshletTriangle));
+
+	AssetMesh->Geometry = MeshGeometryPool.Allocate(Device, SizeInBytes);
+
+	auto QueueSectionUpload = [&](const MeshSection& Section, const void* Data)
+	{
+		QueueBufferUpload(AssetMesh->Geometry.GetResource(), AssetMesh->GetBufferOffset(Section), Data, Section.SizeInBytes);
+	};
+	QueueSectionUpload(AssetMesh->VertexSection, Vertices.data());
+	QueueSectionUpload(AssetMesh->IndexSection, Indices.data());
+	QueueSectionUpload(AssetMesh->MeshletSection, Meshlets.data());
+	QueueSectionUpload(AssetMesh->UniqueVertexIndexSection, UniqueVertexIndices.data());
+	QueueSectionUpload(AssetMesh->PrimitiveIndexSection, PrimitiveIndices.data());
 
+	D3D12_RAYTRACING_GEOMETRY_DESC RaytracingGeometryDesc		= {};
+	RaytracingGeometryDesc.Type									= D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
+	RaytracingGeometryDesc.Flags								= D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+	RaytracingGeometryDesc.Triangles.Transform3x4				= NULL;
+	RaytracingGeometryDesc.Triangles.IndexFormat				= DXGI_FORMAT_R32_UINT;
+	RaytracingGeometryDesc.Triangles.VertexFormat				= DXGI_FORMAT_R32G32B32_FLOAT;
+	RaytracingGeometryDesc.Triangles.IndexCount					= AssetMesh->Lods[0].IndexCount; // The BLAS is always built from LOD 0
+	RaytracingGeometryDesc.Triangles.VertexCount				= static_cast<UINT>(Vertices.size());
+	RaytracingGeometryDesc.Triangles.IndexBuffer				= AssetMesh->GetGpuVirtualAddress(AssetMesh->IndexSection);
+	RaytracingGeometryDesc.Triangles.VertexBuffer.StartAddress	= AssetMesh->GetGpuVirtualAddress(AssetMesh->VertexSection);
+	RaytracingGeometryDesc.Triangles.VertexBuffer.StrideInBytes = sizeof(MeshVertex);
+
+	AssetMesh->Blas.AddGeometry(RaytracingGeometryDesc);
+}
+
+void AssetManager::QueueBufferUpload(ID3D12Resource* Resource, UINT64 Offset, const void* Data, UINT64 SizeInBytes)
+{
+	UploadCommand& Command	= UploadCommands.emplace_back();
+	Command.Resource		= Resource;
+	Command.Subresource		= 0;
+	Command.Data.pData		= Data;
+	Command.Data.RowPitch	= SizeInBytes;
+	Command.Data.SlicePitch	= SizeInBytes;
+	Command.SizeInBytes		= SizeInBytes;
+	Command.BufferOffset	= Offset;
+}
+
+bool AssetManager::HasPendingUploads()
+{
+	if (!UploadCommands.empty())
 	{
-		D3D12_SUBRESOURCE_DATA SubresourceData = {};
-		SubresourceData.pData				   = AssetMesh->Vertices.data();
-		SubresourceData.RowPitch			   = VertexBufferSizeInBytes;
-		SubresourceData.SlicePitch			   = VertexBufferSizeInBytes;
-		Device->Upload(SubresourceData, VertexBuffer.GetResource());
+		return true;
 	}
 
 	{
-		D3D12_SUBRESOURCE_DATA SubresourceData = {};
-		SubresourceData.pData				   = AssetMesh->Indices.data();
-		SubresourceData.RowPitch			   = IndexBufferSizeInBytes;
-		SubresourceData.SlicePitch			   = IndexBufferSizeInBytes;
-		Device->Upload(SubresourceData, IndexBuffer.GetResource());
+		std::scoped_lock Lock(Mutex);
+		if (!MeshUploadQueue.empty() || !TextureUploadQueue.empty())
+		{
+			return true;
+		}
 	}
 
+	std::scoped_lock StreamLock(StreamMutex);
+	return !TextureStreamQueue.empty();
+}
+
+bool AssetManager::QueueNextUpload(D3D12LinkedDevice* Device)
+{
+	// Meshes first, they are small and a world is not visible without them. Mutex is only held to take the request,
+	// the gpu resources are created without it
+	Mesh*	 NextMesh	 = nullptr;
+	Texture* NextTexture = nullptr;
 	{
-		D3D12_SUBRESOURCE_DATA SubresourceData = {};
-		SubresourceData.pData				   = AssetMesh->Meshlets.data();
-		SubresourceData.RowPitch			   = MeshletBufferSizeInBytes;
-		SubresourceData.SlicePitch			   = MeshletBufferSizeInBytes;
-		Device->Upload(SubresourceData, MeshletBuffer.GetResource());
+		std::scoped_lock Lock(Mutex);
+		if (!MeshUploadQueue.empty())
+		{
+			NextMesh = MeshUploadQueue.front();
+			MeshUploadQueue.pop();
+		}
+		else if (!TextureUploadQueue.empty())
+		{
+			NextTexture = TextureUploadQueue.front();
+			TextureUploadQueue.pop();
+		}
 	}
 
+	if (NextMesh)
 	{
-		D3D12_SUBRESOURCE_DATA SubresourceData = {};
-		SubresourceData.pData				   = AssetMesh->UniqueVertexIndices.data();
-		SubresourceData.RowPitch			   = UniqueVertexIndexBufferSizeInBytes;
-		SubresourceData.SlicePitch			   = UniqueVertexIndexBufferSizeInBytes;
-		Device->Upload(SubresourceData, UniqueVertexIndexBuffer.GetResource());
+		QueueMeshUpload(NextMesh, Device);
+		UploadCommands.back().CompletedMesh = NextMesh;
+		return true;
 	}
 
+	if (NextTexture)
 	{
-		D3D12_SUBRESOURCE_DATA SubresourceData = {};
-		SubresourceData.pData				   = AssetMesh->PrimitiveIndices.data();
-		SubresourceData.RowPitch			   = PrimitiveIndexBufferSizeInBytes;
-		SubresourceData.SlicePitch			   = PrimitiveIndexBufferSizeInBytes;
-		Device->Upload(SubresourceData, PrimitiveIndexBuffer.GetResource());
+		QueueTextureUpload(NextTexture, Device);
+		UploadCommands.back().CompletedTexture = NextTexture;
+		return true;
 	}
 
-	AssetMesh->VertexResource			 = std::move(VertexBuffer);
-	AssetMesh->IndexResource			 = std::move(IndexBuffer);
-	AssetMesh->MeshletResource			 = std::move(MeshletBuffer);
-	AssetMesh->UniqueVertexIndexResource = std::move(UniqueVertexIndexBuffer);
-	AssetMesh->PrimitiveIndexResource	 = std::move(PrimitiveIndexBuffer);
+	// Stream texture mips, the texture is recreated with the new resident mips and swapped in on the render thread.
+	// The requests of a texture are recorded in order, so each one copies from the texture of the one before
+	std::optional<TextureStreamRequest> Request;
+	{
+		std::scoped_lock StreamLock(StreamMutex);
+		if (!TextureStreamQueue.empty())
+		{
+			Request = TextureStreamQueue.front();
+			TextureStreamQueue.pop_front();
+		}
+	}
 
-	D3D12_GPU_VIRTUAL_ADDRESS IndexAddress	= AssetMesh->IndexResource.GetGpuVirtualAddress();
-	D3D12_GPU_VIRTUAL_ADDRESS VertexAddress = AssetMesh->VertexResource.GetGpuVirtualAddress();
+	if (Request)
+	{
+		D3D12Texture DxTexture			  = QueueMipsUpload(Request->Texture, Device, Request->Mip);
+		Request->Texture->StreamSource		  = DxTexture.GetResource();
+		Request->Texture->StreamSourceMip = Request->Mip;
+		UploadCommands.back().Streamed		  = StreamedTexture{ Request->Texture, Request->Mip, Request->Generation, std::move(DxTexture) };
+		return true;
+	}
 
-	D3D12_RAYTRACING_GEOMETRY_DESC RaytracingGeometryDesc		= {};
-	RaytracingGeometryDesc.Type									= D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
-	RaytracingGeometryDesc.Flags								= D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE;
-	RaytracingGeometryDesc.Triangles.Transform3x4				= NULL;
-	RaytracingGeometryDesc.Triangles.IndexFormat				= DXGI_FORMAT_R32_UINT;
-	RaytracingGeometryDesc.Triangles.VertexFormat				= DXGI_FORMAT_R32G32B32_FLOAT;
-	RaytracingGeometryDesc.Triangles.IndexCount					= static_cast<UINT>(AssetMesh->Indices.size());
-	RaytracingGeometryDesc.Triangles.VertexCount				= static_cast<UINT>(AssetMesh->Vertices.size());
-	RaytracingGeometryDesc.Triangles.IndexBuffer				= IndexAddress;
-	RaytracingGeometryDesc.Triangles.VertexBuffer.StartAddress	= VertexAddress;
-	RaytracingGeometryDesc.Triangles.VertexBuffer.StrideInBytes = sizeof(Vertex);
+	return false;
+}
 
-	AssetMesh->Blas.AddGeometry(RaytracingGeometryDesc);
+void AssetManager::RecordUploadBatch(D3D12LinkedDevice* Device)
+{
+	UploadBatch Batch;
+	UINT64		SizeInBytes = 0;
 
-	AssetMesh->VertexView = D3D12ShaderResourceView(RenderCore::Device->GetDevice(), &AssetMesh->VertexResource, true, 0, VertexBufferSizeInBytes);
-	AssetMesh->IndexView  = D3D12ShaderResourceView(RenderCore::Device->GetDevice(), &AssetMesh->IndexResource, true, 0, IndexBufferSizeInBytes);
+	// A subresource larger than the batch size still goes in a batch of its own
+	Device->BeginResourceUpload();
+	while (SizeInBytes < UploadBatchSizeInBytes && (!UploadCommands.empty() || QueueNextUpload(Device)))
+	{
+		UploadCommand& Command = UploadCommands.front();
+		if (Command.CopySource)
+		{
+			Device->CopySubresource(Command.Resource, Command.Subresource, Command.CopySource, Command.CopySourceSubresource);
+		}
+		else if (Command.BufferOffset)
+		{
+			Device->UploadBuffer(Command.Data.pData, Command.SizeInBytes, Command.Resource, *Command.BufferOffset);
+		}
+		else
+		{
+			Device->Upload(Command.Data, Command.Resource, Command.Subresource);
+		}
+		SizeInBytes += Command.SizeInBytes;
+
+		if (Command.CompletedMesh)
+		{
+			Batch.Meshes.push_back(Command.CompletedMesh);
+		}
+		if (Command.CompletedTexture)
+		{
+			Batch.Textures.push_back(Command.CompletedTexture);
+		}
+		if (Command.Streamed)
+		{
+			Batch.Streamed.push_back(std::move(*Command.Streamed));
+		}
+		UploadCommands.pop_front();
+	}
+	Batch.SyncHandle = Device->EndResourceUpload(false);
+
+	UploadBatches.push_back(std::move(Batch));
+}
+
+void AssetManager::CompleteUploadBatches()
+{
+	// Batches execute in submission order on the copy queue
+	while (!UploadBatches.empty() && UploadBatches.front().SyncHandle.IsComplete())
+	{
+		UploadBatch Batch = std::move(UploadBatches.front());
+		UploadBatches.pop_front();
+
+		if (!Batch.Streamed.empty())
+		{
+			std::scoped_lock StreamLock(StreamMutex);
+			for (auto& Result : Batch.Streamed)
+			{
+				if (Result.Generation == StreamGeneration)
+				{
+					StreamedTextures.push_back(std::move(Result));
+				}
+			}
+		}
+
+		for (auto Mesh : Batch.Meshes)
+		{
+			// Release memory
+			Mesh->Release();
+
+			Mesh->Handle.State = true;
+			MeshCache.UpdateHandleState(Mesh->Handle);
+		}
+		for (auto Texture : Batch.Textures)
+		{
+			// Release memory, streamed textures keep their image for the mips that are not resident yet
+			if (Texture->TailMip > 0)
+			{
+				std::scoped_lock StreamLock(StreamMutex);
+				NewStreamingTextures.push_back(Texture);
+			}
+			else
+			{
+				Texture->Release();
+			}
+
+			Texture->Handle.State = true;
+			TextureCache.UpdateHandleState(Texture->Handle);
+		}
+	}
 }
 
 void AssetManager::RequestUpload(Texture* Texture)
@@ -247,7 +462,7 @@ void AssetManager::RequestUpload(Texture* Texture)
 
 	std::scoped_lock Lock(Mutex);
 	TextureUploadQueue.push(std::move(Texture));
-	ConditionVariable.notify_all();
+	RequestEvent.SetEvent();
 }
 
 void AssetManager::RequestUpload(Mesh* Mesh)
@@ -264,5 +479,86 @@ void AssetManager::RequestUpload(Mesh* Mesh)
 
 	std::scoped_lock Lock(Mutex);
 	MeshUploadQueue.push(std::move(Mesh));
-	ConditionVariable.notify_all();
+	RequestEvent.SetEvent();
+}
+
+void AssetManager::RequestTextureResidency(Texture* Texture, float ScreenSize)
+{
+	if (Texture->TailMip == 0)
+	{
+		return;
+	}
+
+	// The finest mip that is not minified on screen
+	float Texels = static_cast<float>(std::max(Texture->Resolution.x, Texture->Resolution.y));
+	UINT  Mip	 = ScreenSize >= Texels ? 0 : static_cast<UINT>(std::log2(Texels / std::max(ScreenSize, 1.0f)));
+	TextureResidency.Request(Texture->Handle.Id, Mip, ScreenSize);
+}
+
+void AssetManager::UpdateTextureStreaming()
+{
+	D3D12LinkedDevice* Device = RenderCore::Device->GetDevice();
+	++StreamingFrame;
+
+	std::vector<Texture*>		 NewTextures;
+	std::vector<StreamedTexture> Streamed;
+	{
+		std::scoped_lock StreamLock(StreamMutex);
+		NewTextures.swap(NewStreamingTextures);
+		Streamed.swap(StreamedTextures);
+	}
+
+	for (Texture* Texture : NewTextures)
+	{
+		std::vector<UINT64> MipSizes(Texture->TexImage.GetImageCount());
+		for (size_t Mip = 0; Mip < MipSizes.size(); ++Mip)
+		{
+			MipSizes[Mip] = Texture->TexImage.GetImages()[Mip].slicePitch;
+		}
+
+		TextureResidency.Register(Texture->Handle.Id, MipSizes, Texture->TailMip);
+		StreamingTextures[Texture->Handle.Id] = Texture;
+	}
+
+	// The gpu may still read the old texture, and the materials pick up the new view a frame later
+	for (StreamedTexture& Result : Streamed)
+	{
+		Texture* Asset = Result.Texture;
+		Device->Retire(Asset->DxTexture.GetResource());
+		RetiredViews.push_back({ StreamingFrame, std::move(Asset->SRV) });
+
+		Asset->DxTexture   = std::move(Result.DxTexture);
+		Asset->SRV		   = D3D12ShaderResourceView(Device, &Asset->DxTexture, false, std::nullopt, std::nullopt);
+		Asset->ResidentMip = Result.Mip;
+	}
+
+	std::erase_if(
+		RetiredViews,
+		[](const RetiredView& View)
+		{
+			return StreamingFrame - View.Frame > RetiredViewLifetime;
+		});
+
+	std::vector<TextureResidencyChange> Changes = TextureResidency.Update();
+
+	bool Pending;
+	{
+		std::scoped_lock StreamLock(StreamMutex);
+		for (const auto& Change : Changes)
+		{
+			TextureStreamQueue.push_back({ StreamingTextures[Change.Id], Change.NewMip, StreamGeneration });
+		}
+		Pending = !TextureStreamQueue.empty();
+	}
+
+	// The event stays set while the upload thread is busy, so it picks the requests up once it is done
+	if (Pending)
+	{
+		RequestEvent.SetEvent();
+	}
+}
+
+void AssetManager::ReleaseRetiredGeometry()
+{
+	MeshGeometryPool.ReleaseRetiredAllocations(RenderCore::Device->GetDevice());
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include "AsyncImporter.h"
 #include "AssetCache.h"
+#include "TextureResidency.h"
+#include "GeometryPool.h"
 
 class AssetManager
 {
@@ -31,32 +33,156 @@ public:
 
 	static AssetType GetAssetTypeFromExtension(const std::filesystem::path& Path);
 
-	static void AsyncLoadImage(const TextureImportOptions& Options);
+	static void AsyncLoadImage(const TextureImportOptions& Options, ImportPriority Priority = ImportPriority::Normal);
 
-	static void AsyncLoadMesh(const MeshImportOptions& Options);
+	static void AsyncLoadMesh(const MeshImportOptions& Options, ImportPriority Priority = ImportPriority::Normal);
+
+	// Drops queued imports and uploads, imports that are still running are discarded when they finish.
+	// Has to be called before the caches are destroyed while a load is in flight
+	static void CancelPendingLoads();
+
+	[[nodiscard]] static AsyncImportStats GetImportStats() { return ImportPool.GetStats(); }
 
 	static void RequestUpload(Texture* Texture);
 
 	static void RequestUpload(Mesh* Mesh);
 
+	// Called by the renderer every frame for the textures it draws, ScreenSize is the size in pixels the texture
+	// covers on screen and doubles as its streaming priority
+	static void RequestTextureResidency(Texture* Texture, float ScreenSize);
+
+	// Called once per frame on the render thread, swaps in the textures that finished streaming and queues the
+	// residency changes for the requests of this frame
+	static void UpdateTextureStreaming();
+
+	static void SetTextureBudget(UINT64 BudgetInBytes) { TextureResidency.SetBudget(BudgetInBytes); }
+
+	[[nodiscard]] static const TextureResidencyStats& GetTextureResidencyStats() { return TextureResidency.GetStats(); }
+
+	// Called once per frame on the render thread, geometry of destroyed meshes is reused once the gpu is done with it
+	static void ReleaseRetiredGeometry();
+
+	[[nodiscard]] static GeometryPoolStats GetGeometryPoolStats() { return MeshGeometryPool.GetStats(); }
+
 private:
-	static void UploadTexture(Texture* AssetTexture, D3D12LinkedDevice* Device);
-	static void UploadMesh(Mesh* AssetMesh, D3D12LinkedDevice* Device);
+	// Mips of at most this many texels on their larger side are uploaded with the texture and never evicted
+	static constexpr size_t TextureTailSize = 256;
+
+	static constexpr UINT64 DefaultTextureBudget	   = 1024ull * 1024 * 1024;
+	static constexpr UINT64 MaxTextureStreamInPerFrame = 32ull * 1024 * 1024;
+
+	// Frames a replaced view stays allocated, the gpu and the materials may still reference it
+	static constexpr UINT64 RetiredViewLifetime = 3;
+
+	// Mesh streams within a geometry allocation start at this alignment, enough for the raw and structured root views
+	static constexpr UINT64 MeshSectionAlignment = 16;
 
-	inline static AsyncMeshImporter	   MeshImporter;
-	inline static AsyncTextureImporter TextureImporter;
+	// Uploads are recorded in batches of about this many bytes and submitted without waiting for the copy queue, assets
+	// become valid once the batch with their last subresource completes. Assets larger than a batch are split at
+	// subresource boundaries so small assets queued behind them are not held up for long
+	static constexpr UINT64 UploadBatchSizeInBytes	 = 16ull * 1024 * 1024;
+	static constexpr size_t MaxUploadBatchesInFlight = 4;
+
+	struct TextureStreamRequest
+	{
+		Texture* Texture;
+		UINT	 Mip;
+		UINT64	 Generation;
+	};
+
+	struct StreamedTexture
+	{
+		Texture*	 Texture;
+		UINT		 Mip;
+		UINT64		 Generation;
+		D3D12Texture DxTexture;
+	};
+
+	struct RetiredView
+	{
+		UINT64					Frame;
+		D3D12ShaderResourceView View;
+	};
+
+	// One subresource of an asset, the last one of an asset carries what completes with it
+	struct UploadCommand
+	{
+		ID3D12Resource*		   Resource;
+		UINT				   Subresource;
+		D3D12_SUBRESOURCE_DATA Data;
+		UINT64				   SizeInBytes;
+		std::optional<UINT64>  BufferOffset; // Set when the command writes a range of a buffer
+
+		// Set when the subresource is copied from another texture on the gpu instead of uploaded
+		ID3D12Resource* CopySource			  = nullptr;
+		UINT			CopySourceSubresource = 0;
+
+		Mesh*						   CompletedMesh	= nullptr;
+		Texture*					   CompletedTexture = nullptr;
+		std::optional<StreamedTexture> Streamed;
+	};
+
+	struct UploadBatch
+	{
+		D3D12SyncHandle				 SyncHandle;
+		std::vector<Mesh*>			 Meshes;
+		std::vector<Texture*>		 Textures;
+		std::vector<StreamedTexture> Streamed;
+	};
+
+	// 0 if the texture does not stream
+	static UINT GetTailMip(const DirectX::TexMetadata& Metadata);
+
+	// Create the gpu resources of an asset and queue the upload of their subresources
+	static void			QueueTextureUpload(Texture* AssetTexture, D3D12LinkedDevice* Device);
+	static D3D12Texture QueueMipsUpload(const Texture* AssetTexture, D3D12LinkedDevice* Device, UINT MostDetailedMip);
+	static void			QueueMeshUpload(Mesh* AssetMesh, D3D12LinkedDevice* Device);
+	static void			QueueBufferUpload(ID3D12Resource* Resource, UINT64 Offset, const void* Data, UINT64 SizeInBytes);
+
+	// The following are called on the upload thread with RecordMutex held
+	[[nodiscard]] static bool HasPendingUploads();
+	[[nodiscard]] static bool QueueNextUpload(D3D12LinkedDevice* Device);
+	static void				  RecordUploadBatch(D3D12LinkedDevice* Device);
+	static void				  CompleteUploadBatches();
+
+	// Initialized before and destroyed after the importers that use it
+	inline static AsyncImportPool	   ImportPool{ std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+	inline static AsyncMeshImporter	   MeshImporter{ ImportPool };
+	inline static AsyncTextureImporter TextureImporter{ ImportPool };
+
+	// Allocated from on the upload thread, outlives the meshes that free into it
+	inline static GeometryPool MeshGeometryPool;
 
 	inline static AssetCache<AssetType::Mesh, Mesh>		  MeshCache;
 	inline static AssetCache<AssetType::Texture, Texture> TextureCache;
 
-	// Upload stuff to the GPU
-	inline static std::mutex			  Mutex;
-	inline static std::condition_variable ConditionVariable;
-	inline static std::queue<Mesh*>		  MeshUploadQueue;
-	inline static std::queue<Texture*>	  TextureUploadQueue;
+	// Upload stuff to the GPU. Mutex only guards the requests, so requesting an upload never waits for the upload
+	// thread to record a batch. RecordMutex is held by the upload thread while it records or completes batches
+	inline static std::mutex				Mutex;
+	inline static std::queue<Mesh*>			MeshUploadQueue;
+	inline static std::queue<Texture*>		TextureUploadQueue;
+	inline static wil::unique_event			RequestEvent;
+	inline static std::mutex				RecordMutex;
+	inline static std::deque<UploadCommand>	UploadCommands;	// Of the asset that did not fit the last batch
+	inline static std::deque<UploadBatch>	UploadBatches;	// In flight, in submission order
+	inline static wil::unique_event			BatchEvent;		// Set once the oldest batch in flight completes
 
 	inline static std::jthread		Thread;
 	inline static std::atomic<bool> Quit = false;
 
+	// Texture streaming, only used on the render thread
+	inline static TextureResidencyManager			 TextureResidency{ DefaultTextureBudget, MaxTextureStreamInPerFrame };
+	inline static std::unordered_map<UINT, Texture*> StreamingTextures; // By handle id
+	inline static std::vector<RetiredView>			 RetiredViews;
+	inline static UINT64							 StreamingFrame = 0;
+
+	// Shared with the upload thread, which holds RecordMutex while it records or completes a batch. Generation changes
+	// when pending loads are cancelled so stale streamed textures are dropped
+	inline static std::mutex					   StreamMutex;
+	inline static std::vector<Texture*>			   NewStreamingTextures;
+	inline static std::deque<TextureStreamRequest> TextureStreamQueue;
+	inline static std::vector<StreamedTexture>	   StreamedTextures;
+	inline static UINT64						   StreamGeneration = 0;
+
 	friend class AssetWindow;
 };
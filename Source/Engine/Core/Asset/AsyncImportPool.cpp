@@ -0,0 +1,133 @@
+#include "AsyncImportPool.h"
+
+AsyncImportPool::AsyncImportPool(size_t NumWorkers)
+{
+	Workers.reserve(NumWorkers);
+	for (size_t i = 0; i < NumWorkers; ++i)
+	{
+		Workers.emplace_back(
+			[this, i](std::stop_token StopToken)
+			{
+				std::wstring ThreadName = L"Asset Importer " + std::to_wstring(i);
+				SetThreadDescription(GetCurrentThread(), ThreadName.data());
+				WorkerLoop(StopToken);
+			});
+	}
+}
+
+AsyncImportPool::~AsyncImportPool()
+{
+	for (auto& Worker : Workers)
+	{
+		Worker.request_stop();
+	}
+	WorkAvailable.notify_all();
+}
+
+void AsyncImportPool::Enqueue(const void* Owner, ImportPriority Priority, std::function<void()> Work)
+{
+	{
+		std::scoped_lock Lock(Mutex);
+		Requests.push_back({ Owner, Priority, NextSequence++, Clock::now(), std::move(Work) });
+		std::ranges::push_heap(Requests, HeapCompare);
+
+		Stats.NumQueued	 = Requests.size();
+		Stats.PeakQueued = std::max(Stats.PeakQueued, Stats.NumQueued);
+	}
+	WorkAvailable.notify_one();
+}
+
+size_t AsyncImportPool::Cancel(const void* Owner)
+{
+	std::scoped_lock Lock(Mutex);
+
+	size_t NumCancelled = std::erase_if(
+		Requests,
+		[Owner](const Request& Request)
+		{
+			return Request.Owner == Owner;
+		});
+	std::ranges::make_heap(Requests, HeapCompare);
+
+	Stats.NumQueued = Requests.size();
+	Stats.NumCancelled += NumCancelled;
+	return NumCancelled;
+}
+
+void AsyncImportPool::Drain(const void* Owner)
+{
+	Cancel(Owner);
+
+	std::unique_lock Lock(Mutex);
+	WorkDone.wait(
+		Lock,
+		[&]
+		{
+			return !RunningOwners.contains(Owner);
+		});
+}
+
+AsyncImportStats AsyncImportPool::GetStats() const
+{
+	std::scoped_lock Lock(Mutex);
+	AsyncImportStats Result = Stats;
+	if (UINT64 NumStarted = Stats.NumCompleted + Stats.NumRunning; NumStarted > 0)
+	{
+		Result.AverageLatencyMs = std::chrono::duration<double, std::milli>(TotalLatency).count() / static_cast<double>(NumStarted);
+	}
+	if (Stats.NumCompleted > 0)
+	{
+		Result.AverageImportMs = std::chrono::duration<double, std::milli>(TotalImport).count() / static_cast<double>(Stats.NumCompleted);
+	}
+	return Result;
+}
+
+bool AsyncImportPool::HeapCompare(const Request& a, const Request& b) noexcept
+{
+	if (a.Priority != b.Priority)
+	{
+		return a.Priority < b.Priority;
+	}
+	return a.Sequence > b.Sequence;
+}
+
+void AsyncImportPool::WorkerLoop(std::stop_token StopToken)
+{
+	std::unique_lock Lock(Mutex);
+	while (true)
+	{
+		WorkAvailable.wait(
+			Lock,
+			StopToken,
+			[this]
+			{
+				return !Requests.empty();
+			});
+
+		// Queued requests are dropped once a stop is requested
+		if (StopToken.stop_requested())
+		{
+			break;
+		}
+
+		std::ranges::pop_heap(Requests, HeapCompare);
+		Request Request = std::move(Requests.back());
+		Requests.pop_back();
+
+		Clock::time_point StartTime = Clock::now();
+		TotalLatency += StartTime - Request.EnqueueTime;
+		Stats.NumQueued = Requests.size();
+		++Stats.NumRunning;
+		RunningOwners.insert(Request.Owner);
+
+		Lock.unlock();
+		Request.Work();
+		Lock.lock();
+
+		TotalImport += Clock::now() - StartTime;
+		--Stats.NumRunning;
+		++Stats.NumCompleted;
+		RunningOwners.erase(RunningOwners.find(Request.Owner));
+		WorkDone.notify_all();
+	}
+}
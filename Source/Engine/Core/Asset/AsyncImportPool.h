@@ -0,0 +1,77 @@
+#pragma once
+
+enum class ImportPriority
+{
+	Low,
+	Normal,
+	High,	// Referenced by the world
+	Highest // Needed before the world can be shown, e.g. the skylight
+};
+
+struct AsyncImportStats
+{
+	UINT64 NumQueued		= 0; // Waiting for a worker
+	UINT64 PeakQueued		= 0;
+	UINT64 NumRunning		= 0;
+	UINT64 NumCompleted		= 0;
+	UINT64 NumCancelled		= 0;
+	double AverageLatencyMs = 0.0; // From the request until a worker picks it up
+	double AverageImportMs	= 0.0;
+};
+
+// Worker pool shared by every AsyncImporter, the request with the highest priority runs first and
+// requests of equal priority run in submission order
+class AsyncImportPool
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit AsyncImportPool(size_t NumWorkers);
+	~AsyncImportPool();
+
+	AsyncImportPool(const AsyncImportPool&)			   = delete;
+	AsyncImportPool& operator=(const AsyncImportPool&) = delete;
+
+	[[nodiscard]] size_t GetNumWorkers() const noexcept { return Workers.size(); }
+
+	// Owner identifies the requests for Cancel and Drain
+	void Enqueue(const void* Owner, ImportPriority Priority, std::function<void()> Work);
+
+	// Drops the queued requests of Owner, requests that already started run to completion
+	size_t Cancel(const void* Owner);
+
+	// Cancels the queued requests of Owner and waits for the running ones
+	void Drain(const void* Owner);
+
+	[[nodiscard]] AsyncImportStats GetStats() const;
+
+private:
+	struct Request
+	{
+		const void*			  Owner;
+		ImportPriority		  Priority;
+		UINT64				  Sequence;
+		Clock::time_point	  EnqueueTime;
+		std::function<void()> Work;
+	};
+
+	// Heap order, the highest priority and then the oldest request ends up on top
+	static bool HeapCompare(const Request& a, const Request& b) noexcept;
+
+	void WorkerLoop(std::stop_token StopToken);
+
+private:
+	std::vector<std::jthread> Workers;
+
+	mutable std::mutex			Mutex;
+	std::condition_variable_any WorkAvailable;
+	std::condition_variable		WorkDone;
+
+	// Guarded by Mutex
+	std::vector<Request>				 Requests;
+	std::unordered_multiset<const void*> RunningOwners;
+	UINT64								 NextSequence = 0;
+	AsyncImportStats					 Stats;
+	Clock::duration						 TotalLatency = {};
+	Clock::duration						 TotalImport  = {};
+};
@@ -1,16 +1,20 @@
 #include "AsyncImporter.h"
 #include "AssetManager.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <execution>
+
 // kh = my name initials
-static constexpr char MeshExportExtension[] = ".khscene";
+static constexpr char MeshExportExtension[]	   = ".khscene";
+static constexpr char TextureExportExtension[] = ".khtex";
 
 using namespace DirectX;
 
-static Assimp::Importer	  s_Importer;
 static constexpr uint32_t s_ImporterFlags =
 	aiProcess_ConvertToLeftHanded |
 	aiProcess_JoinIdenticalVertices |
@@ -21,6 +25,10 @@ static constexpr uint32_t s_ImporterFlags =
 	aiProcess_OptimizeMeshes |
 	aiProcess_ValidateDataStructure;
 
+// Every LOD targets half the triangles of the previous one, the chain ends early once a LOD would exceed this error
+// (relative to the bounding box diagonal) or removes less than a quarter of the previous triangles
+static constexpr float s_MaxLodError = 0.05f;
+
 template<typename TLambda>
 class ExecutionTimer
 {
@@ -42,7 +50,129 @@ private:
 	TLambda			  Message;
 };
 
-void AsyncTextureImporter::Import(const TextureImportOptions& Options)
+// Decodes a png, tga, hdr, ... file that was read into memory
+static void DecodeImage(const std::string& Extension, const MemoryMappedView& Source, bool GenerateMips, ScratchImage& OutImage)
+{
+	const void*	 Data = Source.GetView(0);
+	const size_t Size = Source.GetSizeInBytes();
+
+	ScratchImage BaseImage;
+	if (Extension == ".tga")
+	{
+		LoadFromTGAMemory(Data, Size, TGA_FLAGS_NONE, nullptr, BaseImage);
+	}
+	else if (Extension == ".hdr")
+	{
+		LoadFromHDRMemory(Data, Size, nullptr, BaseImage);
+	}
+	else
+	{
+		LoadFromWICMemory(Data, Size, WIC_FLAGS::WIC_FLAGS_FORCE_RGB, nullptr, BaseImage);
+	}
+
+	if (GenerateMips && BaseImage.GetImageCount() > 0)
+	{
+		GenerateMipMaps(*BaseImage.GetImage(0, 0, 0), TEX_FILTER_DEFAULT, 0, OutImage, false);
+	}
+	else
+	{
+		OutImage = std::move(BaseImage);
+	}
+}
+
+// Block compression format for Images, DXGI_FORMAT_UNKNOWN keeps them uncompressed
+static DXGI_FORMAT GetCompressedFormat(const ScratchImage& Images)
+{
+	// D3D12 requires the top level of a block compressed texture to be a multiple of the block size
+	const TexMetadata& Metadata = Images.GetMetadata();
+	if (IsCompressed(Metadata.format) || Metadata.dimension != TEX_DIMENSION_TEXTURE2D || Metadata.width % 4 != 0 || Metadata.height % 4 != 0)
+	{
+		return DXGI_FORMAT_UNKNOWN;
+	}
+
+	if (FormatDataType(Metadata.format) == FORMAT_TYPE_FLOAT)
+	{
+		return DXGI_FORMAT_BC6H_UF16;
+	}
+
+	switch (Metadata.format)
+	{
+	case DXGI_FORMAT_R8G8_UNORM:
+		return DXGI_FORMAT_BC5_UNORM;
+	case DXGI_FORMAT_R8_UNORM:
+		return DXGI_FORMAT_BC4_UNORM;
+	default:
+		return Images.IsAlphaAllOpaque() ? DXGI_FORMAT_BC1_UNORM : DXGI_FORMAT_BC7_UNORM;
+	}
+}
+
+// Compresses every mip and slice in strips of rows so a single large mip is still encoded on every core
+static bool CompressImages(ScratchImage& Images, DXGI_FORMAT Format)
+{
+	static constexpr size_t StripHeight = 64; // Multiple of the block size
+
+	TexMetadata Metadata = Images.GetMetadata();
+	Metadata.format		 = Format;
+
+	ScratchImage Compressed;
+	if (FAILED(Compressed.Initialize(Metadata)))
+	{
+		return false;
+	}
+
+	struct Strip
+	{
+		size_t ImageIndex;
+		size_t Y;
+		size_t Height;
+	};
+	std::vector<Strip> Strips;
+	for (size_t i = 0; i < Images.GetImageCount(); ++i)
+	{
+		const size_t Height = Images.GetImages()[i].height;
+		for (size_t y = 0; y < Height; y += StripHeight)
+		{
+			Strips.push_back({ i, y, std::min(StripHeight, Height - y) });
+		}
+	}
+
+	TEX_COMPRESS_FLAGS Flags = Format == DXGI_FORMAT_BC7_UNORM ? TEX_COMPRESS_BC7_QUICK : TEX_COMPRESS_DEFAULT;
+
+	std::atomic<bool> Failed = false;
+	std::for_each(
+		std::execution::par,
+		Strips.begin(),
+		Strips.end(),
+		[&](const Strip& Strip)
+		{
+			const Image& Source		 = Images.GetImages()[Strip.ImageIndex];
+			const Image& Destination = Compressed.GetImages()[Strip.ImageIndex];
+
+			Image Rows		= Source;
+			Rows.height		= Strip.Height;
+			Rows.slicePitch = Source.rowPitch * Strip.Height;
+			Rows.pixels		= Source.pixels + Strip.Y * Source.rowPitch;
+
+			ScratchImage Blocks;
+			if (FAILED(Compress(Rows, Format, Flags, TEX_THRESHOLD_DEFAULT, Blocks)))
+			{
+				Failed = true;
+				return;
+			}
+
+			// Strips start on a block row, so the compressed rows are contiguous in the destination
+			std::memcpy(Destination.pixels + Strip.Y / 4 * Destination.rowPitch, Blocks.GetPixels(), Blocks.GetPixelsSize());
+		});
+
+	if (Failed)
+	{
+		return false;
+	}
+	Images = std::move(Compressed);
+	return true;
+}
+
+std::vector<Texture> AsyncTextureImporter::Import(const TextureImportOptions& Options)
 {
 	const auto& Path	  = Options.Path;
 	const auto	Extension = Path.extension().string();
@@ -54,62 +184,263 @@ void AsyncTextureImporter::Import(const TextureImportOptions& Options)
 			LOG_INFO("{} loaded in {}(ms)", Path.string(), Elapsed.count());
 		});
 
-	TexMetadata	 TexMetadata = {};
-	ScratchImage OutImage	 = {};
+	ScratchImage OutImage = {};
 	if (Extension == ".dds")
 	{
-		LoadFromDDSFile(Path.c_str(), DDS_FLAGS::DDS_FLAGS_FORCE_RGB, &TexMetadata, OutImage);
+		// Processed offline already, used as is
+		LoadFromDDSFile(Path.c_str(), DDS_FLAGS::DDS_FLAGS_FORCE_RGB, nullptr, OutImage);
 	}
-	else if (Extension == ".tga")
+	else
 	{
-		if (Options.GenerateMips)
+		FileStream Stream(Path, FileMode::Open, FileAccess::Read);
+		if (Stream.GetSizeInBytes() == 0)
 		{
-			ScratchImage BaseImage;
-			LoadFromTGAFile(Path.c_str(), &TexMetadata, BaseImage);
-			GenerateMipMaps(*BaseImage.GetImage(0, 0, 0), TEX_FILTER_DEFAULT, 0, OutImage, false);
+			LOG_ERROR("{} is empty", Path.string());
+			return {};
 		}
-		else
+
+		MemoryMappedFile File(Stream);
+		MemoryMappedView Source = File.CreateView();
+
+		ExportHeader Header = {};
+		Header.Magic		= ExportMagic;
+		Header.Version		= ExportVersion;
+		Header.SourceHash	= CityHash64(reinterpret_cast<const char*>(Source.GetView(0)), Source.GetSizeInBytes());
+		Header.OptionFlags	= (Options.sRGB ? 1 : 0) | (Options.GenerateMips ? 2 : 0) | (Options.Compress ? 4 : 0);
+
+		std::filesystem::path CachePath = Path;
+		CachePath += TextureExportExtension;
+		if (!exists(CachePath) || !ImportExisting(CachePath, Header, OutImage))
 		{
-			LoadFromTGAFile(Path.c_str(), &TexMetadata, OutImage);
+			DecodeImage(Extension, Source, Options.GenerateMips, OutImage);
+
+			DXGI_FORMAT Format = Options.Compress ? GetCompressedFormat(OutImage) : DXGI_FORMAT_UNKNOWN;
+			if (Format != DXGI_FORMAT_UNKNOWN && !CompressImages(OutImage, Format))
+			{
+				LOG_WARN("{}: Block compression failed, keeping the texture uncompressed", Path.string());
+			}
+
+			if (OutImage.GetImageCount() > 0)
+			{
+				Export(CachePath, Header, OutImage);
+			}
 		}
 	}
-	else if (Extension == ".hdr")
+
+	if (OutImage.GetImageCount() == 0)
 	{
-		if (Options.GenerateMips)
+		LOG_ERROR("Failed to load {}", Path.string());
+		return {};
+	}
+
+	const TexMetadata& TexMetadata = OutImage.GetMetadata();
+
+	std::vector<Texture> Textures(1);
+	Texture&			 Texture = Textures[0];
+	Texture.Options				 = Options;
+	Texture.Resolution			 = Vec2i(static_cast<int>(TexMetadata.width), static_cast<int>(TexMetadata.height));
+	Texture.IsCubemap			 = TexMetadata.IsCubemap();
+	Texture.Name				 = Path.filename().string();
+	Texture.TexImage			 = std::move(OutImage);
+	return Textures;
+}
+
+void AsyncTextureImporter::Export(const std::filesystem::path& CachePath, const ExportHeader& Header, const ScratchImage& Image)
+{
+	Blob Dds;
+	if (FAILED(SaveToDDSMemory(Image.GetImages(), Image.GetImageCount(), Image.GetMetadata(), DDS_FLAGS_NONE, Dds)))
+	{
+		LOG_WARN("{}: Failed to write the texture cache", CachePath.string());
+		return;
+	}
+
+	FileStream	 Stream(CachePath, FileMode::Create, FileAccess::Write);
+	BinaryWriter Writer(Stream);
+	Writer.Write<ExportHeader>(Header);
+	Writer.Write(Dds.GetBufferPointer(), Dds.GetBufferSize());
+}
+
+bool AsyncTextureImporter::ImportExisting(const std::filesystem::path& CachePath, const ExportHeader& Expected, ScratchImage& Image)
+{
+	FileStream Stream(CachePath, FileMode::Open, FileAccess::Read);
+	if (Stream.GetSizeInBytes() <= sizeof(ExportHeader))
+	{
+		return false;
+	}
+
+	MemoryMappedFile File(Stream);
+	MemoryMappedView View = File.CreateView();
+
+	// A different source, different options or an older version, the texture is processed again
+	auto Header = View.Read<ExportHeader>(0);
+	if (std::memcmp(&Header, &Expected, sizeof(ExportHeader)) != 0)
+	{
+		return false;
+	}
+
+	return SUCCEEDED(LoadFromDDSMemory(View.GetView(sizeof(ExportHeader)), View.GetSizeInBytes() - sizeof(ExportHeader), DDS_FLAGS_NONE, nullptr, Image));
+}
+
+AssetHandle AsyncTextureImporter::ReserveAsset()
+{
+	return AssetManager::GetTextureCache().Reserve();
+}
+
+void AsyncTextureImporter::ReleaseAsset(AssetHandle Reserved)
+{
+	AssetManager::GetTextureCache().Release(Reserved);
+}
+
+void AsyncTextureImporter::CreateAssets(AssetHandle Reserved, std::vector<Texture>& Textures)
+{
+	// A failed import leaves a hole, the textures requested after it keep their ids
+	auto& TextureCache = AssetManager::GetTextureCache();
+	if (Textures.empty() || !TextureCache.CreateAt(Reserved, std::move(Textures.front())))
+	{
+		TextureCache.Release(Reserved);
+		return;
+	}
+	AssetManager::RequestUpload(TextureCache.GetAsset(Reserved));
+}
+
+// Converts one assimp mesh and builds its meshlets, only touches Mesh so meshes can be processed concurrently
+static void ProcessMesh(const aiMesh* paiMesh, const MeshImportOptions& Options, Mesh* Mesh)
+{
+	// Parse vertex data
+	std::vector<Vertex> Vertices;
+	Vertices.reserve(paiMesh->mNumVertices);
+	for (unsigned int v = 0; v < paiMesh->mNumVertices; ++v)
+	{
+		Vertex& vertex = Vertices.emplace_back();
+		// Position
+		vertex.Position = { paiMesh->mVertices[v].x, paiMesh->mVertices[v].y, paiMesh->mVertices[v].z };
+
+		// Texture coords
+		if (paiMesh->HasTextureCoords(0))
 		{
-			ScratchImage BaseImage;
-			LoadFromHDRFile(Path.c_str(), &TexMetadata, BaseImage);
-			GenerateMipMaps(*BaseImage.GetImage(0, 0, 0), TEX_FILTER_DEFAULT, 0, OutImage, false);
+			vertex.TextureCoord = { paiMesh->mTextureCoords[0][v].x, paiMesh->mTextureCoords[0][v].y };
 		}
-		else
+
+		// Normal
+		if (paiMesh->HasNormals())
 		{
-			LoadFromHDRFile(Path.c_str(), &TexMetadata, OutImage);
+			vertex.Normal = { paiMesh->mNormals[v].x, paiMesh->mNormals[v].y, paiMesh->mNormals[v].z };
 		}
 	}
+
+	XMMATRIX Matrix = XMLoadFloat4x4(&Options.Matrix);
+	XMVector3TransformCoordStream(
+		&Vertices[0].Position,
+		sizeof(Vertex),
+		&Vertices[0].Position,
+		sizeof(Vertex),
+		Vertices.size(),
+		Matrix);
+
+	XMVector3TransformNormalStream(
+		&Vertices[0].Normal,
+		sizeof(Vertex),
+		&Vertices[0].Normal,
+		sizeof(Vertex),
+		Vertices.size(),
+		Matrix);
+
+	// Parse index data
+	std::vector<std::uint32_t> Indices;
+	Indices.reserve(static_cast<size_t>(paiMesh->mNumFaces) * 3);
+	std::span Faces = { paiMesh->mFaces, paiMesh->mNumFaces };
+	for (const auto& Face : Faces)
+	{
+		Indices.push_back(Face.mIndices[0]);
+		Indices.push_back(Face.mIndices[1]);
+		Indices.push_back(Face.mIndices[2]);
+	}
+
+	// Cache and fetch friendly order before the meshlets are built from it
+	if (MeshOptimizationStats Stats; MeshOptimizer::Optimize(Vertices, Indices, &Stats))
+	{
+		LOG_INFO(
+			"{}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, removed {} vertices and {} triangles",
+			Mesh->Name,
+			Stats.AcmrBefore,
+			Stats.AcmrAfter,
+			Stats.AtvrBefore,
+			Stats.AtvrAfter,
+			Stats.NumRemovedVertices,
+			Stats.NumRemovedTriangles);
+	}
 	else
 	{
-		if (Options.GenerateMips)
+		LOG_WARN("{}: Mesh optimization failed, keeping the imported order", Mesh->Name);
+	}
+
+	// LOD 0 followed by the simplified LODs, all of them share the vertices
+	Mesh->Lods.push_back({ 0, static_cast<uint32_t>(Indices.size()), 0, 0, 0.0f });
+	for (size_t Lod = 1; Lod < MaxMeshLods; ++Lod)
+	{
+		size_t TargetFaceCount = Mesh->Lods[0].IndexCount / 3 >> Lod;
+
+		float				  Error;
+		std::vector<uint32_t> LodIndices = MeshSimplifier::Simplify(Vertices, { Indices.data(), Mesh->Lods[0].IndexCount }, TargetFaceCount * 3, s_MaxLodError, &Error);
+		if (LodIndices.empty() || LodIndices.size() > Mesh->Lods.back().IndexCount / 4 * 3)
 		{
-			ScratchImage BaseImage;
-			LoadFromWICFile(Path.c_str(), WIC_FLAGS::WIC_FLAGS_FORCE_RGB, &TexMetadata, BaseImage);
-			GenerateMipMaps(*BaseImage.GetImage(0, 0, 0), TEX_FILTER_DEFAULT, 0, OutImage, false);
+			break;
 		}
-		else
+
+		MeshOptimizer::OptimizeFaces(LodIndices);
+		Mesh->Lods.push_back({ static_cast<uint32_t>(Indices.size()), static_cast<uint32_t>(LodIndices.size()), 0, 0, Error });
+		Indices.insert(Indices.end(), LodIndices.begin(), LodIndices.end());
+	}
+
+	std::vector<XMFLOAT3> Positions;
+	Positions.reserve(Vertices.size());
+	for (const auto& Vertex : Vertices)
+	{
+		Positions.emplace_back(Vertex.Position);
+	}
+
+	// Meshlets of every LOD go into the same buffers, offsets are rebased onto the combined vertex index and
+	// primitive buffers
+	for (MeshLod& Lod : Mesh->Lods)
+	{
+		std::vector<Meshlet>		 LodMeshlets;
+		std::vector<uint8_t>		 LodUniqueVertexIndices;
+		std::vector<MeshletTriangle> LodPrimitiveIndices;
+		ComputeMeshlets(
+			Indices.data() + Lod.IndexOffset,
+			Lod.IndexCount / 3,
+			Positions.data(),
+			Positions.size(),
+			nullptr,
+			LodMeshlets,
+			LodUniqueVertexIndices,
+			LodPrimitiveIndices);
+
+		const uint32_t VertexOffset	   = static_cast<uint32_t>(Mesh->UniqueVertexIndices.size() / sizeof(uint32_t));
+		const uint32_t PrimitiveOffset = static_cast<uint32_t>(Mesh->PrimitiveIndices.size());
+		for (Meshlet& Meshlet : LodMeshlets)
 		{
-			LoadFromWICFile(Path.c_str(), WIC_FLAGS::WIC_FLAGS_FORCE_RGB, &TexMetadata, OutImage);
+			Meshlet.VertOffset += VertexOffset;
+			Meshlet.PrimOffset += PrimitiveOffset;
 		}
+
+		Lod.MeshletOffset = static_cast<uint32_t>(Mesh->Meshlets.size());
+		Lod.MeshletCount  = static_cast<uint32_t>(LodMeshlets.size());
+		Mesh->Meshlets.insert(Mesh->Meshlets.end(), LodMeshlets.begin(), LodMeshlets.end());
+		Mesh->UniqueVertexIndices.insert(Mesh->UniqueVertexIndices.end(), LodUniqueVertexIndices.begin(), LodUniqueVertexIndices.end());
+		Mesh->PrimitiveIndices.insert(Mesh->PrimitiveIndices.end(), LodPrimitiveIndices.begin(), LodPrimitiveIndices.end());
 	}
 
-	Texture* Texture	= AssetManager::CreateAsset<AssetType::Texture>();
-	Texture->Options	= Options;
-	Texture->Resolution = Vec2i(static_cast<int>(TexMetadata.width), static_cast<int>(TexMetadata.height));
-	Texture->IsCubemap	= TexMetadata.IsCubemap();
-	Texture->Name		= Path.filename().string();
-	Texture->TexImage	= std::move(OutImage);
-	AssetManager::RequestUpload(Texture);
+#if KAGUYA_PACKED_VERTEX
+	Mesh->Vertices.resize(Vertices.size());
+	std::ranges::transform(Vertices, Mesh->Vertices.begin(), PackVertex);
+#else
+	Mesh->Vertices = std::move(Vertices);
+#endif
+	Mesh->Indices = std::move(Indices);
 }
 
-void AsyncMeshImporter::Import(const MeshImportOptions& Options)
+std::vector<Mesh> AsyncMeshImporter::Import(const MeshImportOptions& Options)
 {
 	LOG_INFO("Loading: {}", Options.Path.string());
 	ExecutionTimer Timer(
@@ -121,209 +452,196 @@ void AsyncMeshImporter::Import(const MeshImportOptions& Options)
 	std::filesystem::path BinaryPath = Options.Path;
 	BinaryPath.replace_extension(MeshExportExtension);
 
-	std::vector<Mesh*> Meshes;
+	std::vector<Mesh> Meshes;
 	if (exists(BinaryPath))
 	{
 		Meshes = ImportExisting(BinaryPath, Options);
 	}
-	else
+
+	// No export yet or one written by an older version
+	if (Meshes.empty())
 	{
 		const auto Path = Options.Path.string();
 
-		const aiScene* paiScene = s_Importer.ReadFile(Path.data(), s_ImporterFlags);
+		// Assimp::Importer is not thread safe, every import gets its own
+		Assimp::Importer Importer;
+		const aiScene*	 paiScene = Importer.ReadFile(Path.data(), s_ImporterFlags);
 
 		if (!paiScene || !paiScene->HasMeshes())
 		{
 			LOG_ERROR("Assimp::Importer error when loading {}", Path.data());
-			LOG_ERROR("Error: {}", s_Importer.GetErrorString());
-			return;
+			LOG_ERROR("Error: {}", Importer.GetErrorString());
+			return {};
 		}
 
-		if (paiScene->mNumMeshes >= AssetManager::GetMeshCache().NumAssets)
+		// The mesh cache grows as meshes are created, this only guards the id range
+		if (paiScene->mNumMeshes >= AssetManager::GetMeshCache().MaxAssets)
 		{
 			LOG_ERROR(
 				"Scene contains {} meshes, but AssetManager can only handle {} meshes",
 				paiScene->mNumMeshes,
-				AssetManager::GetMeshCache().NumAssets);
-			return;
+				AssetManager::GetMeshCache().MaxAssets);
+			return {};
 		}
 
-		Meshes.reserve(paiScene->mNumMeshes);
+		// Meshes stay in scene order, the export doesn't depend on scheduling
+		Meshes.resize(paiScene->mNumMeshes);
 		for (unsigned m = 0; m < paiScene->mNumMeshes; ++m)
 		{
 			// Assimp object
 			const aiMesh* paiMesh = paiScene->mMeshes[m];
 
-			// Parse vertex data
-			std::vector<Vertex> Vertices;
-			Vertices.reserve(paiMesh->mNumVertices);
-			for (unsigned int v = 0; v < paiMesh->mNumVertices; ++v)
-			{
-				Vertex& vertex = Vertices.emplace_back();
-				// Position
-				vertex.Position = { paiMesh->mVertices[v].x, paiMesh->mVertices[v].y, paiMesh->mVertices[v].z };
-
-				// Texture coords
-				if (paiMesh->HasTextureCoords(0))
-				{
-					vertex.TextureCoord = { paiMesh->mTextureCoords[0][v].x, paiMesh->mTextureCoords[0][v].y };
-				}
-
-				// Normal
-				if (paiMesh->HasNormals())
-				{
-					vertex.Normal = { paiMesh->mNormals[v].x, paiMesh->mNormals[v].y, paiMesh->mNormals[v].z };
-				}
-			}
-
-			XMMATRIX Matrix = XMLoadFloat4x4(&Options.Matrix);
-			XMVector3TransformCoordStream(
-				&Vertices[0].Position,
-				sizeof(Vertex),
-				&Vertices[0].Position,
-				sizeof(Vertex),
-				Vertices.size(),
-				Matrix);
-
-			XMVector3TransformNormalStream(
-				&Vertices[0].Normal,
-				sizeof(Vertex),
-				&Vertices[0].Normal,
-				sizeof(Vertex),
-				Vertices.size(),
-				Matrix);
-
-			// Parse index data
-			std::vector<std::uint32_t> Indices;
-			Indices.reserve(static_cast<size_t>(paiMesh->mNumFaces) * 3);
-			std::span Faces = { paiMesh->mFaces, paiMesh->mNumFaces };
-			for (const auto& Face : Faces)
-			{
-				Indices.push_back(Face.mIndices[0]);
-				Indices.push_back(Face.mIndices[1]);
-				Indices.push_back(Face.mIndices[2]);
-			}
-
-			Mesh* Mesh	  = Meshes.emplace_back(AssetManager::CreateAsset<AssetType::Mesh>());
-			Mesh->Options = Options;
+			Mesh& Mesh	 = Meshes[m];
+			Mesh.Options = Options;
 			if (paiMesh->mName.length == 0)
 			{
-				Mesh->Name = Options.Path.filename().string();
+				Mesh.Name = Options.Path.filename().string();
 			}
 			else
 			{
-				Mesh->Name = paiMesh->mName.C_Str();
+				Mesh.Name = paiMesh->mName.C_Str();
 			}
+		}
 
-			Mesh->Vertices = std::move(Vertices);
-			Mesh->Indices  = std::move(Indices);
-
-			std::vector<XMFLOAT3> Positions;
-			Positions.reserve(Mesh->Vertices.size());
-			for (const auto& Vertex : Mesh->Vertices)
+		std::vector<unsigned> MeshIndices(paiScene->mNumMeshes);
+		std::iota(MeshIndices.begin(), MeshIndices.end(), 0u);
+		std::for_each(
+			std::execution::par,
+			MeshIndices.begin(),
+			MeshIndices.end(),
+			[&](unsigned m)
 			{
-				Positions.emplace_back(Vertex.Position);
-			}
-
-			ComputeMeshlets(
-				Mesh->Indices.data(),
-				Mesh->Indices.size() / 3,
-				Positions.data(),
-				Positions.size(),
-				nullptr,
-				Mesh->Meshlets,
-				Mesh->UniqueVertexIndices,
-				Mesh->PrimitiveIndices);
-		}
+				ProcessMesh(paiScene->mMeshes[m], Options, &Meshes[m]);
+			});
 
 		Export(BinaryPath, Meshes);
 	}
 
-	for (auto Mesh : Meshes)
+	for (auto& Mesh : Meshes)
 	{
-		Mesh->UpdateInfo();
-		Mesh->ComputeBoundingBox();
-		AssetManager::RequestUpload(Mesh);
+		Mesh.UpdateInfo();
+		Mesh.ComputeBoundingBox();
+	}
+	return Meshes;
+}
+
+void AsyncMeshImporter::CreateAssets(std::vector<Mesh>& Meshes)
+{
+	for (auto& Mesh : Meshes)
+	{
+		AssetManager::RequestUpload(AssetManager::CreateAsset<AssetType::Mesh>(std::move(Mesh)));
 	}
 }
 
-void AsyncMeshImporter::Export(const std::filesystem::path& BinaryPath, const std::vector<Mesh*>& Meshes)
+void AsyncMeshImporter::Export(const std::filesystem::path& BinaryPath, std::span<const Mesh> Meshes)
 {
+	// Lay out the file first, the entries precede the sections they point to
+	std::vector<MeshExportEntry> Entries(Meshes.size());
+	MeshExportLayout			 Layout(Entries.size());
+	for (size_t i = 0; i < Meshes.size(); ++i)
+	{
+		Entries[i].Name = Layout.Allocate(Meshes[i].Name.size() * sizeof(char), 1);
+	}
+	for (size_t i = 0; i < Meshes.size(); ++i)
+	{
+		const Mesh* Mesh			   = &Meshes[i];
+		Entries[i].Vertices			   = Layout.Allocate(Mesh->Vertices.size() * sizeof(MeshVertex), MeshExportSectionAlignment);
+		Entries[i].Indices			   = Layout.Allocate(Mesh->Indices.size() * sizeof(std::uint32_t), MeshExportSectionAlignment);
+		Entries[i].Meshlets			   = Layout.Allocate(Mesh->Meshlets.size() * sizeof(Meshlet), MeshExportSectionAlignment);
+		Entries[i].UniqueVertexIndices = Layout.Allocate(Mesh->UniqueVertexIndices.size() * sizeof(uint8_t), MeshExportSectionAlignment);
+		Entries[i].PrimitiveIndices	   = Layout.Allocate(Mesh->PrimitiveIndices.size() * sizeof(MeshletTriangle), MeshExportSectionAlignment);
+		Entries[i].Lods				   = Layout.Allocate(Mesh->Lods.size() * sizeof(MeshLod), alignof(MeshLod));
+	}
+
 	FileStream	 Stream(BinaryPath, FileMode::Create, FileAccess::Write);
 	BinaryWriter Writer(Stream);
 
 	{
-		ExportHeader Header = {};
-		Header.NumMeshes	= Meshes.size();
-
-		Writer.Write<ExportHeader>(Header);
+		MeshExportHeader Header = {};
+		Header.Magic			= MeshExportMagic;
+		Header.Version			= MeshExportVersion;
+		Header.NumMeshes		= Meshes.size();
+		Header.FileSize			= Layout.GetSizeInBytes();
+		Header.VertexStride		= sizeof(MeshVertex);
+
+		Writer.Write<MeshExportHeader>(Header);
+		Writer.Write(Entries.data(), Entries.size() * sizeof(MeshExportEntry));
 	}
-	for (const auto& Mesh : Meshes)
-	{
-		Writer.Write<size_t>(Mesh->Name.size());
-		Writer.Write(Mesh->Name);
 
-		MeshHeader Header			  = {};
-		Header.NumVertices			  = Mesh->Vertices.size();
-		Header.NumIndices			  = Mesh->Indices.size();
-		Header.NumMeshlets			  = Mesh->Meshlets.size();
-		Header.NumUniqueVertexIndices = Mesh->UniqueVertexIndices.size();
-		Header.NumPrimitiveIndices	  = Mesh->PrimitiveIndices.size();
+	uint64_t WrittenSizeInBytes = sizeof(MeshExportHeader) + Entries.size() * sizeof(MeshExportEntry);
+
+	auto WriteSection = [&](const MeshExportSection& Section, const void* Data)
+	{
+		static constexpr std::array<BYTE, MeshExportSectionAlignment> Padding = {};
 
-		Writer.Write<MeshHeader>(Header);
-		Writer.Write(Mesh->Vertices.data(), Mesh->Vertices.size() * sizeof(Vertex));
-		Writer.Write(Mesh->Indices.data(), Mesh->Indices.size() * sizeof(std::uint32_t));
-		Writer.Write(Mesh->Meshlets.data(), Mesh->Meshlets.size() * sizeof(Meshlet));
-		Writer.Write(Mesh->UniqueVertexIndices.data(), Mesh->UniqueVertexIndices.size() * sizeof(uint8_t));
-		Writer.Write(Mesh->PrimitiveIndices.data(), Mesh->PrimitiveIndices.size() * sizeof(MeshletTriangle));
+		Writer.Write(Padding.data(), Section.Offset - WrittenSizeInBytes);
+		Writer.Write(Data, Section.SizeInBytes);
+		WrittenSizeInBytes = Section.Offset + Section.SizeInBytes;
+	};
+	for (size_t i = 0; i < Meshes.size(); ++i)
+	{
+		WriteSection(Entries[i].Name, Meshes[i].Name.data());
+	}
+	for (size_t i = 0; i < Meshes.size(); ++i)
+	{
+		const Mesh* Mesh = &Meshes[i];
+		WriteSection(Entries[i].Vertices, Mesh->Vertices.data());
+		WriteSection(Entries[i].Indices, Mesh->Indices.data());
+		WriteSection(Entries[i].Meshlets, Mesh->Meshlets.data());
+		WriteSection(Entries[i].UniqueVertexIndices, Mesh->UniqueVertexIndices.data());
+		WriteSection(Entries[i].PrimitiveIndices, Mesh->PrimitiveIndices.data());
+		WriteSection(Entries[i].Lods, Mesh->Lods.data());
 	}
 }
 
-std::vector<Mesh*> AsyncMeshImporter::ImportExisting(
+std::vector<Mesh> AsyncMeshImporter::ImportExisting(
 	const std::filesystem::path& BinaryPath,
 	const MeshImportOptions&	 Options)
 {
-	std::vector<Mesh*> Meshes;
+	std::vector<Mesh> Meshes;
 
-	FileStream	 Stream(BinaryPath, FileMode::Open, FileAccess::Read);
-	BinaryReader Reader(Stream);
+	FileStream Stream(BinaryPath, FileMode::Open, FileAccess::Read);
+	if (Stream.GetSizeInBytes() < sizeof(MeshExportHeader))
+	{
+		return Meshes;
+	}
 
+	// The view outlives the file and mapping handles, the meshes keep it alive until they are uploaded
+	MemoryMappedFile				  File(Stream);
+	std::shared_ptr<MemoryMappedView> View = std::make_shared<MemoryMappedView>(File.CreateView());
+
+	MeshExportReader Reader({ View->GetView(0), View->GetSizeInBytes() }, MeshExportFormat::Of<MeshVertex, Meshlet, MeshletTriangle>());
+	if (!Reader.IsValid())
 	{
-		auto Header = Reader.Read<ExportHeader>();
-		Meshes.resize(Header.NumMeshes);
+		LOG_WARN("{} is not a valid version {} .khscene with the current vertex format, importing source again", BinaryPath.string(), MeshExportVersion);
+		return Meshes;
 	}
-	for (auto& Mesh : Meshes)
+
+	std::span<const MeshExportEntry> Entries = Reader.GetEntries();
+
+	Meshes.resize(Entries.size());
+	for (size_t i = 0; i < Entries.size(); ++i)
 	{
-		size_t		Length = Reader.Read<size_t>();
-		std::string string;
-		string.resize(Length);
-		Reader.Read(string.data(), string.size() * sizeof(char));
-
-		auto								  Header = Reader.Read<MeshHeader>();
-		std::vector<Vertex>					  Vertices(Header.NumVertices);
-		std::vector<uint32_t>				  Indices(Header.NumIndices);
-		std::vector<DirectX::Meshlet>		  Meshlets(Header.NumMeshlets);
-		std::vector<uint8_t>				  UniqueVertexIndices(Header.NumUniqueVertexIndices);
-		std::vector<DirectX::MeshletTriangle> PrimitiveIndices(Header.NumPrimitiveIndices);
-
-		Reader.Read(Vertices.data(), Vertices.size() * sizeof(Vertex));
-		Reader.Read(Indices.data(), Indices.size() * sizeof(std::uint32_t));
-		Reader.Read(Meshlets.data(), Meshlets.size() * sizeof(Meshlet));
-		Reader.Read(UniqueVertexIndices.data(), UniqueVertexIndices.size() * sizeof(uint8_t));
-		Reader.Read(PrimitiveIndices.data(), PrimitiveIndices.size() * sizeof(MeshletTriangle));
-
-		Mesh		  = AssetManager::CreateAsset<AssetType::Mesh>();
+		const MeshExportEntry& Entry = Entries[i];
+
+		Mesh* Mesh	  = &Meshes[i];
 		Mesh->Options = Options;
-		Mesh->Name	  = string;
+		Mesh->Name	  = Reader.MapString(Entry.Name);
 
-		Mesh->Vertices			  = std::move(Vertices);
-		Mesh->Indices			  = std::move(Indices);
-		Mesh->Meshlets			  = std::move(Meshlets);
-		Mesh->UniqueVertexIndices = std::move(UniqueVertexIndices);
-		Mesh->PrimitiveIndices	  = std::move(PrimitiveIndices);
+		Mesh->Mapping					= View;
+		Mesh->MappedVertices			= Reader.Map<MeshVertex>(Entry.Vertices);
+		Mesh->MappedIndices				= Reader.Map<uint32_t>(Entry.Indices);
+		Mesh->MappedMeshlets			= Reader.Map<Meshlet>(Entry.Meshlets);
+		Mesh->MappedUniqueVertexIndices = Reader.Map<uint8_t>(Entry.UniqueVertexIndices);
+		Mesh->MappedPrimitiveIndices	= Reader.Map<MeshletTriangle>(Entry.PrimitiveIndices);
+
+		std::span<const MeshLod> Lods = Reader.Map<MeshLod>(Entry.Lods);
+		Mesh->Lods.assign(Lods.begin(), Lods.end());
 
 		Mesh->UpdateInfo();
 	}
 
+	LOG_INFO("{}: mapped {} meshes, {} bytes", BinaryPath.string(), Meshes.size(), View->GetSizeInBytes());
+
 	return Meshes;
 }
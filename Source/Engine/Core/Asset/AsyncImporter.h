@@ -1,48 +1,61 @@
 #pragma once
+#include "AsyncImportPool.h"
 #include "Texture.h"
 #include "Mesh.h"
 
+// Imports run concurrently on the shared AsyncImportPool, TDerived::Import returns the imported assets and
+// TDerived::CreateAssets adds them to the asset cache. Asset handles (and the ids WorldArchive stores) must not depend
+// on scheduling: an importer with TDerived::ReservesHandles reserves the handle on request and creates the asset as
+// soon as its import finishes, the others create assets in request order since a file holds any number of them
 template<typename T, typename TImportOptions, typename TDerived>
 class AsyncImporter
 {
 public:
-	AsyncImporter(const std::wstring& ThreadName)
+	explicit AsyncImporter(AsyncImportPool& Pool)
+		: Pool(Pool)
 	{
-		Thread = std::jthread(
-			[&, ThreadName]()
-			{
-				SetThreadDescription(GetCurrentThread(), ThreadName.data());
-				while (true)
-				{
-					std::unique_lock Lock(Mutex);
-					ConditionVariable.wait(Lock);
-					if (Quit)
-					{
-						break;
-					}
-
-					// Start loading stuff async :D
-					while (!ImportRequests.empty())
-					{
-						auto Options = ImportRequests.front();
-						ImportRequests.pop();
-						static_cast<TDerived*>(this)->Import(Options);
-					}
-				}
-			});
 	}
 
 	~AsyncImporter()
 	{
-		Quit = true;
-		ConditionVariable.notify_one();
+		Pool.Drain(this);
 	}
 
-	void RequestAsyncLoad(const TImportOptions& Options)
+	void RequestAsyncLoad(const TImportOptions& Options, ImportPriority Priority = ImportPriority::Normal)
+	{
+		UINT64 Sequence, Generation;
+		{
+			std::scoped_lock Lock(Mutex);
+			Sequence   = NextSequence++;
+			Generation = CurrentGeneration;
+			if constexpr (TDerived::ReservesHandles)
+			{
+				Reservations.emplace(Sequence, static_cast<TDerived*>(this)->ReserveAsset());
+			}
+		}
+
+		Pool.Enqueue(
+			this,
+			Priority,
+			[this, Options, Sequence, Generation]()
+			{
+				Commit(Sequence, Generation, static_cast<TDerived*>(this)->Import(Options));
+			});
+	}
+
+	// Drops the queued requests, the results of imports that are still running are discarded
+	void CancelPendingLoads()
 	{
 		std::scoped_lock Lock(Mutex);
-		ImportRequests.push(Options);
-		ConditionVariable.notify_one();
+		Pool.Cancel(this);
+		++CurrentGeneration;
+		for (const auto& [Sequence, Handle] : Reservations)
+		{
+			static_cast<TDerived*>(this)->ReleaseAsset(Handle);
+		}
+		Reservations.clear();
+		PendingResults.clear();
+		NextCommit = NextSequence;
 	}
 
 	bool SupportsExtension(const std::filesystem::path& Path)
@@ -57,12 +70,40 @@ public:
 	}
 
 private:
-	std::mutex				   Mutex;
-	std::condition_variable	   ConditionVariable;
-	std::queue<TImportOptions> ImportRequests;
+	void Commit(UINT64 Sequence, UINT64 Generation, std::vector<T>&& Result)
+	{
+		std::scoped_lock Lock(Mutex);
+		if (Generation != CurrentGeneration)
+		{
+			return;
+		}
 
-	std::jthread	  Thread;
-	std::atomic<bool> Quit = false;
+		if constexpr (TDerived::ReservesHandles)
+		{
+			auto Reservation = Reservations.extract(Sequence);
+			static_cast<TDerived*>(this)->CreateAssets(Reservation.mapped(), Result);
+		}
+		else
+		{
+			// Park the result until every earlier request is committed, a failed import commits nothing
+			PendingResults.emplace(Sequence, std::move(Result));
+			for (auto Iter = PendingResults.begin(); Iter != PendingResults.end() && Iter->first == NextCommit; ++NextCommit)
+			{
+				static_cast<TDerived*>(this)->CreateAssets(Iter->second);
+				Iter = PendingResults.erase(Iter);
+			}
+		}
+	}
+
+private:
+	AsyncImportPool& Pool;
+
+	std::mutex						 Mutex;
+	std::map<UINT64, AssetHandle>	 Reservations;
+	std::map<UINT64, std::vector<T>> PendingResults;
+	UINT64							 NextSequence	   = 0;
+	UINT64							 NextCommit		   = 0;
+	UINT64							 CurrentGeneration = 0;
 
 protected:
 	std::set<std::wstring> SupportedExtensions;
@@ -71,8 +112,8 @@ protected:
 class AsyncTextureImporter : public AsyncImporter<Texture, TextureImportOptions, AsyncTextureImporter>
 {
 public:
-	AsyncTextureImporter()
-		: AsyncImporter(L"Texture Importer")
+	explicit AsyncTextureImporter(AsyncImportPool& Pool)
+		: AsyncImporter(Pool)
 	{
 		SupportedExtensions.insert(L".dds");
 		SupportedExtensions.insert(L".hdr");
@@ -84,35 +125,49 @@ public:
 		SupportedExtensions.insert(L".jpeg");
 	}
 
-	void Import(const TextureImportOptions& Options);
+	// A texture file holds a single texture, so its handle is known when the load is requested
+	static constexpr bool ReservesHandles = true;
+
+	std::vector<Texture> Import(const TextureImportOptions& Options);
+	AssetHandle			 ReserveAsset();
+	void				 ReleaseAsset(AssetHandle Reserved);
+	void				 CreateAssets(AssetHandle Reserved, std::vector<Texture>& Textures);
+
+	// .khtex layout, an ExportHeader followed by a .dds holding the processed image (mips and block
+	// compression), so loading it again skips decoding and encoding. The cache is valid while the source file
+	// content and the options are unchanged
+	static constexpr uint32_t ExportMagic	= 0x5854484B; // "KHTX"
+	static constexpr uint32_t ExportVersion = 1;
+
+	struct ExportHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t SourceHash;  // CityHash64 of the source file
+		uint32_t OptionFlags; // TextureImportOptions except the path
+		uint32_t Padding;
+	};
+
+	void Export(const std::filesystem::path& CachePath, const ExportHeader& Header, const DirectX::ScratchImage& Image);
+	bool ImportExisting(const std::filesystem::path& CachePath, const ExportHeader& Expected, DirectX::ScratchImage& Image);
 };
 
 class AsyncMeshImporter : public AsyncImporter<Mesh, MeshImportOptions, AsyncMeshImporter>
 {
 public:
-	AsyncMeshImporter()
-		: AsyncImporter(L"Mesh Importer")
+	explicit AsyncMeshImporter(AsyncImportPool& Pool)
+		: AsyncImporter(Pool)
 	{
 		SupportedExtensions.insert(L".fbx");
 		SupportedExtensions.insert(L".obj");
 	}
 
-	void Import(const MeshImportOptions& Options);
+	static constexpr bool ReservesHandles = false;
 
-	void			   Export(const std::filesystem::path& BinaryPath, const std::vector<Mesh*>& Meshes);
-	std::vector<Mesh*> ImportExisting(const std::filesystem::path& BinaryPath, const MeshImportOptions& Options);
+	std::vector<Mesh> Import(const MeshImportOptions& Options);
+	void			  CreateAssets(std::vector<Mesh>& Meshes);
 
-	struct ExportHeader
-	{
-		size_t NumMeshes;
-	};
-
-	struct MeshHeader
-	{
-		size_t NumVertices;
-		size_t NumIndices;
-		size_t NumMeshlets;
-		size_t NumUniqueVertexIndices;
-		size_t NumPrimitiveIndices;
-	};
+	// .khscene, laid out and validated by MeshExport.h
+	void			  Export(const std::filesystem::path& BinaryPath, std::span<const Mesh> Meshes);
+	std::vector<Mesh> ImportExisting(const std::filesystem::path& BinaryPath, const MeshImportOptions& Options);
 };
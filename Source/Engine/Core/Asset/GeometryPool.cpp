@@ -0,0 +1,178 @@
+#include "GeometryPool.h"
+
+GeometryAllocation::~GeometryAllocation()
+{
+	Release();
+}
+
+GeometryAllocation::GeometryAllocation(GeometryAllocation&& GeometryAllocation) noexcept
+	: Pool(std::exchange(GeometryAllocation.Pool, {}))
+	, Block(GeometryAllocation.Block)
+	, Node(GeometryAllocation.Node)
+	, Offset(GeometryAllocation.Offset)
+	, Size(GeometryAllocation.Size)
+	, Resource(GeometryAllocation.Resource)
+	, GpuVirtualAddress(GeometryAllocation.GpuVirtualAddress)
+	, ViewIndex(GeometryAllocation.ViewIndex)
+{
+}
+
+GeometryAllocation& GeometryAllocation::operator=(GeometryAllocation&& GeometryAllocation) noexcept
+{
+	if (this == &GeometryAllocation)
+	{
+		return *this;
+	}
+
+	Release();
+	Pool			  = std::exchange(GeometryAllocation.Pool, {});
+	Block			  = GeometryAllocation.Block;
+	Node			  = GeometryAllocation.Node;
+	Offset			  = GeometryAllocation.Offset;
+	Size			  = GeometryAllocation.Size;
+	Resource		  = GeometryAllocation.Resource;
+	GpuVirtualAddress = GeometryAllocation.GpuVirtualAddress;
+	ViewIndex		  = GeometryAllocation.ViewIndex;
+
+	return *this;
+}
+
+void GeometryAllocation::Release()
+{
+	if (Pool)
+	{
+		Pool->Free(Block, Node);
+		Pool = nullptr;
+	}
+}
+
+GeometryPool::Block::Block(D3D12LinkedDevice* Device, UINT64 Size)
+	: Buffer(Device, Size, sizeof(UINT), D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_FLAG_NONE)
+	, View(Device, &Buffer, true, 0, static_cast<UINT>(Size))
+	, Allocator(Size)
+{
+}
+
+GeometryAllocation GeometryPool::Allocate(D3D12LinkedDevice* Device, UINT64 Size)
+{
+	std::scoped_lock Lock(Mutex);
+
+	std::optional<TlsfAllocation> Allocation;
+	UINT						  BlockIndex = 0;
+	for (; BlockIndex < Blocks.size(); ++BlockIndex)
+	{
+		if (Blocks[BlockIndex] && (Allocation = Blocks[BlockIndex]->Allocator.Allocate(Size)))
+		{
+			break;
+		}
+	}
+
+	if (!Allocation)
+	{
+		// Slots of released blocks are reused so the indices of the other blocks stay valid
+		auto Slot  = std::find(Blocks.begin(), Blocks.end(), nullptr);
+		BlockIndex = static_cast<UINT>(Slot - Blocks.begin());
+		if (Slot == Blocks.end())
+		{
+			Blocks.emplace_back();
+		}
+
+		UINT64 Capacity	   = std::max(AlignUp(Size, TlsfAllocator::Granularity), BlockSize);
+		Blocks[BlockIndex] = std::make_unique<Block>(Device, Capacity);
+		Allocation		   = Blocks[BlockIndex]->Allocator.Allocate(Size);
+		assert(Allocation);
+	}
+
+	const Block& Block = *Blocks[BlockIndex];
+
+	GeometryAllocation GeometryAllocation;
+	GeometryAllocation.Pool				 = this;
+	GeometryAllocation.Block			 = BlockIndex;
+	GeometryAllocation.Node				 = Allocation->Node;
+	GeometryAllocation.Offset			 = Allocation->Offset;
+	GeometryAllocation.Size				 = Allocation->Size;
+	GeometryAllocation.Resource			 = Block.Buffer.GetResource();
+	GeometryAllocation.GpuVirtualAddress = Block.Buffer.GetGpuVirtualAddress() + Allocation->Offset;
+	GeometryAllocation.ViewIndex		 = Block.View.GetIndex();
+	return GeometryAllocation;
+}
+
+void GeometryPool::ReleaseRetiredAllocations(D3D12LinkedDevice* Device)
+{
+	std::scoped_lock Lock(Mutex);
+
+	// Work submitted after this point no longer references the freed meshes
+	if (!FreedAllocations.empty())
+	{
+		UINT64 GraphicsFenceValue	  = Device->GetGraphicsQueue()->Signal();
+		UINT64 AsyncComputeFenceValue = Device->GetAsyncComputeQueue()->Signal();
+		for (RetiredAllocation& Freed : FreedAllocations)
+		{
+			Freed.GraphicsFenceValue	 = GraphicsFenceValue;
+			Freed.AsyncComputeFenceValue = AsyncComputeFenceValue;
+			RetiredAllocations.push_back(Freed);
+		}
+		FreedAllocations.clear();
+	}
+
+	std::erase_if(
+		RetiredAllocations,
+		[&](const RetiredAllocation& Retired)
+		{
+			if (!Device->GetGraphicsQueue()->IsFenceComplete(Retired.GraphicsFenceValue) ||
+				!Device->GetAsyncComputeQueue()->IsFenceComplete(Retired.AsyncComputeFenceValue))
+			{
+				return false;
+			}
+
+			TlsfAllocator& Allocator = Blocks[Retired.Block]->Allocator;
+			Allocator.Free(Retired.Node);
+
+			// Blocks of oversized meshes are not shared, keep only the ones of the default size around
+			if (Allocator.IsEmpty() && Allocator.GetCapacity() > BlockSize)
+			{
+				Blocks[Retired.Block].reset();
+			}
+			return true;
+		});
+}
+
+void GeometryPool::Destroy()
+{
+	std::scoped_lock Lock(Mutex);
+
+	FreedAllocations.clear();
+	RetiredAllocations.clear();
+	Blocks.clear();
+}
+
+GeometryPoolStats GeometryPool::GetStats() const
+{
+	std::scoped_lock Lock(Mutex);
+
+	GeometryPoolStats Stats = {};
+	for (const auto& Block : Blocks)
+	{
+		if (!Block)
+		{
+			continue;
+		}
+
+		TlsfAllocatorStats BlockStats = Block->Allocator.GetStats();
+		++Stats.NumBlocks;
+		Stats.CapacityInBytes += BlockStats.CapacityInBytes;
+		Stats.UsedInBytes += BlockStats.UsedInBytes;
+		Stats.LargestFreeInBytes = std::max(Stats.LargestFreeInBytes, BlockStats.LargestFreeInBytes);
+		Stats.NumAllocations += BlockStats.NumAllocations;
+		Stats.Fragmentation = std::max(Stats.Fragmentation, BlockStats.Fragmentation);
+	}
+	Stats.NumRetired = static_cast<UINT>(FreedAllocations.size() + RetiredAllocations.size());
+	return Stats;
+}
+
+void GeometryPool::Free(UINT Block, UINT Node)
+{
+	std::scoped_lock Lock(Mutex);
+
+	FreedAllocations.push_back({ .Block = Block, .Node = Node });
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include "Core/RHI/TlsfAllocator.h"
+#include "Core/RHI/D3D12/D3D12Descriptor.h"
+
+class GeometryPool;
+
+struct GeometryPoolStats
+{
+	UINT   NumBlocks		  = 0;
+	UINT64 CapacityInBytes	  = 0;
+	UINT64 UsedInBytes		  = 0;
+	UINT64 LargestFreeInBytes = 0;
+	UINT   NumAllocations	  = 0;
+	UINT   NumRetired		  = 0;	  // Freed but possibly still read by the gpu
+	float  Fragmentation	  = 0.0f; // Of the most fragmented block
+};
+
+// A range of one of the pool's buffers, returned to the pool when destroyed
+class GeometryAllocation
+{
+public:
+	GeometryAllocation() noexcept = default;
+	~GeometryAllocation();
+
+	GeometryAllocation(GeometryAllocation&& GeometryAllocation) noexcept;
+	GeometryAllocation& operator=(GeometryAllocation&& GeometryAllocation) noexcept;
+
+	GeometryAllocation(const GeometryAllocation&)			 = delete;
+	GeometryAllocation& operator=(const GeometryAllocation&) = delete;
+
+	[[nodiscard]] bool IsValid() const noexcept { return Pool != nullptr; }
+
+	[[nodiscard]] ID3D12Resource* GetResource() const noexcept { return Resource; }
+	// Of the allocation within the buffer
+	[[nodiscard]] UINT64 GetOffset() const noexcept { return Offset; }
+	[[nodiscard]] UINT64 GetSize() const noexcept { return Size; }
+	[[nodiscard]] D3D12_GPU_VIRTUAL_ADDRESS GetGpuVirtualAddress() const noexcept { return GpuVirtualAddress; }
+	// Raw view of the whole buffer, shaders add the offset
+	[[nodiscard]] UINT GetViewIndex() const noexcept { return ViewIndex; }
+
+private:
+	friend class GeometryPool;
+
+	void Release();
+
+private:
+	GeometryPool*			  Pool				= nullptr;
+	UINT					  Block				= 0;
+	UINT					  Node				= 0;
+	UINT64					  Offset			= 0;
+	UINT64					  Size				= 0;
+	ID3D12Resource*			  Resource			= nullptr;
+	D3D12_GPU_VIRTUAL_ADDRESS GpuVirtualAddress	= 0;
+	UINT					  ViewIndex			= UINT_MAX;
+};
+
+// Suballocates mesh geometry from a few large buffers instead of creating buffers per mesh, so uploading a mesh does
+// not create resources and the gpu scene binds a handful of buffers. A block is added when none has room, allocations
+// larger than a block get a block of their own
+class GeometryPool
+{
+public:
+	static constexpr UINT64 BlockSize = 64ull * 1024 * 1024;
+
+	GeometryPool() = default;
+
+	GeometryPool(const GeometryPool&)			 = delete;
+	GeometryPool& operator=(const GeometryPool&) = delete;
+
+	// Called on the upload thread
+	[[nodiscard]] GeometryAllocation Allocate(D3D12LinkedDevice* Device, UINT64 Size);
+
+	// Called once per frame on the render thread. Freed ranges are reused once the gpu work submitted before they
+	// were freed has completed
+	void ReleaseRetiredAllocations(D3D12LinkedDevice* Device);
+
+	// Releases every block, the gpu must be idle and every allocation destroyed
+	void Destroy();
+
+	[[nodiscard]] GeometryPoolStats GetStats() const;
+
+private:
+	friend class GeometryAllocation;
+
+	// Any thread, the range is retired until the next ReleaseRetiredAllocations
+	void Free(UINT Block, UINT Node);
+
+private:
+	struct Block
+	{
+		Block(D3D12LinkedDevice* Device, UINT64 Size);
+
+		D3D12Buffer				Buffer;
+		D3D12ShaderResourceView	View;
+		TlsfAllocator			Allocator;
+	};
+
+	struct RetiredAllocation
+	{
+		UINT   Block;
+		UINT   Node;
+		UINT64 GraphicsFenceValue;
+		UINT64 AsyncComputeFenceValue;
+	};
+
+	mutable std::mutex					Mutex;
+	std::vector<std::unique_ptr<Block>>	Blocks;
+	std::vector<RetiredAllocation>		FreedAllocations; // Not stamped with fence values yet
+	std::vector<RetiredAllocation>		RetiredAllocations;
+};
@@ -1,9 +1,12 @@
 #pragma once
 #include "Asset.h"
+#include "MeshExport.h"
 #include "World/Vertex.h"
 #include "Core/Math/Math.h"
 #include "Core/Math/BoundingBox.h"
 #include "Core/RHI/D3D12/D3D12Raytracing.h"
+#include "Core/Asset/GeometryPool.h"
+#include "Core/System/MemoryMappedView.h"
 
 struct MeshImportOptions
 {
@@ -17,24 +20,65 @@ struct MeshImportOptions
 	DirectX::XMFLOAT4X4 Matrix;
 };
 
+// Range of one geometry stream within the mesh's geometry allocation
+struct MeshSection
+{
+	UINT64 Offset	   = 0;
+	UINT64 SizeInBytes = 0;
+};
+
 class Mesh : public Asset
 {
 public:
+	// Geometry to upload, either the vectors or the sections of a memory mapped .khscene
+	[[nodiscard]] std::span<const MeshVertex>				GetVertices() const noexcept { return Mapping ? MappedVertices : Vertices; }
+	[[nodiscard]] std::span<const uint32_t>					GetIndices() const noexcept { return Mapping ? MappedIndices : Indices; }
+	[[nodiscard]] std::span<const DirectX::Meshlet>			GetMeshlets() const noexcept { return Mapping ? MappedMeshlets : Meshlets; }
+	[[nodiscard]] std::span<const uint8_t>					GetUniqueVertexIndices() const noexcept { return Mapping ? MappedUniqueVertexIndices : UniqueVertexIndices; }
+	[[nodiscard]] std::span<const DirectX::MeshletTriangle>	GetPrimitiveIndices() const noexcept { return Mapping ? MappedPrimitiveIndices : PrimitiveIndices; }
+
+	[[nodiscard]] D3D12_GPU_VIRTUAL_ADDRESS GetGpuVirtualAddress(const MeshSection& Section) const noexcept
+	{
+		return Geometry.GetGpuVirtualAddress() + Section.Offset;
+	}
+	// Byte offset of a section within the geometry pool buffer, for the raw view of the buffer
+	[[nodiscard]] UINT64 GetBufferOffset(const MeshSection& Section) const noexcept { return Geometry.GetOffset() + Section.Offset; }
+
+	[[nodiscard]] D3D12_VERTEX_BUFFER_VIEW GetVertexBufferView() const noexcept
+	{
+		D3D12_VERTEX_BUFFER_VIEW VertexBufferView = {};
+		VertexBufferView.BufferLocation			  = GetGpuVirtualAddress(VertexSection);
+		VertexBufferView.SizeInBytes			  = static_cast<UINT>(VertexSection.SizeInBytes);
+		VertexBufferView.StrideInBytes			  = sizeof(MeshVertex);
+		return VertexBufferView;
+	}
+
+	[[nodiscard]] D3D12_INDEX_BUFFER_VIEW GetIndexBufferView() const noexcept
+	{
+		D3D12_INDEX_BUFFER_VIEW IndexBufferView = {};
+		IndexBufferView.BufferLocation			= GetGpuVirtualAddress(IndexSection);
+		IndexBufferView.SizeInBytes				= static_cast<UINT>(IndexSection.SizeInBytes);
+		IndexBufferView.Format					= DXGI_FORMAT_R32_UINT;
+		return IndexBufferView;
+	}
+
 	void ComputeBoundingBox()
 	{
+		std::span<const MeshVertex> Points = GetVertices();
+
 		DirectX::BoundingBox Box;
-		DirectX::BoundingBox::CreateFromPoints(Box, Vertices.size(), &Vertices[0].Position, sizeof(Vertex));
+		DirectX::BoundingBox::CreateFromPoints(Box, Points.size(), &Points[0].Position, sizeof(MeshVertex));
 		BoundingBox.Center	= Vec3f(Box.Center.x, Box.Center.y, Box.Center.z);
 		BoundingBox.Extents = Vec3f(Box.Extents.x, Box.Extents.y, Box.Extents.z);
 	}
 
 	void UpdateInfo()
 	{
-		VertexCount = static_cast<std::uint32_t>(Vertices.size());
-		IndexCount	= static_cast<std::uint32_t>(Indices.size());
-		MeshletCount	 = static_cast<std::uint32_t>(Meshlets.size());
-		VertexIndexCount = static_cast<std::uint32_t>(UniqueVertexIndices.size());
-		PrimitiveCount	 = static_cast<std::uint32_t>(PrimitiveIndices.size());
+		VertexCount		 = static_cast<std::uint32_t>(GetVertices().size());
+		IndexCount		 = static_cast<std::uint32_t>(GetIndices().size());
+		MeshletCount	 = static_cast<std::uint32_t>(GetMeshlets().size());
+		VertexIndexCount = static_cast<std::uint32_t>(GetUniqueVertexIndices().size());
+		PrimitiveCount	 = static_cast<std::uint32_t>(GetPrimitiveIndices().size());
 	}
 
 	void Release()
@@ -44,6 +88,14 @@ public:
 		decltype(Meshlets)().swap(Meshlets);
 		decltype(UniqueVertexIndices)().swap(UniqueVertexIndices);
 		decltype(PrimitiveIndices)().swap(PrimitiveIndices);
+
+		// The file is unmapped once the last mesh of it is released
+		Mapping.reset();
+		MappedVertices			  = {};
+		MappedIndices			  = {};
+		MappedMeshlets			  = {};
+		MappedUniqueVertexIndices = {};
+		MappedPrimitiveIndices	  = {};
 	}
 
 	MeshImportOptions Options;
@@ -56,27 +108,37 @@ public:
 	std::uint32_t VertexIndexCount = 0;
 	std::uint32_t PrimitiveCount   = 0;
 
-	std::vector<Vertex>					  Vertices;
+	std::vector<MeshVertex>				  Vertices;
 	std::vector<uint32_t>				  Indices;
 	std::vector<DirectX::Meshlet>		  Meshlets;
 	std::vector<uint8_t>				  UniqueVertexIndices;
 	std::vector<DirectX::MeshletTriangle> PrimitiveIndices;
 
+	// Kept after the geometry is released, the gpu scene selects LODs from it
+	std::vector<MeshLod> Lods;
+
+	// Set by AsyncMeshImporter::ImportExisting instead of the vectors, shared by every mesh of the file
+	std::shared_ptr<const MemoryMappedView>	  Mapping;
+	std::span<const MeshVertex>				  MappedVertices;
+	std::span<const uint32_t>				  MappedIndices;
+	std::span<const DirectX::Meshlet>		  MappedMeshlets;
+	std::span<const uint8_t>				  MappedUniqueVertexIndices;
+	std::span<const DirectX::MeshletTriangle> MappedPrimitiveIndices;
+
 	BoundingBox BoundingBox;
 
-	D3D12Buffer				  VertexResource;
-	D3D12Buffer				  IndexResource;
-	D3D12Buffer				  MeshletResource;
-	D3D12Buffer				  UniqueVertexIndexResource;
-	D3D12Buffer				  PrimitiveIndexResource;
+	// Every stream is a section of one allocation in the geometry pool
+	GeometryAllocation		  Geometry;
+	MeshSection				  VertexSection;
+	MeshSection				  IndexSection;
+	MeshSection				  MeshletSection;
+	MeshSection				  UniqueVertexIndexSection;
+	MeshSection				  PrimitiveIndexSection;
 	D3D12_GPU_VIRTUAL_ADDRESS AccelerationStructure; // Managed by D3D12RaytracingAccelerationStructureManager
 	D3D12RaytracingGeometry	  Blas;
 	UINT64					  BlasIndex		= UINT64_MAX;
 	bool					  BlasValid		= false;
 	bool					  BlasCompacted = false;
-
-	D3D12ShaderResourceView VertexView;
-	D3D12ShaderResourceView IndexView;
 };
 
 template<>
@@ -0,0 +1,100 @@
+#include "MeshExport.h"
+
+MeshExportLayout::MeshExportLayout(UINT64 NumMeshes)
+	: Offset(sizeof(MeshExportHeader) + NumMeshes * sizeof(MeshExportEntry))
+{
+}
+
+MeshExportSection MeshExportLayout::Allocate(UINT64 SizeInBytes, UINT64 Alignment)
+{
+	MeshExportSection Section = {};
+	Section.Offset			  = SizeInBytes > 0 ? AlignUp(Offset, Alignment) : Offset;
+	Section.SizeInBytes		  = SizeInBytes;
+	Offset					  = Section.Offset + SizeInBytes;
+	return Section;
+}
+
+MeshExportReader::MeshExportReader(std::span<const BYTE> File, const MeshExportFormat& Format)
+	: File(File)
+{
+	Valid = Validate(Format);
+	if (!Valid)
+	{
+		Entries = {};
+	}
+}
+
+bool MeshExportReader::IsValid(const MeshExportSection& Section, const MeshExportElement& Element) const noexcept
+{
+	if (Section.Offset > File.size() || Section.SizeInBytes > File.size() - Section.Offset)
+	{
+		return false;
+	}
+	if (Section.SizeInBytes % Element.Size != 0)
+	{
+		return false;
+	}
+	return Section.SizeInBytes == 0 || reinterpret_cast<std::uintptr_t>(File.data() + Section.Offset) % Element.Alignment == 0;
+}
+
+bool MeshExportReader::Validate(const MeshExportFormat& Format)
+{
+	if (File.size() < sizeof(MeshExportHeader))
+	{
+		return false;
+	}
+
+	MeshExportHeader Header;
+	std::memcpy(&Header, File.data(), sizeof(MeshExportHeader));
+	if (Header.Magic != MeshExportMagic || Header.Version != MeshExportVersion || Header.FileSize != File.size() ||
+		Header.VertexStride != Format.Vertex.Size)
+	{
+		return false;
+	}
+
+	// Bounded by the file size before it is multiplied, a corrupt count can't wrap around
+	if (Header.NumMeshes > (File.size() - sizeof(MeshExportHeader)) / sizeof(MeshExportEntry))
+	{
+		return false;
+	}
+
+	MeshExportSection EntryTable = { sizeof(MeshExportHeader), Header.NumMeshes * sizeof(MeshExportEntry) };
+	if (!IsValid(EntryTable, MeshExportElement::Of<MeshExportEntry>()))
+	{
+		return false;
+	}
+
+	Entries = Map<MeshExportEntry>(EntryTable);
+	return std::ranges::all_of(
+		Entries,
+		[&](const MeshExportEntry& Entry)
+		{
+			return IsValid(Entry, Format);
+		});
+}
+
+bool MeshExportReader::IsValid(const MeshExportEntry& Entry, const MeshExportFormat& Format) const noexcept
+{
+	if (!IsValid(Entry.Name, MeshExportElement::Of<char>()) || !IsValid(Entry.Vertices, Format.Vertex) ||
+		!IsValid(Entry.Indices, MeshExportElement::Of<uint32_t>()) || !IsValid(Entry.Meshlets, Format.Meshlet) ||
+		!IsValid(Entry.UniqueVertexIndices, MeshExportElement::Of<uint8_t>()) ||
+		!IsValid(Entry.PrimitiveIndices, Format.PrimitiveIndex) || !IsValid(Entry.Lods, MeshExportElement::Of<MeshLod>()))
+	{
+		return false;
+	}
+
+	std::span<const MeshLod> Lods = Map<MeshLod>(Entry.Lods);
+	if (Lods.size() > MaxMeshLods)
+	{
+		return false;
+	}
+
+	UINT64 NumIndices  = Entry.Indices.SizeInBytes / sizeof(uint32_t);
+	UINT64 NumMeshlets = Entry.Meshlets.SizeInBytes / Format.Meshlet.Size;
+	return std::ranges::all_of(
+		Lods,
+		[&](const MeshLod& Lod)
+		{
+			return UINT64(Lod.IndexOffset) + Lod.IndexCount <= NumIndices && UINT64(Lod.MeshletOffset) + Lod.MeshletCount <= NumMeshlets;
+		});
+}
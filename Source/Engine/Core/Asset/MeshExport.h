@@ -0,0 +1,129 @@
+#pragma once
+
+// .khscene layout, a MeshExportHeader and a MeshExportEntry per mesh followed by the names and the sections.
+// Sections are stored exactly as they are uploaded and start on a page boundary, so AsyncMeshImporter maps the
+// file and points the meshes into the mapping instead of reading it
+inline constexpr uint32_t MeshExportMagic			 = 0x4353484B; // "KHSC"
+inline constexpr uint32_t MeshExportVersion			 = 5;
+inline constexpr UINT64	  MeshExportSectionAlignment = 4096;
+
+// Must match MAX_MESH_LODS in SharedTypes.hlsli
+inline constexpr size_t MaxMeshLods = 4;
+
+// Range of one level of detail within the index and meshlet buffers of a mesh, LOD 0 is the imported geometry and
+// every LOD indexes the same vertices. Stored as is in the Lods section
+struct MeshLod
+{
+	uint32_t IndexOffset;
+	uint32_t IndexCount;
+	uint32_t MeshletOffset;
+	uint32_t MeshletCount;
+	float	 Error; // Simplification error relative to the diagonal of the bounding box
+};
+
+struct MeshExportHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t NumMeshes;
+	uint64_t FileSize;
+	uint32_t VertexStride; // sizeof(MeshVertex), the vertex format the file was written with
+	uint32_t Padding;
+};
+
+// Byte range within the file
+struct MeshExportSection
+{
+	uint64_t Offset;
+	uint64_t SizeInBytes;
+};
+
+struct MeshExportEntry
+{
+	MeshExportSection Name;
+	MeshExportSection Vertices;
+	MeshExportSection Indices;			   // uint32_t
+	MeshExportSection Meshlets;
+	MeshExportSection UniqueVertexIndices; // uint8_t
+	MeshExportSection PrimitiveIndices;
+	MeshExportSection Lods;				   // MeshLod
+};
+
+// Size and alignment of the elements a section holds
+struct MeshExportElement
+{
+	template<typename T>
+	[[nodiscard]] static constexpr MeshExportElement Of() noexcept
+	{
+		return { sizeof(T), alignof(T) };
+	}
+
+	UINT64 Size;
+	UINT64 Alignment;
+};
+
+// Element types of the sections whose type belongs to the importer
+struct MeshExportFormat
+{
+	template<typename TVertex, typename TMeshlet, typename TTriangle>
+	[[nodiscard]] static constexpr MeshExportFormat Of() noexcept
+	{
+		return { MeshExportElement::Of<TVertex>(), MeshExportElement::Of<TMeshlet>(), MeshExportElement::Of<TTriangle>() };
+	}
+
+	MeshExportElement Vertex;
+	MeshExportElement Meshlet;
+	MeshExportElement PrimitiveIndex;
+};
+
+// Assigns the sections of a file in the order they are allocated, the entries precede the sections they point to
+class MeshExportLayout
+{
+public:
+	explicit MeshExportLayout(UINT64 NumMeshes);
+
+	// Empty sections take no space and are not aligned
+	[[nodiscard]] MeshExportSection Allocate(UINT64 SizeInBytes, UINT64 Alignment);
+
+	[[nodiscard]] UINT64 GetSizeInBytes() const noexcept { return Offset; }
+
+private:
+	UINT64 Offset;
+};
+
+// Validates a .khscene before anything points into it. The header, the entry table and every section are checked
+// against the size of the file without overflowing, a section must hold whole elements of its type at an address
+// aligned for them and the LODs must stay within the indices and meshlets of their mesh. The importer treats a file
+// that fails like one written by an older version and imports the source again
+class MeshExportReader
+{
+public:
+	MeshExportReader(std::span<const BYTE> File, const MeshExportFormat& Format);
+
+	[[nodiscard]] bool IsValid() const noexcept { return Valid; }
+	[[nodiscard]] bool IsValid(const MeshExportSection& Section, const MeshExportElement& Element) const noexcept;
+
+	[[nodiscard]] std::span<const MeshExportEntry> GetEntries() const noexcept { return Entries; }
+
+	template<typename T>
+	[[nodiscard]] std::span<const T> Map(const MeshExportSection& Section) const noexcept
+	{
+		assert(IsValid(Section, MeshExportElement::Of<T>()));
+		return { reinterpret_cast<const T*>(File.data() + Section.Offset), Section.SizeInBytes / sizeof(T) };
+	}
+
+	[[nodiscard]] std::string_view MapString(const MeshExportSection& Section) const noexcept
+	{
+		std::span<const char> String = Map<char>(Section);
+		return { String.data(), String.size() };
+	}
+
+private:
+	[[nodiscard]] bool Validate(const MeshExportFormat& Format);
+	[[nodiscard]] bool IsValid(const MeshExportEntry& Entry, const MeshExportFormat& Format) const noexcept;
+
+private:
+	std::span<const BYTE>			 File;
+	std::span<const MeshExportEntry> Entries;
+	bool							 Valid;
+};
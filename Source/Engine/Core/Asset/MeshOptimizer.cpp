@@ -0,0 +1,240 @@
+#include "MeshOptimizer.h"
+
+// Tom Forsyth, Linear-Speed Vertex Cache Optimisation. A vertex scores by its position in a simulated LRU cache and by
+// the number of its triangles that are left, the triangle around the cache whose vertices score highest is emitted next
+static constexpr uint32_t ScoringCacheSize	= 32;
+static constexpr float	  CacheDecayPower	= 1.5f;
+static constexpr float	  LastTriangleScore = 0.75f;
+static constexpr float	  ValenceBoostScale = 2.0f;
+static constexpr float	  ValenceBoostPower = 0.5f;
+
+static float GetVertexScore(int32_t CachePosition, uint32_t NumActiveFaces)
+{
+	if (NumActiveFaces == 0)
+	{
+		return -1.0f;
+	}
+
+	// The vertices of the last triangle score the same, whichever order they were used in
+	float Score = 0.0f;
+	if (CachePosition >= 0 && CachePosition < 3)
+	{
+		Score = LastTriangleScore;
+	}
+	else if (CachePosition >= 3)
+	{
+		Score = std::pow(1.0f - float(CachePosition - 3) / float(ScoringCacheSize - 3), CacheDecayPower);
+	}
+
+	// Vertices with few triangles left are finished first so they don't have to be loaded again later
+	return Score + ValenceBoostScale * std::pow(float(NumActiveFaces), -ValenceBoostPower);
+}
+
+static bool IsDegenerate(const uint32_t* Face)
+{
+	return Face[0] == Face[1] || Face[1] == Face[2] || Face[0] == Face[2];
+}
+
+static std::vector<uint32_t> RemoveDegenerateFaces(std::span<const uint32_t> Indices)
+{
+	std::vector<uint32_t> Result;
+	Result.reserve(Indices.size());
+	for (size_t i = 0; i + 3 <= Indices.size(); i += 3)
+	{
+		if (!IsDegenerate(&Indices[i]))
+		{
+			Result.insert(Result.end(), &Indices[i], &Indices[i] + 3);
+		}
+	}
+	return Result;
+}
+
+// Shader invocations of a FIFO post-transform cache with MeshOptimizer::VertexCacheSize entries. A vertex is cached
+// while fewer than VertexCacheSize misses happened since it was loaded
+static size_t CountCacheMisses(std::span<const uint32_t> Indices, size_t NumVertices)
+{
+	std::vector<size_t> LoadedAt(NumVertices, 0);
+
+	size_t Misses = 0;
+	for (uint32_t Index : Indices)
+	{
+		if (LoadedAt[Index] == 0 || Misses - LoadedAt[Index] >= MeshOptimizer::VertexCacheSize)
+		{
+			LoadedAt[Index] = ++Misses;
+		}
+	}
+	return Misses;
+}
+
+// Non-degenerate triangles of Indices in cache order, every index must be below NumVertices
+static std::vector<uint32_t> ReorderFaces(std::span<const uint32_t> Indices, size_t NumVertices)
+{
+	std::vector<uint32_t> Faces	   = RemoveDegenerateFaces(Indices);
+	const size_t		  NumFaces = Faces.size() / 3;
+
+	// Triangles of every vertex, the first NumActiveFaces of its range are the ones that are not emitted yet
+	std::vector<uint32_t> FaceOffsets(NumVertices + 1, 0);
+	for (uint32_t Index : Faces)
+	{
+		++FaceOffsets[Index + 1];
+	}
+	std::partial_sum(FaceOffsets.begin(), FaceOffsets.end(), FaceOffsets.begin());
+
+	std::vector<uint32_t> VertexFaces(FaceOffsets.back());
+	std::vector<uint32_t> NumActiveFaces(NumVertices, 0);
+	for (uint32_t i = 0; i < Faces.size(); ++i)
+	{
+		uint32_t Index = Faces[i];
+		VertexFaces[FaceOffsets[Index] + NumActiveFaces[Index]++] = i / 3;
+	}
+
+	std::vector<int32_t> CachePositions(NumVertices, -1);
+	std::vector<float>	 VertexScores(NumVertices);
+	for (size_t i = 0; i < NumVertices; ++i)
+	{
+		VertexScores[i] = GetVertexScore(-1, NumActiveFaces[i]);
+	}
+
+	std::vector<bool>	  Emitted(NumFaces, false);
+	std::vector<uint32_t> Cache;
+	std::vector<uint32_t> NewCache;
+	Cache.reserve(ScoringCacheSize + 3);
+	NewCache.reserve(ScoringCacheSize + 3);
+
+	std::vector<uint32_t> Result;
+	Result.reserve(Faces.size());
+
+	size_t	 NextFace = 0;
+	uint32_t BestFace = UINT32_MAX;
+	while (Result.size() < Faces.size())
+	{
+		// None of the triangles around the cache is left, the next one in input order starts over
+		if (BestFace == UINT32_MAX)
+		{
+			while (Emitted[NextFace])
+			{
+				++NextFace;
+			}
+			BestFace = static_cast<uint32_t>(NextFace);
+		}
+
+		const uint32_t* Face = &Faces[BestFace * 3];
+		Result.insert(Result.end(), Face, Face + 3);
+		Emitted[BestFace] = true;
+
+		for (int i = 0; i < 3; ++i)
+		{
+			uint32_t* Begin = &VertexFaces[FaceOffsets[Face[i]]];
+			uint32_t* End	= Begin + NumActiveFaces[Face[i]]--;
+			std::iter_swap(std::find(Begin, End, BestFace), End - 1);
+		}
+
+		// The vertices of the triangle move to the front of the cache, the ones pushed past its end drop out
+		NewCache.assign(Face, Face + 3);
+		for (uint32_t Index : Cache)
+		{
+			if (Index != Face[0] && Index != Face[1] && Index != Face[2])
+			{
+				NewCache.push_back(Index);
+			}
+		}
+		for (size_t i = 0; i < NewCache.size(); ++i)
+		{
+			uint32_t Index		  = NewCache[i];
+			CachePositions[Index] = i < ScoringCacheSize ? static_cast<int32_t>(i) : -1;
+			VertexScores[Index]	  = GetVertexScore(CachePositions[Index], NumActiveFaces[Index]);
+		}
+		if (NewCache.size() > ScoringCacheSize)
+		{
+			NewCache.resize(ScoringCacheSize);
+		}
+		std::swap(Cache, NewCache);
+
+		// Only the scores of triangles around the cache changed, the best of them is emitted next
+		float BestScore = -1.0f;
+		BestFace		= UINT32_MAX;
+		for (uint32_t Index : Cache)
+		{
+			for (uint32_t i = FaceOffsets[Index]; i < FaceOffsets[Index] + NumActiveFaces[Index]; ++i)
+			{
+				uint32_t		Candidate = VertexFaces[i];
+				const uint32_t* Vertices  = &Faces[Candidate * 3];
+
+				float Score = VertexScores[Vertices[0]] + VertexScores[Vertices[1]] + VertexScores[Vertices[2]];
+				if (Score > BestScore)
+				{
+					BestScore = Score;
+					BestFace  = Candidate;
+				}
+			}
+		}
+	}
+	return Result;
+}
+
+// The reordering is a heuristic, an index buffer that already is in a better order keeps it
+static std::vector<uint32_t> OptimizeFaceOrder(std::span<const uint32_t> Indices, size_t NumVertices)
+{
+	std::vector<uint32_t> Original	= RemoveDegenerateFaces(Indices);
+	std::vector<uint32_t> Reordered = ReorderFaces(Indices, NumVertices);
+	return CountCacheMisses(Reordered, NumVertices) < CountCacheMisses(Original, NumVertices) ? Reordered : Original;
+}
+
+bool MeshOptimizer::Optimize(std::vector<Vertex>& Vertices, std::vector<uint32_t>& Indices, MeshOptimizationStats* Stats /*= nullptr*/)
+{
+	const size_t NumFaces	 = Indices.size() / 3;
+	const size_t NumVertices = Vertices.size();
+	if (NumFaces == 0 || NumVertices == 0 || Indices.size() % 3 != 0 || std::ranges::max(Indices) >= NumVertices)
+	{
+		return false;
+	}
+
+	std::vector<uint32_t> OptimizedIndices = OptimizeFaceOrder(Indices, NumVertices);
+	if (OptimizedIndices.empty())
+	{
+		return false;
+	}
+	const size_t NumOptimizedFaces = OptimizedIndices.size() / 3;
+
+	// Vertices in order of first use, unused vertices are not mapped
+	std::vector<uint32_t> VertexRemap(NumVertices, UINT32_MAX);
+	std::vector<Vertex>	  OptimizedVertices;
+	OptimizedVertices.reserve(NumVertices);
+	for (uint32_t& Index : OptimizedIndices)
+	{
+		if (VertexRemap[Index] == UINT32_MAX)
+		{
+			VertexRemap[Index] = static_cast<uint32_t>(OptimizedVertices.size());
+			OptimizedVertices.push_back(Vertices[Index]);
+		}
+		Index = VertexRemap[Index];
+	}
+
+	if (Stats)
+	{
+		size_t MissesBefore = CountCacheMisses(Indices, NumVertices);
+		size_t MissesAfter	= CountCacheMisses(OptimizedIndices, OptimizedVertices.size());
+
+		Stats->AcmrBefore		   = float(MissesBefore) / float(NumFaces);
+		Stats->AcmrAfter		   = float(MissesAfter) / float(NumOptimizedFaces);
+		Stats->AtvrBefore		   = float(MissesBefore) / float(NumVertices);
+		Stats->AtvrAfter		   = float(MissesAfter) / float(OptimizedVertices.size());
+		Stats->NumRemovedVertices  = NumVertices - OptimizedVertices.size();
+		Stats->NumRemovedTriangles = NumFaces - NumOptimizedFaces;
+	}
+
+	Vertices = std::move(OptimizedVertices);
+	Indices	 = std::move(OptimizedIndices);
+	return true;
+}
+
+bool MeshOptimizer::OptimizeFaces(std::vector<uint32_t>& Indices)
+{
+	if (Indices.empty() || Indices.size() % 3 != 0)
+	{
+		return false;
+	}
+
+	Indices = OptimizeFaceOrder(Indices, size_t(std::ranges::max(Indices)) + 1);
+	return true;
+}
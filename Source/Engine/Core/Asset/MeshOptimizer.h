@@ -0,0 +1,30 @@
+#pragma once
+#include "World/Vertex.h"
+
+struct MeshOptimizationStats
+{
+	// Post-transform cache statistics of a simulated FIFO cache with MeshOptimizer::VertexCacheSize entries,
+	// ACMR is the number of vertex shader invocations per triangle and ATVR per vertex
+	float AcmrBefore = 0.0f;
+	float AcmrAfter	 = 0.0f;
+	float AtvrBefore = 0.0f;
+	float AtvrAfter	 = 0.0f;
+
+	size_t NumRemovedVertices  = 0; // Not referenced by any triangle
+	size_t NumRemovedTriangles = 0; // Degenerate
+};
+
+// Reorders the geometry of an imported mesh before meshlets are built and the mesh is exported. Only depends
+// on its input, the same mesh always produces the same buffers
+struct MeshOptimizer
+{
+	static constexpr uint32_t VertexCacheSize = 12;
+
+	// Reorders the triangles for post-transform cache efficiency, then the vertices in order of first use for
+	// fetch locality. Vertices no triangle references and degenerate triangles are removed. Vertices and Indices
+	// are left untouched if an index is out of range or no triangle is left
+	static bool Optimize(std::vector<Vertex>& Vertices, std::vector<uint32_t>& Indices, MeshOptimizationStats* Stats = nullptr);
+
+	// Only the triangle reordering of Optimize, for index buffers that share an already optimized vertex buffer
+	static bool OptimizeFaces(std::vector<uint32_t>& Indices);
+};
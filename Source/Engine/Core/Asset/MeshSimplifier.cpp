@@ -0,0 +1,342 @@
+#include "MeshSimplifier.h"
+
+using namespace DirectX;
+
+// Area weighted sum of squared distances to a set of planes, stored as the upper triangle of a symmetric 4x4 matrix
+struct Quadric
+{
+	void AddPlane(const XMFLOAT3& Normal, float Distance, float PlaneWeight)
+	{
+		const double n[4] = { Normal.x, Normal.y, Normal.z, Distance };
+		for (int Row = 0, i = 0; Row < 4; ++Row)
+		{
+			for (int Column = Row; Column < 4; ++Column, ++i)
+			{
+				A[i] += PlaneWeight * n[Row] * n[Column];
+			}
+		}
+		Weight += PlaneWeight;
+	}
+
+	[[nodiscard]] double Evaluate(const XMFLOAT3& Position) const noexcept
+	{
+		const double p[4] = { Position.x, Position.y, Position.z, 1.0 };
+
+		double Result = 0.0;
+		for (int Row = 0, i = 0; Row < 4; ++Row)
+		{
+			for (int Column = Row; Column < 4; ++Column, ++i)
+			{
+				Result += (Row == Column ? 1.0 : 2.0) * A[i] * p[Row] * p[Column];
+			}
+		}
+		return Result;
+	}
+
+	Quadric& operator+=(const Quadric& Other) noexcept
+	{
+		for (size_t i = 0; i < A.size(); ++i)
+		{
+			A[i] += Other.A[i];
+		}
+		Weight += Other.Weight;
+		return *this;
+	}
+
+	std::array<double, 10> A	  = {};
+	double				   Weight = 0.0;
+};
+
+struct EdgeCollapse
+{
+	float	 Error;
+	uint32_t From;
+	uint32_t To;
+	uint32_t Version; // Version of From when the error was computed
+};
+
+// Heap order, the cheapest collapse ends up on top. Ties are broken by the vertices so the order never depends on
+// the heap implementation
+static bool CollapseCompare(const EdgeCollapse& a, const EdgeCollapse& b) noexcept
+{
+	if (a.Error != b.Error)
+	{
+		return a.Error > b.Error;
+	}
+	return a.From != b.From ? a.From > b.From : a.To > b.To;
+}
+
+static XMVECTOR TriangleNormal(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2)
+{
+	XMVECTOR v0 = XMLoadFloat3(&p0);
+	return XMVector3Cross(XMVectorSubtract(XMLoadFloat3(&p1), v0), XMVectorSubtract(XMLoadFloat3(&p2), v0));
+}
+
+struct PositionHash
+{
+	size_t operator()(const XMFLOAT3& Position) const noexcept
+	{
+		return CityHash64(reinterpret_cast<const char*>(&Position), sizeof(XMFLOAT3));
+	}
+};
+
+struct PositionEqual
+{
+	bool operator()(const XMFLOAT3& a, const XMFLOAT3& b) const noexcept
+	{
+		return std::memcmp(&a, &b, sizeof(XMFLOAT3)) == 0;
+	}
+};
+
+std::vector<uint32_t> MeshSimplifier::Simplify(
+	std::span<const Vertex>	  Vertices,
+	std::span<const uint32_t> Indices,
+	size_t					  TargetIndexCount,
+	float					  TargetError,
+	float*					  ResultError /*= nullptr*/)
+{
+	const size_t NumVertices = Vertices.size();
+	const size_t NumFaces	 = Indices.size() / 3;
+
+	std::vector<uint32_t> Triangles(Indices.begin(), Indices.begin() + NumFaces * 3);
+	if (ResultError)
+	{
+		*ResultError = 0.0f;
+	}
+
+	BoundingBox Bounds;
+	if (NumVertices > 0)
+	{
+		BoundingBox::CreateFromPoints(Bounds, NumVertices, &Vertices[0].Position, sizeof(Vertex));
+	}
+	const float Diagonal = 2.0f * XMVectorGetX(XMVector3Length(XMLoadFloat3(&Bounds.Extents)));
+	if (NumFaces == 0 || Diagonal == 0.0f)
+	{
+		return Triangles;
+	}
+
+	// Vertices that share a position with another vertex sit on an attribute seam
+	std::vector<uint32_t> Representatives(NumVertices);
+	std::vector<uint32_t> NumShared(NumVertices);
+	{
+		std::unordered_map<XMFLOAT3, uint32_t, PositionHash, PositionEqual> Positions;
+		Positions.reserve(NumVertices);
+		for (uint32_t i = 0; i < NumVertices; ++i)
+		{
+			Representatives[i] = Positions.try_emplace(Vertices[i].Position, i).first->second;
+			++NumShared[Representatives[i]];
+		}
+	}
+
+	// Edges between positions that are not shared by exactly two triangles are open borders or non-manifold
+	std::vector<bool> LockedPositions(NumVertices);
+	{
+		std::unordered_map<uint64_t, uint32_t> EdgeCounts;
+		EdgeCounts.reserve(Triangles.size());
+		for (size_t i = 0; i < Triangles.size(); i += 3)
+		{
+			for (size_t Corner = 0; Corner < 3; ++Corner)
+			{
+				uint64_t a = Representatives[Triangles[i + Corner]];
+				uint64_t b = Representatives[Triangles[i + (Corner + 1) % 3]];
+				if (a != b)
+				{
+					++EdgeCounts[std::min(a, b) << 32 | std::max(a, b)];
+				}
+			}
+		}
+		for (auto [Edge, Count] : EdgeCounts)
+		{
+			if (Count != 2)
+			{
+				LockedPositions[Edge >> 32]		   = true;
+				LockedPositions[Edge & 0xffffffff] = true;
+			}
+		}
+	}
+
+	std::vector<bool> Locked(NumVertices);
+	for (size_t i = 0; i < NumVertices; ++i)
+	{
+		Locked[i] = NumShared[Representatives[i]] > 1 || LockedPositions[Representatives[i]];
+	}
+
+	std::vector<Quadric>			   Quadrics(NumVertices);
+	std::vector<std::vector<uint32_t>> VertexFaces(NumVertices);
+	std::vector<bool>				   FaceAlive(NumFaces);
+	size_t							   NumIndices = 0;
+	for (uint32_t Face = 0; Face < NumFaces; ++Face)
+	{
+		const uint32_t* Triangle = &Triangles[Face * 3];
+		if (Triangle[0] == Triangle[1] || Triangle[1] == Triangle[2] || Triangle[0] == Triangle[2])
+		{
+			continue;
+		}
+
+		FaceAlive[Face] = true;
+		NumIndices += 3;
+
+		XMVECTOR Normal = TriangleNormal(Vertices[Triangle[0]].Position, Vertices[Triangle[1]].Position, Vertices[Triangle[2]].Position);
+		float	 Length = XMVectorGetX(XMVector3Length(Normal));
+
+		XMFLOAT3 UnitNormal;
+		XMStoreFloat3(&UnitNormal, XMVectorScale(Normal, Length > 0.0f ? 1.0f / Length : 0.0f));
+		float Distance = -XMVectorGetX(XMVector3Dot(XMLoadFloat3(&UnitNormal), XMLoadFloat3(&Vertices[Triangle[0]].Position)));
+
+		for (size_t Corner = 0; Corner < 3; ++Corner)
+		{
+			Quadrics[Triangle[Corner]].AddPlane(UnitNormal, Distance, 0.5f * Length);
+			VertexFaces[Triangle[Corner]].push_back(Face);
+		}
+	}
+
+	std::vector<bool>	  Collapsed(NumVertices);
+	std::vector<uint32_t> Versions(NumVertices);
+
+	auto Cost = [&](uint32_t From, uint32_t To)
+	{
+		const Quadric& FromQuadric = Quadrics[From];
+		if (FromQuadric.Weight <= 0.0)
+		{
+			return 0.0f;
+		}
+		double SquaredDistance = std::max(FromQuadric.Evaluate(Vertices[To].Position), 0.0) / FromQuadric.Weight;
+		return static_cast<float>(std::sqrt(SquaredDistance)) / Diagonal;
+	};
+
+	std::vector<EdgeCollapse> Heap;
+
+	auto Push = [&](uint32_t From, uint32_t To)
+	{
+		if (!Locked[From] && !Collapsed[From] && From != To)
+		{
+			Heap.push_back({ Cost(From, To), From, To, Versions[From] });
+			std::ranges::push_heap(Heap, CollapseCompare);
+		}
+	};
+
+	for (uint32_t Face = 0; Face < NumFaces; ++Face)
+	{
+		if (FaceAlive[Face])
+		{
+			for (size_t Corner = 0; Corner < 3; ++Corner)
+			{
+				Push(Triangles[Face * 3 + Corner], Triangles[Face * 3 + (Corner + 1) % 3]);
+				Push(Triangles[Face * 3 + (Corner + 1) % 3], Triangles[Face * 3 + Corner]);
+			}
+		}
+	}
+
+	float MaxError = 0.0f;
+	while (NumIndices > TargetIndexCount && !Heap.empty())
+	{
+		std::ranges::pop_heap(Heap, CollapseCompare);
+		EdgeCollapse Collapse = Heap.back();
+		Heap.pop_back();
+
+		// Everything left on the heap costs at least as much
+		if (Collapse.Error > TargetError)
+		{
+			break;
+		}
+
+		const uint32_t From = Collapse.From;
+		const uint32_t To	= Collapse.To;
+		if (Collapsed[From] || Collapsed[To] || Collapse.Version != Versions[From])
+		{
+			continue;
+		}
+
+		// The edge has to still exist and no remaining triangle around From may flip
+		bool Adjacent = false;
+		bool Flips	  = false;
+		for (uint32_t Face : VertexFaces[From])
+		{
+			const uint32_t* Triangle = &Triangles[Face * 3];
+			if (!FaceAlive[Face])
+			{
+				continue;
+			}
+			if (Triangle[0] == To || Triangle[1] == To || Triangle[2] == To)
+			{
+				Adjacent = true;
+				continue;
+			}
+
+			XMFLOAT3 Positions[3];
+			for (size_t Corner = 0; Corner < 3; ++Corner)
+			{
+				Positions[Corner] = Vertices[Triangle[Corner]].Position;
+			}
+			XMVECTOR Before = TriangleNormal(Positions[0], Positions[1], Positions[2]);
+			for (size_t Corner = 0; Corner < 3; ++Corner)
+			{
+				Positions[Corner] = Vertices[Triangle[Corner] == From ? To : Triangle[Corner]].Position;
+			}
+			XMVECTOR After = TriangleNormal(Positions[0], Positions[1], Positions[2]);
+
+			if (XMVectorGetX(XMVector3Dot(Before, After)) <= 0.0f)
+			{
+				Flips = true;
+				break;
+			}
+		}
+		if (!Adjacent || Flips)
+		{
+			continue;
+		}
+
+		for (uint32_t Face : VertexFaces[From])
+		{
+			uint32_t* Triangle = &Triangles[Face * 3];
+			if (!FaceAlive[Face])
+			{
+				continue;
+			}
+			if (Triangle[0] == To || Triangle[1] == To || Triangle[2] == To)
+			{
+				FaceAlive[Face] = false;
+				NumIndices -= 3;
+				continue;
+			}
+
+			std::ranges::replace(std::span(Triangle, 3), From, To);
+			VertexFaces[To].push_back(Face);
+		}
+		VertexFaces[From].clear();
+
+		Collapsed[From] = true;
+		Quadrics[To] += Quadrics[From];
+		++Versions[To];
+		MaxError = std::max(MaxError, Collapse.Error);
+
+		// The quadric of To changed, and the former neighbours of From are now connected to To
+		for (uint32_t Face : VertexFaces[To])
+		{
+			if (FaceAlive[Face])
+			{
+				for (size_t Corner = 0; Corner < 3; ++Corner)
+				{
+					Push(To, Triangles[Face * 3 + Corner]);
+					Push(Triangles[Face * 3 + Corner], To);
+				}
+			}
+		}
+	}
+
+	std::vector<uint32_t> Result;
+	Result.reserve(NumIndices);
+	for (uint32_t Face = 0; Face < NumFaces; ++Face)
+	{
+		if (FaceAlive[Face])
+		{
+			Result.insert(Result.end(), &Triangles[Face * 3], &Triangles[Face * 3] + 3);
+		}
+	}
+
+	if (ResultError)
+	{
+		*ResultError = MaxError;
+	}
+	return Result;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "World/Vertex.h"
+
+// Quadric error metric edge collapse simplifier used to build LOD chains. Vertices are never moved or created, a
+// collapse merges a vertex into one of its neighbours, so every LOD indexes the vertex buffer of the source mesh.
+// Vertices on attribute seams, open borders and non-manifold edges are locked to keep silhouettes and uv layouts
+struct MeshSimplifier
+{
+	// Collapses edges in order of increasing error until at most TargetIndexCount indices are left or the next
+	// collapse would exceed TargetError. Errors are distances relative to the diagonal of the mesh bounds,
+	// ResultError receives the largest error of the collapses that were made
+	static std::vector<uint32_t> Simplify(
+		std::span<const Vertex>	  Vertices,
+		std::span<const uint32_t> Indices,
+		size_t					  TargetIndexCount,
+		float					  TargetError,
+		float*					  ResultError = nullptr);
+};
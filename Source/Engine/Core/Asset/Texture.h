@@ -11,6 +11,7 @@ struct TextureImportOptions
 
 	bool sRGB		  = false;
 	bool GenerateMips = true;
+	bool Compress	  = true; // Block compress when the format and size allow it
 };
 
 class Texture : public Asset
@@ -26,6 +27,16 @@ public:
 	Vec2i Resolution;
 	bool  IsCubemap = false;
 
+	// Mips from TailMip on are always resident, a texture with a TailMip of 0 does not stream and is fully resident.
+	// DxTexture holds the mips from ResidentMip on, TexImage is kept while the texture streams
+	UINT TailMip	 = 0;
+	UINT ResidentMip = 0;
+
+	// Texture holding the mips from StreamSourceMip on once the uploads queued so far complete, the next stream
+	// request copies them from it. Only used on the upload thread, runs ahead of DxTexture while requests are in flight
+	ID3D12Resource* StreamSource	= nullptr;
+	UINT			StreamSourceMip = 0;
+
 	std::string			  Name;
 	DirectX::ScratchImage TexImage;
 
@@ -0,0 +1,201 @@
+#include "TextureResidency.h"
+
+TextureResidencyManager::TextureResidencyManager(UINT64 BudgetInBytes, UINT64 MaxStreamInPerUpdate)
+	: MaxStreamInPerUpdate(MaxStreamInPerUpdate)
+{
+	Stats.BudgetInBytes = BudgetInBytes;
+}
+
+void TextureResidencyManager::Register(UINT Id, std::span<const UINT64> MipSizes, UINT TailMip)
+{
+	assert(!MipSizes.empty() && TailMip < MipSizes.size());
+
+	Entry Entry = {};
+	Entry.ResidentSizes.resize(MipSizes.size());
+	UINT64 Size = 0;
+	for (size_t Mip = MipSizes.size(); Mip-- > 0;)
+	{
+		Size += MipSizes[Mip];
+		Entry.ResidentSizes[Mip] = Size;
+	}
+	Entry.TailMip	   = TailMip;
+	Entry.ResidentMip  = TailMip;
+	Entry.RequestedMip = TailMip;
+	Entry.Priority	   = 0.0f;
+	Entry.LastRequest  = 0;
+
+	Stats.ResidentSizeInBytes += Entry.ResidentSizes[TailMip];
+	Entries.insert_or_assign(Id, std::move(Entry));
+	Stats.NumTextures = static_cast<UINT>(Entries.size());
+}
+
+void TextureResidencyManager::Unregister(UINT Id)
+{
+	if (auto Iter = Entries.find(Id); Iter != Entries.end())
+	{
+		Stats.ResidentSizeInBytes -= Iter->second.ResidentSizes[Iter->second.ResidentMip];
+		Entries.erase(Iter);
+		Stats.NumTextures = static_cast<UINT>(Entries.size());
+	}
+}
+
+void TextureResidencyManager::Clear()
+{
+	Entries.clear();
+	Stats.ResidentSizeInBytes  = 0;
+	Stats.RequestedSizeInBytes = 0;
+	Stats.NumTextures		   = 0;
+	Stats.NumOverBudget		   = 0;
+}
+
+UINT TextureResidencyManager::GetResidentMip(UINT Id) const
+{
+	auto Iter = Entries.find(Id);
+	return Iter != Entries.end() ? Iter->second.ResidentMip : 0;
+}
+
+void TextureResidencyManager::Request(UINT Id, UINT Mip, float Priority)
+{
+	auto Iter = Entries.find(Id);
+	if (Iter == Entries.end())
+	{
+		return;
+	}
+
+	// The first request of an update replaces the previous one so a texture can also become coarser
+	Entry& Entry = Iter->second;
+	Mip			 = std::min(Mip, Entry.TailMip);
+	if (Entry.LastRequest != UpdateIndex + 1)
+	{
+		Entry.RequestedMip = Mip;
+		Entry.Priority	   = Priority;
+		Entry.LastRequest  = UpdateIndex + 1;
+	}
+	else
+	{
+		Entry.RequestedMip = std::min(Entry.RequestedMip, Mip);
+		Entry.Priority	   = std::max(Entry.Priority, Priority);
+	}
+}
+
+std::vector<TextureResidencyChange> TextureResidencyManager::Update()
+{
+	++UpdateIndex;
+
+	struct Candidate
+	{
+		UINT   Id;
+		Entry* Texture;
+		UINT   TargetMip;
+	};
+	std::vector<Candidate> Candidates;
+	Candidates.reserve(Entries.size());
+
+	UINT64 TailSize			   = 0;
+	Stats.RequestedSizeInBytes = 0;
+	for (auto& [Id, Entry] : Entries)
+	{
+		if (UpdateIndex - Entry.LastRequest > RequestLifetime)
+		{
+			Entry.RequestedMip = Entry.TailMip;
+			Entry.Priority	   = 0.0f;
+		}
+
+		TailSize += Entry.ResidentSizes[Entry.TailMip];
+		Stats.RequestedSizeInBytes += Entry.ResidentSizes[Entry.RequestedMip];
+		Candidates.push_back({ Id, &Entry, Entry.TailMip });
+	}
+
+	// Ties are broken by id so replaying the same requests gives the same result
+	std::ranges::sort(
+		Candidates,
+		[](const Candidate& a, const Candidate& b)
+		{
+			if (a.Texture->Priority != b.Texture->Priority)
+			{
+				return a.Texture->Priority > b.Texture->Priority;
+			}
+			return a.Id < b.Id;
+		});
+
+	// Tails are always resident, the rest of the budget goes to the requests in priority order. A request that does
+	// not fit gets the finest mip that does
+	UINT64 Available	= Stats.BudgetInBytes > TailSize ? Stats.BudgetInBytes - TailSize : 0;
+	Stats.NumOverBudget = 0;
+	for (Candidate& Candidate : Candidates)
+	{
+		const Entry& Entry = *Candidate.Texture;
+		const UINT64 Tail  = Entry.ResidentSizes[Entry.TailMip];
+
+		UINT Mip = Entry.RequestedMip;
+		while (Mip < Entry.TailMip && Entry.ResidentSizes[Mip] - Tail > Available)
+		{
+			++Mip;
+		}
+		Available -= Entry.ResidentSizes[Mip] - Tail;
+		Candidate.TargetMip = Mip;
+		Stats.NumOverBudget += Mip > Entry.RequestedMip ? 1 : 0;
+	}
+
+	// Whatever is left keeps mips that are resident but no longer requested, so moving back and forth does not
+	// stream the same mips again. They are only evicted once the budget is needed
+	for (Candidate& Candidate : Candidates)
+	{
+		const Entry& Entry = *Candidate.Texture;
+		for (UINT Mip = Entry.ResidentMip; Mip < Candidate.TargetMip; ++Mip)
+		{
+			UINT64 Size = Entry.ResidentSizes[Mip] - Entry.ResidentSizes[Candidate.TargetMip];
+			if (Size <= Available)
+			{
+				Available -= Size;
+				Candidate.TargetMip = Mip;
+				break;
+			}
+		}
+	}
+
+	std::vector<TextureResidencyChange> Changes;
+	for (Candidate& Candidate : Candidates)
+	{
+		Entry& Entry = *Candidate.Texture;
+		if (Candidate.TargetMip > Entry.ResidentMip)
+		{
+			Changes.push_back({ Candidate.Id, Entry.ResidentMip, Candidate.TargetMip });
+			Stats.ResidentSizeInBytes -= Entry.ResidentSizes[Entry.ResidentMip] - Entry.ResidentSizes[Candidate.TargetMip];
+			Entry.ResidentMip = Candidate.TargetMip;
+			++Stats.NumEvictions;
+		}
+	}
+
+	// Stream ins are limited per update so a camera cut does not stall on uploads, the most important textures go
+	// first. The first mip of an update always goes through so a mip larger than the limit still makes progress
+	Stats.StreamedInBytes = 0;
+	for (Candidate& Candidate : Candidates)
+	{
+		Entry& Entry = *Candidate.Texture;
+
+		UINT Mip = Entry.ResidentMip;
+		while (Mip > Candidate.TargetMip)
+		{
+			UINT64 Size		= Entry.ResidentSizes[Mip - 1] - Entry.ResidentSizes[Entry.ResidentMip];
+			bool   Progress = Stats.StreamedInBytes == 0 && Mip == Entry.ResidentMip;
+			if (Stats.StreamedInBytes + Size > MaxStreamInPerUpdate && !Progress)
+			{
+				break;
+			}
+			--Mip;
+		}
+
+		if (Mip < Entry.ResidentMip)
+		{
+			UINT64 Size = Entry.ResidentSizes[Mip] - Entry.ResidentSizes[Entry.ResidentMip];
+			Changes.push_back({ Candidate.Id, Entry.ResidentMip, Mip });
+			Stats.StreamedInBytes += Size;
+			Stats.ResidentSizeInBytes += Size;
+			Entry.ResidentMip = Mip;
+			++Stats.NumStreamIns;
+		}
+	}
+
+	return Changes;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+struct TextureResidencyStats
+{
+	UINT64 BudgetInBytes		= 0;
+	UINT64 ResidentSizeInBytes	= 0;
+	UINT64 RequestedSizeInBytes = 0; // Resident size if the budget was unlimited
+	UINT64 StreamedInBytes		= 0; // Last update
+	UINT   NumTextures			= 0;
+	UINT   NumOverBudget		= 0; // Textures kept coarser than requested in the last update
+	UINT64 NumStreamIns			= 0; // Since initialization
+	UINT64 NumEvictions			= 0;
+};
+
+struct TextureResidencyChange
+{
+	UINT Id;
+	UINT OldMip;
+	UINT NewMip; // Finer than OldMip streams mips in, coarser evicts them
+};
+
+// Decides which mips of which textures are resident under a memory budget. Mip 0 is the most detailed and a texture
+// always has every mip from its resident mip to the end of the chain. Textures start with only their mip tail, the
+// renderer requests finer mips every frame with a priority and Update returns the changes that fit the budget
+class TextureResidencyManager
+{
+public:
+	// Updates a request stays valid for, a texture that is no longer requested falls back to its tail
+	static constexpr UINT64 RequestLifetime = 60;
+
+	TextureResidencyManager(UINT64 BudgetInBytes, UINT64 MaxStreamInPerUpdate);
+
+	void SetBudget(UINT64 BudgetInBytes) noexcept { Stats.BudgetInBytes = BudgetInBytes; }
+	void SetMaxStreamInPerUpdate(UINT64 MaxStreamInPerUpdate) noexcept { this->MaxStreamInPerUpdate = MaxStreamInPerUpdate; }
+
+	[[nodiscard]] UINT64 GetBudget() const noexcept { return Stats.BudgetInBytes; }
+
+	// MipSizes holds the size of every mip in bytes, mips from TailMip on stay resident until the texture is unregistered
+	void Register(UINT Id, std::span<const UINT64> MipSizes, UINT TailMip);
+	void Unregister(UINT Id);
+	void Clear();
+
+	[[nodiscard]] bool IsRegistered(UINT Id) const { return Entries.contains(Id); }
+	[[nodiscard]] UINT GetResidentMip(UINT Id) const;
+
+	// Can be called several times per update, the finest mip and the highest priority win
+	void Request(UINT Id, UINT Mip, float Priority);
+
+	// Evictions come first, the changes are considered applied once returned
+	std::vector<TextureResidencyChange> Update();
+
+	[[nodiscard]] const TextureResidencyStats& GetStats() const noexcept { return Stats; }
+
+private:
+	struct Entry
+	{
+		std::vector<UINT64> ResidentSizes; // Size of the chain from a mip to the end
+		UINT				TailMip;
+		UINT				ResidentMip;
+		UINT				RequestedMip;
+		float				Priority;
+		UINT64				LastRequest;
+	};
+
+private:
+	std::unordered_map<UINT, Entry> Entries;
+
+	UINT64				  MaxStreamInPerUpdate;
+	UINT64				  UpdateIndex = 0;
+	TextureResidencyStats Stats;
+};
@@ -1,4 +1,7 @@
 #pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 
 #define DEFAULTCOPYABLE(TypeName)                                                                                      \
 	TypeName(const TypeName&) = default;                                                                               \
@@ -46,30 +49,23 @@ constexpr bool IsDivisible(T Value, T Divisor)
 	return (Value / Divisor) * Divisor == Value;
 }
 
-inline std::uint8_t Log2(std::uint64_t Value)
+// Rounded up, 0 for 0 and 1
+constexpr std::uint8_t Log2(std::uint64_t Value)
 {
-	unsigned long mssb; // most significant set bit
-	unsigned long lssb; // least significant set bit
-
-	// If perfect power of two (only one set bit), return index of bit.  Otherwise round up
-	// fractional log by adding 1 to most signicant set bit's index.
-	if (_BitScanReverse64(&mssb, Value) > 0 && _BitScanForward64(&lssb, Value) > 0)
-		return std::uint8_t(mssb + (mssb == lssb ? 0 : 1));
-
-	return 0;
+	return Value > 1 ? std::uint8_t(std::bit_width(Value - 1)) : 0;
 }
 
-constexpr std::size_t operator"" _KiB(std::size_t X)
+constexpr std::size_t operator"" _KiB(unsigned long long X)
 {
 	return X * 1024;
 }
 
-constexpr std::size_t operator"" _MiB(std::size_t X)
+constexpr std::size_t operator"" _MiB(unsigned long long X)
 {
 	return X * 1024 * 1024;
 }
 
-constexpr std::size_t operator"" _GiB(std::size_t X)
+constexpr std::size_t operator"" _GiB(unsigned long long X)
 {
 	return X * 1024 * 1024 * 1024;
 }
@@ -76,6 +76,28 @@ D3D12SyncHandle D3D12CommandContext::Execute(bool WaitForCompletion)
 	return SyncHandle;
 }
 
+D3D12SyncHandle D3D12CommandContext::Execute(std::span<D3D12CommandContext* const> Contexts, bool WaitForCompletion)
+{
+	assert(!Contexts.empty());
+
+	std::vector<D3D12CommandListHandle*> CommandListHandles;
+	CommandListHandles.reserve(Contexts.size());
+	for (auto Context : Contexts)
+	{
+		assert(Context->GetCommandQueue() == Contexts[0]->GetCommandQueue());
+		CommandListHandles.push_back(&Context->CommandListHandle);
+	}
+
+	D3D12SyncHandle SyncHandle = Contexts[0]->GetCommandQueue()->ExecuteCommandLists(CommandListHandles, WaitForCompletion);
+
+	for (auto Context : Contexts)
+	{
+		Context->CommandAllocatorPool.DiscardCommandAllocator(std::exchange(Context->CommandAllocator, nullptr), SyncHandle);
+		Context->CpuConstantAllocator.Version(SyncHandle);
+	}
+	return SyncHandle;
+}
+
 void D3D12CommandContext::TransitionBarrier(
 	D3D12Resource*		  Resource,
 	D3D12_RESOURCE_STATES State,
@@ -84,6 +106,20 @@ void D3D12CommandContext::TransitionBarrier(
 	CommandListHandle.TransitionBarrier(Resource, State, Subresource);
 }
 
+bool D3D12CommandContext::BeginTransitionBarrier(
+	D3D12Resource*		  Resource,
+	D3D12_RESOURCE_STATES State)
+{
+	return CommandListHandle.BeginTransitionBarrier(Resource, State);
+}
+
+void D3D12CommandContext::EndTransitionBarrier(
+	D3D12Resource*		  Resource,
+	D3D12_RESOURCE_STATES State)
+{
+	CommandListHandle.EndTransitionBarrier(Resource, State);
+}
+
 void D3D12CommandContext::AliasingBarrier(
 	D3D12Resource* BeforeResource,
 	D3D12Resource* AfterResource)
@@ -365,3 +401,30 @@ void D3D12CommandContext::ResetCounter(
 		Allocation.Offset,
 		sizeof(UINT));
 }
+
+void D3D12CommandContext::WriteBuffer(
+	D3D12Resource* Resource,
+	UINT64		   Offset,
+	const void*	   Data,
+	UINT64		   SizeInBytes)
+{
+	const BYTE* Source = static_cast<const BYTE*>(Data);
+	while (SizeInBytes > 0)
+	{
+		UINT64 ChunkSize = std::min(SizeInBytes, D3D12LinearAllocator::CpuAllocatorPageSize);
+
+		D3D12Allocation Allocation = CpuConstantAllocator.Allocate(ChunkSize);
+		std::memcpy(Allocation.CpuVirtualAddress, Source, ChunkSize);
+
+		CommandListHandle->CopyBufferRegion(
+			Resource->GetResource(),
+			Offset,
+			Allocation.Resource,
+			Allocation.Offset,
+			ChunkSize);
+
+		Source += ChunkSize;
+		Offset += ChunkSize;
+		SizeInBytes -= ChunkSize;
+	}
+}
@@ -31,11 +31,22 @@ public:
 	// Returns D3D12SyncHandle, may be ignored if WaitForCompletion is true
 	D3D12SyncHandle Execute(bool WaitForCompletion);
 
+	// Submits closed contexts of the same queue in a single ExecuteCommandLists call, in span order
+	static D3D12SyncHandle Execute(std::span<D3D12CommandContext* const> Contexts, bool WaitForCompletion);
+
 	void TransitionBarrier(
 		D3D12Resource*		  Resource,
 		D3D12_RESOURCE_STATES State,
 		UINT				  Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
 
+	bool BeginTransitionBarrier(
+		D3D12Resource*		  Resource,
+		D3D12_RESOURCE_STATES State);
+
+	void EndTransitionBarrier(
+		D3D12Resource*		  Resource,
+		D3D12_RESOURCE_STATES State);
+
 	void AliasingBarrier(
 		D3D12Resource* BeforeResource,
 		D3D12Resource* AfterResource);
@@ -165,6 +176,13 @@ public:
 		UINT64		   CounterOffset,
 		UINT		   Value = 0);
 
+	// Copies Data into Resource through the constant allocator, split into page sized chunks
+	void WriteBuffer(
+		D3D12Resource* Resource,
+		UINT64		   Offset,
+		const void*	   Data,
+		UINT64		   SizeInBytes);
+
 private:
 	RHID3D12CommandQueueType					   Type;
 	D3D12CommandListHandle						   CommandListHandle;
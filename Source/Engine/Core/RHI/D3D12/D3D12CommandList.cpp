@@ -57,12 +57,13 @@ void ResourceBarrierBatch::Add(
 }
 
 void ResourceBarrierBatch::AddTransition(
-	D3D12Resource*		  Resource,
-	D3D12_RESOURCE_STATES StateBefore,
-	D3D12_RESOURCE_STATES StateAfter,
-	UINT				  Subresource /*= D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES*/)
+	D3D12Resource*				 Resource,
+	D3D12_RESOURCE_STATES		 StateBefore,
+	D3D12_RESOURCE_STATES		 StateAfter,
+	UINT						 Subresource /*= D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES*/,
+	D3D12_RESOURCE_BARRIER_FLAGS Flags /*= D3D12_RESOURCE_BARRIER_FLAG_NONE*/)
 {
-	Add(CD3DX12_RESOURCE_BARRIER::Transition(Resource->GetResource(), StateBefore, StateAfter, Subresource));
+	Add(CD3DX12_RESOURCE_BARRIER::Transition(Resource->GetResource(), StateBefore, StateAfter, Subresource, Flags));
 }
 
 void ResourceBarrierBatch::AddAliasing(
@@ -137,6 +138,7 @@ D3D12CommandListHandle::D3D12CommandListHandle(D3D12CommandListHandle&& D3D12Com
 #endif
 	, ResourceStateTracker(std::move(D3D12CommandListHandle.ResourceStateTracker))
 	, ResourceBarrierBatch(std::move(D3D12CommandListHandle.ResourceBarrierBatch))
+	, SplitResourceBarriers(std::move(D3D12CommandListHandle.SplitResourceBarriers))
 {
 }
 
@@ -155,8 +157,9 @@ D3D12CommandListHandle& D3D12CommandListHandle::operator=(D3D12CommandListHandle
 #ifdef D3D12_DEBUG_RESOURCE_STATES
 	DebugCommandList = std::exchange(D3D12CommandListHandle.DebugCommandList, {});
 #endif
-	ResourceStateTracker = std::move(D3D12CommandListHandle.ResourceStateTracker);
-	ResourceBarrierBatch = std::move(D3D12CommandListHandle.ResourceBarrierBatch);
+	ResourceStateTracker  = std::move(D3D12CommandListHandle.ResourceStateTracker);
+	ResourceBarrierBatch  = std::move(D3D12CommandListHandle.ResourceBarrierBatch);
+	SplitResourceBarriers = std::move(D3D12CommandListHandle.SplitResourceBarriers);
 
 	return *this;
 }
@@ -168,10 +171,15 @@ void D3D12CommandListHandle::Open(ID3D12CommandAllocator* CommandAllocator)
 	// Reset resource state tracking and resource barriers
 	ResourceStateTracker.Reset();
 	ResourceBarrierBatch.Reset();
+	SplitResourceBarriers.clear();
 }
 
 void D3D12CommandListHandle::Close()
 {
+	while (!SplitResourceBarriers.empty())
+	{
+		EndSplitBarrier(SplitResourceBarriers.back().Resource);
+	}
 	FlushResourceBarriers();
 	VERIFY_D3D12_API(GraphicsCommandList->Close());
 }
@@ -182,6 +190,7 @@ void D3D12CommandListHandle::TransitionBarrier(
 	UINT				  Subresource /*= D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES*/)
 {
 	// TODO: There might be some logic and cases here im missing, come back and edit if anything goes boom
+	EndSplitBarrier(Resource);
 
 	CResourceState& ResourceState = ResourceStateTracker.GetResourceState(Resource);
 	// First use on the command list
@@ -226,6 +235,53 @@ void D3D12CommandListHandle::TransitionBarrier(
 	ResourceState.SetSubresourceState(Subresource, State);
 }
 
+bool D3D12CommandListHandle::BeginTransitionBarrier(
+	D3D12Resource*		  Resource,
+	D3D12_RESOURCE_STATES State)
+{
+	EndSplitBarrier(Resource);
+
+	// The begin barrier needs the state before the transition, pending barriers only know it at submission
+	CResourceState& ResourceState = ResourceStateTracker.GetResourceState(Resource);
+	if (ResourceState.IsUnknown() || !ResourceState.IsUniform())
+	{
+		return false;
+	}
+
+	D3D12_RESOURCE_STATES StateBefore = ResourceState.GetSubresourceState(D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+	if (StateBefore == State)
+	{
+		return false;
+	}
+
+	ResourceBarrierBatch.AddTransition(Resource, StateBefore, State, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY);
+	SplitResourceBarriers.push_back({ Resource, StateBefore, State });
+	return true;
+}
+
+void D3D12CommandListHandle::EndTransitionBarrier(
+	D3D12Resource*		  Resource,
+	D3D12_RESOURCE_STATES State)
+{
+	// TransitionBarrier ends the split barrier first, and does nothing else if it already reached State
+	TransitionBarrier(Resource, State);
+}
+
+bool D3D12CommandListHandle::EndSplitBarrier(
+	D3D12Resource* Resource)
+{
+	auto Iter = std::ranges::find(SplitResourceBarriers, Resource, &SplitResourceBarrier::Resource);
+	if (Iter == SplitResourceBarriers.end())
+	{
+		return false;
+	}
+
+	ResourceBarrierBatch.AddTransition(Resource, Iter->StateBefore, Iter->StateAfter, D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, D3D12_RESOURCE_BARRIER_FLAG_END_ONLY);
+	ResourceStateTracker.GetResourceState(Resource).SetSubresourceState(D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, Iter->StateAfter);
+	SplitResourceBarriers.erase(Iter);
+	return true;
+}
+
 void D3D12CommandListHandle::AliasingBarrier(
 	D3D12Resource* BeforeResource,
 	D3D12Resource* AfterResource)
@@ -30,6 +30,14 @@ struct PendingResourceBarrier
 	UINT				  Subresource;
 };
 
+// Transition that began on a command list but has not ended yet
+struct SplitResourceBarrier
+{
+	D3D12Resource*		  Resource;
+	D3D12_RESOURCE_STATES StateBefore;
+	D3D12_RESOURCE_STATES StateAfter;
+};
+
 struct ResourceBarrierBatch
 {
 	static constexpr UINT NumBatches = 64;
@@ -43,10 +51,11 @@ struct ResourceBarrierBatch
 		const D3D12_RESOURCE_BARRIER& ResourceBarrier);
 
 	void AddTransition(
-		D3D12Resource*		  Resource,
-		D3D12_RESOURCE_STATES StateBefore,
-		D3D12_RESOURCE_STATES StateAfter,
-		UINT				  Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+		D3D12Resource*				 Resource,
+		D3D12_RESOURCE_STATES		 StateBefore,
+		D3D12_RESOURCE_STATES		 StateAfter,
+		UINT						 Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES,
+		D3D12_RESOURCE_BARRIER_FLAGS Flags		 = D3D12_RESOURCE_BARRIER_FLAG_NONE);
 
 	void AddAliasing(
 		D3D12Resource* BeforeResource,
@@ -109,6 +118,17 @@ public:
 		D3D12_RESOURCE_STATES State,
 		UINT				  Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
 
+	// Split barrier, the transition overlaps with the work recorded between begin and end.
+	// Returns false without recording anything if the state of the resource is not known on this command list
+	bool BeginTransitionBarrier(
+		D3D12Resource*		  Resource,
+		D3D12_RESOURCE_STATES State);
+
+	// Ends a split barrier begun on this command list, otherwise behaves like TransitionBarrier
+	void EndTransitionBarrier(
+		D3D12Resource*		  Resource,
+		D3D12_RESOURCE_STATES State);
+
 	void AliasingBarrier(
 		D3D12Resource* BeforeResource,
 		D3D12Resource* AfterResource);
@@ -127,6 +147,10 @@ private:
 	// Resolve resource barriers that are needed before this command list is executed
 	std::vector<D3D12_RESOURCE_BARRIER> ResolveResourceBarriers();
 
+	// Returns false if no split barrier of Resource is in flight
+	bool EndSplitBarrier(
+		D3D12Resource* Resource);
+
 private:
 	friend class D3D12CommandQueue;
 
@@ -140,4 +164,7 @@ private:
 #endif
 	D3D12ResourceStateTracker ResourceStateTracker;
 	ResourceBarrierBatch	  ResourceBarrierBatch;
+
+	// Split barriers must end on the command list they began on, outstanding ones are ended on Close
+	std::vector<SplitResourceBarrier> SplitResourceBarriers;
 };
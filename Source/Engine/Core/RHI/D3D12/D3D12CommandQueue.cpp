@@ -9,8 +9,8 @@ D3D12CommandQueue::D3D12CommandQueue(D3D12LinkedDevice* Parent, RHID3D12CommandQ
 	, Fence(Parent->GetParentDevice(), 0, D3D12_FENCE_FLAG_NONE)
 	, ResourceBarrierCommandAllocatorPool(Parent, CommandListType)
 	, ResourceBarrierCommandAllocator(ResourceBarrierCommandAllocatorPool.RequestCommandAllocator())
-	, ResourceBarrierCommandListHandle(Parent, CommandListType)
 {
+	ResourceBarrierCommandListHandles.emplace_back(Parent, CommandListType);
 #ifdef _DEBUG
 	CommandQueue->SetName(GetCommandQueueTypeString(Type));
 	Fence.Get()->SetName(GetCommandQueueTypeFenceString(Type));
@@ -67,26 +67,32 @@ UINT64 D3D12CommandQueue::InitializeTimestampFrequency()
 	return Frequency;
 }
 
-bool D3D12CommandQueue::ResolveResourceBarrierCommandList(D3D12CommandListHandle& CommandListHandle)
+D3D12CommandListHandle* D3D12CommandQueue::ResolveResourceBarrierCommandList(D3D12CommandListHandle& CommandListHandle, UINT Index)
 {
 	std::vector<D3D12_RESOURCE_BARRIER> ResourceBarriers = CommandListHandle.ResolveResourceBarriers();
-
-	bool AnyResolved = !ResourceBarriers.empty();
-	if (AnyResolved)
+	if (ResourceBarriers.empty())
 	{
-		if (!ResourceBarrierCommandAllocator)
-		{
-			ResourceBarrierCommandAllocator = ResourceBarrierCommandAllocatorPool.RequestCommandAllocator();
-		}
+		return nullptr;
+	}
 
-		ResourceBarrierCommandListHandle.Open(ResourceBarrierCommandAllocator.Get());
-		ResourceBarrierCommandListHandle->ResourceBarrier(
-			static_cast<UINT>(ResourceBarriers.size()),
-			ResourceBarriers.data());
-		ResourceBarrierCommandListHandle.Close();
+	if (!ResourceBarrierCommandAllocator)
+	{
+		ResourceBarrierCommandAllocator = ResourceBarrierCommandAllocatorPool.RequestCommandAllocator();
+	}
+	if (Index >= ResourceBarrierCommandListHandles.size())
+	{
+		ResourceBarrierCommandListHandles.emplace_back(GetParentLinkedDevice(), CommandListType);
 	}
 
-	return AnyResolved;
+	// Barrier command lists share the allocator, they are recorded one after another
+	D3D12CommandListHandle& ResourceBarrierCommandListHandle = ResourceBarrierCommandListHandles[Index];
+	ResourceBarrierCommandListHandle.Open(ResourceBarrierCommandAllocator.Get());
+	ResourceBarrierCommandListHandle->ResourceBarrier(
+		static_cast<UINT>(ResourceBarriers.size()),
+		ResourceBarriers.data());
+	ResourceBarrierCommandListHandle.Close();
+
+	return &ResourceBarrierCommandListHandle;
 }
 
 D3D12SyncHandle D3D12CommandQueue::ExecuteCommandLists(
@@ -94,22 +100,36 @@ D3D12SyncHandle D3D12CommandQueue::ExecuteCommandLists(
 	D3D12CommandListHandle* CommandListHandles,
 	bool					WaitForCompletion)
 {
+	assert(NumCommandListHandles <= 32);
+	D3D12CommandListHandle* Handles[32] = {};
+	for (UINT i = 0; i < NumCommandListHandles; ++i)
+	{
+		Handles[i] = &CommandListHandles[i];
+	}
+	return ExecuteCommandLists(std::span(Handles, NumCommandListHandles), WaitForCompletion);
+}
+
+D3D12SyncHandle D3D12CommandQueue::ExecuteCommandLists(
+	std::span<D3D12CommandListHandle* const> CommandListHandles,
+	bool									 WaitForCompletion)
+{
+	// Every command list may need a barrier command list in front of it
+	assert(CommandListHandles.size() <= 32);
+
 	UINT			   NumCommandLists		 = 0;
 	UINT			   NumBarrierCommandList = 0;
 	ID3D12CommandList* CommandLists[64]		 = {};
 
 	// Resolve resource barriers
-	for (UINT i = 0; i < NumCommandListHandles; ++i)
+	for (D3D12CommandListHandle* CommandListHandle : CommandListHandles)
 	{
-		D3D12CommandListHandle& CommandListHandle = CommandListHandles[i];
-
-		if (ResolveResourceBarrierCommandList(CommandListHandle))
+		if (D3D12CommandListHandle* BarrierCommandListHandle = ResolveResourceBarrierCommandList(*CommandListHandle, NumBarrierCommandList))
 		{
-			CommandLists[NumCommandLists++] = ResourceBarrierCommandListHandle.GetCommandList();
+			CommandLists[NumCommandLists++] = BarrierCommandListHandle->GetCommandList();
 			NumBarrierCommandList++;
 		}
 
-		CommandLists[NumCommandLists++] = CommandListHandle.GetCommandList();
+		CommandLists[NumCommandLists++] = CommandListHandle->GetCommandList();
 	}
 
 	CommandQueue->ExecuteCommandLists(NumCommandLists, CommandLists);
@@ -27,11 +27,16 @@ public:
 		D3D12CommandListHandle* CommandListHandles,
 		bool					WaitForCompletion);
 
+	// Command lists are executed in span order
+	D3D12SyncHandle ExecuteCommandLists(
+		std::span<D3D12CommandListHandle* const> CommandListHandles,
+		bool									 WaitForCompletion);
+
 private:
 	Microsoft::WRL::ComPtr<ID3D12CommandQueue> InitializeCommandQueue();
 	UINT64									   InitializeTimestampFrequency();
 
-	[[nodiscard]] bool ResolveResourceBarrierCommandList(D3D12CommandListHandle& CommandListHandle);
+	[[nodiscard]] D3D12CommandListHandle* ResolveResourceBarrierCommandList(D3D12CommandListHandle& CommandListHandle, UINT Index);
 
 private:
 	D3D12_COMMAND_LIST_TYPE					   CommandListType;
@@ -43,7 +48,8 @@ private:
 	// Command allocators used exclusively for resolving resource barriers
 	D3D12CommandAllocatorPool					   ResourceBarrierCommandAllocatorPool;
 	Microsoft::WRL::ComPtr<ID3D12CommandAllocator> ResourceBarrierCommandAllocator;
-	D3D12CommandListHandle						   ResourceBarrierCommandListHandle;
+	// One per command list in a submission, barriers of a list must execute after the preceding list
+	std::vector<D3D12CommandListHandle> ResourceBarrierCommandListHandles;
 };
 
 inline D3D12_COMMAND_LIST_TYPE RHITranslateD3D12(RHID3D12CommandQueueType Type)
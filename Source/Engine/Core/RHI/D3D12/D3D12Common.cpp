@@ -226,6 +226,12 @@ auto D3D12SyncHandle::WaitForCompletion() const -> void
 	Fence->HostWaitForValue(Value);
 }
 
+auto D3D12SyncHandle::SetEventOnCompletion(HANDLE Event) const -> void
+{
+	assert(static_cast<bool>(*this));
+	Fence->SetEventOnCompletion(Value, Event);
+}
+
 void D3D12InputLayout::AddVertexLayoutElement(
 	std::string_view SemanticName,
 	UINT			 SemanticIndex,
@@ -152,6 +152,7 @@ public:
 	[[nodiscard]] auto GetValue() const noexcept -> UINT64;
 	[[nodiscard]] auto IsComplete() const -> bool;
 	auto			   WaitForCompletion() const -> void;
+	auto			   SetEventOnCompletion(HANDLE Event) const -> void;
 
 private:
 	friend class D3D12CommandQueue;
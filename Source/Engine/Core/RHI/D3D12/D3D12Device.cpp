@@ -70,6 +70,7 @@ bool D3D12Device::AllowAsyncPsoCompilation() const noexcept
 void D3D12Device::OnBeginFrame()
 {
 	Profiler.OnBeginFrame();
+	LinkedDevice.ReleaseRetiredResources();
 }
 
 void D3D12Device::OnEndFrame()
@@ -38,6 +38,11 @@ void D3D12Fence::HostWaitForValue(UINT64 Value)
 	UpdateLastCompletedValue();
 }
 
+void D3D12Fence::SetEventOnCompletion(UINT64 Value, HANDLE Event)
+{
+	VERIFY_D3D12_API(Fence->SetEventOnCompletion(Value, Event));
+}
+
 Microsoft::WRL::ComPtr<ID3D12Fence1> D3D12Fence::InitializeFence(UINT64 InitialValue, D3D12_FENCE_FLAGS Flags)
 {
 	Microsoft::WRL::ComPtr<ID3D12Fence1> Fence;
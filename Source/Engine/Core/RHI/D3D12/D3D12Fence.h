@@ -14,6 +14,9 @@ public:
 
 	void HostWaitForValue(UINT64 Value);
 
+	// Event is set once the fence reaches Value, right away if it already has
+	void SetEventOnCompletion(UINT64 Value, HANDLE Event);
+
 private:
 	Microsoft::WRL::ComPtr<ID3D12Fence1> InitializeFence(UINT64 InitialValue, D3D12_FENCE_FLAGS Flags);
 
@@ -18,6 +18,16 @@ static ConsoleVariable CVar_GlobalSamplerHeapSize(
 	"Global Sampler Heap Size",
 	D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE);
 
+static ConsoleVariable CVar_UploadRingSize(
+	"D3D12.UploadRingSize",
+	"Size of the staging ring buffer used for resource uploads in MiB",
+	128);
+
+static ConsoleVariable CVar_NumCommandContexts(
+	"D3D12.NumCommandContexts",
+	"Number of command contexts per queue, allows recording on multiple threads",
+	4);
+
 D3D12LinkedDevice::D3D12LinkedDevice(D3D12Device* Parent)
 	: D3D12DeviceChild(Parent)
 	, GraphicsQueue(this, RHID3D12CommandQueueType::Direct)
@@ -28,13 +38,15 @@ D3D12LinkedDevice::D3D12LinkedDevice(D3D12Device* Parent)
 	, DsvAllocator(this, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, CVar_DescriptorAllocatorPageSize)
 	, ResourceDescriptorHeap(this, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, CVar_GlobalResourceViewHeapSize)
 	, SamplerDescriptorHeap(this, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, CVar_GlobalSamplerHeapSize)
+	, UploadRing(static_cast<UINT64>(std::max(static_cast<int>(CVar_UploadRingSize), 1)) << 20)
+	, UploadStats(UploadRing.GetStats())
 {
 #if _DEBUG
 	ResourceDescriptorHeap.SetName(L"Resource Descriptor Heap");
 	SamplerDescriptorHeap.SetName(L"Sampler Descriptor Heap");
 #endif
 	using enum RHID3D12CommandQueueType;
-	constexpr size_t NumThreads = 1;
+	const size_t NumThreads = std::max(static_cast<int>(CVar_NumCommandContexts), 1);
 	AvailableCommandContexts.reserve(NumThreads);
 	for (unsigned int i = 0; i < NumThreads; ++i)
 	{
@@ -47,6 +59,23 @@ D3D12LinkedDevice::D3D12LinkedDevice(D3D12Device* Parent)
 	}
 	CopyContext1 = std::make_unique<D3D12CommandContext>(this, Copy1, D3D12_COMMAND_LIST_TYPE_COPY);
 	CopyContext2 = std::make_unique<D3D12CommandContext>(this, Copy2, D3D12_COMMAND_LIST_TYPE_COPY);
+
+	D3D12_HEAP_PROPERTIES HeapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	D3D12_RESOURCE_DESC	  ResourceDesc	 = CD3DX12_RESOURCE_DESC::Buffer(UploadRing.GetCapacity());
+	VERIFY_D3D12_API(GetDevice()->CreateCommittedResource(
+		&HeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&ResourceDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(UploadRingResource.ReleaseAndGetAddressOf())));
+#if _DEBUG
+	UploadRingResource->SetName(L"Upload Ring Buffer");
+#endif
+
+	// Buffer uploads are copied in directly, UpdateSubresources maps the ring on its own
+	D3D12_RANGE ReadRange = { 0, 0 };
+	VERIFY_D3D12_API(UploadRingResource->Map(0, &ReadRange, reinterpret_cast<void**>(&UploadRingCpuVirtualAddress)));
 }
 
 D3D12LinkedDevice::~D3D12LinkedDevice()
@@ -123,6 +152,11 @@ D3D12CommandContext& D3D12LinkedDevice::GetCommandContext(UINT ThreadIndex /*= 0
 	return *AvailableCommandContexts[ThreadIndex];
 }
 
+UINT D3D12LinkedDevice::GetNumCommandContexts() const noexcept
+{
+	return static_cast<UINT>(AvailableCommandContexts.size());
+}
+
 D3D12CommandContext& D3D12LinkedDevice::GetAsyncComputeCommandContext(UINT ThreadIndex /*= 0*/)
 {
 	assert(ThreadIndex < AvailableAsyncCommandContexts.size());
@@ -142,12 +176,38 @@ void D3D12LinkedDevice::WaitIdle()
 	CopyQueue2.WaitIdle();
 }
 
+void D3D12LinkedDevice::Retire(ComPtr<ID3D12Resource> Resource)
+{
+	if (!Resource)
+	{
+		return;
+	}
+
+	RetiredResources.push_back({ .Resource				 = std::move(Resource),
+								 .GraphicsFenceValue	 = GraphicsQueue.Signal(),
+								 .AsyncComputeFenceValue = AsyncComputeQueue.Signal(),
+								 .CopyFenceValue		 = CopyQueue1.Signal() });
+}
+
+void D3D12LinkedDevice::ReleaseRetiredResources()
+{
+	std::erase_if(
+		RetiredResources,
+		[this](const RetiredResource& Retired)
+		{
+			return GraphicsQueue.IsFenceComplete(Retired.GraphicsFenceValue) &&
+				   AsyncComputeQueue.IsFenceComplete(Retired.AsyncComputeFenceValue) &&
+				   CopyQueue1.IsFenceComplete(Retired.CopyFenceValue);
+		});
+}
+
 void D3D12LinkedDevice::BeginResourceUpload()
 {
 	if (UploadSyncHandle && UploadSyncHandle.IsComplete())
 	{
 		TrackedResources.clear();
 	}
+	ReleaseCompletedUploads();
 
 	CopyContext2->Open();
 }
@@ -156,15 +216,43 @@ D3D12SyncHandle D3D12LinkedDevice::EndResourceUpload(bool WaitForCompletion)
 {
 	CopyContext2->Close();
 	UploadSyncHandle = CopyContext2->Execute(WaitForCompletion);
+	UploadRing.Submit(UploadSyncHandle.GetValue());
+	PublishUploadStats();
 	return UploadSyncHandle;
 }
 
-void D3D12LinkedDevice::Upload(const std::vector<D3D12_SUBRESOURCE_DATA>& Subresources, ID3D12Resource* Resource)
+void D3D12LinkedDevice::Upload(const std::vector<D3D12_SUBRESOURCE_DATA>& Subresources, ID3D12Resource* Resource, UINT FirstSubresource /*= 0*/)
+{
+	UploadSubresources(Subresources, Resource, FirstSubresource);
+}
+
+void D3D12LinkedDevice::Upload(const D3D12_SUBRESOURCE_DATA& Subresource, ID3D12Resource* Resource, UINT FirstSubresource /*= 0*/)
 {
-	auto				   NumSubresources = static_cast<UINT>(Subresources.size());
-	UINT64				   UploadSize	   = GetRequiredIntermediateSize(Resource, 0, NumSubresources);
-	D3D12_HEAP_PROPERTIES  HeapProperties  = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC	   ResourceDesc	   = CD3DX12_RESOURCE_DESC::Buffer(UploadSize);
+	UploadSubresources({ &Subresource, 1 }, Resource, FirstSubresource);
+}
+
+void D3D12LinkedDevice::UploadSubresources(std::span<const D3D12_SUBRESOURCE_DATA> Subresources, ID3D12Resource* Resource, UINT FirstSubresource)
+{
+	auto   NumSubresources = static_cast<UINT>(Subresources.size());
+	UINT64 UploadSize	   = GetRequiredIntermediateSize(Resource, FirstSubresource, NumSubresources);
+
+	if (UploadSize <= UploadRing.GetCapacity())
+	{
+		UINT64 Offset = AllocateUploadMemory(UploadSize);
+		UpdateSubresources(
+			CopyContext2->GetGraphicsCommandList(),
+			Resource,
+			UploadRingResource.Get(),
+			Offset,
+			FirstSubresource,
+			NumSubresources,
+			Subresources.data());
+		return;
+	}
+
+	// Larger than the whole ring, staged in its own resource that is released once the upload completes
+	D3D12_HEAP_PROPERTIES  HeapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	D3D12_RESOURCE_DESC	   ResourceDesc	  = CD3DX12_RESOURCE_DESC::Buffer(UploadSize);
 	ComPtr<ID3D12Resource> UploadResource;
 	VERIFY_D3D12_API(GetDevice()->CreateCommittedResource(
 		&HeapProperties,
@@ -179,18 +267,31 @@ void D3D12LinkedDevice::Upload(const std::vector<D3D12_SUBRESOURCE_DATA>& Subres
 		Resource,
 		UploadResource.Get(),
 		0,
-		0,
+		FirstSubresource,
 		NumSubresources,
 		Subresources.data());
 
 	TrackedResources.push_back(std::move(UploadResource));
 }
 
-void D3D12LinkedDevice::Upload(const D3D12_SUBRESOURCE_DATA& Subresource, ID3D12Resource* Resource)
+void D3D12LinkedDevice::UploadBuffer(const void* Data, UINT64 SizeInBytes, ID3D12Resource* Resource, UINT64 Offset)
 {
-	UINT64				   UploadSize	  = GetRequiredIntermediateSize(Resource, 0, 1);
+	if (SizeInBytes == 0)
+	{
+		return;
+	}
+
+	if (SizeInBytes <= UploadRing.GetCapacity())
+	{
+		UINT64 UploadOffset = AllocateUploadMemory(SizeInBytes);
+		std::memcpy(UploadRingCpuVirtualAddress + UploadOffset, Data, SizeInBytes);
+		CopyContext2->GetGraphicsCommandList()->CopyBufferRegion(Resource, Offset, UploadRingResource.Get(), UploadOffset, SizeInBytes);
+		return;
+	}
+
+	// Larger than the whole ring, staged in its own resource that is released once the upload completes
 	D3D12_HEAP_PROPERTIES  HeapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-	D3D12_RESOURCE_DESC	   ResourceDesc	  = CD3DX12_RESOURCE_DESC::Buffer(UploadSize);
+	D3D12_RESOURCE_DESC	   ResourceDesc	  = CD3DX12_RESOURCE_DESC::Buffer(SizeInBytes);
 	ComPtr<ID3D12Resource> UploadResource;
 	VERIFY_D3D12_API(GetDevice()->CreateCommittedResource(
 		&HeapProperties,
@@ -200,14 +301,67 @@ void D3D12LinkedDevice::Upload(const D3D12_SUBRESOURCE_DATA& Subresource, ID3D12
 		nullptr,
 		IID_PPV_ARGS(UploadResource.ReleaseAndGetAddressOf())));
 
-	UpdateSubresources<1>(
-		CopyContext2->GetGraphicsCommandList(),
-		Resource,
-		UploadResource.Get(),
-		0,
-		0,
-		1,
-		&Subresource);
+	D3D12_RANGE ReadRange = { 0, 0 };
+	void*		CpuVirtualAddress;
+	VERIFY_D3D12_API(UploadResource->Map(0, &ReadRange, &CpuVirtualAddress));
+	std::memcpy(CpuVirtualAddress, Data, SizeInBytes);
+	UploadResource->Unmap(0, nullptr);
+
+	CopyContext2->GetGraphicsCommandList()->CopyBufferRegion(Resource, Offset, UploadResource.Get(), 0, SizeInBytes);
 
 	TrackedResources.push_back(std::move(UploadResource));
 }
+
+void D3D12LinkedDevice::CopySubresource(ID3D12Resource* Resource, UINT Subresource, ID3D12Resource* Source, UINT SourceSubresource)
+{
+	CD3DX12_TEXTURE_COPY_LOCATION Dst(Resource, Subresource);
+	CD3DX12_TEXTURE_COPY_LOCATION Src(Source, SourceSubresource);
+	CopyContext2->GetGraphicsCommandList()->CopyTextureRegion(&Dst, 0, 0, 0, &Src, nullptr);
+}
+
+UINT64 D3D12LinkedDevice::AllocateUploadMemory(UINT64 Size)
+{
+	std::optional<UINT64> Offset;
+	while (!(Offset = UploadRing.Allocate(Size, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT)))
+	{
+		UploadRing.RecordStall();
+		if (std::optional<UINT64> FenceValue = UploadRing.GetOldestFenceValue())
+		{
+			CopyQueue2.HostWaitForValue(*FenceValue);
+			UploadRing.Release(*FenceValue);
+		}
+		else
+		{
+			// The uploads recorded since BeginResourceUpload fill the ring, submit them before recording more
+			EndResourceUpload(true);
+			BeginResourceUpload();
+		}
+	}
+	PublishUploadStats();
+	return *Offset;
+}
+
+void D3D12LinkedDevice::ReleaseCompletedUploads()
+{
+	while (std::optional<UINT64> FenceValue = UploadRing.GetOldestFenceValue())
+	{
+		if (!CopyQueue2.IsFenceComplete(*FenceValue))
+		{
+			break;
+		}
+		UploadRing.Release(*FenceValue);
+	}
+	PublishUploadStats();
+}
+
+void D3D12LinkedDevice::PublishUploadStats()
+{
+	std::scoped_lock Lock(UploadStatsMutex);
+	UploadStats = UploadRing.GetStats();
+}
+
+RingAllocatorStats D3D12LinkedDevice::GetUploadStats() const
+{
+	std::scoped_lock Lock(UploadStatsMutex);
+	return UploadStats;
+}
@@ -3,6 +3,7 @@
 #include "D3D12DescriptorHeap.h"
 #include "D3D12CommandQueue.h"
 #include "D3D12CommandContext.h"
+#include "Core/RHI/RingAllocator.h"
 
 class D3D12LinkedDevice : public D3D12DeviceChild
 {
@@ -26,6 +27,7 @@ public:
 	template<> D3D12DescriptorHeap& GetDescriptorHeap<D3D12_UNORDERED_ACCESS_VIEW_DESC>() noexcept { return ResourceDescriptorHeap; }
 	// clang-format on
 	[[nodiscard]] D3D12CommandContext& GetCommandContext(UINT ThreadIndex = 0);
+	[[nodiscard]] UINT				   GetNumCommandContexts() const noexcept;
 	[[nodiscard]] D3D12CommandContext& GetAsyncComputeCommandContext(UINT ThreadIndex = 0);
 	[[nodiscard]] D3D12CommandContext& GetCopyContext1();
 
@@ -34,10 +36,42 @@ public:
 	void			BeginResourceUpload();
 	D3D12SyncHandle EndResourceUpload(bool WaitForCompletion);
 
-	void Upload(const std::vector<D3D12_SUBRESOURCE_DATA>& Subresources, ID3D12Resource* Resource);
-	void Upload(const D3D12_SUBRESOURCE_DATA& Subresource, ID3D12Resource* Resource);
+	// Staged in a persistent ring buffer, an upload that does not fit waits for older uploads to complete
+	void Upload(const std::vector<D3D12_SUBRESOURCE_DATA>& Subresources, ID3D12Resource* Resource, UINT FirstSubresource = 0);
+	void Upload(const D3D12_SUBRESOURCE_DATA& Subresource, ID3D12Resource* Resource, UINT FirstSubresource = 0);
+	// Copies SizeInBytes bytes to Offset in the buffer Resource, the rest of the buffer is left as is
+	void UploadBuffer(const void* Data, UINT64 SizeInBytes, ID3D12Resource* Resource, UINT64 Offset);
+	// Copies a subresource between textures of the same format and size on the gpu, nothing is staged
+	void CopySubresource(ID3D12Resource* Resource, UINT Subresource, ID3D12Resource* Source, UINT SourceSubresource);
+
+	// Stats of the upload ring as of the last upload, can be called from any thread
+	[[nodiscard]] RingAllocatorStats GetUploadStats() const;
+
+	// Keeps Resource alive until the work submitted so far on every queue has completed,
+	// used when a resource is replaced (e.g. a buffer that grows) while the gpu may still read it
+	void Retire(Microsoft::WRL::ComPtr<ID3D12Resource> Resource);
+
+	// Called once per frame, releases retired resources whose fences have completed
+	void ReleaseRetiredResources();
 
 private:
+	void UploadSubresources(std::span<const D3D12_SUBRESOURCE_DATA> Subresources, ID3D12Resource* Resource, UINT FirstSubresource);
+
+	[[nodiscard]] UINT64 AllocateUploadMemory(UINT64 Size);
+
+	void ReleaseCompletedUploads();
+
+	void PublishUploadStats();
+
+private:
+	struct RetiredResource
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+		UINT64								   GraphicsFenceValue;
+		UINT64								   AsyncComputeFenceValue;
+		UINT64								   CopyFenceValue;
+	};
+
 	D3D12CommandQueue GraphicsQueue;
 	D3D12CommandQueue AsyncComputeQueue;
 	D3D12CommandQueue CopyQueue1;
@@ -54,5 +88,14 @@ private:
 	std::unique_ptr<D3D12CommandContext>			  CopyContext2;
 
 	D3D12SyncHandle										UploadSyncHandle;
-	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> TrackedResources;
+	Microsoft::WRL::ComPtr<ID3D12Resource>				UploadRingResource;
+	BYTE*												UploadRingCpuVirtualAddress = nullptr;
+	RingAllocator										UploadRing;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> TrackedResources; // Uploads larger than the ring
+
+	// Copy of the ring's stats, the ring itself is only touched by the thread that uploads
+	mutable std::mutex UploadStatsMutex;
+	RingAllocatorStats UploadStats;
+
+	std::vector<RetiredResource> RetiredResources;
 };
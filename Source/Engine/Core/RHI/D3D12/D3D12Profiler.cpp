@@ -1,7 +1,8 @@
 #include "D3D12Profiler.h"
 
-D3D12EventNode	D3D12EventGraph::RootNode	 = D3D12EventNode(-1, "", nullptr);
-D3D12EventNode* D3D12EventGraph::CurrentNode = &D3D12EventGraph::RootNode;
+Mutex						 D3D12EventGraph::Lock;
+D3D12EventNode				 D3D12EventGraph::RootNode	  = D3D12EventNode(-1, "", nullptr);
+thread_local D3D12EventNode* D3D12EventGraph::CurrentNode = &D3D12EventGraph::RootNode;
 
 static D3D12Profiler* g_Profiler = nullptr;
 
@@ -82,19 +82,27 @@ class D3D12EventGraph
 public:
 	static void PushEventNode(const std::string& Name, ID3D12GraphicsCommandList* CommandList)
 	{
+		MutexGuard Guard(Lock);
 		CurrentNode = CurrentNode->GetChild(Name);
 		CurrentNode->StartTiming(CommandList);
 	}
 
 	static void PopEventNode(ID3D12GraphicsCommandList* CommandList)
 	{
+		MutexGuard Guard(Lock);
 		CurrentNode->EndTiming(CommandList);
 		CurrentNode = CurrentNode->Parent;
 	}
 
+	// Each thread tracks its own current node, threads recording on behalf of another thread
+	// adopt its current node so their events nest under it
+	[[nodiscard]] static D3D12EventNode* GetCurrentNode() noexcept { return CurrentNode; }
+	static void							 SetCurrentNode(D3D12EventNode* Node) noexcept { CurrentNode = Node; }
+
 private:
-	static D3D12EventNode  RootNode;
-	static D3D12EventNode* CurrentNode;
+	static Mutex						Lock;
+	static D3D12EventNode				RootNode;
+	static thread_local D3D12EventNode* CurrentNode;
 };
 
 class D3D12Profiler
@@ -79,6 +79,24 @@ D3D12Resource::D3D12Resource(
 	ResourceState.SetSubresourceState(D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, InitialResourceState);
 }
 
+D3D12Resource::D3D12Resource(
+	D3D12LinkedDevice*				 Parent,
+	ID3D12Heap*						 Heap,
+	UINT64							 HeapOffset,
+	D3D12_RESOURCE_DESC				 Desc,
+	D3D12_RESOURCE_STATES			 InitialResourceState,
+	std::optional<D3D12_CLEAR_VALUE> ClearValue)
+	: D3D12LinkedDeviceChild(Parent)
+	, Resource(InitializePlacedResource(Heap, HeapOffset, Desc, InitialResourceState, ClearValue))
+	, ClearValue(ClearValue)
+	, Desc(Resource->GetDesc())
+	, PlaneCount(D3D12GetFormatPlaneCount(Parent->GetDevice(), Desc.Format))
+	, NumSubresources(CalculateNumSubresources())
+	, ResourceState(NumSubresources)
+{
+	ResourceState.SetSubresourceState(D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, InitialResourceState);
+}
+
 Microsoft::WRL::ComPtr<ID3D12Resource> D3D12Resource::InitializeResource(
 	D3D12_HEAP_PROPERTIES			 HeapProperties,
 	D3D12_RESOURCE_DESC				 Desc,
@@ -98,6 +116,26 @@ Microsoft::WRL::ComPtr<ID3D12Resource> D3D12Resource::InitializeResource(
 	return Resource;
 }
 
+Microsoft::WRL::ComPtr<ID3D12Resource> D3D12Resource::InitializePlacedResource(
+	ID3D12Heap*						 Heap,
+	UINT64							 HeapOffset,
+	D3D12_RESOURCE_DESC				 Desc,
+	D3D12_RESOURCE_STATES			 InitialResourceState,
+	std::optional<D3D12_CLEAR_VALUE> ClearValue)
+{
+	D3D12_CLEAR_VALUE* OptimizedClearValue = ClearValue.has_value() ? &(*ClearValue) : nullptr;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> Resource;
+	VERIFY_D3D12_API(Parent->GetDevice()->CreatePlacedResource(
+		Heap,
+		HeapOffset,
+		&Desc,
+		InitialResourceState,
+		OptimizedClearValue,
+		IID_PPV_ARGS(Resource.ReleaseAndGetAddressOf())));
+	return Resource;
+}
+
 UINT D3D12Resource::CalculateNumSubresources()
 {
 	if (Desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER)
@@ -186,6 +224,23 @@ D3D12Texture::D3D12Texture(
 	// Textures can only be in device local heap
 }
 
+D3D12Texture::D3D12Texture(
+	D3D12LinkedDevice*				 Parent,
+	ID3D12Heap*						 Heap,
+	UINT64							 HeapOffset,
+	const D3D12_RESOURCE_DESC&		 Desc,
+	std::optional<D3D12_CLEAR_VALUE> ClearValue /*= std::nullopt*/)
+	: D3D12Resource(
+		  Parent,
+		  Heap,
+		  HeapOffset,
+		  Desc,
+		  ResourceStateDeterminer(Desc, D3D12_HEAP_TYPE_DEFAULT).InferInitialState(),
+		  ClearValue)
+{
+	// Heap is expected to be a device local heap
+}
+
 UINT D3D12Texture::GetSubresourceIndex(
 	std::optional<UINT> OptArraySlice /*= std::nullopt*/,
 	std::optional<UINT> OptMipSlice /*= std::nullopt*/,
@@ -11,6 +11,14 @@ public:
 		D3D12_RESOURCE_DESC				 Desc,
 		D3D12_RESOURCE_STATES			 InitialResourceState,
 		std::optional<D3D12_CLEAR_VALUE> ClearValue);
+	// Placed resource, memory is owned by Heap
+	D3D12Resource(
+		D3D12LinkedDevice*				 Parent,
+		ID3D12Heap*						 Heap,
+		UINT64							 HeapOffset,
+		D3D12_RESOURCE_DESC				 Desc,
+		D3D12_RESOURCE_STATES			 InitialResourceState,
+		std::optional<D3D12_CLEAR_VALUE> ClearValue);
 
 	[[nodiscard]] ID3D12Resource*			 GetResource() const { return Resource.Get(); }
 	[[nodiscard]] D3D12_CLEAR_VALUE			 GetClearValue() const noexcept { return ClearValue.has_value() ? *ClearValue : D3D12_CLEAR_VALUE{}; }
@@ -28,6 +36,13 @@ private:
 		D3D12_RESOURCE_STATES			 InitialResourceState,
 		std::optional<D3D12_CLEAR_VALUE> ClearValue);
 
+	Microsoft::WRL::ComPtr<ID3D12Resource> InitializePlacedResource(
+		ID3D12Heap*						 Heap,
+		UINT64							 HeapOffset,
+		D3D12_RESOURCE_DESC				 Desc,
+		D3D12_RESOURCE_STATES			 InitialResourceState,
+		std::optional<D3D12_CLEAR_VALUE> ClearValue);
+
 	UINT CalculateNumSubresources();
 
 protected:
@@ -115,6 +130,12 @@ public:
 		const D3D12_RESOURCE_DESC&		 Desc,
 		std::optional<D3D12_CLEAR_VALUE> ClearValue = std::nullopt,
 		bool							 Cubemap	= false);
+	D3D12Texture(
+		D3D12LinkedDevice*				 Parent,
+		ID3D12Heap*						 Heap,
+		UINT64							 HeapOffset,
+		const D3D12_RESOURCE_DESC&		 Desc,
+		std::optional<D3D12_CLEAR_VALUE> ClearValue = std::nullopt);
 
 	[[nodiscard]] UINT GetSubresourceIndex(
 		std::optional<UINT> OptArraySlice = std::nullopt,
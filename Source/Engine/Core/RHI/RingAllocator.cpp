@@ -0,0 +1,91 @@
+#include "RingAllocator.h"
+
+RingAllocator::RingAllocator(UINT64 Capacity)
+	: Capacity(Capacity)
+{
+	Stats.CapacityInBytes = Capacity;
+}
+
+std::optional<UINT64> RingAllocator::Allocate(UINT64 Size, UINT64 Alignment)
+{
+	if (Size == 0 || Size > Capacity)
+	{
+		return std::nullopt;
+	}
+
+	// Nothing is allocated, start over so the whole ring is contiguous
+	if (Used == 0)
+	{
+		Head = 0;
+		Tail = 0;
+	}
+
+	UINT64 Offset = AlignUp(Head, Alignment);
+	UINT64 Padding;
+	if (Used > 0 && Head <= Tail)
+	{
+		// The head caught up with the tail, the only free space is in between
+		if (Offset + Size > Tail)
+		{
+			return std::nullopt;
+		}
+		Padding = Offset - Head;
+	}
+	else if (Offset + Size <= Capacity)
+	{
+		Padding = Offset - Head;
+	}
+	else if (Size <= Tail)
+	{
+		// The end of the ring is too small, it is skipped and freed together with this allocation
+		Padding = Capacity - Head;
+		Offset	= 0;
+		++Stats.NumWraparounds;
+	}
+	else
+	{
+		return std::nullopt;
+	}
+
+	Head = Offset + Size;
+	Used += Padding + Size;
+	PendingSize += Padding + Size;
+
+	Stats.UsedInBytes = Used;
+	Stats.StagedInBytes += Size;
+	++Stats.NumAllocations;
+	return Offset;
+}
+
+void RingAllocator::Submit(UINT64 FenceValue)
+{
+	if (PendingSize == 0)
+	{
+		return;
+	}
+
+	assert(Batches.empty() || Batches.back().FenceValue <= FenceValue);
+	Batches.push({ FenceValue, Head, PendingSize });
+	PendingSize = 0;
+}
+
+void RingAllocator::Release(UINT64 CompletedFenceValue)
+{
+	while (!Batches.empty() && Batches.front().FenceValue <= CompletedFenceValue)
+	{
+		Tail = Batches.front().End;
+		Used -= Batches.front().Size;
+		Batches.pop();
+	}
+
+	Stats.UsedInBytes = Used;
+}
+
+std::optional<UINT64> RingAllocator::GetOldestFenceValue() const
+{
+	if (Batches.empty())
+	{
+		return std::nullopt;
+	}
+	return Batches.front().FenceValue;
+}
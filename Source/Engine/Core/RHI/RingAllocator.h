@@ -0,0 +1,57 @@
+#pragma once
+
+struct RingAllocatorStats
+{
+	UINT64 CapacityInBytes = 0;
+	UINT64 UsedInBytes	   = 0; // Including alignment padding and the end of the ring skipped by a wraparound
+	UINT64 StagedInBytes   = 0; // Since initialization
+	UINT64 NumAllocations  = 0;
+	UINT64 NumStalls	   = 0; // Times the owner had to wait for the gpu before an allocation fit
+	UINT64 NumWraparounds  = 0;
+};
+
+// Suballocates a fixed size buffer front to back and wraps around to its start. Allocations made between two calls to
+// Submit form a batch that is freed once its fence value has completed, so the space is reused while later batches are
+// still in flight. The owner maps the offsets into a resource and supplies the fence values
+class RingAllocator
+{
+public:
+	explicit RingAllocator(UINT64 Capacity);
+
+	[[nodiscard]] UINT64 GetCapacity() const noexcept { return Capacity; }
+
+	// Returns the offset of the allocation, std::nullopt if it does not fit until older batches are released.
+	// Allocations larger than the capacity never fit
+	[[nodiscard]] std::optional<UINT64> Allocate(UINT64 Size, UINT64 Alignment);
+
+	// Closes the current batch, it is freed by the first Release with a value of at least FenceValue
+	void Submit(UINT64 FenceValue);
+
+	// Frees every submitted batch whose fence value is at most CompletedFenceValue
+	void Release(UINT64 CompletedFenceValue);
+
+	// Fence value of the oldest submitted batch, waiting for it is the least that frees space
+	[[nodiscard]] std::optional<UINT64> GetOldestFenceValue() const;
+
+	void RecordStall() noexcept { ++Stats.NumStalls; }
+
+	[[nodiscard]] const RingAllocatorStats& GetStats() const noexcept { return Stats; }
+
+private:
+	struct Batch
+	{
+		UINT64 FenceValue;
+		UINT64 End;	 // Tail once the batch is freed
+		UINT64 Size; // Bytes the batch occupies, including padding
+	};
+
+private:
+	UINT64 Capacity;
+	UINT64 Head		   = 0; // Next allocation
+	UINT64 Tail		   = 0; // Start of the oldest batch that is not freed
+	UINT64 Used		   = 0;
+	UINT64 PendingSize = 0; // Allocated since the last Submit
+
+	std::queue<Batch>  Batches;
+	RingAllocatorStats Stats;
+};
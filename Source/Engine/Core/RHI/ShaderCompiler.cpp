@@ -65,26 +65,31 @@ Shader ShaderCompiler::CompileShader(
 {
 	std::wstring ProfileString = ShaderProfileString(ShaderType);
 
-	std::vector<DxcDefine> Defines;
-	Defines.reserve(Options.Defines.size());
-	for (const auto& Define : Options.Defines)
-	{
-		Defines.emplace_back(Define.first.data(), Define.second.data());
-	}
-
-	ShaderCompilationResult Result = Compile(Path, Options.EntryPoint, ProfileString.data(), Defines);
+	ShaderCompilationResult Result = Compile(Path, Options.EntryPoint, ProfileString.data(), GetDefines(Options));
 	return { ShaderType, Result };
 }
 
 Library ShaderCompiler::CompileLibrary(
-	const std::filesystem::path& Path) const
+	const std::filesystem::path& Path,
+	const ShaderCompileOptions&	 Options) const
 {
 	std::wstring ProfileString = LibraryProfileString();
 
-	ShaderCompilationResult Result = Compile(Path, L"", ProfileString.data(), {});
+	ShaderCompilationResult Result = Compile(Path, L"", ProfileString.data(), GetDefines(Options));
 	return { Result };
 }
 
+std::vector<DxcDefine> ShaderCompiler::GetDefines(const ShaderCompileOptions& Options)
+{
+	std::vector<DxcDefine> Defines;
+	Defines.reserve(Options.Defines.size());
+	for (const auto& Define : Options.Defines)
+	{
+		Defines.emplace_back(Define.first.data(), Define.second.data());
+	}
+	return Defines;
+}
+
 std::wstring ShaderCompiler::GetShaderModelString() const
 {
 	std::wstring ShaderModelString;
@@ -133,7 +133,8 @@ public:
 		const ShaderCompileOptions&	 Options) const;
 
 	[[nodiscard]] Library CompileLibrary(
-		const std::filesystem::path& Path) const;
+		const std::filesystem::path& Path,
+		const ShaderCompileOptions&	 Options) const;
 
 private:
 	[[nodiscard]] std::wstring GetShaderModelString() const;
@@ -142,6 +143,8 @@ private:
 
 	[[nodiscard]] std::wstring LibraryProfileString() const;
 
+	[[nodiscard]] static std::vector<DxcDefine> GetDefines(const ShaderCompileOptions& Options);
+
 	[[nodiscard]] ShaderCompilationResult Compile(
 		const std::filesystem::path&  Path,
 		std::wstring_view			  EntryPoint,
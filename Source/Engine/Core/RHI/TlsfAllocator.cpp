@@ -0,0 +1,241 @@
+#include "TlsfAllocator.h"
+#include <bit>
+
+TlsfAllocator::TlsfAllocator(UINT64 Capacity)
+	: Capacity(AlignDown(Capacity, Granularity))
+{
+	FreeLists.fill(NullNode);
+
+	if (this->Capacity > 0)
+	{
+		UINT Index = CreateNode(0, this->Capacity / Granularity);
+		InsertFreeNode(Index);
+	}
+}
+
+std::optional<TlsfAllocation> TlsfAllocator::Allocate(UINT64 Size)
+{
+	if (Size == 0 || Size > Capacity)
+	{
+		return std::nullopt;
+	}
+
+	UINT64 Granules = AlignUp(Size, Granularity) / Granularity;
+	UINT   Index	= FindFreeNode(Granules);
+	if (Index == NullNode)
+	{
+		return std::nullopt;
+	}
+	RemoveFreeNode(Index);
+
+	// The rest of the block stays free right after the allocation
+	if (Nodes[Index].Size > Granules)
+	{
+		UINT Remainder = CreateNode(Nodes[Index].Offset + Granules, Nodes[Index].Size - Granules);
+
+		Nodes[Remainder].PrevPhysical = Index;
+		Nodes[Remainder].NextPhysical = Nodes[Index].NextPhysical;
+		if (Nodes[Index].NextPhysical != NullNode)
+		{
+			Nodes[Nodes[Index].NextPhysical].PrevPhysical = Remainder;
+		}
+		Nodes[Index].NextPhysical = Remainder;
+		Nodes[Index].Size		  = Granules;
+
+		InsertFreeNode(Remainder);
+	}
+
+	Nodes[Index].Free = false;
+	UsedSize += Granules;
+	++NumAllocations;
+	return TlsfAllocation{ Nodes[Index].Offset * Granularity, Size, Index };
+}
+
+void TlsfAllocator::Free(UINT Index)
+{
+	assert(Index < Nodes.size() && !Nodes[Index].Free);
+
+	UsedSize -= Nodes[Index].Size;
+	--NumAllocations;
+
+	// Merge with the free neighbours, the merged block keeps the lowest node
+	if (UINT Next = Nodes[Index].NextPhysical; Next != NullNode && Nodes[Next].Free)
+	{
+		RemoveFreeNode(Next);
+		Nodes[Index].Size += Nodes[Next].Size;
+		Nodes[Index].NextPhysical = Nodes[Next].NextPhysical;
+		if (Nodes[Next].NextPhysical != NullNode)
+		{
+			Nodes[Nodes[Next].NextPhysical].PrevPhysical = Index;
+		}
+		DestroyNode(Next);
+	}
+	if (UINT Prev = Nodes[Index].PrevPhysical; Prev != NullNode && Nodes[Prev].Free)
+	{
+		RemoveFreeNode(Prev);
+		Nodes[Prev].Size += Nodes[Index].Size;
+		Nodes[Prev].NextPhysical = Nodes[Index].NextPhysical;
+		if (Nodes[Index].NextPhysical != NullNode)
+		{
+			Nodes[Nodes[Index].NextPhysical].PrevPhysical = Prev;
+		}
+		DestroyNode(Index);
+		Index = Prev;
+	}
+
+	InsertFreeNode(Index);
+}
+
+TlsfAllocatorStats TlsfAllocator::GetStats() const
+{
+	TlsfAllocatorStats Stats = {};
+	Stats.CapacityInBytes	 = Capacity;
+	Stats.UsedInBytes		 = UsedSize * Granularity;
+	Stats.NumAllocations	 = NumAllocations;
+	Stats.NumFreeBlocks		 = static_cast<UINT>(Nodes.size() - UnusedNodes.size()) - NumAllocations;
+
+	// The largest free block is in the highest non empty size class
+	if (FirstLevelBitmap != 0)
+	{
+		UINT FirstLevel	 = static_cast<UINT>(std::bit_width(FirstLevelBitmap) - 1);
+		UINT SecondLevel = static_cast<UINT>(std::bit_width(SecondLevelBitmaps[FirstLevel]) - 1);
+		for (UINT Index = FreeLists[FirstLevel * SecondLevelCount + SecondLevel]; Index != NullNode; Index = Nodes[Index].NextFree)
+		{
+			Stats.LargestFreeInBytes = std::max(Stats.LargestFreeInBytes, Nodes[Index].Size * Granularity);
+		}
+	}
+
+	UINT64 FreeSize = Capacity - Stats.UsedInBytes;
+	Stats.Fragmentation =
+		FreeSize > 0 ? 1.0f - static_cast<float>(Stats.LargestFreeInBytes) / static_cast<float>(FreeSize) : 0.0f;
+	return Stats;
+}
+
+void TlsfAllocator::GetSizeClass(UINT64 Size, UINT& FirstLevel, UINT& SecondLevel)
+{
+	// Sizes below SecondLevelCount have a class each
+	if (Size < SecondLevelCount)
+	{
+		FirstLevel	= 0;
+		SecondLevel = static_cast<UINT>(Size);
+		return;
+	}
+
+	UINT Log2	= static_cast<UINT>(std::bit_width(Size) - 1);
+	FirstLevel	= Log2 - SecondLevelLog2 + 1;
+	SecondLevel = static_cast<UINT>(Size >> (Log2 - SecondLevelLog2)) - SecondLevelCount;
+}
+
+UINT TlsfAllocator::CreateNode(UINT64 Offset, UINT64 Size)
+{
+	UINT Index;
+	if (!UnusedNodes.empty())
+	{
+		Index = UnusedNodes.back();
+		UnusedNodes.pop_back();
+	}
+	else
+	{
+		Index = static_cast<UINT>(Nodes.size());
+		Nodes.emplace_back();
+	}
+
+	Nodes[Index] = { Offset, Size, NullNode, NullNode, NullNode, NullNode, false };
+	return Index;
+}
+
+void TlsfAllocator::DestroyNode(UINT Index)
+{
+	UnusedNodes.push_back(Index);
+}
+
+void TlsfAllocator::InsertFreeNode(UINT Index)
+{
+	UINT FirstLevel, SecondLevel;
+	GetSizeClass(Nodes[Index].Size, FirstLevel, SecondLevel);
+
+	UINT& Head			  = FreeLists[FirstLevel * SecondLevelCount + SecondLevel];
+	Nodes[Index].Free	  = true;
+	Nodes[Index].PrevFree = NullNode;
+	Nodes[Index].NextFree = Head;
+	if (Head != NullNode)
+	{
+		Nodes[Head].PrevFree = Index;
+	}
+	Head = Index;
+
+	FirstLevelBitmap |= 1ull << FirstLevel;
+	SecondLevelBitmaps[FirstLevel] |= 1u << SecondLevel;
+}
+
+void TlsfAllocator::RemoveFreeNode(UINT Index)
+{
+	UINT FirstLevel, SecondLevel;
+	GetSizeClass(Nodes[Index].Size, FirstLevel, SecondLevel);
+
+	const Node& Node = Nodes[Index];
+	if (Node.PrevFree != NullNode)
+	{
+		Nodes[Node.PrevFree].NextFree = Node.NextFree;
+	}
+	else
+	{
+		FreeLists[FirstLevel * SecondLevelCount + SecondLevel] = Node.NextFree;
+	}
+	if (Node.NextFree != NullNode)
+	{
+		Nodes[Node.NextFree].PrevFree = Node.PrevFree;
+	}
+
+	if (FreeLists[FirstLevel * SecondLevelCount + SecondLevel] == NullNode)
+	{
+		SecondLevelBitmaps[FirstLevel] &= ~(1u << SecondLevel);
+		if (SecondLevelBitmaps[FirstLevel] == 0)
+		{
+			FirstLevelBitmap &= ~(1ull << FirstLevel);
+		}
+	}
+
+	Nodes[Index].Free = false;
+}
+
+UINT TlsfAllocator::FindFreeNode(UINT64 Size) const
+{
+	// Rounding the size up to the next class makes every block of the class large enough
+	UINT64 SearchSize = Size;
+	if (SearchSize >= SecondLevelCount)
+	{
+		SearchSize += (1ull << (std::bit_width(SearchSize) - 1 - SecondLevelLog2)) - 1;
+	}
+
+	UINT FirstLevel, SecondLevel;
+	GetSizeClass(SearchSize, FirstLevel, SecondLevel);
+
+	UINT SecondLevelMap = FirstLevel < FirstLevelCount ? SecondLevelBitmaps[FirstLevel] & (~0u << SecondLevel) : 0;
+	if (SecondLevelMap == 0)
+	{
+		UINT64 FirstLevelMap = FirstLevel + 1 < FirstLevelCount ? FirstLevelBitmap & (~0ull << (FirstLevel + 1)) : 0;
+		if (FirstLevelMap != 0)
+		{
+			FirstLevel	   = static_cast<UINT>(std::countr_zero(FirstLevelMap));
+			SecondLevelMap = SecondLevelBitmaps[FirstLevel];
+		}
+	}
+
+	if (SecondLevelMap != 0)
+	{
+		SecondLevel = static_cast<UINT>(std::countr_zero(SecondLevelMap));
+		return FreeLists[FirstLevel * SecondLevelCount + SecondLevel];
+	}
+
+	// Only the class of the size itself is left, some of its blocks may still be large enough
+	GetSizeClass(Size, FirstLevel, SecondLevel);
+	for (UINT Index = FreeLists[FirstLevel * SecondLevelCount + SecondLevel]; Index != NullNode; Index = Nodes[Index].NextFree)
+	{
+		if (Nodes[Index].Size >= Size)
+		{
+			return Index;
+		}
+	}
+	return NullNode;
+}
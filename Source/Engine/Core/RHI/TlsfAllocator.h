@@ -0,0 +1,82 @@
+#pragma once
+
+struct TlsfAllocatorStats
+{
+	UINT64 CapacityInBytes	  = 0;
+	UINT64 UsedInBytes		  = 0; // Including rounding to the granularity
+	UINT64 LargestFreeInBytes = 0;
+	UINT   NumAllocations	  = 0;
+	UINT   NumFreeBlocks	  = 0;
+	float  Fragmentation	  = 0.0f; // 1 - largest free block / free space, 0 when the free space is contiguous
+};
+
+struct TlsfAllocation
+{
+	UINT64 Offset;
+	UINT64 Size;
+	UINT   Node; // Passed to Free
+};
+
+// Two level segregated fit allocator for offsets into a range. Free blocks are kept in lists by size class, the first
+// level is the power of two of the size and the second level splits it linearly, so allocating and freeing are constant
+// time. Freed blocks are merged with free neighbours right away, the owner maps the offsets into a resource
+class TlsfAllocator
+{
+public:
+	// Sizes and offsets are multiples of this
+	static constexpr UINT64 Granularity = 256;
+
+	explicit TlsfAllocator(UINT64 Capacity);
+
+	[[nodiscard]] UINT64 GetCapacity() const noexcept { return Capacity; }
+	[[nodiscard]] bool	 IsEmpty() const noexcept { return NumAllocations == 0; }
+
+	// std::nullopt if no free block is large enough
+	[[nodiscard]] std::optional<TlsfAllocation> Allocate(UINT64 Size);
+
+	void Free(UINT Node);
+
+	// Walks the largest size class, not meant to be called per allocation
+	[[nodiscard]] TlsfAllocatorStats GetStats() const;
+
+private:
+	static constexpr UINT SecondLevelLog2  = 4;
+	static constexpr UINT SecondLevelCount = 1 << SecondLevelLog2;
+	static constexpr UINT FirstLevelCount  = 64 - SecondLevelLog2;
+	static constexpr UINT NumFreeLists	   = FirstLevelCount * SecondLevelCount;
+	static constexpr UINT NullNode		   = UINT_MAX;
+
+	struct Node
+	{
+		UINT64 Offset;
+		UINT64 Size; // In granules
+		UINT   PrevPhysical;
+		UINT   NextPhysical;
+		UINT   PrevFree;
+		UINT   NextFree;
+		bool   Free;
+	};
+
+	// Size class of a block of Size granules
+	static void GetSizeClass(UINT64 Size, UINT& FirstLevel, UINT& SecondLevel);
+
+	[[nodiscard]] UINT CreateNode(UINT64 Offset, UINT64 Size);
+	void			   DestroyNode(UINT Index);
+
+	void InsertFreeNode(UINT Index);
+	void RemoveFreeNode(UINT Index);
+
+	[[nodiscard]] UINT FindFreeNode(UINT64 Size) const;
+
+private:
+	UINT64 Capacity;
+	UINT64 UsedSize		  = 0; // In granules
+	UINT   NumAllocations = 0;
+
+	std::vector<Node> Nodes;
+	std::vector<UINT> UnusedNodes;
+
+	UINT64							  FirstLevelBitmap = 0;
+	std::array<UINT, FirstLevelCount> SecondLevelBitmaps{};
+	std::array<UINT, NumFreeLists>	  FreeLists;
+};
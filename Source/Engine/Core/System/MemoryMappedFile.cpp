@@ -3,6 +3,7 @@
 
 MemoryMappedFile::MemoryMappedFile(FileStream& Stream, UINT64 FileSize /*= DefaultFileSize*/)
 	: Stream(Stream)
+	, ReadOnly(!Stream.CanWrite())
 {
 	InternalCreate(FileSize);
 }
@@ -13,15 +14,15 @@ MemoryMappedFile::~MemoryMappedFile()
 
 MemoryMappedView MemoryMappedFile::CreateView()
 {
-	constexpr DWORD DesiredAccess = FILE_MAP_ALL_ACCESS;
-	LPVOID			View		  = MapViewOfFile(FileMapping.get(), DesiredAccess, 0, 0, CurrentFileSize);
+	DWORD  DesiredAccess = ReadOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+	LPVOID View			 = MapViewOfFile(FileMapping.get(), DesiredAccess, 0, 0, CurrentFileSize);
 	return MemoryMappedView(static_cast<BYTE*>(View), CurrentFileSize);
 }
 
 MemoryMappedView MemoryMappedFile::CreateView(UINT Offset, UINT64 SizeInBytes)
 {
-	constexpr DWORD DesiredAccess = FILE_MAP_ALL_ACCESS;
-	LPVOID			View		  = MapViewOfFile(FileMapping.get(), DesiredAccess, 0, Offset, SizeInBytes);
+	DWORD  DesiredAccess = ReadOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+	LPVOID View			 = MapViewOfFile(FileMapping.get(), DesiredAccess, 0, Offset, SizeInBytes);
 	return MemoryMappedView(static_cast<BYTE*>(View), SizeInBytes);
 }
 
@@ -41,7 +42,12 @@ void MemoryMappedFile::GrowMapping(UINT64 Size)
 void MemoryMappedFile::InternalCreate(UINT64 FileSize)
 {
 	CurrentFileSize = Stream.GetSizeInBytes();
-	if (CurrentFileSize == 0)
+	if (ReadOnly)
+	{
+		// A read only mapping has to match the file, it can neither be empty nor grown
+		assert(CurrentFileSize > 0);
+	}
+	else if (CurrentFileSize == 0)
 	{
 		// File mapping files with a size of 0 produces an error.
 		CurrentFileSize = DefaultFileSize;
@@ -52,7 +58,8 @@ void MemoryMappedFile::InternalCreate(UINT64 FileSize)
 		CurrentFileSize = FileSize;
 	}
 
-	FileMapping.reset(CreateFileMapping(Stream.GetHandle(), nullptr, PAGE_READWRITE, 0, CurrentFileSize, nullptr));
+	DWORD Protect = ReadOnly ? PAGE_READONLY : PAGE_READWRITE;
+	FileMapping.reset(CreateFileMapping(Stream.GetHandle(), nullptr, Protect, 0, CurrentFileSize, nullptr));
 	if (!FileMapping)
 	{
 		ErrorExit(__FUNCTIONW__);
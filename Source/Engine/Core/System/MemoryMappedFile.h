@@ -8,6 +8,7 @@ class MemoryMappedFile
 public:
 	static constexpr UINT64 DefaultFileSize = 64;
 
+	// The mapping is read only if Stream was opened without write access, it can't be grown then
 	explicit MemoryMappedFile(FileStream& Stream, UINT64 FileSize = DefaultFileSize);
 	~MemoryMappedFile();
 
@@ -28,4 +29,5 @@ private:
 	wil::unique_handle	  FileMapping;
 	std::filesystem::path Path;
 	UINT64				  CurrentFileSize = 0;
+	bool				  ReadOnly		  = false;
 };
@@ -16,7 +16,8 @@ public:
 	MemoryMappedView(MemoryMappedView&& MemoryMappedView) noexcept;
 	MemoryMappedView& operator=(MemoryMappedView&& MemoryMappedView) noexcept;
 
-	[[nodiscard]] bool IsMapped() const noexcept { return View != nullptr; }
+	[[nodiscard]] bool	 IsMapped() const noexcept { return View != nullptr; }
+	[[nodiscard]] UINT64 GetSizeInBytes() const noexcept { return Sentinel - View; }
 
 	void Flush();
 
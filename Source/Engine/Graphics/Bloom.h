@@ -53,6 +53,7 @@ static void BlurUpsample(std::string_view Name, RenderGraph& Graph, BlurUpsample
 		.Read(Inputs.HighResInput)
 		.Read(Inputs.LowResInput)
 		.Write(Inputs.HighResOutput)
+		.SetAsyncCompute()
 		.Execute([=](RenderGraphRegistry& Registry, D3D12CommandContext& Context)
 				 {
 					 D3D12Texture* HighResInput = Registry.Get<D3D12Texture>(Inputs.HighResInput);
@@ -142,6 +143,7 @@ static BloomParameters AddBloomPass(RenderGraph& Graph, const View& View, BloomI
 		.Write(&BloomArgs.Output3[0])
 		.Write(&BloomArgs.Output4[0])
 		.Write(&BloomArgs.Output5[0])
+		.SetAsyncCompute()
 		.Execute([=](RenderGraphRegistry& Registry, D3D12CommandContext& Context)
 				 {
 					 struct Parameters
@@ -169,6 +171,7 @@ static BloomParameters AddBloomPass(RenderGraph& Graph, const View& View, BloomI
 	Graph.AddRenderPass("Bloom Blur")
 		.Read(BloomArgs.Output5[0])
 		.Write(&BloomArgs.Output5[1])
+		.SetAsyncCompute()
 		.Execute([=](RenderGraphRegistry& Registry, D3D12CommandContext& Context)
 				 {
 					 D3D12Texture* Output5a = Registry.Get<D3D12Texture>(BloomArgs.Output5[0]);
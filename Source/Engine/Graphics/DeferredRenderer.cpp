@@ -38,43 +38,9 @@ void DeferredRenderer::Initialize()
 		Registry.GetRootSignature(RootSignatures::GBuffer)->GetApiHandle());
 #endif
 
-	IndirectCommandBuffer = D3D12Buffer(
-		RenderCore::Device->GetDevice(),
-		CommandBufferCounterOffset + sizeof(UINT64),
-		sizeof(CommandSignatureParams),
-		D3D12_HEAP_TYPE_DEFAULT,
-		D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
-	UAV = D3D12UnorderedAccessView(RenderCore::Device->GetDevice(), &IndirectCommandBuffer, World::MeshLimit, CommandBufferCounterOffset);
+	ReserveIndirectCommandBuffer(GpuScene::MinBufferCapacity);
 
-	Materials = D3D12Buffer(
-		RenderCore::Device->GetDevice(),
-		sizeof(Hlsl::Material) * World::MaterialLimit,
-		sizeof(Hlsl::Material),
-		D3D12_HEAP_TYPE_UPLOAD,
-		D3D12_RESOURCE_FLAG_NONE);
-	Materials.Initialize();
-	pMaterial = Materials.GetCpuVirtualAddress<Hlsl::Material>();
-
-	Lights = D3D12Buffer(
-		RenderCore::Device->GetDevice(),
-		sizeof(Hlsl::Light) * World::LightLimit,
-		sizeof(Hlsl::Light),
-		D3D12_HEAP_TYPE_UPLOAD,
-		D3D12_RESOURCE_FLAG_NONE);
-	Lights.Initialize();
-	pLights = Lights.GetCpuVirtualAddress<Hlsl::Light>();
-
-	Meshes = D3D12Buffer(
-		RenderCore::Device->GetDevice(),
-		sizeof(Hlsl::Mesh) * World::MeshLimit,
-		sizeof(Hlsl::Mesh),
-		D3D12_HEAP_TYPE_UPLOAD,
-		D3D12_RESOURCE_FLAG_NONE);
-	Meshes.Initialize();
-	pMeshes = Meshes.GetCpuVirtualAddress<Hlsl::Mesh>();
-
-	StaticMeshes.reserve(World::MeshLimit);
-	HlslMeshes.resize(World::MeshLimit);
+	Scene.Initialize();
 }
 
 void DeferredRenderer::Destroy()
@@ -82,6 +48,28 @@ void DeferredRenderer::Destroy()
 	//DEBUG_RENDERER_SHUTDOWN();
 }
 
+void DeferredRenderer::ReserveIndirectCommandBuffer(UINT64 NumCommands)
+{
+	if (IndirectCommandBuffer.GetResource() && NumCommands <= IndirectCommandCapacity)
+	{
+		return;
+	}
+
+	// The culling pass and ExecuteIndirect of the previous frame may still reference the old buffer
+	RenderCore::Device->GetDevice()->Retire(IndirectCommandBuffer.GetResource());
+
+	IndirectCommandCapacity	   = std::max(NumCommands, IndirectCommandCapacity * 2);
+	CommandBufferCounterOffset = AlignUp(IndirectCommandCapacity * sizeof(CommandSignatureParams), D3D12_UAV_COUNTER_PLACEMENT_ALIGNMENT);
+
+	IndirectCommandBuffer = D3D12Buffer(
+		RenderCore::Device->GetDevice(),
+		CommandBufferCounterOffset + sizeof(UINT64),
+		sizeof(CommandSignatureParams),
+		D3D12_HEAP_TYPE_DEFAULT,
+		D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	UAV = D3D12UnorderedAccessView(RenderCore::Device->GetDevice(), &IndirectCommandBuffer, static_cast<UINT>(IndirectCommandCapacity), CommandBufferCounterOffset);
+}
+
 void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 {
 	if (ImGui::Begin("Renderer"))
@@ -91,61 +79,16 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 		ImGui::Combo("View", &ViewMode, View, static_cast<int>(std::size(View)));
 
 		ImGui::Checkbox("Debug Renderer", &DebugRenderer::Enable);
+
+		ImGui::Text("Scene Upload: %llu bytes (%u dirty actors)", Scene.GetStats().UploadSizeInBytes, Scene.GetStats().NumDirtyActors);
+		ImGui::Text("Scene: %u meshes, %u materials, %u lights", Scene.GetNumMeshes(), Scene.GetNumMaterials(), Scene.GetNumLights());
+		ImGui::Text("Scene Buffers: %llu bytes (%u growths)", Scene.GetStats().BufferSizeInBytes, Scene.GetStats().NumBufferGrowths);
 	}
 	ImGui::End();
 
-	StaticMeshes.clear();
-
-	NumMaterials = NumLights = NumMeshes = 0;
-	World->Registry.view<CoreComponent, StaticMeshComponent>().each(
-		[&](CoreComponent& Core, StaticMeshComponent& StaticMesh)
-		{
-			if (StaticMesh.Mesh)
-			{
-				D3D12Buffer& VertexBuffer = StaticMesh.Mesh->VertexResource;
-				D3D12Buffer& IndexBuffer  = StaticMesh.Mesh->IndexResource;
-
-				D3D12_DRAW_INDEXED_ARGUMENTS DrawIndexedArguments = {};
-				DrawIndexedArguments.IndexCountPerInstance		  = StaticMesh.Mesh->IndexCount;
-				DrawIndexedArguments.InstanceCount				  = 1;
-				DrawIndexedArguments.StartIndexLocation			  = 0;
-				DrawIndexedArguments.BaseVertexLocation			  = 0;
-				DrawIndexedArguments.StartInstanceLocation		  = 0;
-
-				pMaterial[NumMaterials] = GetHLSLMaterialDesc(StaticMesh.Material);
-
-				Hlsl::Mesh Mesh		   = GetHLSLMeshDesc(Core.Transform);
-				Mesh.PreviousTransform = HlslMeshes[NumMeshes].Transform;
-
-				Mesh.VertexBuffer		 = VertexBuffer.GetVertexBufferView();
-				Mesh.IndexBuffer		 = IndexBuffer.GetIndexBufferView();
-				Mesh.Meshlets			 = StaticMesh.Mesh->MeshletResource.GetGpuVirtualAddress();
-				Mesh.UniqueVertexIndices = StaticMesh.Mesh->UniqueVertexIndexResource.GetGpuVirtualAddress();
-				Mesh.PrimitiveIndices	 = StaticMesh.Mesh->PrimitiveIndexResource.GetGpuVirtualAddress();
-
-				Mesh.MaterialIndex = NumMaterials;
-				Mesh.NumMeshlets   = StaticMesh.Mesh->MeshletCount;
-
-				Mesh.BoundingBox = StaticMesh.Mesh->BoundingBox;
-
-				Mesh.DrawIndexedArguments = DrawIndexedArguments;
-
-				HlslMeshes[NumMeshes] = Mesh;
-
-				StaticMeshes.push_back(&StaticMesh);
-
-				// DEBUG_RENDERER_ADD_BOUNDINGBOX(Core.Transform, Mesh.BoundingBox, Vector3f(1.0f));
-
-				++NumMaterials;
-				++NumMeshes;
-			}
-		});
-	World->Registry.view<CoreComponent, LightComponent>().each(
-		[&](CoreComponent& Core, LightComponent& Light)
-		{
-			pLights[NumLights++] = GetHLSLLightDesc(Core.Transform, Light);
-		});
-	std::memcpy(pMeshes, HlslMeshes.data(), sizeof(Hlsl::Mesh) * World::MeshLimit);
+	Scene.Update(World);
+	UINT NumMeshes = Scene.GetNumMeshes();
+	ReserveIndirectCommandBuffer(NumMeshes);
 
 	if (World->WorldState & EWorldState::EWorldState_Update)
 	{
@@ -161,7 +104,7 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 	} g_GlobalConstants			= {};
 	g_GlobalConstants.Camera	= GetHLSLCameraDesc(*World->ActiveCamera);
 	g_GlobalConstants.NumMeshes = NumMeshes;
-	g_GlobalConstants.NumLights = NumLights;
+	g_GlobalConstants.NumLights = Scene.GetNumLights();
 
 	// Work flow is as following:
 	// Copy Queue -> Compute Queue -> Graphics Queue
@@ -171,6 +114,7 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 	Copy.Open();
 	{
 		Copy.ResetCounter(&IndirectCommandBuffer, CommandBufferCounterOffset);
+		Scene.Upload(Copy);
 	}
 	Copy.Close();
 	D3D12SyncHandle CopySyncHandle = Copy.Execute(false);
@@ -191,7 +135,7 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 			AsyncCompute.SetComputeRootSignature(Registry.GetRootSignature(RootSignatures::IndirectCull));
 
 			AsyncCompute.SetComputeConstantBuffer(0, sizeof(GlobalConstants), &g_GlobalConstants);
-			AsyncCompute->SetComputeRootShaderResourceView(1, Meshes.GetGpuVirtualAddress());
+			AsyncCompute->SetComputeRootShaderResourceView(1, Scene.Meshes.GetGpuVirtualAddress());
 			AsyncCompute->SetComputeRootDescriptorTable(2, UAV.GetGpuHandle());
 
 			AsyncCompute.Dispatch1D<128>(NumMeshes);
@@ -200,6 +144,7 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 		ComputeSyncHandle = AsyncCompute.Execute(false);
 	}
 
+	Context.GetCommandQueue()->WaitForSyncHandle(CopySyncHandle);
 	Context.GetCommandQueue()->WaitForSyncHandle(ComputeSyncHandle);
 
 	RenderGraph Graph(Allocator, Registry);
@@ -261,10 +206,10 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 
 #if USE_MESH_SHADERS
 	Graph.AddRenderPass("GBuffer (Mesh Shaders)")
-		.Write(&GBufferArgs.Albedo)
-		.Write(&GBufferArgs.Normal)
-		.Write(&GBufferArgs.Motion)
-		.Write(&GBufferArgs.Depth)
+		.Write(&GBufferArgs.Albedo, RgWriteAccess::RenderTarget)
+		.Write(&GBufferArgs.Normal, RgWriteAccess::RenderTarget)
+		.Write(&GBufferArgs.Motion, RgWriteAccess::RenderTarget)
+		.Write(&GBufferArgs.Depth, RgWriteAccess::DepthStencil)
 		.Execute([=, this](RenderGraphRegistry& Registry, D3D12CommandContext& Context)
 				 {
 					 D3D12ScopedEvent(Context, "GBuffer (Mesh Shaders)");
@@ -272,8 +217,8 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 					 Context.SetPipelineState(Registry.GetPipelineState(PipelineStates::Meshlet));
 					 Context.SetGraphicsRootSignature(Registry.GetRootSignature(RootSignatures::Meshlet));
 					 Context.SetGraphicsConstantBuffer(5, sizeof(GlobalConstants), &g_GlobalConstants);
-					 Context->SetGraphicsRootShaderResourceView(6, Materials.GetGpuVirtualAddress());
-					 Context->SetGraphicsRootShaderResourceView(7, Meshes.GetGpuVirtualAddress());
+					 Context->SetGraphicsRootShaderResourceView(6, Scene.Materials.GetGpuVirtualAddress());
+					 Context->SetGraphicsRootShaderResourceView(7, Scene.Meshes.GetGpuVirtualAddress());
 
 					 Context->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 					 Context.SetViewport(RHIViewport(0.0f, 0.0f, View.Width, View.Height, 0.0f, 1.0f));
@@ -285,7 +230,7 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 
 					 Context->ExecuteIndirect(
 						 CommandSignature,
-						 World::MeshLimit,
+						 static_cast<UINT>(IndirectCommandCapacity),
 						 IndirectCommandBuffer.GetResource(),
 						 0,
 						 IndirectCommandBuffer.GetResource(),
@@ -295,10 +240,10 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 				 });
 #else
 	Graph.AddRenderPass("GBuffer")
-		.Write(&GBufferArgs.Albedo)
-		.Write(&GBufferArgs.Normal)
-		.Write(&GBufferArgs.Motion)
-		.Write(&GBufferArgs.Depth)
+		.Write(&GBufferArgs.Albedo, RgWriteAccess::RenderTarget)
+		.Write(&GBufferArgs.Normal, RgWriteAccess::RenderTarget)
+		.Write(&GBufferArgs.Motion, RgWriteAccess::RenderTarget)
+		.Write(&GBufferArgs.Depth, RgWriteAccess::DepthStencil)
 		.Execute([=, this](RenderGraphRegistry& Registry, D3D12CommandContext& Context)
 				 {
 					 D3D12ScopedEvent(Context, "GBuffer");
@@ -306,9 +251,9 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 					 Context.SetPipelineState(Registry.GetPipelineState(PipelineStates::GBuffer));
 					 Context.SetGraphicsRootSignature(Registry.GetRootSignature(RootSignatures::GBuffer));
 					 Context.SetGraphicsConstantBuffer(1, sizeof(GlobalConstants), &g_GlobalConstants);
-					 Context->SetGraphicsRootShaderResourceView(2, Materials.GetGpuVirtualAddress());
-					 Context->SetGraphicsRootShaderResourceView(3, Lights.GetGpuVirtualAddress());
-					 Context->SetGraphicsRootShaderResourceView(4, Meshes.GetGpuVirtualAddress());
+					 Context->SetGraphicsRootShaderResourceView(2, Scene.Materials.GetGpuVirtualAddress());
+					 Context->SetGraphicsRootShaderResourceView(3, Scene.Lights.GetGpuVirtualAddress());
+					 Context->SetGraphicsRootShaderResourceView(4, Scene.Meshes.GetGpuVirtualAddress());
 
 					 Context->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 					 Context.SetViewport(RHIViewport(0.0f, 0.0f, View.Width, View.Height, 0.0f, 1.0f));
@@ -320,7 +265,7 @@ void DeferredRenderer::Render(World* World, D3D12CommandContext& Context)
 
 					 Context->ExecuteIndirect(
 						 CommandSignature,
-						 World::MeshLimit,
+						 static_cast<UINT>(IndirectCommandCapacity),
 						 IndirectCommandBuffer.GetResource(),
 						 0,
 						 IndirectCommandBuffer.GetResource(),
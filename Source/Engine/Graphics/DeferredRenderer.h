@@ -1,5 +1,6 @@
 #pragma once
 #include "Renderer.h"
+#include "GpuScene.h"
 
 #define USE_MESH_SHADERS 1
 
@@ -13,6 +14,9 @@ private:
 	void Destroy() override;
 	void Render(World* World, D3D12CommandContext& Context) override;
 
+	// Grows the indirect command buffer geometrically so it can hold a command for every mesh
+	void ReserveIndirectCommandBuffer(UINT64 NumCommands);
+
 private:
 #pragma pack(push, 4)
 #if USE_MESH_SHADERS
@@ -36,25 +40,14 @@ private:
 #endif
 #pragma pack(pop)
 
-	static constexpr UINT64 TotalCommandBufferSizeInBytes = World::MeshLimit * sizeof(CommandSignatureParams);
-	static constexpr UINT64 CommandBufferCounterOffset	  = AlignUp(TotalCommandBufferSizeInBytes, D3D12_UAV_COUNTER_PLACEMENT_ALIGNMENT);
-
 	D3D12CommandSignature CommandSignature;
 
 	D3D12Buffer				 IndirectCommandBuffer;
 	D3D12UnorderedAccessView UAV;
+	UINT64					 IndirectCommandCapacity	= 0;
+	UINT64					 CommandBufferCounterOffset = 0;
 
-	std::vector<StaticMeshComponent*> StaticMeshes;
-	std::vector<Hlsl::Mesh>			  HlslMeshes;
-
-	D3D12Buffer		Materials;
-	Hlsl::Material* pMaterial = nullptr;
-	D3D12Buffer		Lights;
-	Hlsl::Light*	pLights = nullptr;
-	D3D12Buffer		Meshes;
-	Hlsl::Mesh*		pMeshes = nullptr;
-
-	UINT NumMaterials = 0, NumLights = 0, NumMeshes = 0;
+	GpuScene Scene;
 
 	int ViewMode = 0;
 };
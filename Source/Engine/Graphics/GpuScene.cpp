@@ -0,0 +1,237 @@
+#include "GpuScene.h"
+#include <RenderCore/RenderCore.h>
+
+UINT GpuMaterialTable::Acquire(const Hlsl::Material& Material)
+{
+	if (auto Iter = Slots.find(Material); Iter != Slots.end())
+	{
+		++RefCounts[Iter->second];
+		return Iter->second;
+	}
+
+	UINT Slot;
+	if (!FreeSlots.empty())
+	{
+		Slot = FreeSlots.back();
+		FreeSlots.pop_back();
+		Records[Slot]	= Material;
+		RefCounts[Slot] = 1;
+	}
+	else
+	{
+		Slot = Size();
+		Records.push_back(Material);
+		RefCounts.push_back(1);
+	}
+
+	Slots.emplace(Material, Slot);
+	DirtySlots.push_back(Slot);
+	return Slot;
+}
+
+void GpuMaterialTable::Release(UINT Slot)
+{
+	assert(RefCounts[Slot] > 0);
+	if (--RefCounts[Slot] == 0)
+	{
+		// The record stays in the buffer until the slot is reused, nothing references it anymore
+		Slots.erase(Records[Slot]);
+		FreeSlots.push_back(Slot);
+	}
+}
+
+void GpuMaterialTable::MarkAllDirty()
+{
+	DirtySlots.resize(Records.size());
+	std::iota(DirtySlots.begin(), DirtySlots.end(), 0u);
+}
+
+void GpuMaterialTable::Clear()
+{
+	Records.clear();
+	RefCounts.clear();
+	FreeSlots.clear();
+	Slots.clear();
+	DirtySlots.clear();
+}
+
+UINT64 GpuMaterialTable::Upload(D3D12CommandContext& Context, D3D12Buffer& Buffer)
+{
+	return UploadDirtySlots<Hlsl::Material>(Context, Buffer, Records, DirtySlots);
+}
+
+void GpuScene::Initialize()
+{
+	ReserveBuffer(Materials, sizeof(Hlsl::Material), MinBufferCapacity);
+	ReserveBuffer(Lights, sizeof(Hlsl::Light), MinBufferCapacity);
+	ReserveBuffer(Meshes, sizeof(Hlsl::Mesh), MinBufferCapacity);
+}
+
+void GpuScene::Update(World* World)
+{
+	if (World->RenderStateReset)
+	{
+		World->RenderStateReset = false;
+
+		MaterialTable.Clear();
+		LightTable.Clear();
+		MeshTable.Clear();
+		MovedActors.clear();
+
+		World->RenderStateDirtyActors.clear();
+		for (entt::entity Entity : World->Registry.view<CoreComponent>())
+		{
+			World->RenderStateDirtyActors.push_back(Entity);
+		}
+	}
+
+	std::vector<entt::entity> DirtyActors = std::move(MovedActors);
+	MovedActors.clear();
+	DirtyActors.insert(DirtyActors.end(), World->RenderStateDirtyActors.begin(), World->RenderStateDirtyActors.end());
+	World->RenderStateDirtyActors.clear();
+
+	// An actor is usually marked several times a frame (component added, then modified), writing a mesh twice
+	// would overwrite PreviousTransform with the current transform
+	std::ranges::sort(DirtyActors);
+	auto [First, Last] = std::ranges::unique(DirtyActors);
+	DirtyActors.erase(First, Last);
+
+	for (entt::entity Entity : DirtyActors)
+	{
+		UpdateActor(World, Entity);
+	}
+
+	Stats.NumDirtyActors = static_cast<UINT>(DirtyActors.size());
+}
+
+void GpuScene::Upload(D3D12CommandContext& Context)
+{
+	if (ReserveBuffer(Materials, sizeof(Hlsl::Material), MaterialTable.Size()))
+	{
+		MaterialTable.MarkAllDirty();
+	}
+	if (ReserveBuffer(Lights, sizeof(Hlsl::Light), LightTable.Size()))
+	{
+		LightTable.MarkAllDirty();
+	}
+	if (ReserveBuffer(Meshes, sizeof(Hlsl::Mesh), MeshTable.Size()))
+	{
+		MeshTable.MarkAllDirty();
+	}
+
+	Stats.UploadSizeInBytes = 0;
+	Stats.UploadSizeInBytes += MaterialTable.Upload(Context, Materials);
+	Stats.UploadSizeInBytes += LightTable.Upload(Context, Lights);
+	Stats.UploadSizeInBytes += MeshTable.Upload(Context, Meshes);
+}
+
+void GpuScene::UpdateActor(World* World, entt::entity Entity)
+{
+	entt::registry& Registry = World->Registry;
+
+	// Destroyed actors are removed from every table
+	bool				 Valid		= Registry.valid(Entity);
+	CoreComponent*		 Core		= Valid ? Registry.try_get<CoreComponent>(Entity) : nullptr;
+	StaticMeshComponent* StaticMesh = Valid ? Registry.try_get<StaticMeshComponent>(Entity) : nullptr;
+	LightComponent*		 Light		= Valid ? Registry.try_get<LightComponent>(Entity) : nullptr;
+
+	if (Core && StaticMesh && StaticMesh->Mesh)
+	{
+		const Mesh&				 AssetMesh = *StaticMesh->Mesh;
+		std::span<const MeshLod> Lods	   = AssetMesh.Lods;
+
+		D3D12_DRAW_INDEXED_ARGUMENTS DrawIndexedArguments = {};
+		DrawIndexedArguments.IndexCountPerInstance		  = Lods[0].IndexCount; // IndirectCull selects the LOD
+		DrawIndexedArguments.InstanceCount				  = 1;
+		DrawIndexedArguments.StartIndexLocation			  = 0;
+		DrawIndexedArguments.BaseVertexLocation			  = 0;
+		DrawIndexedArguments.StartInstanceLocation		  = 0;
+
+		Hlsl::Mesh		  Mesh	   = GetHLSLMeshDesc(Core->Transform);
+		const Hlsl::Mesh* Previous = MeshTable.Find(Entity);
+		Mesh.PreviousTransform	   = Previous ? Previous->Transform : Mesh.Transform;
+
+		Mesh.VertexBuffer		 = AssetMesh.GetVertexBufferView();
+		Mesh.IndexBuffer		 = AssetMesh.GetIndexBufferView();
+		Mesh.Meshlets			 = AssetMesh.GetGpuVirtualAddress(AssetMesh.MeshletSection);
+		Mesh.UniqueVertexIndices = AssetMesh.GetGpuVirtualAddress(AssetMesh.UniqueVertexIndexSection);
+		Mesh.PrimitiveIndices	 = AssetMesh.GetGpuVirtualAddress(AssetMesh.PrimitiveIndexSection);
+
+		Mesh.NumMeshlets  = Lods[0].MeshletCount;
+		Mesh.VertexView	  = AssetMesh.Geometry.GetViewIndex();
+		Mesh.IndexView	  = AssetMesh.Geometry.GetViewIndex();
+		Mesh.VertexOffset = static_cast<UINT>(AssetMesh.GetBufferOffset(AssetMesh.VertexSection));
+		Mesh.IndexOffset  = static_cast<UINT>(AssetMesh.GetBufferOffset(AssetMesh.IndexSection));
+
+		Mesh.NumLods = static_cast<UINT>(std::min(Lods.size(), MaxMeshLods));
+		for (UINT i = 0; i < Mesh.NumLods; ++i)
+		{
+			Mesh.Lods[i]	  = { Lods[i].IndexOffset, Lods[i].IndexCount, Lods[i].MeshletOffset, Lods[i].MeshletCount };
+			Mesh.LodErrors[i] = Lods[i].Error;
+		}
+
+		// Acquire before releasing the old reference so an unchanged material keeps its slot
+		Mesh.MaterialIndex = MaterialTable.Acquire(GetHLSLMaterialDesc(StaticMesh->Material));
+		if (Previous)
+		{
+			MaterialTable.Release(Previous->MaterialIndex);
+		}
+
+		Mesh.BoundingBox = StaticMesh->Mesh->BoundingBox;
+
+		Mesh.DrawIndexedArguments = DrawIndexedArguments;
+
+		MeshTable.Write(Entity, Mesh);
+
+		if (std::memcmp(&Mesh.Transform, &Mesh.PreviousTransform, sizeof(DirectX::XMFLOAT4X4)) != 0)
+		{
+			MovedActors.push_back(Entity);
+		}
+	}
+	else
+	{
+		RemoveMesh(Entity);
+	}
+
+	if (Core && Light)
+	{
+		LightTable.Write(Entity, GetHLSLLightDesc(Core->Transform, *Light));
+	}
+	else
+	{
+		LightTable.Remove(Entity);
+	}
+}
+
+void GpuScene::RemoveMesh(entt::entity Entity)
+{
+	if (const Hlsl::Mesh* Mesh = MeshTable.Find(Entity))
+	{
+		MaterialTable.Release(Mesh->MaterialIndex);
+		MeshTable.Remove(Entity);
+	}
+}
+
+bool GpuScene::ReserveBuffer(D3D12Buffer& Buffer, UINT Stride, UINT64 NumElements)
+{
+	UINT64 Capacity = Buffer.GetResource() ? Buffer.GetDesc().Width / Stride : 0;
+	if (Buffer.GetResource() && NumElements <= Capacity)
+	{
+		return false;
+	}
+
+	// Geometric growth keeps the number of full re-uploads logarithmic in the scene size
+	UINT64 NewCapacity = std::max({ NumElements, Capacity * 2, MinBufferCapacity });
+
+	D3D12LinkedDevice* Device = RenderCore::Device->GetDevice();
+	if (Buffer.GetResource())
+	{
+		Stats.BufferSizeInBytes -= Buffer.GetDesc().Width;
+		Device->Retire(Buffer.GetResource());
+		++Stats.NumBufferGrowths;
+	}
+
+	Buffer = D3D12Buffer(Device, NewCapacity * Stride, Stride, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_FLAG_NONE);
+	Stats.BufferSizeInBytes += NewCapacity * Stride;
+	return true;
+}
@@ -0,0 +1,244 @@
+#pragma once
+#include "World/World.h"
+
+// Copies contiguous runs of dirty slots to Buffer and clears DirtySlots, returns the number of bytes uploaded
+template<typename T>
+UINT64 UploadDirtySlots(D3D12CommandContext& Context, D3D12Buffer& Buffer, std::span<const T> Records, std::vector<UINT>& DirtySlots)
+{
+	std::ranges::sort(DirtySlots);
+	auto [First, Last] = std::ranges::unique(DirtySlots);
+	DirtySlots.erase(First, Last);
+
+	const UINT Size = static_cast<UINT>(Records.size());
+
+	UINT64 UploadSizeInBytes = 0;
+	for (size_t i = 0; i < DirtySlots.size();)
+	{
+		// Slots at or past the end belonged to removed records, the gpu never reads them
+		UINT Begin = DirtySlots[i];
+		if (Begin >= Size)
+		{
+			break;
+		}
+
+		UINT End = Begin + 1;
+		for (++i; i < DirtySlots.size() && DirtySlots[i] == End && End < Size; ++i)
+		{
+			++End;
+		}
+
+		UINT64 SizeInBytes = sizeof(T) * (End - Begin);
+		Context.WriteBuffer(&Buffer, sizeof(T) * Begin, &Records[Begin], SizeInBytes);
+		UploadSizeInBytes += SizeInBytes;
+	}
+	DirtySlots.clear();
+
+	return UploadSizeInBytes;
+}
+
+// Dense table of gpu records with a stable slot per entity, records are written into a cpu mirror and only
+// the dirty slots are copied to the gpu buffer. Removal moves the last record into the freed slot so the
+// records stay contiguous and shaders can index [0, Size)
+template<typename T>
+class GpuSceneTable
+{
+public:
+	[[nodiscard]] UINT Size() const noexcept { return static_cast<UINT>(Records.size()); }
+
+	[[nodiscard]] std::span<const entt::entity> GetEntities() const noexcept { return Entities; }
+
+	[[nodiscard]] T* Find(entt::entity Entity) noexcept;
+
+	// Inserts or overwrites the record of Entity, returns the slot
+	UINT Write(entt::entity Entity, const T& Record);
+
+	// Returns the slot whose record was moved into the freed slot, or UINT_MAX if nothing was moved
+	UINT Remove(entt::entity Entity);
+
+	void MarkDirty(UINT Slot) { DirtySlots.push_back(Slot); }
+	void MarkAllDirty();
+
+	void Clear();
+
+	// Copies contiguous runs of dirty slots to Buffer, returns the number of bytes uploaded
+	UINT64 Upload(D3D12CommandContext& Context, D3D12Buffer& Buffer);
+
+private:
+	std::vector<T>						   Records;
+	std::vector<entt::entity>			   Entities;
+	std::unordered_map<entt::entity, UINT> Slots;
+	std::vector<UINT>					   DirtySlots;
+};
+
+template<typename T>
+T* GpuSceneTable<T>::Find(entt::entity Entity) noexcept
+{
+	auto Iter = Slots.find(Entity);
+	return Iter != Slots.end() ? &Records[Iter->second] : nullptr;
+}
+
+template<typename T>
+UINT GpuSceneTable<T>::Write(entt::entity Entity, const T& Record)
+{
+	auto [Iter, Inserted] = Slots.try_emplace(Entity, Size());
+	if (Inserted)
+	{
+		Records.push_back(Record);
+		Entities.push_back(Entity);
+	}
+	else
+	{
+		Records[Iter->second] = Record;
+	}
+	MarkDirty(Iter->second);
+	return Iter->second;
+}
+
+template<typename T>
+UINT GpuSceneTable<T>::Remove(entt::entity Entity)
+{
+	auto Iter = Slots.find(Entity);
+	if (Iter == Slots.end())
+	{
+		return UINT_MAX;
+	}
+
+	UINT Slot = Iter->second;
+	UINT Last = Size() - 1;
+	Slots.erase(Iter);
+
+	UINT Moved = UINT_MAX;
+	if (Slot != Last)
+	{
+		Records[Slot]		  = Records[Last];
+		Entities[Slot]		  = Entities[Last];
+		Slots[Entities[Slot]] = Slot;
+		Moved				  = Slot;
+		MarkDirty(Slot);
+	}
+	Records.pop_back();
+	Entities.pop_back();
+	return Moved;
+}
+
+template<typename T>
+void GpuSceneTable<T>::MarkAllDirty()
+{
+	DirtySlots.resize(Records.size());
+	std::iota(DirtySlots.begin(), DirtySlots.end(), 0u);
+}
+
+template<typename T>
+void GpuSceneTable<T>::Clear()
+{
+	Records.clear();
+	Entities.clear();
+	Slots.clear();
+	DirtySlots.clear();
+}
+
+template<typename T>
+UINT64 GpuSceneTable<T>::Upload(D3D12CommandContext& Context, D3D12Buffer& Buffer)
+{
+	return UploadDirtySlots<T>(Context, Buffer, Records, DirtySlots);
+}
+
+// Deduplicated materials, actors with identical material parameters and textures share one reference counted slot.
+// Slots never move while referenced so meshes keep their MaterialIndex, released slots are reused
+class GpuMaterialTable
+{
+public:
+	// Number of slots including released ones, shaders can index [0, Size)
+	[[nodiscard]] UINT Size() const noexcept { return static_cast<UINT>(Records.size()); }
+	[[nodiscard]] UINT GetNumMaterials() const noexcept { return static_cast<UINT>(Slots.size()); }
+
+	// Returns the slot of Material and adds a reference, the slot is only written if the material is new
+	UINT Acquire(const Hlsl::Material& Material);
+
+	void Release(UINT Slot);
+
+	void MarkAllDirty();
+
+	void Clear();
+
+	UINT64 Upload(D3D12CommandContext& Context, D3D12Buffer& Buffer);
+
+private:
+	struct MaterialHash
+	{
+		size_t operator()(const Hlsl::Material& Material) const noexcept
+		{
+			return CityHash64(reinterpret_cast<const char*>(&Material), sizeof(Hlsl::Material));
+		}
+	};
+
+	struct MaterialEqual
+	{
+		bool operator()(const Hlsl::Material& a, const Hlsl::Material& b) const noexcept
+		{
+			return std::memcmp(&a, &b, sizeof(Hlsl::Material)) == 0;
+		}
+	};
+
+	std::vector<Hlsl::Material>											  Records;
+	std::vector<UINT>													  RefCounts;
+	std::vector<UINT>													  FreeSlots;
+	std::unordered_map<Hlsl::Material, UINT, MaterialHash, MaterialEqual> Slots;
+	std::vector<UINT>													  DirtySlots;
+};
+
+struct GpuSceneStats
+{
+	UINT64 UploadSizeInBytes = 0;
+	UINT64 BufferSizeInBytes = 0; // Total size of the scene buffers
+	UINT   NumDirtyActors	 = 0;
+	UINT   NumBufferGrowths	 = 0; // Since initialization
+};
+
+// Persistent scene data shared by the renderers, meshes, materials and lights live in default heap buffers
+// and are kept in sync with the world through World::RenderStateDirtyActors instead of being rebuilt every frame
+class GpuScene
+{
+public:
+	// Buffers start at this many elements and double whenever the scene outgrows them
+	static constexpr UINT64 MinBufferCapacity = 64;
+
+	void Initialize();
+
+	// Consumes the dirty actors of the world and updates the cpu mirror
+	void Update(World* World);
+
+	// Grows the buffers if needed and records copies for the dirty slots into Context, can be a copy queue context.
+	// Buffers may be replaced, so gpu addresses have to be fetched after this
+	void Upload(D3D12CommandContext& Context);
+
+	[[nodiscard]] UINT GetNumMeshes() const noexcept { return MeshTable.Size(); }
+	[[nodiscard]] UINT GetNumMaterials() const noexcept { return MaterialTable.GetNumMaterials(); }
+	[[nodiscard]] UINT GetNumLights() const noexcept { return LightTable.Size(); }
+
+	// Entity of every mesh in slot order, InstanceID of a raytracing instance has to match the slot
+	[[nodiscard]] std::span<const entt::entity> GetMeshEntities() const noexcept { return MeshTable.GetEntities(); }
+
+	[[nodiscard]] const GpuSceneStats& GetStats() const noexcept { return Stats; }
+
+	D3D12Buffer Materials;
+	D3D12Buffer Lights;
+	D3D12Buffer Meshes;
+
+private:
+	void UpdateActor(World* World, entt::entity Entity);
+	void RemoveMesh(entt::entity Entity);
+
+	// Returns true if Buffer was replaced and has to be uploaded again
+	bool ReserveBuffer(D3D12Buffer& Buffer, UINT Stride, UINT64 NumElements);
+
+private:
+	GpuMaterialTable		   MaterialTable;
+	GpuSceneTable<Hlsl::Light> LightTable;
+	GpuSceneTable<Hlsl::Mesh>  MeshTable;
+
+	// Meshes that moved last frame have to be written again so PreviousTransform catches up
+	std::vector<entt::entity> MovedActors;
+
+	GpuSceneStats Stats;
+};
@@ -102,15 +102,14 @@ void PathIntegratorDXR1_0::Render(World* World, D3D12CommandContext& Context)
 		HitGroupShaderTable->Reset();
 		for (auto [i, MeshRenderer] : enumerate(AccelerationStructure.StaticMeshes))
 		{
-			ID3D12Resource* VertexBuffer = MeshRenderer->Mesh->VertexResource.GetResource();
-			ID3D12Resource* IndexBuffer	 = MeshRenderer->Mesh->IndexResource.GetResource();
+			const Mesh* Mesh = MeshRenderer->Mesh;
 
 			D3D12RaytracingShaderTable<RootArgument>::Record Record = {};
 			Record.ShaderIdentifier									= RaytracingPipelineStates::g_DefaultSID;
 			Record.RootArguments.MaterialIndex						= static_cast<UINT>(i);
 			Record.RootArguments.Padding							= 0xDEADBEEF;
-			Record.RootArguments.VertexBuffer						= VertexBuffer->GetGPUVirtualAddress();
-			Record.RootArguments.IndexBuffer						= IndexBuffer->GetGPUVirtualAddress();
+			Record.RootArguments.VertexBuffer						= Mesh->GetGpuVirtualAddress(Mesh->VertexSection);
+			Record.RootArguments.IndexBuffer						= Mesh->GetGpuVirtualAddress(Mesh->IndexSection);
 
 			HitGroupShaderTable->AddShaderRecord(Record);
 		}
@@ -165,7 +164,8 @@ void PathIntegratorDXR1_0::Render(World* World, D3D12CommandContext& Context)
 		RgTextureDesc()
 			.SetFormat(DXGI_FORMAT_R32G32B32A32_FLOAT)
 			.SetExtent(View.Width, View.Height, 1)
-			.AllowUnorderedAccess());
+			.AllowUnorderedAccess()
+			.SetPersistent());
 	PathTraceArgs.OutputSrv = Graph.Create<D3D12ShaderResourceView>(
 		"Path Trace Output Srv",
 		RgViewDesc()
@@ -10,37 +10,10 @@ void PathIntegratorDXR1_1::Initialize()
 	RootSignatures::Compile(Registry);
 	PipelineStates::Compile(Registry);
 
-	AccelerationStructure = RaytracingAccelerationStructure(1, World::MeshLimit);
+	AccelerationStructure = RaytracingAccelerationStructure(1, GpuScene::MinBufferCapacity);
 	AccelerationStructure.Initialize();
 
-	Materials = D3D12Buffer(
-		RenderCore::Device->GetDevice(),
-		sizeof(Hlsl::Material) * World::MaterialLimit,
-		sizeof(Hlsl::Material),
-		D3D12_HEAP_TYPE_UPLOAD,
-		D3D12_RESOURCE_FLAG_NONE);
-	Materials.Initialize();
-	pMaterial = Materials.GetCpuVirtualAddress<Hlsl::Material>();
-
-	Lights = D3D12Buffer(
-		RenderCore::Device->GetDevice(),
-		sizeof(Hlsl::Light) * World::LightLimit,
-		sizeof(Hlsl::Light),
-		D3D12_HEAP_TYPE_UPLOAD,
-		D3D12_RESOURCE_FLAG_NONE);
-	Lights.Initialize();
-	pLights = Lights.GetCpuVirtualAddress<Hlsl::Light>();
-
-	Meshes = D3D12Buffer(
-		RenderCore::Device->GetDevice(),
-		sizeof(Hlsl::Mesh) * World::MeshLimit,
-		sizeof(Hlsl::Mesh),
-		D3D12_HEAP_TYPE_UPLOAD,
-		D3D12_RESOURCE_FLAG_NONE);
-	Meshes.Initialize();
-	pMeshes = Meshes.GetCpuVirtualAddress<Hlsl::Mesh>();
-
-	HlslMeshes.resize(World::MeshLimit);
+	Scene.Initialize();
 }
 
 void PathIntegratorDXR1_1::Destroy()
@@ -71,60 +44,29 @@ void PathIntegratorDXR1_1::Render(World* World, D3D12CommandContext& Context)
 
 		ImGui::Text("Num Temporal Samples: %u", NumTemporalSamples);
 		ImGui::Text("Samples Per Pixel: %u", 4u);
+		ImGui::Text("Scene Upload: %llu bytes (%u dirty actors)", Scene.GetStats().UploadSizeInBytes, Scene.GetStats().NumDirtyActors);
+		ImGui::Text("Scene: %u meshes, %u materials, %u lights", Scene.GetNumMeshes(), Scene.GetNumMaterials(), Scene.GetNumLights());
+		ImGui::Text("Scene Buffers: %llu bytes (%u growths)", Scene.GetStats().BufferSizeInBytes, Scene.GetStats().NumBufferGrowths);
 	}
 	ImGui::End();
 
-	NumMaterials = NumLights = NumMeshes = 0;
-	AccelerationStructure.Reset();
-	World->Registry.view<CoreComponent, StaticMeshComponent>().each(
-		[&](CoreComponent& Core, StaticMeshComponent& StaticMesh)
-		{
-			if (StaticMesh.Mesh)
-			{
-				AccelerationStructure.AddInstance(Core.Transform, &StaticMesh);
-
-				D3D12Buffer& VertexBuffer = StaticMesh.Mesh->VertexResource;
-				D3D12Buffer& IndexBuffer  = StaticMesh.Mesh->IndexResource;
-
-				D3D12_DRAW_INDEXED_ARGUMENTS DrawIndexedArguments = {};
-				DrawIndexedArguments.IndexCountPerInstance		  = StaticMesh.Mesh->IndexCount;
-				DrawIndexedArguments.InstanceCount				  = 1;
-				DrawIndexedArguments.StartIndexLocation			  = 0;
-				DrawIndexedArguments.BaseVertexLocation			  = 0;
-				DrawIndexedArguments.StartInstanceLocation		  = 0;
-
-				pMaterial[NumMaterials] = GetHLSLMaterialDesc(StaticMesh.Material);
-
-				Hlsl::Mesh Mesh		   = GetHLSLMeshDesc(Core.Transform);
-				Mesh.PreviousTransform = HlslMeshes[NumMeshes].Transform;
-
-				Mesh.VertexBuffer = VertexBuffer.GetVertexBufferView();
-				Mesh.IndexBuffer  = IndexBuffer.GetIndexBufferView();
-				//Mesh.Meshlets			 = StaticMesh.Mesh->MeshletResource.GetGpuVirtualAddress();
-				//Mesh.UniqueVertexIndices = StaticMesh.Mesh->UniqueVertexIndexResource.GetGpuVirtualAddress();
-				//Mesh.PrimitiveIndices	 = StaticMesh.Mesh->PrimitiveIndexResource.GetGpuVirtualAddress();
-
-				Mesh.MaterialIndex = NumMaterials;
-				//Mesh.NumMeshlets   = StaticMesh.Mesh->MeshletCount;
-				Mesh.VertexView = StaticMesh.Mesh->VertexView.GetIndex();
-				Mesh.IndexView	= StaticMesh.Mesh->IndexView.GetIndex();
+	Scene.Update(World);
 
-				Mesh.BoundingBox = StaticMesh.Mesh->BoundingBox;
-
-				Mesh.DrawIndexedArguments = DrawIndexedArguments;
-
-				HlslMeshes[NumMeshes] = Mesh;
+	D3D12CommandContext& Copy = RenderCore::Device->GetDevice()->GetCopyContext1();
+	Copy.Open();
+	{
+		Scene.Upload(Copy);
+	}
+	Copy.Close();
+	D3D12SyncHandle CopySyncHandle = Copy.Execute(false);
 
-				++NumMaterials;
-				++NumMeshes;
-			}
-		});
-	World->Registry.view<CoreComponent, LightComponent>().each(
-		[&](CoreComponent& Core, LightComponent& Light)
-		{
-			pLights[NumLights++] = GetHLSLLightDesc(Core.Transform, Light);
-		});
-	std::memcpy(pMeshes, HlslMeshes.data(), sizeof(Hlsl::Mesh) * World::MeshLimit);
+	// Instances are added in scene slot order so InstanceID indexes the mesh buffer
+	AccelerationStructure.Reset();
+	for (entt::entity Entity : Scene.GetMeshEntities())
+	{
+		auto [Core, StaticMesh] = World->Registry.get<CoreComponent, StaticMeshComponent>(Entity);
+		AccelerationStructure.AddInstance(Core.Transform, &StaticMesh);
+	}
 
 	D3D12SyncHandle ASBuildSyncHandle;
 	if (AccelerationStructure.IsValid())
@@ -148,6 +90,7 @@ void PathIntegratorDXR1_1::Render(World* World, D3D12CommandContext& Context)
 		ResetPathIntegrator = true;
 	}
 
+	Context.GetCommandQueue()->WaitForSyncHandle(CopySyncHandle);
 	Context.GetCommandQueue()->WaitForSyncHandle(ASBuildSyncHandle);
 
 	if (ResetPathIntegrator)
@@ -163,7 +106,7 @@ void PathIntegratorDXR1_1::Render(World* World, D3D12CommandContext& Context)
 		RgResourceHandle Srv;
 		RgResourceHandle Uav;
 	} PathTraceArgs;
-	PathTraceArgs.Output = Graph.Create<D3D12Texture>("Path Trace Output", RgTextureDesc().SetFormat(DXGI_FORMAT_R32G32B32A32_FLOAT).SetExtent(View.Width, View.Height, 1).AllowUnorderedAccess());
+	PathTraceArgs.Output = Graph.Create<D3D12Texture>("Path Trace Output", RgTextureDesc().SetFormat(DXGI_FORMAT_R32G32B32A32_FLOAT).SetExtent(View.Width, View.Height, 1).AllowUnorderedAccess().SetPersistent());
 	PathTraceArgs.Srv	 = Graph.Create<D3D12ShaderResourceView>("Path Trace Output Srv", RgViewDesc().SetResource(PathTraceArgs.Output).AsTextureSrv());
 	PathTraceArgs.Uav	 = Graph.Create<D3D12UnorderedAccessView>("Path Trace Output Uav", RgViewDesc().SetResource(PathTraceArgs.Output).AsTextureUav());
 
@@ -197,7 +140,7 @@ void PathIntegratorDXR1_1::Render(World* World, D3D12CommandContext& Context)
 					 } g_GlobalConstants					 = {};
 					 g_GlobalConstants.Camera				 = GetHLSLCameraDesc(*World->ActiveCamera);
 					 g_GlobalConstants.Resolution			 = { static_cast<float>(View.Width), static_cast<float>(View.Height), 1.0f / static_cast<float>(View.Width), 1.0f / static_cast<float>(View.Height) };
-					 g_GlobalConstants.NumLights			 = NumLights;
+					 g_GlobalConstants.NumLights			 = Scene.GetNumLights();
 					 g_GlobalConstants.TotalFrameCount		 = FrameCounter++;
 					 g_GlobalConstants.MaxDepth				 = PathIntegratorState.MaxDepth;
 					 g_GlobalConstants.NumAccumulatedSamples = NumTemporalSamples++;
@@ -211,9 +154,9 @@ void PathIntegratorDXR1_1::Render(World* World, D3D12CommandContext& Context)
 					 Context.SetComputeRootSignature(Registry.GetRootSignature(RootSignatures::RTX::PathTrace));
 					 Context.SetComputeConstantBuffer(0, sizeof(GlobalConstants), &g_GlobalConstants);
 					 Context->SetComputeRootDescriptorTable(1, AccelerationStructure.GetShaderResourceView().GetGpuHandle());
-					 Context->SetComputeRootShaderResourceView(2, Materials.GetGpuVirtualAddress());
-					 Context->SetComputeRootShaderResourceView(3, Lights.GetGpuVirtualAddress());
-					 Context->SetComputeRootShaderResourceView(4, Meshes.GetGpuVirtualAddress());
+					 Context->SetComputeRootShaderResourceView(2, Scene.Materials.GetGpuVirtualAddress());
+					 Context->SetComputeRootShaderResourceView(3, Scene.Lights.GetGpuVirtualAddress());
+					 Context->SetComputeRootShaderResourceView(4, Scene.Meshes.GetGpuVirtualAddress());
 
 					 Context.Dispatch2D<16, 16>(View.Width, View.Height);
 					 Context.UAVBarrier(nullptr);
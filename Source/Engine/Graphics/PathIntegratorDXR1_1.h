@@ -1,5 +1,6 @@
 #pragma once
 #include "PathIntegratorDXR1_0.h"
+#include "GpuScene.h"
 
 class PathIntegratorDXR1_1 final : public Renderer
 {
@@ -20,14 +21,5 @@ private:
 
 	PathIntegratorState PathIntegratorState;
 
-	D3D12Buffer		Materials;
-	Hlsl::Material* pMaterial = nullptr;
-	D3D12Buffer		Lights;
-	Hlsl::Light*	pLights = nullptr;
-	D3D12Buffer		Meshes;
-	Hlsl::Mesh*		pMeshes = nullptr;
-
-	UINT NumMaterials = 0, NumLights = 0, NumMeshes = 0;
-
-	std::vector<Hlsl::Mesh> HlslMeshes;
+	GpuScene Scene;
 };
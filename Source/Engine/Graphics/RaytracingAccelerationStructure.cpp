@@ -15,13 +15,7 @@ RaytracingAccelerationStructure::RaytracingAccelerationStructure(UINT NumHitGrou
 
 void RaytracingAccelerationStructure::Initialize()
 {
-	InstanceDescs = D3D12Buffer(
-		RenderCore::Device->GetDevice(),
-		sizeof(D3D12_RAYTRACING_INSTANCE_DESC) * NumInstances,
-		sizeof(D3D12_RAYTRACING_INSTANCE_DESC),
-		D3D12_HEAP_TYPE_UPLOAD,
-		D3D12_RESOURCE_FLAG_NONE);
-	InstanceDescs.Initialize();
+	ReserveInstanceDescs(NumInstances);
 }
 
 void RaytracingAccelerationStructure::Reset()
@@ -35,8 +29,6 @@ void RaytracingAccelerationStructure::Reset()
 
 void RaytracingAccelerationStructure::AddInstance(const Transform& Transform, StaticMeshComponent* StaticMesh)
 {
-	assert(TopLevelAccelerationStructure.size() < NumInstances);
-
 	D3D12_RAYTRACING_INSTANCE_DESC RaytracingInstanceDesc = {};
 	XMStoreFloat3x4(reinterpret_cast<DirectX::XMFLOAT3X4*>(RaytracingInstanceDesc.Transform), Transform.Matrix());
 	RaytracingInstanceDesc.InstanceID						   = CurrentInstanceID++;
@@ -105,6 +97,7 @@ void RaytracingAccelerationStructure::Build(D3D12CommandContext& Context)
 	if (!TlasScratch.GetResource() || TlasScratch.GetDesc().Width < ScratchSize)
 	{
 		// TLAS Scratch
+		RenderCore::Device->GetDevice()->Retire(TlasScratch.GetResource());
 		TlasScratch = D3D12Buffer(
 			RenderCore::Device->GetDevice(),
 			ScratchSize,
@@ -116,11 +109,13 @@ void RaytracingAccelerationStructure::Build(D3D12CommandContext& Context)
 	if (!TlasResult.GetResource() || TlasResult.GetDesc().Width < ResultSize)
 	{
 		// TLAS Result
+		RenderCore::Device->GetDevice()->Retire(TlasResult.GetResource());
 		TlasResult = D3D12ASBuffer(RenderCore::Device->GetDevice(), ResultSize);
 		SRV		   = D3D12ShaderResourceView(RenderCore::Device->GetDevice(), &TlasResult);
 	}
 
 	// Create the description for each instance
+	ReserveInstanceDescs(TopLevelAccelerationStructure.size());
 	auto Instances = InstanceDescs.GetCpuVirtualAddress<D3D12_RAYTRACING_INSTANCE_DESC>();
 	for (auto [i, Instance] : enumerate(TopLevelAccelerationStructure))
 	{
@@ -144,3 +139,26 @@ void RaytracingAccelerationStructure::PostBuild(D3D12SyncHandle SyncHandle)
 		}
 	}
 }
+
+void RaytracingAccelerationStructure::ReserveInstanceDescs(size_t NumInstanceDescs)
+{
+	if (InstanceDescs.GetResource() && NumInstanceDescs <= NumInstances)
+	{
+		return;
+	}
+
+	if (InstanceDescs.GetResource())
+	{
+		// The previous build may still read the old instances
+		RenderCore::Device->GetDevice()->Retire(InstanceDescs.GetResource());
+		NumInstances = std::max(NumInstanceDescs, NumInstances * 2);
+	}
+
+	InstanceDescs = D3D12Buffer(
+		RenderCore::Device->GetDevice(),
+		sizeof(D3D12_RAYTRACING_INSTANCE_DESC) * NumInstances,
+		sizeof(D3D12_RAYTRACING_INSTANCE_DESC),
+		D3D12_HEAP_TYPE_UPLOAD,
+		D3D12_RESOURCE_FLAG_NONE);
+	InstanceDescs.Initialize();
+}
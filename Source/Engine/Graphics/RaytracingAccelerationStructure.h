@@ -10,6 +10,7 @@ class RaytracingAccelerationStructure
 {
 public:
 	RaytracingAccelerationStructure() noexcept = default;
+	// NumInstances is the initial capacity, the instance buffer grows when more instances are added
 	RaytracingAccelerationStructure(UINT NumHitGroups, size_t NumInstances);
 
 	void Initialize();
@@ -28,8 +29,12 @@ public:
 	// update internal BLAS address
 	void PostBuild(D3D12SyncHandle SyncHandle);
 
+private:
+	void ReserveInstanceDescs(size_t NumInstanceDescs);
+
+public:
 	UINT   NumHitGroups = 0;
-	size_t NumInstances = 0;
+	size_t NumInstances = 0; // Capacity of InstanceDescs
 
 	D3D12RaytracingAccelerationStructureManager Manager;
 
@@ -1,5 +1,6 @@
 #include "Renderer.h"
 #include "RendererRegistry.h"
+#include "Core/Asset/AssetManager.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -85,6 +86,34 @@ void Renderer::OnRender(World* World)
 	}
 	ImGui::End();
 
+	if (ImGui::Begin("Render Graph"))
+	{
+		constexpr float MiB = 1024.0f * 1024.0f;
+
+		const RgAliasingStats& AliasingStats = Registry.GetAliasingStats();
+		ImGui::Text("Transient Textures: %zu", AliasingStats.NumTransientTextures);
+		ImGui::Text("Non Aliased: %.2f MiB", static_cast<float>(AliasingStats.NonAliasedSizeInBytes) / MiB);
+		ImGui::Text("Aliased: %.2f MiB", static_cast<float>(AliasingStats.AliasedSizeInBytes) / MiB);
+		ImGui::Text("Peak Live: %.2f MiB", static_cast<float>(AliasingStats.PeakLiveSizeInBytes) / MiB);
+		ImGui::Text("Heap: %.2f MiB", static_cast<float>(AliasingStats.HeapSizeInBytes) / MiB);
+
+		const RgCullingStats& CullingStats = Registry.GetCullingStats();
+		ImGui::Text("Culled Passes: %zu", CullingStats.NumCulledPasses);
+		ImGui::Text("Culled Textures: %zu (%.2f MiB)", CullingStats.NumCulledTextures, static_cast<float>(CullingStats.SkippedSizeInBytes) / MiB);
+
+		const RgRecordingStats& RecordingStats = Registry.GetRecordingStats();
+		ImGui::Text("Parallel Levels: %zu", RecordingStats.NumParallelLevels);
+		ImGui::Text("Worker Command Lists: %zu", RecordingStats.NumCommandLists);
+		ImGui::Text("Async Compute Passes: %zu", RecordingStats.NumAsyncComputePasses);
+		ImGui::Text("Queue Waits: %zu", RecordingStats.NumQueueWaits);
+
+		const RgBarrierStats& BarrierStats = Registry.GetBarrierStats();
+		ImGui::Text("Barriers: %zu", BarrierStats.NumTransitions + BarrierStats.NumUavBarriers + BarrierStats.NumAliasingBarriers);
+		ImGui::Text("Transitions: %zu (%zu split, %zu skipped)", BarrierStats.NumTransitions, BarrierStats.NumSplitBarriers, BarrierStats.NumSkippedTransitions);
+		ImGui::Text("Resource Accesses: %zu", BarrierStats.NumAccesses);
+	}
+	ImGui::End();
+
 	D3D12CommandContext& Context = RenderCore::Device->GetDevice()->GetCommandContext();
 	Context.Open();
 	{
@@ -115,6 +144,10 @@ void Renderer::OnRender(World* World)
 			View.Height						 = std::clamp<uint32_t>(static_cast<int>(ViewportSize.y), 1, 2160);
 			World->ActiveCamera->AspectRatio = static_cast<float>(View.Width) / static_cast<float>(View.Height);
 
+			RequestTextureResidency(World);
+			AssetManager::UpdateTextureStreaming();
+			AssetManager::ReleaseRetiredGeometry();
+
 			D3D12ScopedEvent(Context, "Render");
 			Render(World, Context);
 
@@ -205,3 +238,37 @@ void Renderer::OnResize(uint32_t Width, uint32_t Height)
 {
 	SwapChain.Resize(Width, Height);
 }
+
+void Renderer::RequestTextureResidency(World* World)
+{
+	using namespace DirectX;
+
+	const CameraComponent* Camera = World->ActiveCamera;
+	if (!Camera || !Camera->pTransform)
+	{
+		return;
+	}
+
+	XMVECTOR Eye		   = XMLoadFloat3(&Camera->pTransform->Position);
+	float	 PixelsPerUnit = static_cast<float>(View.Height) / (2.0f * std::tan(XMConvertToRadians(Camera->FoVY) * 0.5f));
+
+	World->Registry.view<CoreComponent, StaticMeshComponent>().each(
+		[&](CoreComponent& Core, StaticMeshComponent& StaticMesh)
+		{
+			AssetHandle Handle	= StaticMesh.Material.Albedo.Handle;
+			Texture*	Texture = AssetManager::GetTextureCache().GetValidAsset(Handle);
+			if (!Texture || !StaticMesh.Mesh)
+			{
+				return;
+			}
+
+			// Assumes the texture is mapped once across the bounding sphere of the mesh
+			const auto&		Box	   = StaticMesh.Mesh->BoundingBox;
+			const XMFLOAT3& Scale  = Core.Transform.Scale;
+			XMVECTOR		Center = XMVector3Transform(XMVectorSet(Box.Center.x, Box.Center.y, Box.Center.z, 1.0f), Core.Transform.Matrix());
+			float			Radius = XMVectorGetX(XMVector3Length(XMVectorSet(Box.Extents.x, Box.Extents.y, Box.Extents.z, 0.0f))) * std::max({ Scale.x, Scale.y, Scale.z });
+
+			float Distance = std::max(XMVectorGetX(XMVector3Length(XMVectorSubtract(Center, Eye))) - Radius, Camera->NearZ);
+			AssetManager::RequestTextureResidency(Texture, 2.0f * Radius * PixelsPerUnit / Distance);
+		});
+}
@@ -49,6 +49,10 @@ protected:
 	virtual void Destroy()											= 0;
 	virtual void Render(World* World, D3D12CommandContext& Context) = 0;
 
+private:
+	// Feeds the screen space size of every textured mesh back to texture streaming
+	void RequestTextureResidency(World* World);
+
 protected:
 	Window*		   MainWindow = nullptr;
 	D3D12SwapChain SwapChain;
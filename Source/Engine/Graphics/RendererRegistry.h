@@ -1,6 +1,7 @@
 #pragma once
 #include <RenderCore/RenderCore.h>
 #include "RenderGraph/RenderGraph.h"
+#include "World/Vertex.h"
 
 struct Shaders
 {
@@ -9,6 +10,9 @@ struct Shaders
 	static constexpr LPCWSTR g_PSEntryPoint = L"PSMain";
 	static constexpr LPCWSTR g_CSEntryPoint = L"CSMain";
 
+	// Value of PACKED_VERTEX for shaders that read the mesh vertex buffers
+	static constexpr LPCWSTR g_PackedVertex = KAGUYA_PACKED_VERTEX ? L"1" : L"0";
+
 	// Vertex Shaders
 	struct VS
 	{
@@ -55,6 +59,7 @@ struct Shaders
 
 		{
 			ShaderCompileOptions Options(g_CSEntryPoint);
+			Options.SetDefine(L"PACKED_VERTEX", g_PackedVertex);
 			RTX::PathTrace = RenderCore::Compiler->CompileShader(
 				RHI_SHADER_TYPE::Compute,
 				ExecutableDirectory / L"Shaders/PathTrace1_1.hlsl",
@@ -71,6 +76,7 @@ struct Shaders
 		}
 		{
 			ShaderCompileOptions Options(g_VSEntryPoint);
+			Options.SetDefine(L"PACKED_VERTEX", g_PackedVertex);
 			VS::GBuffer = RenderCore::Compiler->CompileShader(
 				RHI_SHADER_TYPE::Vertex,
 				ExecutableDirectory / L"Shaders/GBuffer.hlsl",
@@ -80,6 +86,7 @@ struct Shaders
 		// MS
 		{
 			ShaderCompileOptions Options(g_MSEntryPoint);
+			Options.SetDefine(L"PACKED_VERTEX", g_PackedVertex);
 			MS::Meshlet = RenderCore::Compiler->CompileShader(
 				RHI_SHADER_TYPE::Mesh,
 				ExecutableDirectory / L"Shaders/Meshlet.ms.hlsl",
@@ -177,7 +184,9 @@ struct Libraries
 	{
 		const auto& ExecutableDirectory = Application::ExecutableDirectory;
 
-		PathTrace = RenderCore::Compiler->CompileLibrary(ExecutableDirectory / L"Shaders/PathTrace.hlsl");
+		ShaderCompileOptions Options(L"");
+		Options.SetDefine(L"PACKED_VERTEX", Shaders::g_PackedVertex);
+		PathTrace = RenderCore::Compiler->CompileLibrary(ExecutableDirectory / L"Shaders/PathTrace.hlsl", Options);
 	}
 };
 
@@ -317,8 +326,13 @@ struct PipelineStates
 		{
 			D3D12InputLayout InputLayout(3);
 			InputLayout.AddVertexLayoutElement("POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0);
+#if KAGUYA_PACKED_VERTEX
+			InputLayout.AddVertexLayoutElement("TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0);
+			InputLayout.AddVertexLayoutElement("NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0);
+#else
 			InputLayout.AddVertexLayoutElement("TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0);
 			InputLayout.AddVertexLayoutElement("NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0);
+#endif
 
 			DepthStencilState DepthStencilState;
 			DepthStencilState.DepthEnable = true;
@@ -1,6 +1,7 @@
 #include "AssetWindow.h"
 #include <imgui_internal.h>
 #include "Core/Asset/AssetManager.h"
+#include "RenderCore/RenderCore.h"
 
 enum AssetTextureColumnID
 {
@@ -81,6 +82,7 @@ void AssetWindow::OnRender()
 			{
 				ImGui::Checkbox("sRGB", &TextureOptions.sRGB);
 				ImGui::Checkbox("Generate Mips", &TextureOptions.GenerateMips);
+				ImGui::Checkbox("Compress", &TextureOptions.Compress);
 
 				if (ImGui::Button("Browse...", ImVec2(120, 0)))
 				{
@@ -119,6 +121,52 @@ void AssetWindow::OnRender()
 										   ImGuiTableFlags_Hideable | ImGuiTableFlags_RowBg |
 										   ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV;
 
+	AsyncImportStats ImportStats = AssetManager::GetImportStats();
+	ImGui::Text(
+		"Imports: %llu queued (peak %llu), %llu running, %llu done, %llu cancelled",
+		ImportStats.NumQueued,
+		ImportStats.PeakQueued,
+		ImportStats.NumRunning,
+		ImportStats.NumCompleted,
+		ImportStats.NumCancelled);
+	ImGui::Text("Import latency: %.2f ms, import time: %.2f ms", ImportStats.AverageLatencyMs, ImportStats.AverageImportMs);
+
+	constexpr float MiB = 1024.0f * 1024.0f;
+
+	const TextureResidencyStats& ResidencyStats = AssetManager::GetTextureResidencyStats();
+	ImGui::Text(
+		"Texture residency: %.2f MiB resident, %.2f MiB requested, %u streaming textures (%u over budget)",
+		static_cast<float>(ResidencyStats.ResidentSizeInBytes) / MiB,
+		static_cast<float>(ResidencyStats.RequestedSizeInBytes) / MiB,
+		ResidencyStats.NumTextures,
+		ResidencyStats.NumOverBudget);
+	ImGui::Text("Texture streaming: %llu stream ins, %llu evictions", ResidencyStats.NumStreamIns, ResidencyStats.NumEvictions);
+
+	int BudgetMiB = static_cast<int>(ResidencyStats.BudgetInBytes >> 20);
+	if (ImGui::SliderInt("Texture Budget (MiB)", &BudgetMiB, 64, 8192))
+	{
+		AssetManager::SetTextureBudget(static_cast<UINT64>(BudgetMiB) << 20);
+	}
+
+	RingAllocatorStats UploadStats = RenderCore::Device->GetDevice()->GetUploadStats();
+	ImGui::Text(
+		"Upload ring: %.2f / %.2f MiB in flight, %.2f MiB staged, %llu stalls, %llu wraparounds",
+		static_cast<float>(UploadStats.UsedInBytes) / MiB,
+		static_cast<float>(UploadStats.CapacityInBytes) / MiB,
+		static_cast<float>(UploadStats.StagedInBytes) / MiB,
+		UploadStats.NumStalls,
+		UploadStats.NumWraparounds);
+
+	GeometryPoolStats GeometryStats = AssetManager::GetGeometryPoolStats();
+	ImGui::Text(
+		"Geometry pool: %.2f / %.2f MiB in %u blocks, %u meshes, %u retired, %.2f fragmentation",
+		static_cast<float>(GeometryStats.UsedInBytes) / MiB,
+		static_cast<float>(GeometryStats.CapacityInBytes) / MiB,
+		GeometryStats.NumBlocks,
+		GeometryStats.NumAllocations,
+		GeometryStats.NumRetired,
+		GeometryStats.Fragmentation);
+
 	ImGui::Text("Textures");
 	if (ImGui::BeginTable("TextureCache", AssetTextureColumnCount, TableFlags))
 	{
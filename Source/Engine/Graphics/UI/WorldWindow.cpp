@@ -56,7 +56,9 @@ void WorldWindow::OnRender()
 			SelectedIndex = std::nullopt;
 		}
 
-		COMDLG_FILTERSPEC ComDlgFS[] = { { L"Scene File", L"*.json" }, { L"All Files (*.*)", L"*.*" } };
+		COMDLG_FILTERSPEC ComDlgFS[]		 = { { L"Scene File", L"*.json" }, { L"All Files (*.*)", L"*.*" } };
+		COMDLG_FILTERSPEC SnapshotComDlgFS[] = { { L"Scene Snapshot", L"*.khworld" }, { L"All Files (*.*)", L"*.*" } };
+		COMDLG_FILTERSPEC LoadComDlgFS[]	 = { { L"Scene File", L"*.json;*.khworld" }, { L"All Files (*.*)", L"*.*" } };
 
 		if (ImGui::MenuItem("Save"))
 		{
@@ -67,9 +69,18 @@ void WorldWindow::OnRender()
 			}
 		}
 
+		if (ImGui::MenuItem("Save Snapshot"))
+		{
+			std::filesystem::path Path = FileSystem::SaveDialog(SnapshotComDlgFS);
+			if (!Path.empty())
+			{
+				WorldArchive::SaveSnapshot(Path.replace_extension(WorldArchive::SnapshotExtension), pWorld);
+			}
+		}
+
 		if (ImGui::MenuItem("Load"))
 		{
-			std::filesystem::path Path = FileSystem::OpenDialog(ComDlgFS);
+			std::filesystem::path Path = FileSystem::OpenDialog(LoadComDlgFS);
 			if (!Path.empty())
 			{
 				WorldArchive::Load(Path, pWorld);
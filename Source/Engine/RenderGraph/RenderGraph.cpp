@@ -1,7 +1,119 @@
 #include "RenderGraph.h"
 
-RenderPass::RenderPass(std::string_view Name)
+static ConsoleVariable CVar_ParallelRecording(
+	"RenderGraph.ParallelRecording",
+	"Records the passes of a dependency level on multiple threads",
+	true);
+
+static ConsoleVariable CVar_AsyncCompute(
+	"RenderGraph.AsyncCompute",
+	"Executes passes tagged as async compute on the async compute queue",
+	true);
+
+static ConsoleVariable CVar_SplitBarriers(
+	"RenderGraph.SplitBarriers",
+	"Splits transitions of resources that are idle for at least one dependency level into begin/end barriers",
+	true);
+
+static ConsoleVariable CVar_MinPassesPerCommandList(
+	"RenderGraph.MinPassesPerCommandList",
+	"Minimum number of passes recorded into a worker command list, small levels are recorded serially",
+	2);
+
+static bool IsReadOnlyState(D3D12_RESOURCE_STATES State) noexcept
+{
+	constexpr D3D12_RESOURCE_STATES ReadOnlyStates =
+		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER | D3D12_RESOURCE_STATE_INDEX_BUFFER | D3D12_RESOURCE_STATE_DEPTH_READ |
+		D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT |
+		D3D12_RESOURCE_STATE_COPY_SOURCE;
+	return State != D3D12_RESOURCE_STATE_UNKNOWN && (State & ~ReadOnlyStates) == 0;
+}
+
+static D3D12Resource* GetApiResource(RenderGraphRegistry& Registry, RgResourceHandle Handle)
+{
+	if (Handle.Type == RgResourceType::Buffer)
+	{
+		return Registry.Get<D3D12Buffer>(Handle);
+	}
+	return Registry.Get<D3D12Texture>(Handle);
+}
+
+// State a texture has to be in to be discarded, none if it is neither a render target nor a depth stencil
+static std::optional<D3D12_RESOURCE_STATES> GetDiscardState(const D3D12_RESOURCE_DESC& Desc) noexcept
+{
+	if (Desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET)
+	{
+		return D3D12_RESOURCE_STATE_RENDER_TARGET;
+	}
+	if (Desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)
+	{
+		return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+	}
+	return std::nullopt;
+}
+
+// Records buckets of a dependency level into worker contexts of the graphics queue
+class RgLevelRecorder final : public IRgCommandRecorder
+{
+public:
+	RgLevelRecorder(
+		RenderGraph*						  Graph,
+		D3D12CommandContext&				  Context,
+		std::span<RenderPass* const>		  RenderPasses,
+		std::span<D3D12CommandContext* const> WorkerContexts)
+		: Graph(Graph)
+		, Context(Context)
+		, RenderPasses(RenderPasses)
+		, WorkerContexts(WorkerContexts)
+	{
+	}
+
+	void BeginRecording(size_t NumBuckets) override
+	{
+		// Everything recorded so far, including the barriers of this level, must execute before the buckets
+		Context.Close();
+		Context.Execute(false);
+
+		EventNode = D3D12EventGraph::GetCurrentNode();
+	}
+
+	void RecordBucket(size_t BucketIndex, RgPassBucket Bucket) override
+	{
+		// Nest profile events of the workers under the event that is open on the calling thread
+		D3D12EventGraph::SetCurrentNode(EventNode);
+
+		D3D12CommandContext& WorkerContext = *WorkerContexts[BucketIndex];
+		WorkerContext.Open();
+		for (size_t i = Bucket.Begin; i < Bucket.End; ++i)
+		{
+			if (RenderPasses[i]->Callback)
+			{
+				RenderPasses[i]->Callback(Graph->GetRegistry(), WorkerContext);
+			}
+		}
+		WorkerContext.Close();
+	}
+
+	void EndRecording(size_t NumBuckets) override
+	{
+		D3D12CommandContext::Execute(WorkerContexts.first(NumBuckets), false);
+		Context.Open();
+	}
+
+private:
+	RenderGraph*						  Graph;
+	D3D12CommandContext&				  Context;
+	std::span<RenderPass* const>		  RenderPasses;
+	std::span<D3D12CommandContext* const> WorkerContexts;
+	D3D12EventNode*						  EventNode = nullptr;
+};
+
+RenderPass::RenderPass(RenderGraphAllocator& Allocator, std::string_view Name)
 	: Name(Name)
+	, Reads(Allocator)
+	, Writes(Allocator)
+	, WriteAccesses(Allocator)
+	, ReadWrites(Allocator)
 {
 }
 
@@ -10,35 +122,55 @@ RenderPass& RenderPass::Read(RgResourceHandle Resource)
 	// Only allow buffers/textures
 	assert(Resource.IsValid());
 	assert(Resource.Type == RgResourceType::Buffer || Resource.Type == RgResourceType::Texture);
-	Reads.insert(Resource);
-	ReadWrites.insert(Resource);
+	if (!ReadsFrom(Resource))
+	{
+		Reads.push_back(Resource);
+	}
+	if (!HasDependency(Resource))
+	{
+		ReadWrites.push_back(Resource);
+	}
 	return *this;
 }
 
-RenderPass& RenderPass::Write(RgResourceHandle* Resource)
+RenderPass& RenderPass::Write(RgResourceHandle* Resource, RgWriteAccess Access /*= RgWriteAccess::UnorderedAccess*/)
 {
 	// Only allow buffers/textures
 	assert(Resource && Resource->IsValid());
 	assert(Resource->Type == RgResourceType::Buffer || Resource->Type == RgResourceType::Texture);
+	assert(Resource->Type == RgResourceType::Texture || Access == RgWriteAccess::UnorderedAccess);
 	Resource->Version++;
-	Writes.insert(*Resource);
-	ReadWrites.insert(*Resource);
+	Writes.push_back(*Resource);
+	WriteAccesses.push_back(Access);
+	ReadWrites.push_back(*Resource);
+	return *this;
+}
+
+RenderPass& RenderPass::SetSideEffects()
+{
+	SideEffects = true;
+	return *this;
+}
+
+RenderPass& RenderPass::SetAsyncCompute()
+{
+	AsyncCompute = true;
 	return *this;
 }
 
 bool RenderPass::HasDependency(RgResourceHandle Resource) const
 {
-	return ReadWrites.contains(Resource);
+	return std::ranges::find(ReadWrites, Resource) != ReadWrites.end();
 }
 
 bool RenderPass::WritesTo(RgResourceHandle Resource) const
 {
-	return Writes.contains(Resource);
+	return std::ranges::find(Writes, Resource) != Writes.end();
 }
 
 bool RenderPass::ReadsFrom(RgResourceHandle Resource) const
 {
-	return Reads.contains(Resource);
+	return std::ranges::find(Reads, Resource) != Reads.end();
 }
 
 bool RenderPass::HasAnyDependencies() const noexcept
@@ -48,49 +180,79 @@ bool RenderPass::HasAnyDependencies() const noexcept
 
 void RenderGraphDependencyLevel::AddRenderPass(RenderPass* RenderPass)
 {
-	RenderPasses.push_back(RenderPass);
-	Reads.insert(RenderPass->Reads.begin(), RenderPass->Reads.end());
-	Writes.insert(RenderPass->Writes.begin(), RenderPass->Writes.end());
+	if (RenderPass->Queue == RgQueueType::AsyncCompute)
+	{
+		AsyncComputePasses.push_back(RenderPass);
+	}
+	else
+	{
+		RenderPasses.push_back(RenderPass);
+	}
+}
+
+void RenderGraphDependencyLevel::AddAliasedTexture(RgResourceHandle Texture)
+{
+	AliasedTextures.push_back(Texture);
 }
 
-void RenderGraphDependencyLevel::Execute(RenderGraph* RenderGraph, D3D12CommandContext& Context)
+void RenderGraphDependencyLevel::ApplyBarriers(RenderGraph* RenderGraph, D3D12CommandContext& Context)
 {
-	// Figure out all the barriers needed for each level
-	// Handle resource transitions for all registered resources
-	for (auto Read : Reads)
-	{
-		D3D12_RESOURCE_STATES ReadState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+	RenderGraphRegistry& Registry = RenderGraph->GetRegistry();
 
-		if (RenderGraph->AllowUnorderedAccess(Read))
+	// The heap memory of aliased textures may have been used by other textures in previous levels. Aliased render
+	// targets and depth stencils must be initialized with a discard whatever their first use is, the discard needs
+	// the render target or depth write state and the barriers below move them on to the state of their first use
+	std::vector<D3D12Texture*> Discards;
+	for (auto Texture : AliasedTextures)
+	{
+		D3D12Texture* ApiTexture = Registry.Get<D3D12Texture>(Texture);
+		Context.AliasingBarrier(nullptr, ApiTexture);
+		if (std::optional<D3D12_RESOURCE_STATES> State = GetDiscardState(ApiTexture->GetDesc()))
 		{
-			ReadState |= D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+			Context.TransitionBarrier(ApiTexture, *State);
+			Discards.push_back(ApiTexture);
 		}
-
-		D3D12Texture* Texture = RenderGraph->GetRegistry().Get<D3D12Texture>(Read);
-		Context.TransitionBarrier(Texture, ReadState);
 	}
-	for (auto Write : Writes)
-	{
-		D3D12_RESOURCE_STATES WriteState = D3D12_RESOURCE_STATE_COMMON;
 
-		if (RenderGraph->AllowRenderTarget(Write))
-		{
-			WriteState |= D3D12_RESOURCE_STATE_RENDER_TARGET;
-		}
-		if (RenderGraph->AllowDepthStencil(Write))
+	if (!Discards.empty())
+	{
+		Context.FlushResourceBarriers();
+		for (D3D12Texture* Texture : Discards)
 		{
-			WriteState |= D3D12_RESOURCE_STATE_DEPTH_WRITE;
+			Context->DiscardResource(Texture->GetResource(), nullptr);
 		}
-		if (RenderGraph->AllowUnorderedAccess(Write))
+	}
+
+	for (const auto& Barrier : Barriers)
+	{
+		D3D12Resource* Resource = GetApiResource(Registry, Barrier.Resource);
+		switch (Barrier.Type)
 		{
-			WriteState |= D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+		case RgBarrierType::Transition:
+			Context.TransitionBarrier(Resource, Barrier.State);
+			break;
+		case RgBarrierType::BeginSplit:
+			// Falls back to a regular transition at the end if the state is unknown to this command list
+			std::ignore = Context.BeginTransitionBarrier(Resource, Barrier.State);
+			break;
+		case RgBarrierType::EndSplit:
+			Context.EndTransitionBarrier(Resource, Barrier.State);
+			break;
+		case RgBarrierType::UnorderedAccess:
+			Context.UAVBarrier(Resource);
+			break;
 		}
-
-		D3D12Texture* Texture = RenderGraph->GetRegistry().Get<D3D12Texture>(Write);
-		Context.TransitionBarrier(Texture, WriteState);
 	}
 
 	Context.FlushResourceBarriers();
+}
+
+size_t RenderGraphDependencyLevel::Execute(RenderGraph* RenderGraph, D3D12CommandContext& Context)
+{
+	if (size_t NumCommandLists = ExecuteParallel(RenderGraph, Context); NumCommandLists > 0)
+	{
+		return NumCommandLists;
+	}
 
 	for (auto& RenderPass : RenderPasses)
 	{
@@ -99,6 +261,37 @@ void RenderGraphDependencyLevel::Execute(RenderGraph* RenderGraph, D3D12CommandC
 			RenderPass->Callback(RenderGraph->GetRegistry(), Context);
 		}
 	}
+	return 0;
+}
+
+void RenderGraphDependencyLevel::ExecuteAsyncCompute(RenderGraph* RenderGraph, D3D12CommandContext& Context)
+{
+	for (auto& RenderPass : AsyncComputePasses)
+	{
+		if (RenderPass->Callback)
+		{
+			RenderPass->Callback(RenderGraph->GetRegistry(), Context);
+		}
+	}
+}
+
+size_t RenderGraphDependencyLevel::ExecuteParallel(RenderGraph* RenderGraph, D3D12CommandContext& Context)
+{
+	RgScheduler* Scheduler = RenderGraph->Scheduler;
+	if (!Scheduler)
+	{
+		return 0;
+	}
+
+	// Splitting a level costs an extra submission, only worth it if there are multiple buckets
+	size_t MinPassesPerBucket = static_cast<size_t>(std::max(static_cast<int>(CVar_MinPassesPerCommandList), 1));
+	if (RgScheduler::Partition(RenderPasses.size(), Scheduler->GetMaxConcurrency(), MinPassesPerBucket).size() < 2)
+	{
+		return 0;
+	}
+
+	RgLevelRecorder Recorder(RenderGraph, Context, RenderPasses, RenderGraph->WorkerContexts);
+	return Scheduler->Execute(Recorder, RenderPasses.size(), MinPassesPerBucket);
 }
 
 RenderGraph::RenderGraph(RenderGraphAllocator& Allocator, RenderGraphRegistry& Registry)
@@ -108,7 +301,7 @@ RenderGraph::RenderGraph(RenderGraphAllocator& Allocator, RenderGraphRegistry& R
 	Allocator.Reset();
 
 	// Allocate epilogue pass after allocator reset
-	EpiloguePass = Allocator.Construct<RenderPass>("Epilogue");
+	EpiloguePass = Allocator.Construct<RenderPass>(Allocator, "Epilogue");
 }
 
 RenderGraph::~RenderGraph()
@@ -117,12 +310,17 @@ RenderGraph::~RenderGraph()
 	{
 		Allocator.Destruct(RenderPass);
 	}
+	for (auto RenderPass : CulledPasses)
+	{
+		Allocator.Destruct(RenderPass);
+	}
 	RenderPasses.clear();
+	CulledPasses.clear();
 }
 
 RenderPass& RenderGraph::AddRenderPass(std::string_view Name)
 {
-	RenderPass* NewRenderPass = Allocator.Construct<RenderPass>(Name);
+	RenderPass* NewRenderPass = Allocator.Construct<RenderPass>(Allocator, Name);
 	RenderPasses.emplace_back(NewRenderPass);
 	return *NewRenderPass;
 }
@@ -143,11 +341,123 @@ void RenderGraph::Execute(D3D12CommandContext& Context)
 	Setup();
 	Registry.RealizeResources(this);
 
+	D3D12LinkedDevice* Device = Context.GetParentLinkedDevice();
+
+	// Every context of the graphics queue other than the one recording the graph can be used by a worker
+	WorkerContexts.clear();
+	if (CVar_ParallelRecording)
+	{
+		for (UINT i = 0; i < Device->GetNumCommandContexts(); ++i)
+		{
+			if (D3D12CommandContext* WorkerContext = &Device->GetCommandContext(i); WorkerContext != &Context)
+			{
+				WorkerContexts.push_back(WorkerContext);
+			}
+		}
+	}
+
+	Scheduler = nullptr;
+	if (WorkerContexts.size() >= 2)
+	{
+		if (!Registry.Scheduler || Registry.Scheduler->GetMaxConcurrency() != WorkerContexts.size())
+		{
+			Registry.Scheduler = std::make_unique<RgScheduler>(WorkerContexts.size() - 1);
+		}
+		Scheduler = Registry.Scheduler.get();
+	}
+	Registry.RecordingStats = {};
+
+	D3D12CommandQueue*	 GraphicsQueue		 = Context.GetCommandQueue();
+	D3D12CommandQueue*	 AsyncComputeQueue	 = Device->GetAsyncComputeQueue();
+	D3D12CommandContext& AsyncComputeContext = Device->GetAsyncComputeCommandContext();
+	bool				 AsyncComputeOpen	 = false;
+
+	std::vector<D3D12SyncHandle> SyncHandles(SyncPlan.Signals.size());
+
+	// Submitting ends the command list, the queue signals once the submitted work completes
+	auto Submit = [&](bool AsyncCompute) -> D3D12SyncHandle
+	{
+		if (AsyncCompute)
+		{
+			assert(AsyncComputeOpen);
+			AsyncComputeOpen = false;
+			AsyncComputeContext.Close();
+			return AsyncComputeContext.Execute(false);
+		}
+
+		Context.Close();
+		D3D12SyncHandle SyncHandle = Context.Execute(false);
+		Context.Open();
+		return SyncHandle;
+	};
+
+	auto Wait = [&](size_t Node, bool AsyncCompute)
+	{
+		const auto& Waits = SyncPlan.Waits[Node];
+		if (Waits.empty())
+		{
+			return;
+		}
+
+		// Work recorded before the wait does not depend on the other queue, submit it first
+		if (!AsyncCompute || AsyncComputeOpen)
+		{
+			Submit(AsyncCompute);
+		}
+
+		D3D12CommandQueue* Queue = AsyncCompute ? AsyncComputeQueue : GraphicsQueue;
+		for (const auto& QueueWait : Waits)
+		{
+			Queue->WaitForSyncHandle(SyncHandles[QueueWait.Node]);
+		}
+		Registry.RecordingStats.NumQueueWaits += Waits.size();
+	};
+
+	auto Signal = [&](size_t Node, bool AsyncCompute)
+	{
+		if (SyncPlan.Signals[Node])
+		{
+			SyncHandles[Node] = Submit(AsyncCompute);
+		}
+	};
+
 	D3D12ScopedEvent(Context, "Render Graph");
-	for (auto& DependencyLevel : DependencyLevels)
+	for (size_t i = 0; i < DependencyLevels.size(); ++i)
 	{
-		DependencyLevel.Execute(this, Context);
+		RenderGraphDependencyLevel& DependencyLevel = DependencyLevels[i];
+
+		size_t BarrierNode = RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_Barriers);
+		Wait(BarrierNode, false);
+		DependencyLevel.ApplyBarriers(this, Context);
+		Signal(BarrierNode, false);
+
+		if (DependencyLevel.HasAsyncComputePasses())
+		{
+			size_t AsyncComputeNode = RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_AsyncCompute);
+			Wait(AsyncComputeNode, true);
+			if (!AsyncComputeOpen)
+			{
+				AsyncComputeContext.Open();
+				AsyncComputeOpen = true;
+			}
+			DependencyLevel.ExecuteAsyncCompute(this, AsyncComputeContext);
+			Registry.RecordingStats.NumAsyncComputePasses += DependencyLevel.AsyncComputePasses.size();
+			Signal(AsyncComputeNode, true);
+		}
+
+		size_t GraphicsNode = RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_Graphics);
+		Wait(GraphicsNode, false);
+		if (size_t NumCommandLists = DependencyLevel.Execute(this, Context); NumCommandLists > 0)
+		{
+			Registry.RecordingStats.NumParallelLevels++;
+			Registry.RecordingStats.NumCommandLists += NumCommandLists;
+		}
+		Signal(GraphicsNode, false);
 	}
+
+	// Async compute work must not outlive the frame, resources it uses may be released or reused by the next graph
+	Wait(RgSyncPlanner::GetFrameEndNode(DependencyLevels.size()), false);
+	assert(!AsyncComputeOpen);
 }
 
 bool RenderGraph::AllowRenderTarget(RgResourceHandle Resource) const noexcept
@@ -167,7 +477,12 @@ bool RenderGraph::AllowDepthStencil(RgResourceHandle Resource) const noexcept
 bool RenderGraph::AllowUnorderedAccess(RgResourceHandle Resource) const noexcept
 {
 	assert(Resource.Type == RgResourceType::Buffer || Resource.Type == RgResourceType::Texture);
-	// TODO: Buffer
+	if (Resource.Type == RgResourceType::Buffer)
+	{
+		assert(Resource.Id < Buffers.size());
+		return Buffers[Resource.Id].Desc.UnorderedAccess;
+	}
+	assert(Resource.Id < Textures.size());
 	return Textures[Resource.Id].Desc.UnorderedAccess;
 }
 
@@ -179,102 +494,505 @@ void RenderGraph::Setup()
 	// https://www.gdcvault.com/play/1024612/FrameGraph-Extensible-Rendering-Architecture-in
 	// https://media.contentapi.ea.com/content/dam/ea/seed/presentations/wihlidal-halcyonarchitecture-notes.pdf
 
+	// The declared graph is usually identical from frame to frame, in which case the compiled graph of the
+	// previous frame is reused and only the callbacks declared this frame are bound
+	StructureHash = ComputeStructureHash();
+	Cached		  = Registry.CompiledGraph.Hash == StructureHash;
+	if (Cached)
+	{
+		LoadCompiledGraph(Registry.CompiledGraph);
+	}
+	else
+	{
+		Compile(Registry.CompiledGraph);
+	}
+
+	AssignQueues();
+
+	DependencyLevels.resize(*std::ranges::max_element(Distances) + 1);
+	for (size_t i = 0; i < TopologicalSortedPasses.size(); ++i)
+	{
+		// Distances are indexed by the pass index, not the sorted index
+		int level = Distances[TopologicalSortedPasses[i]->TopologicalIndex];
+		DependencyLevels[level].AddRenderPass(TopologicalSortedPasses[i]);
+	}
+
+	ComputeResourceLifetimes();
+	BuildBarriers();
+	BuildSyncPlan();
+}
+
+void RenderGraph::Compile(RgCompiledGraph& CompiledGraph)
+{
+	std::vector<bool> Alive = CullRenderPasses();
+	RemoveCulledPasses(Alive);
+
 	// Adjacency lists
-	AdjacencyLists.resize(RenderPasses.size());
+	// Every resource version has a single producer, so edges are found with one sweep over the reads
+	// instead of testing every pass against every other pass
+	BuildProducerTable();
+
+	RgDependencyGraph Graph = RgDependencyGraph::Build(
+		Producers,
+		RenderPasses.size(),
+		[this](size_t i, auto&& Callback)
+		{
+			for (auto Resource : RenderPasses[i]->Reads)
+			{
+				Callback(GetResourceVersion(Resource));
+			}
+		});
 
-	for (size_t i = 0; i < RenderPasses.size(); ++i)
+	AdjacencyLists = std::move(Graph.AdjacencyLists);
+	Distances	   = std::move(Graph.Distances);
+
+	TopologicalSortedPasses.reserve(Graph.TopologicalOrder.size());
+	for (size_t i : Graph.TopologicalOrder)
 	{
-		RenderPass* Node = RenderPasses[i];
-		if (!Node->HasAnyDependencies())
+		RenderPasses[i]->TopologicalIndex = i;
+		TopologicalSortedPasses.push_back(RenderPasses[i]);
+	}
+
+	CompiledGraph.Hash			   = StructureHash;
+	CompiledGraph.Alive			   = std::move(Alive);
+	CompiledGraph.AdjacencyLists   = AdjacencyLists;
+	CompiledGraph.TopologicalOrder = std::move(Graph.TopologicalOrder);
+	CompiledGraph.Distances		   = Distances;
+}
+
+void RenderGraph::LoadCompiledGraph(const RgCompiledGraph& CompiledGraph)
+{
+	RemoveCulledPasses(CompiledGraph.Alive);
+
+	AdjacencyLists = CompiledGraph.AdjacencyLists;
+
+	TopologicalSortedPasses.reserve(CompiledGraph.TopologicalOrder.size());
+	for (size_t i : CompiledGraph.TopologicalOrder)
+	{
+		RenderPasses[i]->TopologicalIndex = i;
+		TopologicalSortedPasses.push_back(RenderPasses[i]);
+	}
+
+	Distances = CompiledGraph.Distances;
+}
+
+void RenderGraph::ComputeResourceLifetimes()
+{
+	// Passes within a dependency level have their barriers batched, so a level is the smallest
+	// unit of time a texture can be alive for
+	for (auto& Texture : Textures)
+	{
+		Texture.Usage = { .Persistent = Texture.Desc.Persistent };
+	}
+
+	for (auto RenderPass : TopologicalSortedPasses)
+	{
+		size_t Level = static_cast<size_t>(Distances[RenderPass->TopologicalIndex]);
+		for (auto Resource : RenderPass->ReadWrites)
+		{
+			if (Resource.Type == RgResourceType::Texture)
+			{
+				RgResourceUsage& Usage = Textures[Resource.Id].Usage;
+				Usage.Lifetime.Extend(Level);
+				Usage.AsyncCompute |= RenderPass->Queue == RgQueueType::AsyncCompute;
+			}
+		}
+	}
+
+	for (auto Resource : EpiloguePass->Reads)
+	{
+		if (Resource.Type == RgResourceType::Texture)
+		{
+			Textures[Resource.Id].Usage.Exported = true;
+		}
+	}
+
+	for (const auto& Texture : Textures)
+	{
+		if (Texture.Usage.IsTransient())
+		{
+			DependencyLevels[Texture.Usage.Lifetime.Begin].AddAliasedTexture(Texture.Handle);
+		}
+	}
+}
+
+void RenderGraph::AssignQueues()
+{
+	for (auto RenderPass : TopologicalSortedPasses)
+	{
+		RenderPass->Queue = RgQueueType::Graphics;
+		if (!CVar_AsyncCompute || !RenderPass->AsyncCompute)
 		{
 			continue;
 		}
 
-		std::vector<UINT64>& Indices = AdjacencyLists[i];
+		// The compute queue cannot access render targets/depth stencils
+		bool Eligible = std::ranges::all_of(
+			RenderPass->Writes,
+			[this](RgResourceHandle Resource)
+			{
+				if (Resource.Type == RgResourceType::Buffer)
+				{
+					return AllowUnorderedAccess(Resource);
+				}
+				return AllowUnorderedAccess(Resource) && !AllowRenderTarget(Resource) && !AllowDepthStencil(Resource);
+			});
+		if (Eligible)
+		{
+			RenderPass->Queue = RgQueueType::AsyncCompute;
+		}
+	}
+}
+
+void RenderGraph::BuildBarriers()
+{
+	// Every resource is transitioned to the exact state its passes need, only when that differs from the state it
+	// was left in. A resource idle for at least one level begins its transition right after its last use
+	struct ResourceUse
+	{
+		D3D12_RESOURCE_STATES State = D3D12_RESOURCE_STATE_UNKNOWN; // Unknown until first used in the graph
+		size_t				  Level = SIZE_MAX;
+	};
+
+	std::vector<ResourceUse> LastUses(Textures.size() + Buffers.size());
+	RgBarrierStats			 Stats		   = {};
+	bool					 SplitBarriers = CVar_SplitBarriers;
 
-		// Reverse iterate the render passes here, because often or not, the adjacency list should be built upon
-		// the latest changes to the render passes since those pass are more likely to change the resource we are writing to from other passes
-		// if we were to iterate from 0 to RenderPasses.size(), it'd often break the algorithm and
-		// creates an valid, but incorrect adjacency list
-		for (size_t j = RenderPasses.size(); j-- != 0;)
+	auto GetIndex = [this](RgResourceHandle Resource)
+	{
+		return Resource.Type == RgResourceType::Texture ? Resource.Id : Textures.size() + Resource.Id;
+	};
+
+	std::vector<RgBarrier> States;
+	for (size_t i = 0; i < DependencyLevels.size(); ++i)
+	{
+		RenderGraphDependencyLevel& DependencyLevel = DependencyLevels[i];
+		Stats.NumAliasingBarriers += DependencyLevel.AliasedTextures.size();
+
+		// Reads of different passes combine, a pass that reads and writes a resource accesses it in the write state
+		States.clear();
+		for (const auto& Passes : { &DependencyLevel.RenderPasses, &DependencyLevel.AsyncComputePasses })
 		{
-			if (i == j)
+			for (auto RenderPass : *Passes)
 			{
+				for (auto Resource : RenderPass->ReadWrites)
+				{
+					Stats.NumAccesses++;
+
+					D3D12_RESOURCE_STATES State = GetRequiredState(RenderPass, Resource);
+
+					auto Iter = std::ranges::find_if(
+						States,
+						[&](const RgBarrier& Barrier)
+						{
+							return Barrier.Resource.Type == Resource.Type && Barrier.Resource.Id == Resource.Id;
+						});
+					if (Iter == States.end())
+					{
+						States.push_back({ Resource, State, RgBarrierType::Transition });
+					}
+					else if (IsReadOnlyState(Iter->State) && IsReadOnlyState(State))
+					{
+						Iter->State |= State;
+					}
+					else if (!IsReadOnlyState(State))
+					{
+						Iter->State = State;
+					}
+				}
+			}
+		}
+
+		for (auto [Resource, State, Type] : States)
+		{
+			ResourceUse& LastUse = LastUses[GetIndex(Resource)];
+
+			// Successive unordered accesses need to be ordered, but not transitioned
+			if (LastUse.State == State && State == D3D12_RESOURCE_STATE_UNORDERED_ACCESS)
+			{
+				DependencyLevel.Barriers.push_back({ Resource, State, RgBarrierType::UnorderedAccess });
+				Stats.NumUavBarriers++;
+				LastUse.Level = i;
 				continue;
 			}
 
-			RenderPass* Neighbor = RenderPasses[j];
-			for (auto Resource : Node->Writes)
+			// Read only states are widened, reading a subset of the states a resource is in needs no transition
+			if (IsReadOnlyState(LastUse.State) && IsReadOnlyState(State))
 			{
-				// If the neighbor reads from a resource written to by the current pass, then it is a dependency, add it to the adjacency list
-				if (Neighbor->ReadsFrom(Resource))
-				{
-					Indices.push_back(j);
-					break;
-				}
+				State |= LastUse.State;
+			}
+			if (LastUse.State == State)
+			{
+				Stats.NumSkippedTransitions++;
+				LastUse.Level = i;
+				continue;
+			}
+
+			if (SplitBarriers && LastUse.State != D3D12_RESOURCE_STATE_UNKNOWN && LastUse.Level + 1 < i)
+			{
+				DependencyLevels[LastUse.Level + 1].Barriers.push_back({ Resource, State, RgBarrierType::BeginSplit });
+				DependencyLevel.Barriers.push_back({ Resource, State, RgBarrierType::EndSplit });
+				Stats.NumSplitBarriers++;
+			}
+			else
+			{
+				DependencyLevel.Barriers.push_back({ Resource, State, RgBarrierType::Transition });
 			}
+			Stats.NumTransitions++;
+			LastUse = { State, i };
 		}
 	}
 
-	// Topological sort
-	std::stack<size_t> Stack;
-	std::vector<bool>  Visited(RenderPasses.size(), false);
+	Registry.BarrierStats = Stats;
+}
+
+D3D12_RESOURCE_STATES RenderGraph::GetRequiredState(const RenderPass* RenderPass, RgResourceHandle Resource) const noexcept
+{
+	bool Texture = Resource.Type == RgResourceType::Texture;
 
-	for (size_t i = 0; i < RenderPasses.size(); i++)
+	if (auto Iter = std::ranges::find(RenderPass->Writes, Resource); Iter != RenderPass->Writes.end())
 	{
-		if (!Visited[i])
+		// The pass declared how it writes the resource, the texture has to allow it
+		switch (RenderPass->WriteAccesses[Iter - RenderPass->Writes.begin()])
 		{
-			DepthFirstSearch(i, Visited, Stack);
+		case RgWriteAccess::RenderTarget:
+			assert(Texture && AllowRenderTarget(Resource));
+			return D3D12_RESOURCE_STATE_RENDER_TARGET;
+		case RgWriteAccess::DepthStencil:
+			assert(Texture && AllowDepthStencil(Resource));
+			return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+		default:
+			assert(AllowUnorderedAccess(Resource));
+			return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 		}
 	}
 
-	TopologicalSortedPasses.reserve(Stack.size());
-	while (!Stack.empty())
+	// The epilogue hands its reads to whatever samples them after the graph, the async compute queue
+	// cannot use pixel shader resources, passes of the graphics queue may read from any shader stage
+	if (RenderPass == EpiloguePass)
 	{
-		size_t i						  = Stack.top();
-		RenderPasses[i]->TopologicalIndex = i;
-		TopologicalSortedPasses.push_back(RenderPasses[i]);
-		Stack.pop();
+		return D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 	}
+	if (RenderPass->Queue == RgQueueType::AsyncCompute)
+	{
+		return D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+	}
+	return D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+}
 
-	// Longest path search
-	// Render passes in a dependency level share the same recursion depth,
-	// or rather maximum recursion depth AKA longest path in a DAG
-	std::vector<int> Distances(TopologicalSortedPasses.size(), 0);
+void RenderGraph::BuildSyncPlan()
+{
+	static_assert(static_cast<size_t>(RgQueueType::Graphics) == RgSyncQueue_Graphics);
+	static_assert(static_cast<size_t>(RgQueueType::AsyncCompute) == RgSyncQueue_AsyncCompute);
 
-	for (auto& TopologicalSortedPass : TopologicalSortedPasses)
+	std::vector<RgSyncLevel> Levels(DependencyLevels.size());
+	for (size_t i = 0; i < DependencyLevels.size(); ++i)
 	{
-		size_t u = TopologicalSortedPass->TopologicalIndex;
-		for (auto v : AdjacencyLists[u])
+		const RenderGraphDependencyLevel& DependencyLevel = DependencyLevels[i];
+
+		RgSyncLevel& Level	  = Levels[i];
+		Level.HasAsyncCompute = DependencyLevel.HasAsyncComputePasses();
+		for (const auto& Barrier : DependencyLevel.Barriers)
 		{
-			if (Distances[v] < Distances[u] + 1)
+			Level.BarrierResources.push_back(GetResourceVersion(Barrier.Resource).Resource);
+		}
+		for (auto RenderPass : DependencyLevel.AsyncComputePasses)
+		{
+			for (auto Resource : RenderPass->ReadWrites)
 			{
-				Distances[v] = Distances[u] + 1;
+				Level.AsyncComputeResources.push_back(GetResourceVersion(Resource).Resource);
 			}
 		}
 	}
 
-	DependencyLevels.resize(*std::ranges::max_element(Distances) + 1);
-	for (size_t i = 0; i < TopologicalSortedPasses.size(); ++i)
+	std::vector<RgSyncNode> Nodes = RgSyncPlanner::BuildLevelNodes(Levels, Textures.size() + Buffers.size());
+	SyncPlan					  = RgSyncPlanner::Plan(Nodes, RgSyncQueue_Count);
+}
+
+template<typename T>
+static void HashCombine(UINT64& Hash, const T& Value)
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&Value), sizeof(T), Hash);
+}
+
+static void HashCombine(UINT64& Hash, std::string_view Value)
+{
+	Hash = CityHash64WithSeed(Value.data(), Value.size(), Hash);
+}
+
+UINT64 RenderGraph::ComputeStructureHash() const
+{
+	// Fields are hashed one by one, descs contain padding and unions that are not fully initialized
+	UINT64 Hash = 0;
+
+	HashCombine(Hash, RenderPasses.size());
+	for (auto RenderPass : RenderPasses)
 	{
-		int level = Distances[i];
-		DependencyLevels[level].AddRenderPass(TopologicalSortedPasses[i]);
+		HashCombine(Hash, RenderPass->Name);
+		HashCombine(Hash, RenderPass->SideEffects);
+		HashCombine(Hash, RenderPass->Reads.size());
+		for (auto Resource : RenderPass->Reads)
+		{
+			HashCombine(Hash, Resource);
+		}
+		HashCombine(Hash, RenderPass->Writes.size());
+		for (auto Resource : RenderPass->Writes)
+		{
+			HashCombine(Hash, Resource);
+		}
+	}
+
+	HashCombine(Hash, Buffers.size());
+	for (const auto& Buffer : Buffers)
+	{
+		HashCombine(Hash, Buffer.Name);
+		HashCombine(Hash, Buffer.Desc.SizeInBytes);
+		HashCombine(Hash, Buffer.Desc.UnorderedAccess);
+	}
+
+	HashCombine(Hash, Textures.size());
+	for (const auto& Texture : Textures)
+	{
+		const RgTextureDesc& Desc = Texture.Desc;
+		HashCombine(Hash, Texture.Name);
+		HashCombine(Hash, Desc.Format);
+		HashCombine(Hash, Desc.Type);
+		HashCombine(Hash, Desc.Width);
+		HashCombine(Hash, Desc.Height);
+		HashCombine(Hash, Desc.DepthOrArraySize);
+		HashCombine(Hash, Desc.MipLevels);
+		HashCombine(Hash, Desc.RenderTarget);
+		HashCombine(Hash, Desc.DepthStencil);
+		HashCombine(Hash, Desc.UnorderedAccess);
+		HashCombine(Hash, Desc.Persistent);
+		HashCombine(Hash, Desc.OptimizedClearValue.has_value());
+		if (Desc.OptimizedClearValue)
+		{
+			HashCombine(Hash, Desc.OptimizedClearValue->Format);
+			HashCombine(Hash, Desc.OptimizedClearValue->Color);
+		}
+	}
+
+	HashCombine(Hash, RenderTargets.size());
+	for (const auto& RenderTarget : RenderTargets)
+	{
+		const RgRenderTargetDesc& Desc = RenderTarget.Desc;
+		HashCombine(Hash, Desc.NumRenderTargets);
+		for (UINT i = 0; i < Desc.NumRenderTargets; ++i)
+		{
+			HashCombine(Hash, Desc.RenderTargets[i]);
+			HashCombine(Hash, Desc.sRGB[i]);
+		}
+		HashCombine(Hash, Desc.DepthStencil);
+	}
+
+	for (const auto& Views : { &ShaderResourceViews, &UnorderedAccessViews })
+	{
+		HashCombine(Hash, Views->size());
+		for (const auto& View : *Views)
+		{
+			const RgViewDesc& Desc = View.Desc;
+			HashCombine(Hash, Desc.Resource);
+			HashCombine(Hash, Desc.Type);
+			switch (Desc.Type)
+			{
+			case RgViewType::BufferSrv:
+				HashCombine(Hash, Desc.BufferSrv.Raw);
+				HashCombine(Hash, Desc.BufferSrv.FirstElement);
+				HashCombine(Hash, Desc.BufferSrv.NumElements);
+				break;
+			case RgViewType::BufferUav:
+				HashCombine(Hash, Desc.BufferUav.NumElements);
+				HashCombine(Hash, Desc.BufferUav.CounterOffsetInBytes);
+				break;
+			case RgViewType::TextureSrv:
+				HashCombine(Hash, Desc.TextureSrv.sRGB);
+				HashCombine(Hash, Desc.TextureSrv.MostDetailedMip);
+				HashCombine(Hash, Desc.TextureSrv.MipLevels);
+				break;
+			case RgViewType::TextureUav:
+				HashCombine(Hash, Desc.TextureUav.ArraySlice);
+				HashCombine(Hash, Desc.TextureUav.MipSlice);
+				break;
+			}
+		}
 	}
+
+	return Hash;
+}
+
+RgResourceVersion RenderGraph::GetResourceVersion(RgResourceHandle Resource) const noexcept
+{
+	size_t Index = Resource.Type == RgResourceType::Texture ? Resource.Id : Textures.size() + Resource.Id;
+	return { Index, Resource.Version };
 }
 
-void RenderGraph::DepthFirstSearch(size_t n, std::vector<bool>& Visited, std::stack<size_t>& Stack)
+void RenderGraph::BuildProducerTable()
 {
-	Visited[n] = true;
+	Producers.Build(
+		Textures.size() + Buffers.size(),
+		RenderPasses.size(),
+		[this](size_t i, auto&& Callback)
+		{
+			for (auto Resource : RenderPasses[i]->Writes)
+			{
+				Callback(GetResourceVersion(Resource));
+			}
+		});
+}
 
-	for (auto i : AdjacencyLists[n])
+std::vector<bool> RenderGraph::CullRenderPasses()
+{
+	// Walk backwards from the epilogue and passes with side effects through the producers of every read,
+	// passes that are never reached do not contribute to the frame
+	BuildProducerTable();
+
+	std::vector<bool> Alive(RenderPasses.size(), false);
+	for (size_t i = 0; i < RenderPasses.size(); ++i)
 	{
-		if (!Visited[i])
+		RenderPass* RenderPass = RenderPasses[i];
+
+		// Writes to persistent textures are visible in later frames
+		bool WritesPersistent = std::ranges::any_of(
+			RenderPass->Writes,
+			[this](RgResourceHandle Resource)
+			{
+				return Resource.Type == RgResourceType::Texture && Textures[Resource.Id].Desc.Persistent;
+			});
+
+		Alive[i] = RenderPass == EpiloguePass || RenderPass->SideEffects || WritesPersistent;
+	}
+
+	Producers.PropagateAlive(
+		Alive,
+		[this](size_t i, auto&& Callback)
 		{
-			DepthFirstSearch(i, Visited, Stack);
+			for (auto Resource : RenderPasses[i]->Reads)
+			{
+				Callback(GetResourceVersion(Resource));
+			}
+		});
+
+	return Alive;
+}
+
+void RenderGraph::RemoveCulledPasses(const std::vector<bool>& Alive)
+{
+	std::vector<RenderPass*> AlivePasses;
+	AlivePasses.reserve(RenderPasses.size());
+	for (size_t i = 0; i < RenderPasses.size(); ++i)
+	{
+		if (Alive[i])
+		{
+			AlivePasses.push_back(RenderPasses[i]);
+		}
+		else
+		{
+			CulledPasses.push_back(RenderPasses[i]);
 		}
 	}
-
-	Stack.push(n);
+	RenderPasses = std::move(AlivePasses);
 }
 
 void RenderGraph::ExportDgml(DgmlBuilder& Builder)
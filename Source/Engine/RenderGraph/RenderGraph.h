@@ -1,54 +1,37 @@
 #pragma once
+#include "RenderGraphAllocator.h"
+#include "RenderGraphCompiler.h"
 #include "RenderGraphRegistry.h"
 #include "DgmlBuilder.h"
 
-#include <stack>
-
-class RenderGraphAllocator
+enum class RgQueueType
 {
-public:
-	explicit RenderGraphAllocator(size_t SizeInBytes)
-		: BaseAddress(std::make_unique<BYTE[]>(SizeInBytes))
-		, Ptr(BaseAddress.get())
-		, Sentinel(Ptr + SizeInBytes)
-		, CurrentMemoryUsage(0)
-	{
-	}
-
-	void* Allocate(size_t SizeInBytes, size_t Alignment)
-	{
-		SizeInBytes	 = AlignUp(SizeInBytes, Alignment);
-		BYTE* Result = Ptr += SizeInBytes;
-		assert(Result + SizeInBytes <= Sentinel);
-
-		CurrentMemoryUsage += SizeInBytes;
-		return Result;
-	}
-
-	template<typename T, typename... TArgs>
-	T* Construct(TArgs&&... Args)
-	{
-		void* Memory = Allocate(sizeof(T), 16);
-		return new (Memory) T(std::forward<TArgs>(Args)...);
-	}
+	Graphics,
+	AsyncCompute,
+	Count
+};
 
-	template<typename T>
-	static void Destruct(T* Ptr)
-	{
-		Ptr->~T();
-	}
+enum class RgBarrierType
+{
+	Transition,
+	BeginSplit, // Recorded after the last use of the resource
+	EndSplit,	// Recorded before the next use of the resource
+	UnorderedAccess
+};
 
-	void Reset()
-	{
-		Ptr				   = BaseAddress.get();
-		CurrentMemoryUsage = 0;
-	}
+// How a pass writes a resource, textures that allow several kinds of writes are transitioned according to it
+enum class RgWriteAccess
+{
+	UnorderedAccess,
+	RenderTarget,
+	DepthStencil
+};
 
-private:
-	std::unique_ptr<BYTE[]> BaseAddress;
-	BYTE*					Ptr;
-	BYTE*					Sentinel;
-	std::size_t				CurrentMemoryUsage;
+struct RgBarrier
+{
+	RgResourceHandle	  Resource;
+	D3D12_RESOURCE_STATES State;
+	RgBarrierType		  Type;
 };
 
 class RenderPass
@@ -56,10 +39,17 @@ class RenderPass
 public:
 	using ExecuteCallback = Delegate<void(RenderGraphRegistry& Registry, D3D12CommandContext& Context)>;
 
-	RenderPass(std::string_view Name);
+	RenderPass(RenderGraphAllocator& Allocator, std::string_view Name);
 
 	RenderPass& Read(RgResourceHandle Resource);
-	RenderPass& Write(RgResourceHandle* Resource);
+	RenderPass& Write(RgResourceHandle* Resource, RgWriteAccess Access = RgWriteAccess::UnorderedAccess);
+
+	// Passes with side effects are never culled, even if nothing consumes their writes
+	RenderPass& SetSideEffects();
+
+	// Compute only passes may run on the async compute queue, the graph falls back to the graphics queue
+	// if the pass writes textures that the compute queue cannot access
+	RenderPass& SetAsyncCompute();
 
 	template<typename PFNRenderPassCallback>
 	void Execute(PFNRenderPassCallback&& Callback)
@@ -75,10 +65,15 @@ public:
 
 	std::string_view Name;
 	size_t			 TopologicalIndex = 0;
+	bool			 SideEffects	  = false;
+	bool			 AsyncCompute	  = false;
+	RgQueueType		 Queue			  = RgQueueType::Graphics; // Assigned by the graph
 
-	std::unordered_set<RgResourceHandle> Reads;
-	std::unordered_set<RgResourceHandle> Writes;
-	std::unordered_set<RgResourceHandle> ReadWrites;
+	// Passes declare a handful of resources, linear search over a flat array beats hashing
+	RgVector<RgResourceHandle> Reads;
+	RgVector<RgResourceHandle> Writes;
+	RgVector<RgWriteAccess>	   WriteAccesses; // Parallel to Writes
+	RgVector<RgResourceHandle> ReadWrites;
 
 	ExecuteCallback Callback;
 };
@@ -88,14 +83,32 @@ class RenderGraphDependencyLevel
 public:
 	void AddRenderPass(RenderPass* RenderPass);
 
-	void Execute(RenderGraph* RenderGraph, D3D12CommandContext& Context);
+	// Transient textures whose lifetime begins at this level
+	void AddAliasedTexture(RgResourceHandle Texture);
+
+	[[nodiscard]] bool HasAsyncComputePasses() const noexcept { return !AsyncComputePasses.empty(); }
+
+	// Barriers of the passes on both queues are recorded on the graphics queue
+	void ApplyBarriers(RenderGraph* RenderGraph, D3D12CommandContext& Context);
+
+	// Returns the number of worker command lists the passes were recorded into, 0 if recorded into Context
+	size_t Execute(RenderGraph* RenderGraph, D3D12CommandContext& Context);
+
+	void ExecuteAsyncCompute(RenderGraph* RenderGraph, D3D12CommandContext& Context);
+
+private:
+	size_t ExecuteParallel(RenderGraph* RenderGraph, D3D12CommandContext& Context);
 
 private:
+	friend class RenderGraph;
+
 	std::vector<RenderPass*> RenderPasses;
+	std::vector<RenderPass*> AsyncComputePasses;
+
+	// Apply barriers at a dependency level to reduce redudant barriers, filled in by RenderGraph::BuildBarriers
+	std::vector<RgBarrier> Barriers;
 
-	// Apply barriers at a dependency level to reduce redudant barriers
-	std::unordered_set<RgResourceHandle> Reads;
-	std::unordered_set<RgResourceHandle> Writes;
+	std::vector<RgResourceHandle> AliasedTextures;
 };
 
 class RenderGraph
@@ -166,7 +179,27 @@ public:
 private:
 	void Setup();
 
-	void DepthFirstSearch(size_t n, std::vector<bool>& Visited, std::stack<size_t>& Stack);
+	[[nodiscard]] UINT64 ComputeStructureHash() const;
+
+	void Compile(RgCompiledGraph& CompiledGraph);
+	void LoadCompiledGraph(const RgCompiledGraph& CompiledGraph);
+
+	// Textures are numbered first followed by buffers
+	[[nodiscard]] RgResourceVersion GetResourceVersion(RgResourceHandle Resource) const noexcept;
+
+	void BuildProducerTable();
+
+	[[nodiscard]] std::vector<bool> CullRenderPasses();
+	void							RemoveCulledPasses(const std::vector<bool>& Alive);
+
+	void ComputeResourceLifetimes();
+
+	void AssignQueues();
+	void BuildBarriers();
+	void BuildSyncPlan();
+
+	// State a pass needs a resource in, derived from how the pass accesses it and the queue the pass runs on
+	[[nodiscard]] D3D12_RESOURCE_STATES GetRequiredState(const RenderPass* RenderPass, RgResourceHandle Resource) const noexcept;
 
 	std::string_view GetResourceName(RgResourceHandle Handle)
 	{
@@ -182,6 +215,7 @@ private:
 
 private:
 	friend class RenderGraphRegistry;
+	friend class RenderGraphDependencyLevel;
 
 	RenderGraphAllocator& Allocator;
 	RenderGraphRegistry&  Registry;
@@ -193,10 +227,23 @@ private:
 	std::vector<RgView>			UnorderedAccessViews;
 
 	std::vector<RenderPass*> RenderPasses;
+	std::vector<RenderPass*> CulledPasses;
 	RenderPass*				 EpiloguePass;
 
-	std::vector<std::vector<UINT64>> AdjacencyLists;
+	RgProducerTable Producers;
+
+	std::vector<std::vector<size_t>> AdjacencyLists;
 	std::vector<RenderPass*>		 TopologicalSortedPasses;
+	std::vector<int>				 Distances;
+
+	UINT64 StructureHash = 0;
+	bool   Cached		 = false;
 
 	std::vector<RenderGraphDependencyLevel> DependencyLevels;
+
+	RgSyncPlan SyncPlan;
+
+	// Set during Execute when parallel recording is enabled, bucket i is recorded into WorkerContexts[i]
+	RgScheduler*					  Scheduler = nullptr;
+	std::vector<D3D12CommandContext*> WorkerContexts;
 };
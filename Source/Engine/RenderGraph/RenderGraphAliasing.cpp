@@ -0,0 +1,97 @@
+#include "RenderGraphAliasing.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+static std::uint64_t AlignOffset(std::uint64_t Offset, std::uint64_t Alignment)
+{
+	Alignment = Alignment == 0 ? 1 : Alignment;
+	return (Offset + Alignment - 1) / Alignment * Alignment;
+}
+
+RgAliasingPlan RgResourceAliaser::Plan(std::span<const RgAliasingRequest> Requests)
+{
+	RgAliasingPlan Plan = {};
+	Plan.Offsets.resize(Requests.size(), 0);
+
+	std::vector<std::size_t> Order(Requests.size());
+	std::iota(Order.begin(), Order.end(), 0);
+	// Sort by size, then by lifetime start and index so the plan is deterministic
+	std::ranges::sort(
+		Order,
+		[&](std::size_t a, std::size_t b)
+		{
+			if (Requests[a].SizeInBytes != Requests[b].SizeInBytes)
+			{
+				return Requests[a].SizeInBytes > Requests[b].SizeInBytes;
+			}
+			if (Requests[a].Lifetime.Begin != Requests[b].Lifetime.Begin)
+			{
+				return Requests[a].Lifetime.Begin < Requests[b].Lifetime.Begin;
+			}
+			return a < b;
+		});
+
+	struct Interval
+	{
+		std::uint64_t Begin;
+		std::uint64_t End;
+	};
+
+	std::vector<std::size_t> Placed;
+	std::vector<Interval>	 Conflicts;
+	Placed.reserve(Requests.size());
+
+	for (std::size_t i : Order)
+	{
+		const RgAliasingRequest& Request = Requests[i];
+		Plan.NonAliasedSizeInBytes += Request.SizeInBytes;
+
+		// Memory ranges occupied by resources that are alive at the same time
+		Conflicts.clear();
+		for (std::size_t j : Placed)
+		{
+			if (Requests[j].Lifetime.Overlaps(Request.Lifetime))
+			{
+				Conflicts.push_back({ Plan.Offsets[j], Plan.Offsets[j] + Requests[j].SizeInBytes });
+			}
+		}
+		std::ranges::sort(Conflicts, {}, &Interval::Begin);
+
+		// First fit, find the lowest gap that is large enough
+		std::uint64_t Offset = 0;
+		for (const auto& Conflict : Conflicts)
+		{
+			if (AlignOffset(Offset, Request.Alignment) + Request.SizeInBytes <= Conflict.Begin)
+			{
+				break;
+			}
+			Offset = std::max(Offset, Conflict.End);
+		}
+		Offset = AlignOffset(Offset, Request.Alignment);
+
+		Plan.Offsets[i]			= Offset;
+		Plan.AliasedSizeInBytes = std::max(Plan.AliasedSizeInBytes, Offset + Request.SizeInBytes);
+		Placed.push_back(i);
+	}
+
+	// Sweep the timeline for the peak amount of live memory
+	std::map<std::size_t, std::int64_t> Deltas;
+	for (const auto& Request : Requests)
+	{
+		if (Request.Lifetime.IsValid())
+		{
+			Deltas[Request.Lifetime.Begin] += static_cast<std::int64_t>(Request.SizeInBytes);
+			Deltas[Request.Lifetime.End + 1] -= static_cast<std::int64_t>(Request.SizeInBytes);
+		}
+	}
+
+	std::int64_t LiveSizeInBytes = 0;
+	for (auto [Point, Delta] : Deltas)
+	{
+		LiveSizeInBytes += Delta;
+		Plan.PeakLiveSizeInBytes = std::max(Plan.PeakLiveSizeInBytes, static_cast<std::uint64_t>(LiveSizeInBytes));
+	}
+
+	return Plan;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Packs transient resources whose lifetimes don't overlap into a shared heap
+
+// Inclusive range of timeline points (dependency levels) a resource is accessed in
+struct RgResourceLifetime
+{
+	[[nodiscard]] bool IsValid() const noexcept { return Begin <= End; }
+	[[nodiscard]] bool Overlaps(const RgResourceLifetime& Other) const noexcept { return Begin <= Other.End && Other.Begin <= End; }
+
+	void Extend(std::size_t Point) noexcept
+	{
+		Begin = Point < Begin ? Point : Begin;
+		End	  = Point > End ? Point : End;
+	}
+
+	std::size_t Begin = SIZE_MAX;
+	std::size_t End	  = 0;
+};
+
+// How the graph uses a resource, decides whether the resource may share heap memory with others
+struct RgResourceUsage
+{
+	// Resources accessed on the async compute queue are never transient, lifetimes are measured in
+	// dependency levels of the graphics queue while the async compute queue runs ahead of or behind them
+	[[nodiscard]] bool IsTransient() const noexcept { return Lifetime.IsValid() && !Persistent && !Exported && !AsyncCompute; }
+
+	RgResourceLifetime Lifetime;
+	bool			   Persistent	= false; // Contents are kept across frames
+	bool			   Exported		= false; // Read by the epilogue, outlives the graph
+	bool			   AsyncCompute = false; // Accessed by a pass on the async compute queue
+};
+
+struct RgAliasingRequest
+{
+	RgResourceLifetime Lifetime;
+	std::uint64_t	   SizeInBytes = 0;
+	std::uint64_t	   Alignment   = 1;
+};
+
+struct RgAliasingPlan
+{
+	// Heap offset for every request, in request order
+	std::vector<std::uint64_t> Offsets;
+
+	std::uint64_t NonAliasedSizeInBytes = 0; // Every resource gets its own memory
+	std::uint64_t AliasedSizeInBytes	= 0; // Size of the heap required by the plan
+	std::uint64_t PeakLiveSizeInBytes	= 0; // Lower bound, max bytes alive at any timeline point
+};
+
+class RgResourceAliaser
+{
+public:
+	// Greedy interval packing, largest resources are placed first at the lowest offset
+	// that does not intersect any already placed resource with an overlapping lifetime
+	[[nodiscard]] static RgAliasingPlan Plan(std::span<const RgAliasingRequest> Requests);
+};
@@ -0,0 +1,48 @@
+#include "RenderGraphAllocator.h"
+
+RenderGraphAllocator::RenderGraphAllocator(size_t BlockSizeInBytes)
+	: BlockSizeInBytes(BlockSizeInBytes)
+	, Ptr(nullptr)
+	, Sentinel(nullptr)
+	, CurrentMemoryUsage(0)
+{
+	Blocks.push_back({ std::make_unique<BYTE[]>(BlockSizeInBytes), BlockSizeInBytes });
+	Ptr		 = Blocks.back().Memory.get();
+	Sentinel = Ptr + BlockSizeInBytes;
+}
+
+void RenderGraphAllocator::Reset()
+{
+	// Everything allocated last frame fits in a single block of the chain's capacity
+	if (Blocks.size() > 1)
+	{
+		size_t SizeInBytes = GetCapacity();
+		Blocks.clear();
+		Blocks.push_back({ std::make_unique<BYTE[]>(SizeInBytes), SizeInBytes });
+	}
+
+	Ptr				   = Blocks.back().Memory.get();
+	Sentinel		   = Ptr + Blocks.back().SizeInBytes;
+	CurrentMemoryUsage = 0;
+}
+
+size_t RenderGraphAllocator::GetCapacity() const noexcept
+{
+	size_t SizeInBytes = 0;
+	for (const auto& Block : Blocks)
+	{
+		SizeInBytes += Block.SizeInBytes;
+	}
+	return SizeInBytes;
+}
+
+BYTE* RenderGraphAllocator::AllocateBlock(size_t SizeInBytes, size_t Alignment)
+{
+	// Oversized allocations get a block of their own, padded so the aligned allocation fits
+	size_t NewBlockSizeInBytes = std::max(BlockSizeInBytes, SizeInBytes + Alignment);
+	Blocks.push_back({ std::make_unique<BYTE[]>(NewBlockSizeInBytes), NewBlockSizeInBytes });
+
+	Ptr		 = Blocks.back().Memory.get();
+	Sentinel = Ptr + NewBlockSizeInBytes;
+	return AlignUp(Ptr, Alignment);
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Linear allocator for everything a render graph declares in a frame, memory is only reclaimed on Reset.
+// Allocations that do not fit chain a new block, Reset merges the chain into a single block
+// so the next frame fits without chaining
+class RenderGraphAllocator
+{
+public:
+	explicit RenderGraphAllocator(size_t BlockSizeInBytes);
+
+	void* Allocate(size_t SizeInBytes, size_t Alignment)
+	{
+		SizeInBytes	 = AlignUp(SizeInBytes, Alignment);
+		BYTE* Result = AlignUp(Ptr, Alignment);
+		if (Result > Sentinel || SizeInBytes > static_cast<size_t>(Sentinel - Result))
+		{
+			Result = AllocateBlock(SizeInBytes, Alignment);
+		}
+
+		Ptr = Result + SizeInBytes;
+		CurrentMemoryUsage += SizeInBytes;
+		return Result;
+	}
+
+	template<typename T, typename... TArgs>
+	T* Construct(TArgs&&... Args)
+	{
+		void* Memory = Allocate(sizeof(T), 16);
+		return new (Memory) T(std::forward<TArgs>(Args)...);
+	}
+
+	template<typename T>
+	static void Destruct(T* Ptr)
+	{
+		Ptr->~T();
+	}
+
+	void Reset();
+
+	[[nodiscard]] size_t GetMemoryUsage() const noexcept { return CurrentMemoryUsage; }
+	[[nodiscard]] size_t GetNumBlocks() const noexcept { return Blocks.size(); }
+	[[nodiscard]] size_t GetCapacity() const noexcept;
+
+private:
+	// Slow path of Allocate, starts a new block the allocation fits in
+	[[nodiscard]] BYTE* AllocateBlock(size_t SizeInBytes, size_t Alignment);
+
+	struct Block
+	{
+		std::unique_ptr<BYTE[]> Memory;
+		size_t					SizeInBytes;
+	};
+
+	size_t			   BlockSizeInBytes;
+	std::vector<Block> Blocks; // The last block is allocated from
+	BYTE*			   Ptr;
+	BYTE*			   Sentinel;
+	std::size_t		   CurrentMemoryUsage;
+};
+
+// Stl allocator that sub-allocates from RenderGraphAllocator, memory is only reclaimed on RenderGraphAllocator::Reset
+template<typename T>
+class RenderGraphStlAllocator
+{
+public:
+	using value_type = T;
+
+	RenderGraphStlAllocator(RenderGraphAllocator& Allocator) noexcept
+		: Allocator(&Allocator)
+	{
+	}
+
+	template<typename U>
+	RenderGraphStlAllocator(const RenderGraphStlAllocator<U>& Other) noexcept
+		: Allocator(Other.Allocator)
+	{
+	}
+
+	[[nodiscard]] T* allocate(size_t Count)
+	{
+		return static_cast<T*>(Allocator->Allocate(Count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T*, size_t) noexcept {}
+
+	template<typename U>
+	bool operator==(const RenderGraphStlAllocator<U>& Other) const noexcept
+	{
+		return Allocator == Other.Allocator;
+	}
+
+	RenderGraphAllocator* Allocator;
+};
+
+template<typename T>
+using RgVector = std::vector<T, RenderGraphStlAllocator<T>>;
@@ -1,5 +1,8 @@
 #pragma once
 #include <compare>
+#include "RenderGraphAliasing.h"
+#include "RenderGraphScheduler.h"
+#include "RenderGraphSynchronization.h"
 
 enum class RgResourceType : UINT64
 {
@@ -128,6 +131,13 @@ struct RgTextureDesc
 		return *this;
 	}
 
+	// Persistent textures keep their content across frames (e.g. accumulation) and are never aliased
+	RgTextureDesc& SetPersistent()
+	{
+		Persistent = true;
+		return *this;
+	}
+
 	DXGI_FORMAT						 Format				 = DXGI_FORMAT_UNKNOWN;
 	RgTextureType					 Type				 = RgTextureType::Texture2D;
 	UINT							 Width				 = 1;
@@ -137,6 +147,7 @@ struct RgTextureDesc
 	bool							 RenderTarget		 = false;
 	bool							 DepthStencil		 = false;
 	bool							 UnorderedAccess	 = false;
+	bool							 Persistent			 = false;
 	std::optional<D3D12_CLEAR_VALUE> OptimizedClearValue = std::nullopt;
 };
 
@@ -272,6 +283,9 @@ struct RgBuffer : RgResource
 struct RgTexture : RgResource
 {
 	RgTextureDesc Desc;
+
+	// Filled in by RenderGraph::Setup, transient textures are placed in aliased heap memory
+	RgResourceUsage Usage;
 };
 
 struct RgRenderTarget : RgResource
@@ -0,0 +1,61 @@
+#include "RenderGraphCompiler.h"
+#include <algorithm>
+#include <utility>
+
+void RgDependencyGraph::Sort()
+{
+	for (auto& Indices : AdjacencyLists)
+	{
+		std::ranges::sort(Indices);
+		Indices.erase(std::ranges::unique(Indices).begin(), Indices.end());
+	}
+
+	// Topological sort, reverse post order of a depth first search.
+	// The search keeps its own stack, chains of passes such as per mip bloom can get deep
+	std::vector<bool>								  Visited(AdjacencyLists.size(), false);
+	std::vector<std::pair<std::size_t, std::size_t>> Stack; // Pass, next edge to follow
+	TopologicalOrder.clear();
+	TopologicalOrder.reserve(AdjacencyLists.size());
+
+	for (std::size_t i = 0; i < AdjacencyLists.size(); ++i)
+	{
+		if (Visited[i])
+		{
+			continue;
+		}
+
+		Visited[i] = true;
+		Stack.emplace_back(i, 0);
+		while (!Stack.empty())
+		{
+			auto [u, Edge] = Stack.back();
+			if (Edge < AdjacencyLists[u].size())
+			{
+				Stack.back().second++;
+				if (std::size_t v = AdjacencyLists[u][Edge]; !Visited[v])
+				{
+					Visited[v] = true;
+					Stack.emplace_back(v, 0);
+				}
+			}
+			else
+			{
+				TopologicalOrder.push_back(u);
+				Stack.pop_back();
+			}
+		}
+	}
+	std::ranges::reverse(TopologicalOrder);
+
+	// Longest path search
+	// Render passes in a dependency level share the same recursion depth,
+	// or rather maximum recursion depth AKA longest path in a DAG
+	Distances.assign(AdjacencyLists.size(), 0);
+	for (std::size_t u : TopologicalOrder)
+	{
+		for (std::size_t v : AdjacencyLists[u])
+		{
+			Distances[v] = std::max(Distances[v], Distances[u] + 1);
+		}
+	}
+}
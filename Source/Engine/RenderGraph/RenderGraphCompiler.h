@@ -0,0 +1,136 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Orders the passes of a graph into dependency levels by the resource versions they read and write
+
+// Version of a resource, resources of every type are numbered densely
+struct RgResourceVersion
+{
+	std::size_t Resource;
+	std::size_t Version;
+};
+
+// Index of the pass that writes every resource version, located at Offsets[Resource] + Version
+class RgProducerTable
+{
+public:
+	// ForEachWrite(Pass, Callback) invokes Callback(RgResourceVersion) for every resource version the pass writes
+	template<typename TForEachWrite>
+	void Build(std::size_t NumResources, std::size_t NumPasses, TForEachWrite&& ForEachWrite)
+	{
+		// Count the versions of each resource, then lay the producers out flat
+		Offsets.assign(NumResources, 1);
+		for (std::size_t i = 0; i < NumPasses; ++i)
+		{
+			ForEachWrite(
+				i,
+				[this](RgResourceVersion Write)
+				{
+					Offsets[Write.Resource] = std::max(Offsets[Write.Resource], Write.Version + 1);
+				});
+		}
+
+		std::size_t NumProducers = 0;
+		for (std::size_t& Offset : Offsets)
+		{
+			std::size_t NumVersions = Offset;
+			Offset					= NumProducers;
+			NumProducers += NumVersions;
+		}
+
+		Producers.assign(NumProducers, SIZE_MAX);
+		for (std::size_t i = 0; i < NumPasses; ++i)
+		{
+			ForEachWrite(
+				i,
+				[this, i](RgResourceVersion Write)
+				{
+					Producers[Offsets[Write.Resource] + Write.Version] = i;
+				});
+		}
+	}
+
+	// SIZE_MAX if the version is never written within the graph
+	[[nodiscard]] std::size_t GetProducer(RgResourceVersion Read) const noexcept
+	{
+		std::size_t Begin = Offsets[Read.Resource];
+		std::size_t End	  = Read.Resource + 1 < Offsets.size() ? Offsets[Read.Resource + 1] : Producers.size();
+		return Begin + Read.Version < End ? Producers[Begin + Read.Version] : SIZE_MAX;
+	}
+
+	// Marks every pass that produces a version read by an alive pass as alive, transitively.
+	// ForEachRead(Pass, Callback) invokes Callback(RgResourceVersion) for every resource version the pass reads
+	template<typename TForEachRead>
+	void PropagateAlive(std::vector<bool>& Alive, TForEachRead&& ForEachRead) const
+	{
+		std::vector<std::size_t> Worklist;
+		for (std::size_t i = 0; i < Alive.size(); ++i)
+		{
+			if (Alive[i])
+			{
+				Worklist.push_back(i);
+			}
+		}
+
+		while (!Worklist.empty())
+		{
+			std::size_t i = Worklist.back();
+			Worklist.pop_back();
+
+			ForEachRead(
+				i,
+				[&](RgResourceVersion Read)
+				{
+					std::size_t Producer = GetProducer(Read);
+					if (Producer != SIZE_MAX && !Alive[Producer])
+					{
+						Alive[Producer] = true;
+						Worklist.push_back(Producer);
+					}
+				});
+		}
+	}
+
+private:
+	std::vector<std::size_t> Offsets;
+	std::vector<std::size_t> Producers;
+};
+
+struct RgDependencyGraph
+{
+	// ForEachRead(Pass, Callback) invokes Callback(RgResourceVersion) for every resource version the pass reads,
+	// every read adds an edge from the producer of the version to the pass
+	template<typename TForEachRead>
+	[[nodiscard]] static RgDependencyGraph Build(const RgProducerTable& Producers, std::size_t NumPasses, TForEachRead&& ForEachRead)
+	{
+		RgDependencyGraph Graph;
+		Graph.AdjacencyLists.resize(NumPasses);
+		for (std::size_t i = 0; i < NumPasses; ++i)
+		{
+			ForEachRead(
+				i,
+				[&](RgResourceVersion Read)
+				{
+					std::size_t Producer = Producers.GetProducer(Read);
+					if (Producer != SIZE_MAX && Producer != i)
+					{
+						Graph.AdjacencyLists[Producer].push_back(i);
+					}
+				});
+		}
+		Graph.Sort();
+		return Graph;
+	}
+
+	std::vector<std::vector<std::size_t>> AdjacencyLists;
+	std::vector<std::size_t>			  TopologicalOrder;
+	std::vector<int>					  Distances; // Longest path to every pass, which is its dependency level
+
+private:
+	// Removes duplicate edges, sorts the passes topologically and finds the longest paths
+	void Sort();
+};
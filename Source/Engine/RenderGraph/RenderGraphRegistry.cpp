@@ -2,6 +2,82 @@
 #include "RenderGraph.h"
 #include <RenderCore/RenderCore.h>
 
+static D3D12_RESOURCE_DESC GetResourceDesc(const RgTextureDesc& Desc)
+{
+	D3D12_RESOURCE_DESC	 ResourceDesc  = {};
+	D3D12_RESOURCE_FLAGS ResourceFlags = D3D12_RESOURCE_FLAG_NONE;
+
+	if (Desc.RenderTarget)
+	{
+		ResourceFlags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+	}
+	if (Desc.DepthStencil)
+	{
+		ResourceFlags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+	}
+	if (Desc.UnorderedAccess)
+	{
+		ResourceFlags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+	}
+
+	switch (Desc.Type)
+	{
+	case RgTextureType::Texture2D:
+		ResourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
+			Desc.Format,
+			Desc.Width,
+			Desc.Height,
+			1,
+			Desc.MipLevels,
+			1,
+			0,
+			ResourceFlags);
+		break;
+	case RgTextureType::Texture2DArray:
+		ResourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
+			Desc.Format,
+			Desc.Width,
+			Desc.Height,
+			Desc.DepthOrArraySize,
+			Desc.MipLevels,
+			1,
+			0,
+			ResourceFlags);
+		break;
+	case RgTextureType::Texture3D:
+		ResourceDesc = CD3DX12_RESOURCE_DESC::Tex3D(
+			Desc.Format,
+			Desc.Width,
+			Desc.Height,
+			Desc.DepthOrArraySize,
+			Desc.MipLevels,
+			ResourceFlags);
+		break;
+	case RgTextureType::TextureCube:
+		ResourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
+			Desc.Format,
+			Desc.Width,
+			Desc.Height,
+			Desc.DepthOrArraySize,
+			Desc.MipLevels,
+			1,
+			0,
+			ResourceFlags);
+		break;
+	default:
+		break;
+	}
+
+	return ResourceDesc;
+}
+
+static bool IsCompatible(const D3D12_RESOURCE_DESC& Desc, const D3D12_RESOURCE_DESC& Other)
+{
+	return Desc.Dimension == Other.Dimension && Desc.Width == Other.Width && Desc.Height == Other.Height &&
+		   Desc.DepthOrArraySize == Other.DepthOrArraySize && Desc.MipLevels == Other.MipLevels && Desc.Format == Other.Format &&
+		   Desc.Flags == Other.Flags;
+}
+
 auto RenderGraphRegistry::CreateRootSignature(std::unique_ptr<D3D12RootSignature>&& RootSignature) -> RgResourceHandle
 {
 	return RootSignatureRegistry.Add(std::forward<std::unique_ptr<D3D12RootSignature>>(RootSignature));
@@ -34,9 +110,7 @@ D3D12RaytracingPipelineState* RenderGraphRegistry::GetRaytracingPipelineState(Rg
 
 void RenderGraphRegistry::RealizeResources(RenderGraph* Graph)
 {
-	ShaderResourceViews.clear();
-	UnorderedAccessViews.clear();
-
+	// Views are kept across frames and only recreated when the graph changed or the texture they reference was recreated
 	this->Graph = Graph;
 	Buffers.resize(Graph->Buffers.size());
 	Textures.resize(Graph->Textures.size());
@@ -44,6 +118,20 @@ void RenderGraphRegistry::RealizeResources(RenderGraph* Graph)
 	ShaderResourceViews.resize(Graph->ShaderResourceViews.size());
 	UnorderedAccessViews.resize(Graph->UnorderedAccessViews.size());
 
+	TexturePlacements.resize(Graph->Textures.size());
+	RecreatedTextures.assign(Graph->Textures.size(), false);
+
+	std::vector<D3D12_RESOURCE_DESC> ResourceDescs(Graph->Textures.size());
+	for (size_t i = 0; i < Graph->Textures.size(); ++i)
+	{
+		ResourceDescs[i] = GetResourceDesc(Graph->Textures[i].Desc);
+	}
+
+	CullingStats				 = {};
+	CullingStats.NumCulledPasses = Graph->CulledPasses.size();
+
+	RealizeTransientTextures(ResourceDescs);
+
 	for (size_t i = 0; i < Graph->Textures.size(); ++i)
 	{
 		auto& RHITexture = Graph->Textures[i];
@@ -51,9 +139,31 @@ void RenderGraphRegistry::RealizeResources(RenderGraph* Graph)
 		RgResourceHandle&	 Handle = RHITexture.Handle;
 		const RgTextureDesc& Desc	= RHITexture.Desc;
 
+		if (RHITexture.Usage.IsTransient())
+		{
+			continue;
+		}
+
+		if (!RHITexture.Usage.Lifetime.IsValid())
+		{
+			ID3D12Device*				   Device		  = RenderCore::Device->GetDevice()->GetDevice();
+			D3D12_RESOURCE_ALLOCATION_INFO AllocationInfo = Device->GetResourceAllocationInfo(0, 1, &ResourceDescs[i]);
+
+			CullingStats.NumCulledTextures++;
+			CullingStats.SkippedSizeInBytes += AllocationInfo.SizeInBytes;
+
+			if (Textures[i].GetResource())
+			{
+				TexturePlacements[i] = {};
+				Textures[i]			 = D3D12Texture();
+				RecreatedTextures[i] = true;
+			}
+			continue;
+		}
+
 		if (Handle.State)
 		{
-			if (!Textures[i].GetResource() || Desc.Width != Textures[i].GetDesc().Width || Desc.Height != Textures[i].GetDesc().Height)
+			if (!Textures[i].GetResource() || TexturePlacements[i].Heap != UINT64_MAX || Desc.Width != Textures[i].GetDesc().Width || Desc.Height != Textures[i].GetDesc().Height)
 			{
 				Handle.State = false;
 			}
@@ -64,79 +174,54 @@ void RenderGraphRegistry::RealizeResources(RenderGraph* Graph)
 		}
 		Handle.State = true;
 
-		D3D12_RESOURCE_DESC	 ResourceDesc  = {};
-		D3D12_RESOURCE_FLAGS ResourceFlags = D3D12_RESOURCE_FLAG_NONE;
-
-		if (Desc.RenderTarget)
-		{
-			ResourceFlags |= D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-		}
-		if (Desc.DepthStencil)
-		{
-			ResourceFlags |= D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
-		}
-		if (Desc.UnorderedAccess)
-		{
-			ResourceFlags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
-		}
-
-		switch (Desc.Type)
-		{
-		case RgTextureType::Texture2D:
-			ResourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
-				Desc.Format,
-				Desc.Width,
-				Desc.Height,
-				1,
-				Desc.MipLevels,
-				1,
-				0,
-				ResourceFlags);
-			break;
-		case RgTextureType::Texture2DArray:
-			ResourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
-				Desc.Format,
-				Desc.Width,
-				Desc.Height,
-				Desc.DepthOrArraySize,
-				Desc.MipLevels,
-				1,
-				0,
-				ResourceFlags);
-			break;
-		case RgTextureType::Texture3D:
-			ResourceDesc = CD3DX12_RESOURCE_DESC::Tex3D(
-				Desc.Format,
-				Desc.Width,
-				Desc.Height,
-				Desc.DepthOrArraySize,
-				Desc.MipLevels,
-				ResourceFlags);
-			break;
-		case RgTextureType::TextureCube:
-			ResourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
-				Desc.Format,
-				Desc.Width,
-				Desc.Height,
-				Desc.DepthOrArraySize,
-				Desc.MipLevels,
-				1,
-				0,
-				ResourceFlags);
-			break;
-		default:
-			break;
+		TexturePlacements[i] = {};
+		Textures[i]			 = D3D12Texture(RenderCore::Device->GetDevice(), ResourceDescs[i], Desc.OptimizedClearValue);
+		RecreatedTextures[i] = true;
+		std::wstring Name	 = std::wstring(RHITexture.Name.begin(), RHITexture.Name.end());
+		Textures[i].GetResource()->SetName(Name.data());
+	}
+
+	for (size_t i = 0; i < Graph->Buffers.size(); ++i)
+	{
+		const auto&			Buffer = Graph->Buffers[i];
+		const RgBufferDesc& Desc   = Buffer.Desc;
+
+		D3D12_RESOURCE_FLAGS ResourceFlags = Desc.UnorderedAccess ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
+		if (Buffers[i].GetResource() && Buffers[i].GetDesc().Width == Desc.SizeInBytes && Buffers[i].GetDesc().Flags == ResourceFlags)
+		{
+			continue;
 		}
 
-		Textures[i]		  = D3D12Texture(RenderCore::Device->GetDevice(), ResourceDesc, Desc.OptimizedClearValue);
-		std::wstring Name = std::wstring(RHITexture.Name.begin(), RHITexture.Name.end());
-		Textures[i].GetResource()->SetName(Name.data());
+		Buffers[i]		  = D3D12Buffer(RenderCore::Device->GetDevice(), Desc.SizeInBytes, 0, D3D12_HEAP_TYPE_DEFAULT, ResourceFlags);
+		std::wstring Name = std::wstring(Buffer.Name.begin(), Buffer.Name.end());
+		Buffers[i].GetResource()->SetName(Name.data());
 	}
 
 	for (size_t i = 0; i < Graph->RenderTargets.size(); ++i)
 	{
 		const auto& RgRt = Graph->RenderTargets[i];
 
+		bool Realized = !RgRt.Desc.DepthStencil.IsValid() || IsTextureRealized(RgRt.Desc.DepthStencil);
+		for (UINT j = 0; j < RgRt.Desc.NumRenderTargets; ++j)
+		{
+			Realized &= IsTextureRealized(RgRt.Desc.RenderTargets[j]);
+		}
+		if (!Realized)
+		{
+			RenderTargets[i] = D3D12RenderTarget();
+			continue;
+		}
+
+		bool Stale = !RenderTargets[i].GetParentLinkedDevice() || IsViewStale(RgRt.Desc.DepthStencil);
+		for (UINT j = 0; j < RgRt.Desc.NumRenderTargets; ++j)
+		{
+			Stale |= IsViewStale(RgRt.Desc.RenderTargets[j]);
+		}
+		if (!Stale)
+		{
+			continue;
+		}
+
 		D3D12RenderTargetDesc ApiDesc = {};
 
 		for (UINT j = 0; j < RgRt.Desc.NumRenderTargets; ++j)
@@ -154,6 +239,15 @@ void RenderGraphRegistry::RealizeResources(RenderGraph* Graph)
 	for (size_t i = 0; i < ShaderResourceViews.size(); ++i)
 	{
 		const auto& RgSrv = Graph->ShaderResourceViews[i];
+		if (!IsTextureRealized(RgSrv.Desc.Resource))
+		{
+			ShaderResourceViews[i] = D3D12ShaderResourceView();
+			continue;
+		}
+		if (ShaderResourceViews[i].IsValid() && !IsViewStale(RgSrv.Desc.Resource))
+		{
+			continue;
+		}
 
 		switch (RgSrv.Desc.Type)
 		{
@@ -189,6 +283,15 @@ void RenderGraphRegistry::RealizeResources(RenderGraph* Graph)
 	for (size_t i = 0; i < UnorderedAccessViews.size(); ++i)
 	{
 		const auto& RgUav = Graph->UnorderedAccessViews[i];
+		if (!IsTextureRealized(RgUav.Desc.Resource))
+		{
+			UnorderedAccessViews[i] = D3D12UnorderedAccessView();
+			continue;
+		}
+		if (UnorderedAccessViews[i].IsValid() && !IsViewStale(RgUav.Desc.Resource))
+		{
+			continue;
+		}
 
 		switch (RgUav.Desc.Type)
 		{
@@ -219,3 +322,105 @@ void RenderGraphRegistry::RealizeResources(RenderGraph* Graph)
 		}
 	}
 }
+
+bool RenderGraphRegistry::IsTextureRealized(RgResourceHandle Handle) const noexcept
+{
+	if (Handle.Type != RgResourceType::Texture)
+	{
+		return true;
+	}
+	return Graph->Textures[Handle.Id].Usage.Lifetime.IsValid();
+}
+
+bool RenderGraphRegistry::IsViewStale(RgResourceHandle Handle) const noexcept
+{
+	// Cached graphs declare the same views as the previous frame, so only the underlying texture can change
+	if (!Graph->Cached)
+	{
+		return true;
+	}
+	return Handle.Type == RgResourceType::Texture && RecreatedTextures[Handle.Id];
+}
+
+void RenderGraphRegistry::RealizeTransientTextures(const std::vector<D3D12_RESOURCE_DESC>& ResourceDescs)
+{
+	ID3D12Device* Device = RenderCore::Device->GetDevice()->GetDevice();
+
+	std::vector<RgAliasingRequest> Requests[TransientHeap_Count];
+	std::vector<size_t>			   RequestTextures[TransientHeap_Count];
+
+	for (size_t i = 0; i < Graph->Textures.size(); ++i)
+	{
+		const auto& RHITexture = Graph->Textures[i];
+		if (!RHITexture.Usage.IsTransient())
+		{
+			continue;
+		}
+
+		D3D12_RESOURCE_ALLOCATION_INFO AllocationInfo = Device->GetResourceAllocationInfo(0, 1, &ResourceDescs[i]);
+
+		ETransientHeap HeapType = RHITexture.Desc.RenderTarget || RHITexture.Desc.DepthStencil ? TransientHeap_RtDsTextures : TransientHeap_Textures;
+		Requests[HeapType].push_back({ RHITexture.Usage.Lifetime, AllocationInfo.SizeInBytes, AllocationInfo.Alignment });
+		RequestTextures[HeapType].push_back(i);
+	}
+
+	AliasingStats = {};
+	for (int HeapType = 0; HeapType < TransientHeap_Count; ++HeapType)
+	{
+		RgTransientHeap& TransientHeap = TransientHeaps[HeapType];
+		RgAliasingPlan	 Plan		   = RgResourceAliaser::Plan(Requests[HeapType]);
+
+		AliasingStats.NumTransientTextures += Requests[HeapType].size();
+		AliasingStats.NonAliasedSizeInBytes += Plan.NonAliasedSizeInBytes;
+		AliasingStats.AliasedSizeInBytes += Plan.AliasedSizeInBytes;
+		AliasingStats.PeakLiveSizeInBytes += Plan.PeakLiveSizeInBytes;
+
+		bool HeapRecreated = false;
+		if (Plan.AliasedSizeInBytes > TransientHeap.SizeInBytes)
+		{
+			// Textures must be released before the heap backing them
+			for (size_t i = 0; i < TexturePlacements.size(); ++i)
+			{
+				if (TexturePlacements[i].Heap == static_cast<UINT64>(HeapType))
+				{
+					Textures[i]			 = D3D12Texture();
+					TexturePlacements[i] = {};
+					RecreatedTextures[i] = true;
+				}
+			}
+
+			D3D12_HEAP_FLAGS HeapFlags = HeapType == TransientHeap_RtDsTextures ? D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES : D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES;
+
+			CD3DX12_HEAP_DESC HeapDesc(
+				AlignUp<UINT64>(Plan.AliasedSizeInBytes, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT),
+				D3D12_HEAP_TYPE_DEFAULT,
+				D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT,
+				HeapFlags);
+
+			TransientHeap.Heap.Reset();
+			VERIFY_D3D12_API(Device->CreateHeap(&HeapDesc, IID_PPV_ARGS(TransientHeap.Heap.ReleaseAndGetAddressOf())));
+			TransientHeap.Heap->SetName(HeapType == TransientHeap_RtDsTextures ? L"Render Graph Transient RT/DS Heap" : L"Render Graph Transient Heap");
+			TransientHeap.SizeInBytes = HeapDesc.SizeInBytes;
+			HeapRecreated			  = true;
+		}
+		AliasingStats.HeapSizeInBytes += TransientHeap.SizeInBytes;
+
+		for (size_t j = 0; j < RequestTextures[HeapType].size(); ++j)
+		{
+			size_t			   i		  = RequestTextures[HeapType][j];
+			const auto&		   RHITexture = Graph->Textures[i];
+			RgTexturePlacement Placement  = { static_cast<UINT64>(HeapType), Plan.Offsets[j] };
+
+			if (!HeapRecreated && Textures[i].GetResource() && TexturePlacements[i] == Placement && IsCompatible(Textures[i].GetDesc(), ResourceDescs[i]))
+			{
+				continue;
+			}
+
+			TexturePlacements[i] = Placement;
+			Textures[i]			 = D3D12Texture(RenderCore::Device->GetDevice(), TransientHeap.Heap.Get(), Placement.Offset, ResourceDescs[i], RHITexture.Desc.OptimizedClearValue);
+			RecreatedTextures[i] = true;
+			std::wstring Name	 = std::wstring(RHITexture.Name.begin(), RHITexture.Name.end());
+			Textures[i].GetResource()->SetName(Name.data());
+		}
+	}
+}
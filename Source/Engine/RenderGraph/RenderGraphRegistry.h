@@ -33,6 +33,51 @@ using RootSignatureRegistry			  = RgRegistry<std::unique_ptr<D3D12RootSignature>
 using PipelineStateRegistry			  = RgRegistry<std::unique_ptr<D3D12PipelineState>, RgResourceType::PipelineState>;
 using RaytracingPipelineStateRegistry = RgRegistry<std::unique_ptr<D3D12RaytracingPipelineState>, RgResourceType::RaytracingPipelineState>;
 
+struct RgAliasingStats
+{
+	size_t NumTransientTextures	 = 0;
+	UINT64 NonAliasedSizeInBytes = 0;
+	UINT64 AliasedSizeInBytes	 = 0;
+	UINT64 PeakLiveSizeInBytes	 = 0;
+	UINT64 HeapSizeInBytes		 = 0;
+};
+
+// Result of compiling a RenderGraph, indices refer to the order passes were declared in
+struct RgCompiledGraph
+{
+	UINT64							 Hash = 0;
+	std::vector<bool>				 Alive;
+	std::vector<std::vector<size_t>> AdjacencyLists;
+	std::vector<size_t>				 TopologicalOrder;
+	std::vector<int>				 Distances;
+};
+
+struct RgCullingStats
+{
+	size_t NumCulledPasses	  = 0;
+	size_t NumCulledTextures  = 0;
+	UINT64 SkippedSizeInBytes = 0;
+};
+
+struct RgRecordingStats
+{
+	size_t NumParallelLevels	 = 0;
+	size_t NumCommandLists		 = 0; // Worker command lists recorded by parallel levels
+	size_t NumAsyncComputePasses = 0;
+	size_t NumQueueWaits		 = 0; // Cross queue waits inserted by the graph
+};
+
+// Barriers recorded by the graph per frame
+struct RgBarrierStats
+{
+	size_t NumAccesses			 = 0; // Resource accesses declared by the passes
+	size_t NumTransitions		 = 0; // A split barrier counts as a single transition
+	size_t NumSplitBarriers		 = 0;
+	size_t NumSkippedTransitions = 0; // Resource already in the required state
+	size_t NumUavBarriers		 = 0;
+	size_t NumAliasingBarriers	 = 0;
+};
+
 class RenderGraphRegistry
 {
 public:
@@ -46,6 +91,11 @@ public:
 
 	void RealizeResources(RenderGraph* Graph);
 
+	[[nodiscard]] const RgAliasingStats&  GetAliasingStats() const noexcept { return AliasingStats; }
+	[[nodiscard]] const RgCullingStats&	  GetCullingStats() const noexcept { return CullingStats; }
+	[[nodiscard]] const RgRecordingStats& GetRecordingStats() const noexcept { return RecordingStats; }
+	[[nodiscard]] const RgBarrierStats&	  GetBarrierStats() const noexcept { return BarrierStats; }
+
 	template<typename T>
 	[[nodiscard]] auto Get(RgResourceHandle Handle) -> T*
 	{
@@ -82,7 +132,37 @@ private:
 		}
 	}
 
+	void RealizeTransientTextures(const std::vector<D3D12_RESOURCE_DESC>& ResourceDescs);
+
+	// Textures that are only accessed by culled passes are not realized
+	[[nodiscard]] bool IsTextureRealized(RgResourceHandle Handle) const noexcept;
+	[[nodiscard]] bool IsViewStale(RgResourceHandle Handle) const noexcept;
+
 private:
+	// Render targets/depth stencils and other textures live in separate heaps so that resource heap tier 1 is supported
+	enum ETransientHeap
+	{
+		TransientHeap_Textures,
+		TransientHeap_RtDsTextures,
+		TransientHeap_Count
+	};
+
+	struct RgTransientHeap
+	{
+		Microsoft::WRL::ComPtr<ID3D12Heap> Heap;
+		UINT64							   SizeInBytes = 0;
+	};
+
+	struct RgTexturePlacement
+	{
+		auto operator<=>(const RgTexturePlacement&) const = default;
+
+		UINT64 Heap	  = UINT64_MAX; // UINT64_MAX for committed textures
+		UINT64 Offset = 0;
+	};
+
+	friend class RenderGraph;
+
 	RenderGraph*					Graph = nullptr;
 	RootSignatureRegistry			RootSignatureRegistry;
 	PipelineStateRegistry			PipelineStateRegistry;
@@ -93,4 +173,20 @@ private:
 	std::vector<D3D12RenderTarget>		  RenderTargets;
 	std::vector<D3D12ShaderResourceView>  ShaderResourceViews;
 	std::vector<D3D12UnorderedAccessView> UnorderedAccessViews;
+
+	RgTransientHeap					TransientHeaps[TransientHeap_Count];
+	std::vector<RgTexturePlacement> TexturePlacements;
+	RgAliasingStats					AliasingStats;
+	RgCullingStats					CullingStats;
+	RgBarrierStats					BarrierStats;
+
+	// Reused by the next RenderGraph if it is declared identically
+	RgCompiledGraph CompiledGraph;
+
+	// Textures recreated by the current RealizeResources, views of these need to be recreated as well
+	std::vector<bool> RecreatedTextures;
+
+	// Worker threads are kept alive across frames, created once parallel recording is enabled
+	std::unique_ptr<RgScheduler> Scheduler;
+	RgRecordingStats			 RecordingStats;
 };
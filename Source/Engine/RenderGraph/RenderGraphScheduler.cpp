@@ -0,0 +1,145 @@
+#include "RenderGraphScheduler.h"
+#include <algorithm>
+
+RgScheduler::RgScheduler(std::size_t NumWorkers)
+{
+	Workers.reserve(NumWorkers);
+	for (std::size_t i = 0; i < NumWorkers; ++i)
+	{
+		Workers.emplace_back(
+			[this, i](std::stop_token StopToken)
+			{
+				WorkerLoop(StopToken, i);
+			});
+	}
+}
+
+RgScheduler::~RgScheduler()
+{
+	// Request stop before joining so workers blocked on WorkAvailable wake up
+	for (auto& Worker : Workers)
+	{
+		Worker.request_stop();
+	}
+	Workers.clear();
+}
+
+std::vector<RgPassBucket> RgScheduler::Partition(
+	std::size_t NumPasses,
+	std::size_t MaxBuckets,
+	std::size_t MinPassesPerBucket /*= 1*/)
+{
+	std::vector<RgPassBucket> Buckets;
+	if (NumPasses == 0)
+	{
+		return Buckets;
+	}
+
+	MinPassesPerBucket	   = std::max<std::size_t>(MinPassesPerBucket, 1);
+	std::size_t NumBuckets = std::clamp<std::size_t>(NumPasses / MinPassesPerBucket, 1, std::max<std::size_t>(MaxBuckets, 1));
+
+	// Spread the remainder over the first buckets so sizes differ by at most one
+	std::size_t BaseSize  = NumPasses / NumBuckets;
+	std::size_t Remainder = NumPasses % NumBuckets;
+	std::size_t Begin	  = 0;
+
+	Buckets.reserve(NumBuckets);
+	for (std::size_t i = 0; i < NumBuckets; ++i)
+	{
+		std::size_t Size = BaseSize + (i < Remainder ? 1 : 0);
+		Buckets.push_back({ Begin, Begin + Size });
+		Begin += Size;
+	}
+
+	return Buckets;
+}
+
+std::size_t RgScheduler::Execute(IRgCommandRecorder& Recorder, std::size_t NumPasses, std::size_t MinPassesPerBucket /*= 1*/)
+{
+	std::vector<RgPassBucket> Partitions = Partition(NumPasses, GetMaxConcurrency(), MinPassesPerBucket);
+	std::size_t				  NumBuckets = Partitions.size();
+	if (NumBuckets == 0)
+	{
+		return 0;
+	}
+
+	Recorder.BeginRecording(NumBuckets);
+
+	RgPassBucket First = Partitions[0];
+	if (NumBuckets > 1)
+	{
+		{
+			std::scoped_lock Lock(Mutex);
+			this->Recorder	  = &Recorder;
+			Buckets			  = std::move(Partitions);
+			NumPendingWorkers = NumBuckets - 1;
+			++Generation;
+		}
+		WorkAvailable.notify_all();
+	}
+
+	Recorder.RecordBucket(0, First);
+
+	if (NumBuckets > 1)
+	{
+		std::unique_lock Lock(Mutex);
+		WorkDone.wait(
+			Lock,
+			[this]
+			{
+				return NumPendingWorkers == 0;
+			});
+		this->Recorder = nullptr;
+		Buckets.clear();
+	}
+
+	Recorder.EndRecording(NumBuckets);
+	return NumBuckets;
+}
+
+void RgScheduler::WorkerLoop(std::stop_token StopToken, std::size_t WorkerIndex)
+{
+	// Worker i records bucket i + 1, bucket 0 belongs to the calling thread
+	std::size_t BucketIndex	   = WorkerIndex + 1;
+	std::size_t SeenGeneration = 0;
+
+	while (true)
+	{
+		IRgCommandRecorder* Job = nullptr;
+		RgPassBucket		Bucket;
+		{
+			std::unique_lock Lock(Mutex);
+			if (!WorkAvailable.wait(
+					Lock,
+					StopToken,
+					[&]
+					{
+						return Generation != SeenGeneration;
+					}))
+			{
+				return;
+			}
+
+			SeenGeneration = Generation;
+			if (BucketIndex >= Buckets.size())
+			{
+				continue;
+			}
+
+			Job	   = Recorder;
+			Bucket = Buckets[BucketIndex];
+		}
+
+		Job->RecordBucket(BucketIndex, Bucket);
+
+		bool Done;
+		{
+			std::scoped_lock Lock(Mutex);
+			Done = --NumPendingWorkers == 0;
+		}
+		if (Done)
+		{
+			WorkDone.notify_one();
+		}
+	}
+}
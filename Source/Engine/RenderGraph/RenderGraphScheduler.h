@@ -0,0 +1,73 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+// Splits the passes of a dependency level into buckets and records the buckets on worker threads
+
+// Contiguous range [Begin, End) of passes within a dependency level
+struct RgPassBucket
+{
+	[[nodiscard]] std::size_t Size() const noexcept { return End - Begin; }
+
+	std::size_t Begin = 0;
+	std::size_t End	  = 0;
+};
+
+// Implemented by the render graph on top of D3D12 command contexts, BucketIndex selects the context to record into
+class IRgCommandRecorder
+{
+public:
+	virtual ~IRgCommandRecorder() = default;
+
+	// Called on the calling thread before any bucket is recorded
+	virtual void BeginRecording(std::size_t NumBuckets) = 0;
+
+	// Called concurrently, every bucket is recorded exactly once
+	virtual void RecordBucket(std::size_t BucketIndex, RgPassBucket Bucket) = 0;
+
+	// Called on the calling thread after all buckets are recorded, buckets must be submitted in index order
+	virtual void EndRecording(std::size_t NumBuckets) = 0;
+};
+
+class RgScheduler
+{
+public:
+	explicit RgScheduler(std::size_t NumWorkers);
+	~RgScheduler();
+
+	RgScheduler(const RgScheduler&)			   = delete;
+	RgScheduler& operator=(const RgScheduler&) = delete;
+
+	// Including the calling thread
+	[[nodiscard]] std::size_t GetMaxConcurrency() const noexcept { return Workers.size() + 1; }
+
+	// Splits NumPasses ordered passes into at most MaxBuckets contiguous buckets of near equal size,
+	// submitting the buckets in order preserves the order of the passes
+	[[nodiscard]] static std::vector<RgPassBucket> Partition(
+		std::size_t NumPasses,
+		std::size_t MaxBuckets,
+		std::size_t MinPassesPerBucket = 1);
+
+	// Records NumPasses passes, the first bucket is recorded on the calling thread, returns the number of buckets
+	std::size_t Execute(IRgCommandRecorder& Recorder, std::size_t NumPasses, std::size_t MinPassesPerBucket = 1);
+
+private:
+	void WorkerLoop(std::stop_token StopToken, std::size_t WorkerIndex);
+
+private:
+	std::vector<std::jthread> Workers;
+
+	std::mutex					Mutex;
+	std::condition_variable_any WorkAvailable;
+	std::condition_variable		WorkDone;
+
+	// Current job, guarded by Mutex
+	IRgCommandRecorder*		  Recorder = nullptr;
+	std::vector<RgPassBucket> Buckets;
+	std::size_t				  Generation		= 0;
+	std::size_t				  NumPendingWorkers = 0;
+};
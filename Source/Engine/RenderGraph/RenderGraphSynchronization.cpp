@@ -0,0 +1,131 @@
+#include "RenderGraphSynchronization.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+
+std::vector<RgSyncNode> RgSyncPlanner::BuildLevelNodes(std::span<const RgSyncLevel> Levels, std::size_t NumResources)
+{
+	std::vector<RgSyncNode>	 Nodes(Levels.size() * LevelNode_Count + 1);
+	std::vector<std::size_t> LastAsyncComputeNodes(NumResources, SIZE_MAX);
+	std::size_t				 LastAsyncComputeNode = SIZE_MAX;
+
+	for (std::size_t i = 0; i < Levels.size(); ++i)
+	{
+		const RgSyncLevel& Level = Levels[i];
+
+		RgSyncNode& BarrierNode		 = Nodes[GetLevelNode(i, LevelNode_Barriers)];
+		RgSyncNode& AsyncComputeNode = Nodes[GetLevelNode(i, LevelNode_AsyncCompute)];
+		RgSyncNode& GraphicsNode	 = Nodes[GetLevelNode(i, LevelNode_Graphics)];
+		BarrierNode.Queue			 = RgSyncQueue_Graphics;
+		AsyncComputeNode.Queue		 = RgSyncQueue_AsyncCompute;
+		GraphicsNode.Queue			 = RgSyncQueue_Graphics;
+
+		// Resources without barriers are kept in a read only state both queues can read concurrently
+		for (std::size_t Resource : Level.BarrierResources)
+		{
+			if (std::size_t Node = LastAsyncComputeNodes[Resource]; Node != SIZE_MAX)
+			{
+				BarrierNode.Predecessors.push_back(Node);
+			}
+		}
+
+		if (Level.HasAsyncCompute)
+		{
+			AsyncComputeNode.Predecessors.push_back(GetLevelNode(i, LevelNode_Barriers));
+			LastAsyncComputeNode = GetLevelNode(i, LevelNode_AsyncCompute);
+		}
+		GraphicsNode.Predecessors.push_back(GetLevelNode(i, LevelNode_Barriers));
+
+		for (std::size_t Resource : Level.AsyncComputeResources)
+		{
+			LastAsyncComputeNodes[Resource] = GetLevelNode(i, LevelNode_AsyncCompute);
+		}
+	}
+
+	// Async compute nodes run in order, joining the last one covers the others
+	RgSyncNode& FrameEndNode = Nodes.back();
+	FrameEndNode.Queue		 = RgSyncQueue_Graphics;
+	if (LastAsyncComputeNode != SIZE_MAX)
+	{
+		FrameEndNode.Predecessors.push_back(LastAsyncComputeNode);
+	}
+
+	return Nodes;
+}
+
+RgSyncPlan RgSyncPlanner::Plan(std::span<const RgSyncNode> Nodes, std::size_t NumQueues)
+{
+	RgSyncPlan Plan = {};
+	Plan.Signals.resize(Nodes.size(), false);
+	Plan.Waits.resize(Nodes.size());
+
+	// Clocks count nodes submitted per queue, 0 means no node of that queue is known to have completed
+	using VectorClock = std::vector<std::size_t>;
+	std::vector<VectorClock> QueueClocks(NumQueues, VectorClock(NumQueues, 0));
+	std::vector<VectorClock> NodeClocks(Nodes.size());
+	std::vector<std::size_t> Sequence(Nodes.size(), 0);
+
+	// Latest predecessor per queue, the queues are in order so waiting on it covers earlier ones
+	std::vector<std::size_t> Latest(NumQueues);
+	constexpr std::size_t	 None = SIZE_MAX;
+
+	for (std::size_t i = 0; i < Nodes.size(); ++i)
+	{
+		const RgSyncNode& Node = Nodes[i];
+		assert(Node.Queue < NumQueues);
+		VectorClock& Clock = QueueClocks[Node.Queue];
+
+		std::ranges::fill(Latest, None);
+		for (std::size_t Predecessor : Node.Predecessors)
+		{
+			assert(Predecessor < i);
+			std::size_t Queue = Nodes[Predecessor].Queue;
+			if (Queue == Node.Queue)
+			{
+				continue;
+			}
+
+			Plan.NumCrossQueueEdges++;
+			if (Latest[Queue] == None || Sequence[Predecessor] > Sequence[Latest[Queue]])
+			{
+				Latest[Queue] = Predecessor;
+			}
+		}
+
+		// Wait on the most recent nodes first, their clocks are the most likely to cover the others
+		std::vector<std::size_t> Candidates;
+		for (std::size_t Predecessor : Latest)
+		{
+			if (Predecessor != None)
+			{
+				Candidates.push_back(Predecessor);
+			}
+		}
+		std::ranges::sort(Candidates, std::greater{});
+
+		for (std::size_t Predecessor : Candidates)
+		{
+			std::size_t Queue = Nodes[Predecessor].Queue;
+			if (Clock[Queue] >= Sequence[Predecessor])
+			{
+				continue;
+			}
+
+			Plan.Signals[Predecessor] = true;
+			Plan.Waits[i].push_back({ Queue, Predecessor });
+			Plan.NumWaits++;
+
+			const VectorClock& PredecessorClock = NodeClocks[Predecessor];
+			for (std::size_t q = 0; q < NumQueues; ++q)
+			{
+				Clock[q] = std::max(Clock[q], PredecessorClock[q]);
+			}
+		}
+
+		Sequence[i]	  = ++Clock[Node.Queue];
+		NodeClocks[i] = Clock;
+	}
+
+	return Plan;
+}
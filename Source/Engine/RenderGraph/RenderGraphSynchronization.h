@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Places the fence signals and waits between queues that the dependency edges require, redundant waits are dropped
+
+// Unit of work submitted to a queue, nodes are given in the order they are recorded
+struct RgSyncNode
+{
+	std::size_t				 Queue = 0;
+	std::vector<std::size_t> Predecessors; // Indices of earlier nodes this node depends on
+};
+
+struct RgQueueWait
+{
+	std::size_t Queue = 0; // Queue that signals
+	std::size_t Node  = 0; // Node whose completion is waited on
+};
+
+struct RgSyncPlan
+{
+	std::vector<bool>					  Signals; // Node signals its queue once submitted
+	std::vector<std::vector<RgQueueWait>> Waits;   // Waits inserted on the node's queue before it is submitted
+
+	std::size_t NumCrossQueueEdges = 0;
+	std::size_t NumWaits		   = 0;
+};
+
+// Queues of the nodes built by RgSyncPlanner::BuildLevelNodes
+enum RgSyncQueue : std::size_t
+{
+	RgSyncQueue_Graphics,
+	RgSyncQueue_AsyncCompute,
+	RgSyncQueue_Count
+};
+
+// Resources a render graph dependency level synchronizes on, resources of every type are numbered densely
+struct RgSyncLevel
+{
+	std::vector<std::size_t> BarrierResources;		// Transitioned by the level's barriers
+	std::vector<std::size_t> AsyncComputeResources; // Accessed by the level's async compute passes
+	bool					 HasAsyncCompute = false;
+};
+
+class RgSyncPlanner
+{
+public:
+	// Every dependency level is split into nodes that are recorded in this order
+	enum LevelNode
+	{
+		LevelNode_Barriers,
+		LevelNode_AsyncCompute,
+		LevelNode_Graphics,
+		LevelNode_Count
+	};
+
+	[[nodiscard]] static std::size_t GetLevelNode(std::size_t Level, LevelNode Node) noexcept { return Level * LevelNode_Count + Node; }
+
+	// Graphics node after the last level, async compute work joins the graphics queue there
+	// so none of it outlives the frame
+	[[nodiscard]] static std::size_t GetFrameEndNode(std::size_t NumLevels) noexcept { return NumLevels * LevelNode_Count; }
+
+	// Barriers of both queues are recorded on the graphics queue, so they wait for the async compute nodes
+	// that last used the resources they transition, and async compute nodes of a level wait for its barriers.
+	// Graphics nodes read async compute results through the barriers of their level
+	[[nodiscard]] static std::vector<RgSyncNode> BuildLevelNodes(std::span<const RgSyncLevel> Levels, std::size_t NumResources);
+
+	// Every queue keeps a vector clock of the latest node of every other queue it is known to execute after,
+	// a cross queue edge only becomes a wait if neither an earlier wait nor a transitive one already covers it
+	[[nodiscard]] static RgSyncPlan Plan(std::span<const RgSyncNode> Nodes, std::size_t NumQueues);
+};
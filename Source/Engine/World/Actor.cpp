@@ -4,6 +4,7 @@
 void Actor::OnComponentModified()
 {
 	World->WorldState |= EWorldState_Update;
+	World->MarkRenderStateDirty(Handle);
 }
 
 Actor::operator bool() const noexcept
@@ -30,6 +31,7 @@ Actor Actor::Clone()
 	CopyComponentIfExists<LightComponent>(Clone, *this, World->Registry);
 	CopyComponentIfExists<StaticMeshComponent>(Clone, *this, World->Registry);
 	// CopyComponentIfExists<NativeScriptComponent>(Clone, *this, World->Registry);
+	World->MarkRenderStateDirty(Clone);
 
 	return Clone;
 }
@@ -1,6 +1,12 @@
 #pragma once
 #include <tuple>
 
+template<typename TClass>
+const char* RegisterClassName();
+
+template<typename TClass>
+auto RegisterClassAttributes();
+
 template<typename T, typename TTuple>
 struct AttributeContainer
 {
@@ -14,12 +20,6 @@ auto Attributes(TArgs&&... Args)
 	return std::make_tuple(std::forward<TArgs>(Args)...);
 }
 
-template<typename TClass>
-const char* RegisterClassName();
-
-template<typename TClass>
-auto RegisterClassAttributes();
-
 template<typename TClass>
 const char* GetClass()
 {
@@ -1,5 +1,12 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+
+// Set to 1 to upload and cache meshes as PackedVertex instead of Vertex, shaders are compiled with PACKED_VERTEX
+// set to the same value. Existing .khscene files are imported again when this changes
+#define KAGUYA_PACKED_VERTEX 0
 
 struct Vertex
 {
@@ -7,3 +14,77 @@ struct Vertex
 	DirectX::XMFLOAT2 TextureCoord;
 	DirectX::XMFLOAT3 Normal;
 };
+
+// 20 instead of 32 bytes, must match VertexData in Vertex.hlsli. Position stays full precision since
+// the BLAS is built straight from the vertex buffer
+struct PackedVertex
+{
+	DirectX::XMFLOAT3				 Position;
+	DirectX::PackedVector::XMHALF2	 TextureCoord;
+	DirectX::PackedVector::XMSHORTN2 Normal; // Octahedral
+};
+
+static_assert(sizeof(PackedVertex) == 20);
+
+#if KAGUYA_PACKED_VERTEX
+using MeshVertex = PackedVertex;
+#else
+using MeshVertex = Vertex;
+#endif
+
+// Maps a unit vector onto the [-1, 1] square, the lower hemisphere is folded over the diagonals
+inline DirectX::XMFLOAT2 OctahedralEncode(const DirectX::XMFLOAT3& Normal)
+{
+	float Sum = std::abs(Normal.x) + std::abs(Normal.y) + std::abs(Normal.z);
+	if (Sum == 0.0f)
+	{
+		return { 0.0f, 0.0f };
+	}
+
+	float x = Normal.x / Sum;
+	float y = Normal.y / Sum;
+	if (Normal.z < 0.0f)
+	{
+		float FoldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		float FoldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+		x			  = FoldedX;
+		y			  = FoldedY;
+	}
+	return { x, y };
+}
+
+inline DirectX::XMFLOAT3 OctahedralDecode(const DirectX::XMFLOAT2& Encoded)
+{
+	DirectX::XMFLOAT3 Normal(Encoded.x, Encoded.y, 1.0f - std::abs(Encoded.x) - std::abs(Encoded.y));
+
+	float t = std::max(-Normal.z, 0.0f);
+	Normal.x += Normal.x >= 0.0f ? -t : t;
+	Normal.y += Normal.y >= 0.0f ? -t : t;
+
+	DirectX::XMStoreFloat3(&Normal, DirectX::XMVector3Normalize(DirectX::XMLoadFloat3(&Normal)));
+	return Normal;
+}
+
+inline PackedVertex PackVertex(const Vertex& Source)
+{
+	DirectX::XMFLOAT2 Normal = OctahedralEncode(Source.Normal);
+
+	PackedVertex Packed = {};
+	Packed.Position		= Source.Position;
+	Packed.TextureCoord = DirectX::PackedVector::XMHALF2(Source.TextureCoord.x, Source.TextureCoord.y);
+	Packed.Normal		= DirectX::PackedVector::XMSHORTN2(Normal.x, Normal.y);
+	return Packed;
+}
+
+inline Vertex UnpackVertex(const PackedVertex& Packed)
+{
+	DirectX::XMFLOAT2 TextureCoord, Normal;
+	DirectX::XMStoreFloat2(&TextureCoord, DirectX::PackedVector::XMLoadHalf2(&Packed.TextureCoord));
+	DirectX::XMStoreFloat2(&Normal, DirectX::PackedVector::XMLoadShortN2(&Packed.Normal));
+
+	Vertex Unpacked		  = {};
+	Unpacked.Position	  = Packed.Position;
+	Unpacked.TextureCoord = TextureCoord;
+	Unpacked.Normal		  = OctahedralDecode(Normal);
+	return Unpacked;
+}
@@ -19,6 +19,23 @@ auto World::CreateActor(std::string_view Name /*= {}*/) -> Actor
 	return Actor;
 }
 
+void World::CreateActors(size_t Count)
+{
+	std::vector<entt::entity> Entities(Count);
+	Registry.create(Entities.begin(), Entities.end());
+
+	CoreComponent Core = {};
+	Core.Name		   = DefaultActorName;
+	Registry.insert<CoreComponent>(Entities.begin(), Entities.end(), Core);
+
+	Actors.reserve(Actors.size() + Count);
+	for (entt::entity Entity : Entities)
+	{
+		Actors.emplace_back(Entity, this);
+	}
+	OnComponentsAdded<CoreComponent>(Entities);
+}
+
 auto World::GetMainCamera() -> Actor
 {
 	auto View = Registry.view<CameraComponent>();
@@ -53,6 +70,8 @@ void World::Clear(bool AddDefaultEntities /*= true*/)
 	Registry.clear();
 	ActiveCamera = nullptr;
 	Actors.clear();
+	RenderStateDirtyActors.clear();
+	RenderStateReset = true;
 	if (AddDefaultEntities)
 	{
 		ActiveCameraActor = CreateActor("Main Camera");
@@ -70,6 +89,7 @@ void World::DestroyActor(size_t Index)
 	{
 		return;
 	}
+	MarkRenderStateDirty(Entity);
 	Registry.destroy(Entity);
 	Actors.erase(Actors.begin() + Index);
 }
@@ -90,6 +110,11 @@ void World::BeginPlay()
 {
 }
 
+void World::MarkRenderStateDirty(entt::entity Handle)
+{
+	RenderStateDirtyActors.push_back(Handle);
+}
+
 void World::ResolveComponentDependencies()
 {
 	Registry.view<CoreComponent, CameraComponent>().each(
@@ -106,11 +131,16 @@ void World::ResolveComponentDependencies()
 
 	// Refresh StaticMeshComponent
 	Registry.view<StaticMeshComponent>().each(
-		[](StaticMeshComponent& StaticMesh)
+		[&](entt::entity Entity, StaticMeshComponent& StaticMesh)
 		{
+			// Assets finish streaming in asynchronously, so the gpu scene needs to pick up the resolved mesh and texture
+			bool Changed = false;
+
 			{
-				auto Handle			= StaticMesh.Handle;
-				StaticMesh.Mesh		= AssetManager::GetMeshCache().GetValidAsset(Handle);
+				auto  Handle = StaticMesh.Handle;
+				Mesh* Asset	 = AssetManager::GetMeshCache().GetValidAsset(Handle);
+				Changed |= StaticMesh.Mesh != Asset;
+				StaticMesh.Mesh		= Asset;
 				StaticMesh.HandleId = Handle.Id;
 			}
 
@@ -119,10 +149,17 @@ void World::ResolveComponentDependencies()
 				auto Texture = AssetManager::GetTextureCache().GetValidAsset(Handle);
 				if (Texture)
 				{
+					int TextureIndex = static_cast<int>(Texture->SRV.GetIndex());
+					Changed |= StaticMesh.Material.TextureIndices[0] != TextureIndex;
 					StaticMesh.Material.Albedo.HandleId	  = Handle.Id;
-					StaticMesh.Material.TextureIndices[0] = Texture->SRV.GetIndex();
+					StaticMesh.Material.TextureIndices[0] = TextureIndex;
 				}
 			}
+
+			if (Changed)
+			{
+				MarkRenderStateDirty(Entity);
+			}
 		});
 
 	Registry.view<SkyLightComponent>().each(
@@ -166,6 +203,7 @@ void World::OnComponentAdded(Actor Actor, T& Component)
 template<>
 void World::OnComponentAdded<CoreComponent>(Actor Actor, CoreComponent& Component)
 {
+	MarkRenderStateDirty(Actor);
 }
 
 template<>
@@ -185,6 +223,7 @@ void World::OnComponentAdded<CameraComponent>(Actor Actor, CameraComponent& Comp
 template<>
 void World::OnComponentAdded<LightComponent>(Actor Actor, LightComponent& Component)
 {
+	MarkRenderStateDirty(Actor);
 }
 
 template<>
@@ -203,6 +242,7 @@ void World::OnComponentAdded<SkyLightComponent>(Actor Actor, SkyLightComponent&
 template<>
 void World::OnComponentAdded<StaticMeshComponent>(Actor Actor, StaticMeshComponent& Component)
 {
+	MarkRenderStateDirty(Actor);
 }
 
 template<>
@@ -219,6 +259,7 @@ void World::OnComponentRemoved(Actor Actor, T& Component)
 template<>
 void World::OnComponentRemoved<CoreComponent>(Actor Actor, CoreComponent& Component)
 {
+	MarkRenderStateDirty(Actor);
 }
 
 template<>
@@ -229,6 +270,7 @@ void World::OnComponentRemoved<CameraComponent>(Actor Actor, CameraComponent& Co
 template<>
 void World::OnComponentRemoved<LightComponent>(Actor Actor, LightComponent& Component)
 {
+	MarkRenderStateDirty(Actor);
 }
 
 template<>
@@ -239,6 +281,7 @@ void World::OnComponentRemoved<SkyLightComponent>(Actor Actor, SkyLightComponent
 template<>
 void World::OnComponentRemoved<StaticMeshComponent>(Actor Actor, StaticMeshComponent& Component)
 {
+	MarkRenderStateDirty(Actor);
 }
 
 template<>
@@ -20,6 +20,8 @@ public:
 	World();
 
 	[[nodiscard]] auto CreateActor(std::string_view Name = {}) -> Actor;
+	// Bulk CreateActor, entities and CoreComponents are created in one go and appended to Actors
+	void CreateActors(size_t Count);
 	[[nodiscard]] auto GetMainCamera() -> Actor;
 	[[nodiscard]] auto GetMainSkyLight() -> Actor;
 
@@ -34,10 +36,22 @@ public:
 	template<typename T>
 	void OnComponentRemoved(Actor Actor, T& Component);
 
+	// Bulk GetOrAddComponent for unique entities. OnComponentAdded is not run for the added components, so they can be
+	// filled in from several threads through the returned pointers and the hooks run by OnComponentsAdded afterwards
+	template<typename T>
+	[[nodiscard]] auto EmplaceComponents(std::span<const entt::entity> Entities) -> std::vector<T*>;
+
+	// Runs OnComponentAdded in entity order, the batched pass of EmplaceComponents
+	template<typename T>
+	void OnComponentsAdded(std::span<const entt::entity> Entities);
+
 	void Update(float DeltaTime);
 
 	void BeginPlay();
 
+	// Queues the actor for the renderer, the gpu scene only re-uploads actors that have been marked
+	void MarkRenderStateDirty(entt::entity Handle);
+
 private:
 	void ResolveComponentDependencies();
 	void UpdateScripts(float DeltaTime);
@@ -52,6 +66,10 @@ public:
 	CameraComponent*   ActiveCamera	  = nullptr;
 	SkyLightComponent* ActiveSkyLight = nullptr;
 	std::vector<Actor> Actors;
+
+	// Consumed by the gpu scene every frame, RenderStateReset requests a full rebuild (e.g. after the registry is cleared)
+	std::vector<entt::entity> RenderStateDirtyActors;
+	bool					  RenderStateReset = true;
 };
 
 template<typename T, typename... TArgs>
@@ -99,6 +117,38 @@ void Actor::RemoveComponent()
 	World->Registry.remove<T>(Handle);
 }
 
+template<typename T>
+auto World::EmplaceComponents(std::span<const entt::entity> Entities) -> std::vector<T*>
+{
+	std::vector<entt::entity> Missing;
+	for (entt::entity Entity : Entities)
+	{
+		if (!Registry.any_of<T>(Entity))
+		{
+			Missing.push_back(Entity);
+		}
+	}
+	Registry.insert<T>(Missing.begin(), Missing.end());
+
+	// Taken once every component is in place, inserting may reallocate the storage
+	std::vector<T*> Components;
+	Components.reserve(Entities.size());
+	for (entt::entity Entity : Entities)
+	{
+		Components.push_back(&Registry.get<T>(Entity));
+	}
+	return Components;
+}
+
+template<typename T>
+void World::OnComponentsAdded(std::span<const entt::entity> Entities)
+{
+	for (entt::entity Entity : Entities)
+	{
+		OnComponentAdded<T>(Actor(Entity, this), Registry.get<T>(Entity));
+	}
+}
+
 namespace Hlsl
 {
 struct Material
@@ -136,6 +186,14 @@ struct Light
 	DirectX::XMFLOAT3 I;
 };
 
+struct MeshLod
+{
+	unsigned int IndexOffset;
+	unsigned int IndexCount;
+	unsigned int MeshletOffset;
+	unsigned int MeshletCount;
+};
+
 struct Mesh
 {
 	// 64
@@ -156,14 +214,21 @@ struct Mesh
 	// 20
 	D3D12_DRAW_INDEXED_ARGUMENTS DrawIndexedArguments;
 
-	// 20
+	// 28
 	unsigned int MaterialIndex;
 	unsigned int NumMeshlets;
+	// Raw views of the geometry pool buffer holding the mesh and byte offsets into it
 	unsigned int VertexView;
 	unsigned int IndexView;
-	unsigned int DEADBEEF2 = 0xDEADBEEF;
+	unsigned int VertexOffset;
+	unsigned int IndexOffset;
+	unsigned int NumLods;
+
+	// 80
+	MeshLod Lods[MaxMeshLods];
+	float	LodErrors[MaxMeshLods];
 };
-static_assert(sizeof(Mesh) == 256);
+static_assert(sizeof(Mesh) == 344);
 
 struct Camera
 {
@@ -1,8 +1,11 @@
 #include "WorldArchive.h"
+#include "WorldSnapshot.h"
 #include "World.h"
 #include <Core/Asset/AssetManager.h>
 #include "WorldJson.h"
 
+#include <execution>
+
 namespace Version
 {
 constexpr int	  Major	   = 1;
@@ -45,6 +48,7 @@ void WorldArchive::Save(const std::filesystem::path& Path, World* World)
 				auto&				  JsonTexture	   = JsonTextures[AssetPath.string()];
 				JsonTexture["Options"]["sRGB"]		   = Resource->Options.sRGB;
 				JsonTexture["Options"]["GenerateMips"] = Resource->Options.GenerateMips;
+				JsonTexture["Options"]["Compress"]	   = Resource->Options.Compress;
 			});
 
 		auto& JsonMeshes = Json["Meshes"];
@@ -72,30 +76,124 @@ void WorldArchive::Save(const std::filesystem::path& Path, World* World)
 	ofs << std::setfill('\t') << std::setw(1) << Json << std::endl;
 }
 
+// Calls F for every index in [0, Count) on the standard library's threads, in chunks so small components are not
+// scheduled one by one. std::for_each terminates if an element throws, the first exception is rethrown here instead
+template<typename Functor>
+static void ParallelFor(size_t Count, Functor&& F)
+{
+	constexpr size_t ChunkSize = 256;
+
+	std::vector<size_t> Chunks((Count + ChunkSize - 1) / ChunkSize);
+	std::iota(Chunks.begin(), Chunks.end(), size_t(0));
+
+	std::mutex		   Mutex;
+	std::exception_ptr Exception;
+	std::for_each(
+		std::execution::par,
+		Chunks.begin(),
+		Chunks.end(),
+		[&](size_t Chunk)
+		{
+			try
+			{
+				for (size_t i = Chunk * ChunkSize; i < std::min(Count, (Chunk + 1) * ChunkSize); ++i)
+				{
+					F(i);
+				}
+			}
+			catch (...)
+			{
+				std::scoped_lock Lock(Mutex);
+				if (!Exception)
+				{
+					Exception = std::current_exception();
+				}
+			}
+		});
+
+	if (Exception)
+	{
+		std::rethrow_exception(Exception);
+	}
+}
+
+// Deserializes T of every actor of the world, the components are added in bulk and filled in parallel
 template<typename T>
 struct ComponentDeserializer
 {
-	ComponentDeserializer(const json& Json, Actor* Actor)
+	ComponentDeserializer(const json& JsonWorld, World* World)
 	{
-		if (auto iter = Json.find(GetClass<T>()); iter != Json.end())
+		std::vector<entt::entity> Entities;
+		std::vector<const json*>  Values;
+		for (size_t i = 0; i < JsonWorld.size(); ++i)
 		{
-			auto& Component = Actor->GetOrAddComponent<T>();
+			const auto& JsonEntity = JsonWorld[i];
+			if (auto iter = JsonEntity.find(GetClass<T>()); iter != JsonEntity.end())
+			{
+				Entities.push_back(World->Actors[i]);
+				Values.push_back(&iter.value());
+			}
+		}
 
-			ForEachAttribute<T>(
-				[&](auto&& Attribute)
-				{
-					const auto& Value = iter.value();
+		std::vector<T*> Components = World->EmplaceComponents<T>(Entities);
+		ParallelFor(
+			Components.size(),
+			[&](size_t i)
+			{
+				const auto& Value = *Values[i];
 
-					const char* Name = Attribute.GetName();
-					if (Value.contains(Name))
+				ForEachAttribute<T>(
+					[&](auto&& Attribute)
 					{
-						Attribute.Set(Component, Value[Name].template get<decltype(Attribute.GetType())>());
-					}
-				});
+						const char* Name = Attribute.GetName();
+						if (Value.contains(Name))
+						{
+							Attribute.Set(*Components[i], Value[Name].template get<decltype(Attribute.GetType())>());
+						}
+					});
+			});
+
+		// CreateActors has run the hooks of the CoreComponents already
+		if constexpr (!std::is_same_v<T, CoreComponent>)
+		{
+			World->OnComponentsAdded<T>(Entities);
 		}
 	}
 };
 
+// Destroys the assets of the current world, imports of a previous load would otherwise land in the new caches
+static void ReleaseAssets()
+{
+	AssetManager::CancelPendingLoads();
+	AssetManager::GetTextureCache().DestroyAll();
+	AssetManager::GetMeshCache().DestroyAll();
+}
+
+// Archives store handle ids, the handles are resolved once the assets are created
+static void ResolveAssetHandles(Actor Actor)
+{
+	if (Actor.HasComponent<SkyLightComponent>())
+	{
+		auto& SkyLight		  = Actor.GetComponent<SkyLightComponent>();
+		SkyLight.Handle.Type  = AssetType::Texture;
+		SkyLight.Handle.State = false;
+		SkyLight.Handle.Id	  = SkyLight.HandleId;
+	}
+
+	if (Actor.HasComponent<StaticMeshComponent>())
+	{
+		auto& StaticMesh		= Actor.GetComponent<StaticMeshComponent>();
+		StaticMesh.Handle.Type	= AssetType::Mesh;
+		StaticMesh.Handle.State = false;
+		StaticMesh.Handle.Id	= StaticMesh.HandleId;
+
+		auto& Albedo		= StaticMesh.Material.Albedo;
+		Albedo.Handle.Type	= AssetType::Texture;
+		Albedo.Handle.State = false;
+		Albedo.Handle.Id	= Albedo.HandleId;
+	}
+}
+
 template<typename T>
 void JsonGetIfExists(const json::value_type& Json, const char* Key, T& RefValue)
 {
@@ -107,8 +205,13 @@ void JsonGetIfExists(const json::value_type& Json, const char* Key, T& RefValue)
 
 void WorldArchive::Load(const std::filesystem::path& Path, World* World)
 {
-	AssetManager::GetTextureCache().DestroyAll();
-	AssetManager::GetMeshCache().DestroyAll();
+	if (Path.extension() == SnapshotExtension)
+	{
+		LoadSnapshot(Path, World);
+		return;
+	}
+
+	ReleaseAssets();
 
 	std::ifstream ifs(Path);
 	json		  Json;
@@ -122,10 +225,26 @@ void WorldArchive::Load(const std::filesystem::path& Path, World* World)
 		}
 	}
 
+	// Textures get their handle id in request order, so the ids referenced by the world tell which requests
+	// are needed first. Mesh files contain an unknown number of meshes and can't be mapped to ids up front
+	std::unordered_map<uint32_t, ImportPriority> TexturePriorities;
+	if (Json.contains("World"))
+	{
+		const json::json_pointer AlbedoPointer("/StaticMesh/Material/Albedo/HandleId");
+		const json::json_pointer SkyLightPointer("/SkyLight/HandleId");
+		for (const auto& JsonEntity : Json["World"])
+		{
+			TexturePriorities.try_emplace(JsonEntity.value(AlbedoPointer, UINT32_MAX), ImportPriority::High);
+			TexturePriorities[JsonEntity.value(SkyLightPointer, UINT32_MAX)] = ImportPriority::Highest;
+		}
+	}
+
 	if (Json.contains("Textures"))
 	{
+		uint32_t HandleId = 0;
+
 		const auto& JsonTextures = Json["Textures"];
-		for (auto iter = JsonTextures.begin(); iter != JsonTextures.end(); ++iter)
+		for (auto iter = JsonTextures.begin(); iter != JsonTextures.end(); ++iter, ++HandleId)
 		{
 			TextureImportOptions Options = {};
 			Options.Path				 = Application::ExecutableDirectory / iter.key();
@@ -135,9 +254,11 @@ void WorldArchive::Load(const std::filesystem::path& Path, World* World)
 				auto& JsonOptions = Value["Options"];
 				JsonGetIfExists<bool>(JsonOptions, "sRGB", Options.sRGB);
 				JsonGetIfExists<bool>(JsonOptions, "GenerateMips", Options.GenerateMips);
+				JsonGetIfExists<bool>(JsonOptions, "Compress", Options.Compress);
 			}
 
-			AssetManager::AsyncLoadImage(Options);
+			auto Priority = TexturePriorities.find(HandleId);
+			AssetManager::AsyncLoadImage(Options, Priority != TexturePriorities.end() ? Priority->second : ImportPriority::Normal);
 		}
 	}
 
@@ -155,7 +276,7 @@ void WorldArchive::Load(const std::filesystem::path& Path, World* World)
 				auto& JsonOptions = Value["Options"];
 			}
 
-			AssetManager::AsyncLoadMesh(Options);
+			AssetManager::AsyncLoadMesh(Options, ImportPriority::High);
 		}
 	}
 
@@ -163,32 +284,195 @@ void WorldArchive::Load(const std::filesystem::path& Path, World* World)
 	{
 		World->Clear(false);
 
+		// Actors are created up front and deserialized a component type at a time, see ComponentDeserializer
 		const auto& JsonWorld = Json["World"];
-		for (const auto& JsonEntity : JsonWorld)
+		World->CreateActors(JsonWorld.size());
+
+		ComponentDeserializer<CoreComponent>(JsonWorld, World);
+		ComponentDeserializer<CameraComponent>(JsonWorld, World);
+		ComponentDeserializer<LightComponent>(JsonWorld, World);
+		ComponentDeserializer<SkyLightComponent>(JsonWorld, World);
+		ComponentDeserializer<StaticMeshComponent>(JsonWorld, World);
+
+		for (Actor Actor : World->Actors)
 		{
-			Actor Actor = World->CreateActor();
+			ResolveAssetHandles(Actor);
+		}
+	}
+}
 
-			ComponentDeserializer<CoreComponent>(JsonEntity, &Actor);
-			ComponentDeserializer<CameraComponent>(JsonEntity, &Actor);
-			ComponentDeserializer<LightComponent>(JsonEntity, &Actor);
-			ComponentDeserializer<SkyLightComponent>(JsonEntity, &Actor);
-			ComponentDeserializer<StaticMeshComponent>(JsonEntity, &Actor);
+// Attribute types that are reflected classes themselves, a snapshot stores their attributes instead
+template<>
+inline constexpr bool IsSnapshotNestedClass<Transform> = true;
+template<>
+inline constexpr bool IsSnapshotNestedClass<Material> = true;
+template<>
+inline constexpr bool IsSnapshotNestedClass<MaterialTexture> = true;
 
-			if (Actor.HasComponent<SkyLightComponent>())
-			{
-				auto& SkyLight		  = Actor.GetComponent<SkyLightComponent>();
-				SkyLight.Handle.Type  = AssetType::Texture;
-				SkyLight.Handle.State = false;
-				SkyLight.Handle.Id	  = SkyLight.HandleId;
-			}
+template<typename T>
+static void AddSnapshotColumn(WorldSnapshotWriter& Writer, World* World)
+{
+	std::vector<uint32_t> ActorIndices;
+	std::vector<const T*> Components;
+	for (auto [i, Actor] : enumerate(World->Actors))
+	{
+		if (Actor.HasComponent<T>())
+		{
+			ActorIndices.push_back(static_cast<uint32_t>(i));
+			Components.push_back(&Actor.GetComponent<T>());
+		}
+	}
+	Writer.AddColumn<T>(ActorIndices, Components);
+}
 
-			if (Actor.HasComponent<StaticMeshComponent>())
+void WorldArchive::SaveSnapshot(const std::filesystem::path& Path, World* World)
+{
+	WorldSnapshotWriter Writer;
+
+	AssetManager::GetTextureCache().EnumerateAsset(
+		[&](AssetHandle Handle, Texture* Resource)
+		{
+			std::filesystem::path AssetPath = relative(Resource->Options.Path, Application::ExecutableDirectory);
+			Writer.AddTexture(
+				AssetPath.string(),
+				(Resource->Options.sRGB ? 1 : 0) | (Resource->Options.GenerateMips ? 2 : 0) | (Resource->Options.Compress ? 4 : 0));
+		});
+
+	// Every mesh of a file has the path of the file, which is loaded once
+	std::unordered_set<std::string> MeshPaths;
+	AssetManager::GetMeshCache().EnumerateAsset(
+		[&](AssetHandle Handle, Mesh* Resource)
+		{
+			std::string AssetPath = relative(Resource->Options.Path, Application::ExecutableDirectory).string();
+			if (MeshPaths.insert(AssetPath).second)
 			{
-				auto& StaticMesh		= Actor.GetComponent<StaticMeshComponent>();
-				StaticMesh.Handle.Type	= AssetType::Mesh;
-				StaticMesh.Handle.State = false;
-				StaticMesh.Handle.Id	= StaticMesh.HandleId;
+				Writer.AddMesh(AssetPath);
 			}
+		});
+
+	AddSnapshotColumn<CoreComponent>(Writer, World);
+	AddSnapshotColumn<CameraComponent>(Writer, World);
+	AddSnapshotColumn<LightComponent>(Writer, World);
+	AddSnapshotColumn<SkyLightComponent>(Writer, World);
+	AddSnapshotColumn<StaticMeshComponent>(Writer, World);
+
+	std::vector<BYTE> File = Writer.Finish(static_cast<uint32_t>(World->Actors.size()));
+
+	FileStream	 Stream(Path, FileMode::Create, FileAccess::Write);
+	BinaryWriter BinaryWriter(Stream);
+	BinaryWriter.Write(File.data(), File.size());
+}
+
+template<typename T>
+static void ReadSnapshotColumn(const WorldSnapshotReader& Reader, World* World)
+{
+	const WorldSnapshotColumn* Column = Reader.FindColumn(GetClass<T>());
+	if (!Column)
+	{
+		return;
+	}
+
+	// Resolved once per column, the attributes of every component are then read from their arrays
+	std::vector<WorldSnapshotSchemaAttribute> Schema;
+	std::vector<const BYTE*>				  Arrays = Reader.GetAttributeArrays<T>(*Column, Schema);
+	for (size_t i = 0; i < Schema.size(); ++i)
+	{
+		if (!Arrays[i])
+		{
+			LOG_WARN("Snapshot does not store {}.{}, it keeps its default", GetClass<T>(), Schema[i].Path);
 		}
 	}
+
+	// The reader has checked that every actor index is in range and appears once
+	std::vector<entt::entity> Entities;
+	Entities.reserve(Column->NumComponents);
+	for (uint32_t ActorIndex : Reader.Map<uint32_t>(Column->Actors))
+	{
+		Entities.push_back(World->Actors[ActorIndex]);
+	}
+
+	std::vector<T*> Components = World->EmplaceComponents<T>(Entities);
+	ParallelFor(
+		Components.size(),
+		[&](size_t i)
+		{
+			Reader.ReadComponent(Arrays, i, *Components[i]);
+		});
+
+	// CreateActors has run the hooks of the CoreComponents already
+	if constexpr (!std::is_same_v<T, CoreComponent>)
+	{
+		World->OnComponentsAdded<T>(Entities);
+	}
+}
+
+void WorldArchive::LoadSnapshot(const std::filesystem::path& Path, World* World)
+{
+	FileStream Stream(Path, FileMode::Open, FileAccess::Read);
+	if (Stream.GetSizeInBytes() < sizeof(WorldSnapshotHeader))
+	{
+		throw std::exception("Invalid snapshot");
+	}
+
+	MemoryMappedFile	File(Stream);
+	MemoryMappedView	View = File.CreateView();
+	WorldSnapshotReader Reader({ View.GetView(0), View.GetSizeInBytes() });
+	if (!Reader.IsValid())
+	{
+		throw std::exception("Invalid snapshot");
+	}
+
+	ReleaseAssets();
+
+	// Same priorities as a JSON load, read from the handle id arrays instead of per actor
+	std::unordered_map<uint32_t, ImportPriority> TexturePriorities;
+	auto FindHandleIds = [&](const char* Name, const char* AttributePath) -> std::span<const uint32_t>
+	{
+		const WorldSnapshotColumn*	  Column	= Reader.FindColumn(Name);
+		const WorldSnapshotAttribute* Attribute = Column ? Reader.FindAttribute(*Column, { AttributePath, sizeof(uint32_t), false }) : nullptr;
+		return Attribute ? Reader.Map<uint32_t>(Attribute->Data) : std::span<const uint32_t>();
+	};
+	for (uint32_t HandleId : FindHandleIds(GetClass<StaticMeshComponent>(), "Material.Albedo.HandleId"))
+	{
+		TexturePriorities.try_emplace(HandleId, ImportPriority::High);
+	}
+	for (uint32_t HandleId : FindHandleIds(GetClass<SkyLightComponent>(), "HandleId"))
+	{
+		TexturePriorities[HandleId] = ImportPriority::Highest;
+	}
+
+	for (auto [HandleId, Entry] : enumerate(Reader.GetTextures()))
+	{
+		TextureImportOptions Options = {};
+		Options.Path				 = Application::ExecutableDirectory / Reader.MapString(Entry.Path);
+		Options.sRGB				 = (Entry.OptionFlags & 1) != 0;
+		Options.GenerateMips		 = (Entry.OptionFlags & 2) != 0;
+		Options.Compress			 = (Entry.OptionFlags & 4) != 0;
+
+		auto Priority = TexturePriorities.find(static_cast<uint32_t>(HandleId));
+		AssetManager::AsyncLoadImage(Options, Priority != TexturePriorities.end() ? Priority->second : ImportPriority::Normal);
+	}
+
+	for (const WorldSnapshotSection& Mesh : Reader.GetMeshes())
+	{
+		MeshImportOptions Options = {};
+		Options.Path			  = Application::ExecutableDirectory / Reader.MapString(Mesh);
+		AssetManager::AsyncLoadMesh(Options, ImportPriority::High);
+	}
+
+	World->Clear(false);
+	World->CreateActors(Reader.GetNumActors());
+
+	ReadSnapshotColumn<CoreComponent>(Reader, World);
+	ReadSnapshotColumn<CameraComponent>(Reader, World);
+	ReadSnapshotColumn<LightComponent>(Reader, World);
+	ReadSnapshotColumn<SkyLightComponent>(Reader, World);
+	ReadSnapshotColumn<StaticMeshComponent>(Reader, World);
+
+	for (Actor Actor : World->Actors)
+	{
+		ResolveAssetHandles(Actor);
+	}
+
+	LOG_INFO("{}: loaded {} actors, {} bytes", Path.string(), World->Actors.size(), View.GetSizeInBytes());
 }
@@ -6,7 +6,17 @@ class World;
 class WorldArchive
 {
 public:
+	static constexpr char SnapshotExtension[] = ".khworld";
+
+	// JSON, the format worlds are edited and exchanged in
 	static void Save(const std::filesystem::path& Path, World* World);
 
+	// Reads a snapshot if Path has the snapshot extension, JSON otherwise
 	static void Load(const std::filesystem::path& Path, World* World);
+
+	// Binary snapshot of what Save writes, generated from the same attribute reflection and laid out by
+	// WorldSnapshot.h. Attributes are stored per component type, so loading maps the file and copies attribute
+	// arrays instead of parsing and looking up keys per actor
+	static void SaveSnapshot(const std::filesystem::path& Path, World* World);
+	static void LoadSnapshot(const std::filesystem::path& Path, World* World);
 };
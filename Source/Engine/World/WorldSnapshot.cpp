@@ -0,0 +1,199 @@
+#include "WorldSnapshot.h"
+
+WorldSnapshotWriter::WorldSnapshotWriter()
+{
+	File.resize(sizeof(WorldSnapshotHeader));
+}
+
+void WorldSnapshotWriter::AddTexture(std::string_view Path, uint32_t OptionFlags)
+{
+	WorldSnapshotTexture& Texture = Textures.emplace_back();
+	Texture.Path				  = Append(Path);
+	Texture.OptionFlags			  = OptionFlags;
+}
+
+void WorldSnapshotWriter::AddMesh(std::string_view Path)
+{
+	Meshes.push_back(Append(Path));
+}
+
+std::vector<BYTE> WorldSnapshotWriter::Finish(uint32_t NumActors)
+{
+	WorldSnapshotHeader Header = {};
+	Header.Magic			   = WorldSnapshotMagic;
+	Header.Version			   = WorldSnapshotVersion;
+	Header.NumActors		   = NumActors;
+	Header.Textures			   = Append(std::span<const WorldSnapshotTexture>(Textures));
+	Header.Meshes			   = Append(std::span<const WorldSnapshotSection>(Meshes));
+	Header.Columns			   = Append(std::span<const WorldSnapshotColumn>(Columns));
+	Header.Attributes		   = Append(std::span<const WorldSnapshotAttribute>(Attributes));
+	Header.FileSize			   = File.size();
+	std::memcpy(File.data(), &Header, sizeof(WorldSnapshotHeader));
+
+	Textures.clear();
+	Meshes.clear();
+	Columns.clear();
+	Attributes.clear();
+	return std::exchange(File, std::vector<BYTE>(sizeof(WorldSnapshotHeader)));
+}
+
+WorldSnapshotSection WorldSnapshotWriter::Append(const void* Data, uint64_t SizeInBytes, uint64_t Alignment)
+{
+	WorldSnapshotSection Section = {};
+	Section.Offset				 = AlignUp<uint64_t>(File.size(), Alignment);
+	Section.SizeInBytes			 = SizeInBytes;
+
+	File.resize(Section.Offset + SizeInBytes);
+	if (SizeInBytes > 0)
+	{
+		std::memcpy(File.data() + Section.Offset, Data, SizeInBytes);
+	}
+	return Section;
+}
+
+WorldSnapshotReader::WorldSnapshotReader(std::span<const BYTE> File)
+	: File(File)
+{
+	Valid = Validate();
+	if (!Valid)
+	{
+		NumActors  = 0;
+		Textures   = {};
+		Meshes	   = {};
+		Columns	   = {};
+		Attributes = {};
+	}
+}
+
+const WorldSnapshotColumn* WorldSnapshotReader::FindColumn(std::string_view Name) const noexcept
+{
+	for (const WorldSnapshotColumn& Column : Columns)
+	{
+		if (MapString(Column.Name) == Name)
+		{
+			return &Column;
+		}
+	}
+	return nullptr;
+}
+
+const WorldSnapshotAttribute* WorldSnapshotReader::FindAttribute(const WorldSnapshotColumn& Column, const WorldSnapshotSchemaAttribute& Expected) const noexcept
+{
+	for (const WorldSnapshotAttribute& Attribute : Attributes.subspan(Column.FirstAttribute, Column.NumAttributes))
+	{
+		if (MapString(Attribute.Path) == Expected.Path && Attribute.ElementSize == Expected.ElementSize &&
+			static_cast<bool>(Attribute.IsString) == Expected.IsString)
+		{
+			return &Attribute;
+		}
+	}
+	return nullptr;
+}
+
+bool WorldSnapshotReader::IsValid(const WorldSnapshotSection& Section, UINT64 Alignment) const noexcept
+{
+	// Written so that nothing overflows whatever the file holds
+	if (Section.Offset > File.size() || Section.SizeInBytes > File.size() - Section.Offset)
+	{
+		return false;
+	}
+	return Section.SizeInBytes == 0 || reinterpret_cast<uintptr_t>(File.data() + Section.Offset) % Alignment == 0;
+}
+
+bool WorldSnapshotReader::IsValid(const WorldSnapshotColumn& Column) const
+{
+	if (!IsValid(Column.Name, 1) || !IsValid(Column.Actors, alignof(uint32_t)) ||
+		Column.Actors.SizeInBytes != static_cast<uint64_t>(Column.NumComponents) * sizeof(uint32_t) ||
+		static_cast<uint64_t>(Column.FirstAttribute) + Column.NumAttributes > Attributes.size())
+	{
+		return false;
+	}
+
+	// Components of a column are read in parallel, an actor appears once per column. Sorted instead of marked so the
+	// cost follows the size of the file, not the actor count in the header
+	std::span<const uint32_t> Actors = Map<uint32_t>(Column.Actors);
+	std::vector<uint32_t>	  Sorted(Actors.begin(), Actors.end());
+	std::ranges::sort(Sorted);
+	if ((!Sorted.empty() && Sorted.back() >= NumActors) || std::ranges::adjacent_find(Sorted) != Sorted.end())
+	{
+		return false;
+	}
+
+	for (const WorldSnapshotAttribute& Attribute : Attributes.subspan(Column.FirstAttribute, Column.NumAttributes))
+	{
+		// Arrays are aligned for any attribute type, the handle id arrays are read in place
+		if (!IsValid(Attribute.Path, 1) || Attribute.ElementSize == 0 || !IsValid(Attribute.Data, WorldSnapshotArrayAlignment) ||
+			Attribute.Data.SizeInBytes != static_cast<uint64_t>(Column.NumComponents) * Attribute.ElementSize)
+		{
+			return false;
+		}
+
+		if (Attribute.IsString)
+		{
+			if (Attribute.ElementSize != sizeof(WorldSnapshotSection))
+			{
+				return false;
+			}
+			for (uint32_t i = 0; i < Column.NumComponents; ++i)
+			{
+				WorldSnapshotSection String;
+				std::memcpy(&String, File.data() + Attribute.Data.Offset + i * sizeof(String), sizeof(String));
+				if (!IsValid(String, 1))
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool WorldSnapshotReader::Validate()
+{
+	if (File.size() < sizeof(WorldSnapshotHeader))
+	{
+		return false;
+	}
+
+	WorldSnapshotHeader Header;
+	std::memcpy(&Header, File.data(), sizeof(WorldSnapshotHeader));
+	if (Header.Magic != WorldSnapshotMagic || Header.Version != WorldSnapshotVersion || Header.FileSize != File.size())
+	{
+		return false;
+	}
+
+	if (!IsTable<WorldSnapshotTexture>(Header.Textures) || !IsTable<WorldSnapshotSection>(Header.Meshes) ||
+		!IsTable<WorldSnapshotColumn>(Header.Columns) || !IsTable<WorldSnapshotAttribute>(Header.Attributes))
+	{
+		return false;
+	}
+
+	NumActors  = Header.NumActors;
+	Textures   = Map<WorldSnapshotTexture>(Header.Textures);
+	Meshes	   = Map<WorldSnapshotSection>(Header.Meshes);
+	Columns	   = Map<WorldSnapshotColumn>(Header.Columns);
+	Attributes = Map<WorldSnapshotAttribute>(Header.Attributes);
+
+	for (const WorldSnapshotTexture& Texture : Textures)
+	{
+		if (!IsValid(Texture.Path, 1))
+		{
+			return false;
+		}
+	}
+	for (const WorldSnapshotSection& Mesh : Meshes)
+	{
+		if (!IsValid(Mesh, 1))
+		{
+			return false;
+		}
+	}
+	for (const WorldSnapshotColumn& Column : Columns)
+	{
+		if (!IsValid(Column))
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,308 @@
+#pragma once
+#include "Attribute.h"
+
+// .khworld layout, a WorldSnapshotHeader followed by the strings, the tables and the attribute arrays. Every reflected
+// attribute that is not a reflected class itself is stored as an array with an element per component, named by its
+// path within the component (e.g. "Transform.Position"). Readers match the attributes of the current build against
+// these paths, attributes missing from the file keep their defaults like with JSON
+inline constexpr uint32_t WorldSnapshotMagic		  = 0x4457484B; // "KHWD"
+inline constexpr uint32_t WorldSnapshotVersion		  = 1;
+inline constexpr UINT64	  WorldSnapshotArrayAlignment = 16;
+
+// Byte range within the file
+struct WorldSnapshotSection
+{
+	uint64_t Offset;
+	uint64_t SizeInBytes;
+};
+
+struct WorldSnapshotHeader
+{
+	uint32_t			 Magic;
+	uint32_t			 Version;
+	uint64_t			 FileSize;
+	uint32_t			 NumActors;
+	uint32_t			 Padding;
+	WorldSnapshotSection Textures;	 // WorldSnapshotTexture per texture, in handle id order
+	WorldSnapshotSection Meshes;	 // WorldSnapshotSection per mesh file path
+	WorldSnapshotSection Columns;	 // WorldSnapshotColumn per component type
+	WorldSnapshotSection Attributes; // WorldSnapshotAttribute per attribute of every column
+};
+
+struct WorldSnapshotTexture
+{
+	WorldSnapshotSection Path;
+	uint32_t			 OptionFlags; // sRGB, GenerateMips and Compress
+	uint32_t			 Padding;
+};
+
+struct WorldSnapshotColumn
+{
+	WorldSnapshotSection Name;	 // Class name of the component
+	WorldSnapshotSection Actors; // uint32_t actor index per component
+	uint32_t			 NumComponents;
+	uint32_t			 FirstAttribute;
+	uint32_t			 NumAttributes;
+	uint32_t			 Padding;
+};
+
+struct WorldSnapshotAttribute
+{
+	WorldSnapshotSection Path;
+	WorldSnapshotSection Data;		  // Element per component of the column
+	uint32_t			 ElementSize; // sizeof the attribute, strings are stored as a WorldSnapshotSection of their characters
+	uint32_t			 IsString;
+};
+
+// Attribute types that are reflected classes themselves, a snapshot stores their attributes instead. Specialized by
+// the code that registers the class attributes before it writes or reads a snapshot
+template<typename T>
+inline constexpr bool IsSnapshotNestedClass = false;
+
+struct WorldSnapshotSchemaAttribute
+{
+	std::string Path;
+	uint32_t	ElementSize;
+	bool		IsString;
+};
+
+// Stored attributes of TClass in ForEachStoredAttribute order
+template<typename TClass>
+void GetSnapshotSchema(const std::string& Prefix, std::vector<WorldSnapshotSchemaAttribute>& Schema)
+{
+	ForEachAttribute<TClass>(
+		[&](auto&& Attribute)
+		{
+			using T = decltype(Attribute.GetType());
+
+			std::string Path = Prefix + Attribute.GetName();
+			if constexpr (IsSnapshotNestedClass<T>)
+			{
+				GetSnapshotSchema<T>(Path + ".", Schema);
+			}
+			else if constexpr (std::is_same_v<T, std::string>)
+			{
+				Schema.push_back({ std::move(Path), sizeof(WorldSnapshotSection), true });
+			}
+			else
+			{
+				static_assert(std::is_trivially_copyable_v<T>, "Attribute is neither a string nor trivially copyable");
+				Schema.push_back({ std::move(Path), sizeof(T), false });
+			}
+		});
+}
+
+template<typename TClass, typename Functor>
+void ForEachStoredAttribute(TClass& Object, Functor&& F)
+{
+	ForEachAttribute<std::remove_const_t<TClass>>(
+		[&](auto&& Attribute)
+		{
+			if constexpr (IsSnapshotNestedClass<decltype(Attribute.GetType())>)
+			{
+				ForEachStoredAttribute(Attribute.Get(Object), F);
+			}
+			else
+			{
+				F(Attribute.Get(Object));
+			}
+		});
+}
+
+// Builds a file in memory, sections are appended as they are written and the tables and the header last
+class WorldSnapshotWriter
+{
+public:
+	WorldSnapshotWriter();
+
+	void AddTexture(std::string_view Path, uint32_t OptionFlags);
+	void AddMesh(std::string_view Path);
+
+	// Components of type T and the index of the actor each belongs to, an actor has at most one component per type
+	template<typename T>
+	void AddColumn(std::span<const uint32_t> ActorIndices, std::span<const T* const> Components);
+
+	// Writes the tables and the header, the writer is empty afterwards
+	[[nodiscard]] std::vector<BYTE> Finish(uint32_t NumActors);
+
+private:
+	WorldSnapshotSection Append(const void* Data, uint64_t SizeInBytes, uint64_t Alignment);
+	WorldSnapshotSection Append(std::string_view String) { return Append(String.data(), String.size(), 1); }
+
+	template<typename T>
+	WorldSnapshotSection Append(std::span<const T> Data, uint64_t Alignment = alignof(T))
+	{
+		return Append(Data.data(), Data.size_bytes(), Alignment);
+	}
+
+private:
+	std::vector<BYTE>					File;
+	std::vector<WorldSnapshotTexture>	Textures;
+	std::vector<WorldSnapshotSection>	Meshes;
+	std::vector<WorldSnapshotColumn>	Columns;
+	std::vector<WorldSnapshotAttribute> Attributes;
+};
+
+template<typename T>
+void WorldSnapshotWriter::AddColumn(std::span<const uint32_t> ActorIndices, std::span<const T* const> Components)
+{
+	assert(ActorIndices.size() == Components.size());
+
+	std::vector<WorldSnapshotSchemaAttribute> Schema;
+	GetSnapshotSchema<T>("", Schema);
+
+	// Strings go to the file right away, the arrays hold their sections
+	std::vector<std::vector<BYTE>> Arrays(Schema.size());
+	for (size_t i = 0; i < Schema.size(); ++i)
+	{
+		Arrays[i].reserve(Components.size() * Schema[i].ElementSize);
+	}
+	for (const T* Component : Components)
+	{
+		size_t Index = 0;
+		ForEachStoredAttribute(
+			*Component,
+			[&](const auto& Value)
+			{
+				std::vector<BYTE>& Array = Arrays[Index++];
+				if constexpr (std::is_same_v<std::remove_cvref_t<decltype(Value)>, std::string>)
+				{
+					WorldSnapshotSection String = Append(Value);
+					Array.insert(Array.end(), reinterpret_cast<const BYTE*>(&String), reinterpret_cast<const BYTE*>(&String + 1));
+				}
+				else
+				{
+					Array.insert(Array.end(), reinterpret_cast<const BYTE*>(&Value), reinterpret_cast<const BYTE*>(&Value + 1));
+				}
+			});
+	}
+
+	WorldSnapshotColumn Column = {};
+	Column.Name				   = Append(GetClass<T>());
+	Column.Actors			   = Append(ActorIndices);
+	Column.NumComponents	   = static_cast<uint32_t>(Components.size());
+	Column.FirstAttribute	   = static_cast<uint32_t>(Attributes.size());
+	Column.NumAttributes	   = static_cast<uint32_t>(Schema.size());
+	Columns.push_back(Column);
+
+	for (size_t i = 0; i < Schema.size(); ++i)
+	{
+		WorldSnapshotAttribute Attribute = {};
+		Attribute.Path					 = Append(Schema[i].Path);
+		Attribute.Data					 = Append(Arrays[i].data(), Arrays[i].size(), WorldSnapshotArrayAlignment);
+		Attribute.ElementSize			 = Schema[i].ElementSize;
+		Attribute.IsString				 = Schema[i].IsString;
+		Attributes.push_back(Attribute);
+	}
+}
+
+// Validates a .khworld before anything is read from it, so a world is never left half loaded. The header, the tables,
+// every section and every stored string are checked against the size of the file without overflowing, the actor
+// indices of a column must be in range and unique and an attribute array must hold an element per component. Once
+// IsValid, mapping and reading never go out of the file
+class WorldSnapshotReader
+{
+public:
+	explicit WorldSnapshotReader(std::span<const BYTE> File);
+
+	[[nodiscard]] bool IsValid() const noexcept { return Valid; }
+
+	[[nodiscard]] uint32_t								GetNumActors() const noexcept { return NumActors; }
+	[[nodiscard]] std::span<const WorldSnapshotTexture>	GetTextures() const noexcept { return Textures; }
+	[[nodiscard]] std::span<const WorldSnapshotSection>	GetMeshes() const noexcept { return Meshes; }
+	[[nodiscard]] std::span<const WorldSnapshotColumn>	GetColumns() const noexcept { return Columns; }
+
+	template<typename T>
+	[[nodiscard]] std::span<const T> Map(const WorldSnapshotSection& Section) const noexcept
+	{
+		assert(IsValid(Section, alignof(T)));
+		return { reinterpret_cast<const T*>(File.data() + Section.Offset), Section.SizeInBytes / sizeof(T) };
+	}
+
+	[[nodiscard]] std::string_view MapString(const WorldSnapshotSection& Section) const noexcept
+	{
+		std::span<const char> String = Map<char>(Section);
+		return { String.data(), String.size() };
+	}
+
+	// nullptr if the file has no column of class Name
+	[[nodiscard]] const WorldSnapshotColumn* FindColumn(std::string_view Name) const noexcept;
+
+	// Attribute of the column stored in the expected format, nullptr if the file doesn't store it
+	[[nodiscard]] const WorldSnapshotAttribute* FindAttribute(const WorldSnapshotColumn& Column, const WorldSnapshotSchemaAttribute& Expected) const noexcept;
+
+	// Array of every stored attribute of T in ForEachStoredAttribute order, nullptr for the ones the file doesn't
+	// store. Schema receives the attributes so the caller can report the missing ones
+	template<typename T>
+	[[nodiscard]] std::vector<const BYTE*> GetAttributeArrays(const WorldSnapshotColumn& Column, std::vector<WorldSnapshotSchemaAttribute>& Schema) const;
+
+	// Reads the Index-th component of a column from the arrays of GetAttributeArrays, components of a column can be
+	// read from several threads
+	template<typename T>
+	void ReadComponent(std::span<const BYTE* const> Arrays, size_t Index, T& Component) const;
+
+private:
+	[[nodiscard]] bool IsValid(const WorldSnapshotSection& Section, UINT64 Alignment) const noexcept;
+	[[nodiscard]] bool IsValid(const WorldSnapshotColumn& Column) const;
+
+	template<typename T>
+	[[nodiscard]] bool IsTable(const WorldSnapshotSection& Section) const noexcept
+	{
+		return IsValid(Section, alignof(T)) && Section.SizeInBytes % sizeof(T) == 0;
+	}
+
+	[[nodiscard]] bool Validate();
+
+private:
+	std::span<const BYTE>					File;
+	uint32_t								NumActors = 0;
+	std::span<const WorldSnapshotTexture>	Textures;
+	std::span<const WorldSnapshotSection>	Meshes;
+	std::span<const WorldSnapshotColumn>	Columns;
+	std::span<const WorldSnapshotAttribute> Attributes;
+	bool									Valid;
+};
+
+template<typename T>
+std::vector<const BYTE*> WorldSnapshotReader::GetAttributeArrays(const WorldSnapshotColumn& Column, std::vector<WorldSnapshotSchemaAttribute>& Schema) const
+{
+	Schema.clear();
+	GetSnapshotSchema<T>("", Schema);
+
+	std::vector<const BYTE*> Arrays(Schema.size());
+	for (size_t i = 0; i < Schema.size(); ++i)
+	{
+		if (const WorldSnapshotAttribute* Attribute = FindAttribute(Column, Schema[i]))
+		{
+			Arrays[i] = File.data() + Attribute->Data.Offset;
+		}
+	}
+	return Arrays;
+}
+
+template<typename T>
+void WorldSnapshotReader::ReadComponent(std::span<const BYTE* const> Arrays, size_t Index, T& Component) const
+{
+	size_t Attribute = 0;
+	ForEachStoredAttribute(
+		Component,
+		[&](auto& Value)
+		{
+			const BYTE* Array = Arrays[Attribute++];
+			if (!Array)
+			{
+				return;
+			}
+
+			if constexpr (std::is_same_v<std::remove_cvref_t<decltype(Value)>, std::string>)
+			{
+				WorldSnapshotSection String;
+				std::memcpy(&String, Array + Index * sizeof(String), sizeof(String));
+				Value = MapString(String);
+			}
+			else
+			{
+				std::memcpy(&Value, Array + Index * sizeof(Value), sizeof(Value));
+			}
+		});
+}
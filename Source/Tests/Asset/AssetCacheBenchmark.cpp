@@ -0,0 +1,194 @@
+#include "Core/Sync.h"
+#include "Core/Asset/AssetCache.h"
+#include "Benchmark.h"
+#include <latch>
+
+// Resolves 16384 asset handles from 1, 2, 4 and 8 reader threads the way World::ResolveComponentDependencies does
+// every frame, alone and while a writer thread publishes handle states like the upload thread. AssetCache validates
+// handles against the atomic slot words, LockedCache is GetValidAsset and UpdateHandleState as they were before,
+// under the cache's RwLock.
+
+struct BenchmarkAsset : Asset
+{
+	explicit BenchmarkAsset(uint32_t Value)
+		: Value(Value)
+	{
+	}
+
+	uint32_t Value;
+};
+
+using BenchmarkCache = AssetCache<AssetType::Mesh, BenchmarkAsset>;
+
+class LockedCache
+{
+public:
+	explicit LockedCache(BenchmarkCache& Cache)
+	{
+		for (AssetHandle Handle : Cache)
+		{
+			Handles.push_back(Handle);
+			Assets.push_back(Cache.GetAsset(Handle));
+		}
+	}
+
+	BenchmarkAsset* GetValidAsset(AssetHandle& Handle)
+	{
+		if (Handle.IsValid() && BenchmarkCache::ValidateHandle(Handle))
+		{
+			RwLockReadGuard Guard(Mutex);
+
+			bool State = Handles[Handle.Id].State;
+			if (State)
+			{
+				Handle.State = State;
+				return Assets[Handle.Id];
+			}
+		}
+
+		return nullptr;
+	}
+
+	void UpdateHandleState(AssetHandle Handle)
+	{
+		if (Handle.IsValid() && BenchmarkCache::ValidateHandle(Handle))
+		{
+			RwLockWriteGuard Guard(Mutex);
+
+			Handles[Handle.Id].State = Handle.State;
+		}
+	}
+
+private:
+	std::vector<AssetHandle>	 Handles;
+	std::vector<BenchmarkAsset*> Assets;
+	RwLock						 Mutex;
+};
+
+struct BenchmarkResult
+{
+	double MillionLookupsPerSecond;
+	double WritesPerMillisecond;
+};
+
+static size_t Checksum = 0;
+
+template<typename TCache>
+static BenchmarkResult Run(TCache& Cache, std::span<const AssetHandle> Handles, int NumReaders, bool HasWriter, int Iterations)
+{
+	std::latch			Start(NumReaders + 1);
+	std::atomic<bool>	Done	  = false;
+	std::atomic<size_t> Sum		  = 0;
+	size_t				NumWrites = 0;
+
+	std::vector<std::thread> Readers;
+	for (int i = 0; i < NumReaders; ++i)
+	{
+		Readers.emplace_back(
+			[&, i]
+			{
+				// Every reader walks the handles in an order of its own, like the components of a world do
+				std::vector<AssetHandle> Order(Handles.begin(), Handles.end());
+				std::ranges::shuffle(Order, std::mt19937(i));
+
+				Start.arrive_and_wait();
+
+				size_t ReaderSum = 0;
+				for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+				{
+					for (AssetHandle& Handle : Order)
+					{
+						if (BenchmarkAsset* Asset = Cache.GetValidAsset(Handle))
+						{
+							ReaderSum += Asset->Value;
+						}
+					}
+				}
+				Sum += ReaderSum;
+			});
+	}
+
+	// Publishes the state every asset already has, the readers resolve the same assets with or without the writer
+	std::thread Writer;
+	if (HasWriter)
+	{
+		Writer = std::thread(
+			[&]
+			{
+				std::mt19937 Random(NumReaders);
+				while (!Done.load(std::memory_order_relaxed))
+				{
+					Cache.UpdateHandleState(Handles[Random() % Handles.size()]);
+					++NumWrites;
+				}
+			});
+	}
+
+	Start.arrive_and_wait();
+	auto Begin = std::chrono::steady_clock::now();
+	for (std::thread& Reader : Readers)
+	{
+		Reader.join();
+	}
+	auto End = std::chrono::steady_clock::now();
+
+	Done = true;
+	if (Writer.joinable())
+	{
+		Writer.join();
+	}
+	Checksum += Sum;
+
+	double Milliseconds = std::chrono::duration<double, std::milli>(End - Begin).count();
+	double NumLookups	= double(NumReaders) * Iterations * Handles.size();
+
+	BenchmarkResult Result		   = {};
+	Result.MillionLookupsPerSecond = NumLookups / Milliseconds / 1000.0;
+	Result.WritesPerMillisecond	   = double(NumWrites) / Milliseconds;
+	return Result;
+}
+
+int main(int argc, char** argv)
+{
+	int Iterations = ParseIterations(argc, argv, 200);
+
+	auto Cache = std::make_unique<BenchmarkCache>();
+
+	std::vector<AssetHandle> Handles;
+	for (uint32_t i = 0; i < 16384; ++i)
+	{
+		AssetHandle Handle = Cache->Create(i);
+		Handle.State	   = true;
+		Cache->UpdateHandleState(Handle);
+		Handles.push_back(Handle);
+	}
+	LockedCache Locked(*Cache);
+
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+	BenchmarkTable Table({
+		{ "Readers", 8 },
+		{ "Writer", 8 },
+		{ "locked Mlook/s", 16, 1 },
+		{ "atomic Mlook/s", 16, 1 },
+		{ "speedup", 12, 2, "x" },
+		{ "atomic writes/ms", 16, 1 },
+	});
+	for (int NumReaders : { 1, 2, 4, 8 })
+	{
+		for (bool HasWriter : { false, true })
+		{
+			BenchmarkResult LockedResult = Run(Locked, Handles, NumReaders, HasWriter, Iterations);
+			BenchmarkResult AtomicResult = Run(*Cache, Handles, NumReaders, HasWriter, Iterations);
+			Table.Row(
+				NumReaders,
+				HasWriter ? "yes" : "no",
+				LockedResult.MillionLookupsPerSecond,
+				AtomicResult.MillionLookupsPerSecond,
+				AtomicResult.MillionLookupsPerSecond / LockedResult.MillionLookupsPerSecond,
+				AtomicResult.WritesPerMillisecond);
+		}
+	}
+
+	KeepChecksum(Checksum);
+	return 0;
+}
@@ -0,0 +1,137 @@
+#include "MeshExportWriter.h"
+#include "Benchmark.h"
+
+// Loads in memory .khscene files of 10, 100 and 1000 meshes the way AsyncMeshImporter::ImportExisting does:
+// validates the header, the entry table and every section, then points the meshes into the file. Reading the
+// sections into vectors is timed next to it, that is what a load costs without the mapping.
+
+struct MappedMesh
+{
+	std::string					  Name;
+	std::span<const TestVertex>	  Vertices;
+	std::span<const uint32_t>	  Indices;
+	std::span<const TestMeshlet>  Meshlets;
+	std::span<const uint8_t>	  UniqueVertexIndices;
+	std::span<const TestTriangle> PrimitiveIndices;
+	std::vector<MeshLod>		  Lods;
+};
+
+template<typename T>
+static std::vector<T> Copy(std::span<const T> Section)
+{
+	return { Section.begin(), Section.end() };
+}
+
+struct BenchmarkResult
+{
+	std::size_t NumMeshes;
+	double		FileSizeInMiB;
+	double		MicrosecondsPerValidate;
+	double		MicrosecondsPerMap;
+	double		MicrosecondsPerRead;
+};
+
+static BenchmarkResult Run(std::size_t NumMeshes, int Iterations)
+{
+	// Mesh sizes vary like the meshes of a scene, from a few hundred to a few thousand triangles
+	std::vector<TestMesh> Meshes;
+	for (std::size_t i = 0; i < NumMeshes; ++i)
+	{
+		Meshes.push_back(MakeTestMesh("Mesh" + std::to_string(i), 8 + uint32_t(i * 7 % 40)));
+	}
+	const std::vector<BYTE> File = WriteTestExport(Meshes);
+
+	BenchmarkResult Result = {};
+	Result.NumMeshes	   = NumMeshes;
+	Result.FileSizeInMiB   = double(File.size()) / (1024 * 1024);
+
+	std::size_t Checksum = 0;
+
+	Result.MicrosecondsPerValidate = TimePerIteration<std::micro>(
+		Iterations,
+		[&]()
+		{
+			MeshExportReader Reader(File, TestFormat);
+			Checksum += Reader.GetEntries().size();
+		});
+
+	Result.MicrosecondsPerMap = TimePerIteration<std::micro>(
+		Iterations,
+		[&]()
+		{
+			MeshExportReader Reader(File, TestFormat);
+			if (!Reader.IsValid())
+			{
+				std::fprintf(stderr, "Generated file is not valid\n");
+				std::exit(1);
+			}
+
+			std::vector<MappedMesh> Mapped(Reader.GetEntries().size());
+			for (std::size_t i = 0; i < Mapped.size(); ++i)
+			{
+				const MeshExportEntry& Entry = Reader.GetEntries()[i];
+				MappedMesh*			   Mesh	 = &Mapped[i];
+
+				Mesh->Name				  = Reader.MapString(Entry.Name);
+				Mesh->Vertices			  = Reader.Map<TestVertex>(Entry.Vertices);
+				Mesh->Indices			  = Reader.Map<uint32_t>(Entry.Indices);
+				Mesh->Meshlets			  = Reader.Map<TestMeshlet>(Entry.Meshlets);
+				Mesh->UniqueVertexIndices = Reader.Map<uint8_t>(Entry.UniqueVertexIndices);
+				Mesh->PrimitiveIndices	  = Reader.Map<TestTriangle>(Entry.PrimitiveIndices);
+
+				std::span<const MeshLod> Lods = Reader.Map<MeshLod>(Entry.Lods);
+				Mesh->Lods.assign(Lods.begin(), Lods.end());
+			}
+			Checksum += Mapped.back().Indices.size();
+		});
+
+	Result.MicrosecondsPerRead = TimePerIteration<std::micro>(
+		Iterations,
+		[&]()
+		{
+			MeshExportReader Reader(File, TestFormat);
+
+			std::vector<TestMesh> Read(Reader.GetEntries().size());
+			for (std::size_t i = 0; i < Read.size(); ++i)
+			{
+				const MeshExportEntry& Entry = Reader.GetEntries()[i];
+				TestMesh*			   Mesh	 = &Read[i];
+
+				Mesh->Name				  = Reader.MapString(Entry.Name);
+				Mesh->Vertices			  = Copy(Reader.Map<TestVertex>(Entry.Vertices));
+				Mesh->Indices			  = Copy(Reader.Map<uint32_t>(Entry.Indices));
+				Mesh->Meshlets			  = Copy(Reader.Map<TestMeshlet>(Entry.Meshlets));
+				Mesh->UniqueVertexIndices = Copy(Reader.Map<uint8_t>(Entry.UniqueVertexIndices));
+				Mesh->PrimitiveIndices	  = Copy(Reader.Map<TestTriangle>(Entry.PrimitiveIndices));
+				Mesh->Lods				  = Copy(Reader.Map<MeshLod>(Entry.Lods));
+			}
+			Checksum += Read.back().Indices.size();
+		});
+
+	KeepChecksum(Checksum);
+	return Result;
+}
+
+int main(int argc, char** argv)
+{
+	int Iterations = ParseIterations(argc, argv, 1000);
+
+	BenchmarkTable Table({
+		{ "Meshes", 8 },
+		{ "MiB", 10 },
+		{ "us/validate", 14 },
+		{ "us/map", 14 },
+		{ "us/read", 14 },
+	});
+	for (std::size_t NumMeshes : { 10, 100, 1000 })
+	{
+		BenchmarkResult Result = Run(NumMeshes, NumMeshes >= 1000 ? std::max(Iterations / 10, 1) : Iterations);
+		Table.Row(
+			Result.NumMeshes,
+			Result.FileSizeInMiB,
+			Result.MicrosecondsPerValidate,
+			Result.MicrosecondsPerMap,
+			Result.MicrosecondsPerRead);
+	}
+	return 0;
+}
@@ -0,0 +1,240 @@
+#include "MeshExportWriter.h"
+
+static std::vector<TestMesh> MakeTestScene()
+{
+	std::vector<TestMesh> Meshes;
+	Meshes.push_back(MakeTestMesh("Floor", 8));
+	Meshes.push_back(MakeTestMesh("Wall", 3));
+	Meshes.push_back(MakeTestMesh("", 1));
+	return Meshes;
+}
+
+static MeshExportHeader& GetHeader(std::vector<BYTE>& File)
+{
+	return *reinterpret_cast<MeshExportHeader*>(File.data());
+}
+
+static MeshExportEntry& GetEntry(std::vector<BYTE>& File, size_t Index)
+{
+	return reinterpret_cast<MeshExportEntry*>(File.data() + sizeof(MeshExportHeader))[Index];
+}
+
+static bool IsValid(const std::vector<BYTE>& File)
+{
+	return MeshExportReader(File, TestFormat).IsValid();
+}
+
+TEST(MeshExport, LayoutPutsEntriesFirstAndAlignsSections)
+{
+	MeshExportLayout Layout(2);
+	EXPECT_EQ(Layout.GetSizeInBytes(), sizeof(MeshExportHeader) + 2 * sizeof(MeshExportEntry));
+
+	MeshExportSection Name = Layout.Allocate(5, 1);
+	EXPECT_EQ(Name.Offset, sizeof(MeshExportHeader) + 2 * sizeof(MeshExportEntry));
+
+	MeshExportSection Vertices = Layout.Allocate(100, MeshExportSectionAlignment);
+	EXPECT_EQ(Vertices.Offset, MeshExportSectionAlignment);
+	EXPECT_EQ(Layout.GetSizeInBytes(), MeshExportSectionAlignment + 100);
+
+	// Empty sections take no space and are not aligned
+	MeshExportSection Empty = Layout.Allocate(0, MeshExportSectionAlignment);
+	EXPECT_EQ(Empty.Offset, MeshExportSectionAlignment + 100);
+	EXPECT_EQ(Layout.GetSizeInBytes(), MeshExportSectionAlignment + 100);
+}
+
+TEST(MeshExport, RoundTrip)
+{
+	std::vector<TestMesh> Meshes = MakeTestScene();
+	std::vector<BYTE>	  File	 = WriteTestExport(Meshes);
+	MeshExportReader	  Reader(File, TestFormat);
+
+	ASSERT_TRUE(Reader.IsValid());
+	ASSERT_EQ(Reader.GetEntries().size(), Meshes.size());
+	for (size_t i = 0; i < Meshes.size(); ++i)
+	{
+		const MeshExportEntry& Entry = Reader.GetEntries()[i];
+		const TestMesh&		   Mesh	 = Meshes[i];
+		EXPECT_EQ(Reader.MapString(Entry.Name), Mesh.Name);
+
+		std::span<const TestVertex> Vertices = Reader.Map<TestVertex>(Entry.Vertices);
+		ASSERT_EQ(Vertices.size(), Mesh.Vertices.size());
+		EXPECT_EQ(std::memcmp(Vertices.data(), Mesh.Vertices.data(), Vertices.size_bytes()), 0);
+
+		EXPECT_TRUE(std::ranges::equal(Reader.Map<uint32_t>(Entry.Indices), Mesh.Indices));
+		EXPECT_TRUE(std::ranges::equal(Reader.Map<uint8_t>(Entry.UniqueVertexIndices), Mesh.UniqueVertexIndices));
+		EXPECT_TRUE(std::ranges::equal(Reader.Map<TestTriangle>(Entry.PrimitiveIndices), Mesh.PrimitiveIndices));
+		EXPECT_EQ(Reader.Map<TestMeshlet>(Entry.Meshlets).size(), Mesh.Meshlets.size());
+		EXPECT_EQ(Reader.Map<MeshLod>(Entry.Lods).size(), Mesh.Lods.size());
+
+		// Mapped in place, uploads read straight from the file
+		EXPECT_EQ(Entry.Vertices.Offset % MeshExportSectionAlignment, 0u);
+		EXPECT_EQ(reinterpret_cast<const BYTE*>(Vertices.data()), File.data() + Entry.Vertices.Offset);
+	}
+}
+
+TEST(MeshExport, EmptySceneIsValid)
+{
+	std::vector<BYTE> File = WriteTestExport({});
+	MeshExportReader  Reader(File, TestFormat);
+	EXPECT_TRUE(Reader.IsValid());
+	EXPECT_TRUE(Reader.GetEntries().empty());
+}
+
+TEST(MeshExport, HeaderMismatchesAreRejected)
+{
+	const std::vector<BYTE> Valid = WriteTestExport(MakeTestScene());
+	ASSERT_TRUE(IsValid(Valid));
+
+	std::vector<BYTE> File = Valid;
+	GetHeader(File).Magic++;
+	EXPECT_FALSE(IsValid(File));
+
+	File = Valid;
+	GetHeader(File).Version++;
+	EXPECT_FALSE(IsValid(File));
+
+	// Written with another vertex format
+	File						 = Valid;
+	GetHeader(File).VertexStride = 20;
+	EXPECT_FALSE(IsValid(File));
+
+	EXPECT_FALSE(MeshExportReader(Valid, MeshExportFormat::Of<uint64_t, TestMeshlet, TestTriangle>()).IsValid());
+}
+
+TEST(MeshExport, TruncatedFilesAreRejected)
+{
+	const std::vector<BYTE> Valid = WriteTestExport(MakeTestScene());
+
+	EXPECT_FALSE(IsValid({}));
+	EXPECT_FALSE(IsValid(std::vector<BYTE>(Valid.begin(), Valid.begin() + sizeof(MeshExportHeader) - 1)));
+
+	// FileSize no longer matches
+	std::vector<BYTE> File(Valid.begin(), Valid.end() - 1);
+	EXPECT_FALSE(IsValid(File));
+
+	// Matches, but the last section runs past the end
+	GetHeader(File).FileSize = File.size();
+	EXPECT_FALSE(IsValid(File));
+}
+
+TEST(MeshExport, MeshCountThatOverflowsIsRejected)
+{
+	const std::vector<BYTE> Valid = WriteTestExport(MakeTestScene());
+
+	// NumMeshes * sizeof(MeshExportEntry) wraps around to a size that fits the file
+	std::vector<BYTE> File	  = Valid;
+	GetHeader(File).NumMeshes = (UINT64_MAX / sizeof(MeshExportEntry)) + 2;
+	ASSERT_LT(GetHeader(File).NumMeshes * sizeof(MeshExportEntry), File.size());
+	EXPECT_FALSE(IsValid(File));
+
+	// More entries than the file has room for
+	File					  = Valid;
+	GetHeader(File).NumMeshes = File.size() / sizeof(MeshExportEntry);
+	EXPECT_FALSE(IsValid(File));
+
+	File					  = Valid;
+	GetHeader(File).NumMeshes = UINT64_MAX;
+	EXPECT_FALSE(IsValid(File));
+}
+
+TEST(MeshExport, SectionsOutOfBoundsAreRejected)
+{
+	const std::vector<BYTE> Valid = WriteTestExport(MakeTestScene());
+
+	MeshExportSection MeshExportEntry::*Sections[] = {
+		&MeshExportEntry::Name,		&MeshExportEntry::Vertices,			   &MeshExportEntry::Indices,
+		&MeshExportEntry::Meshlets, &MeshExportEntry::UniqueVertexIndices, &MeshExportEntry::PrimitiveIndices,
+		&MeshExportEntry::Lods,
+	};
+	for (auto Section : Sections)
+	{
+		std::vector<BYTE> File				= Valid;
+		(GetEntry(File, 1).*Section).Offset	= File.size() + 1;
+		EXPECT_FALSE(IsValid(File));
+
+		// Offset + SizeInBytes wraps around
+		File									 = Valid;
+		(GetEntry(File, 1).*Section).Offset		 = 64;
+		(GetEntry(File, 1).*Section).SizeInBytes = UINT64_MAX - 63;
+		EXPECT_FALSE(IsValid(File));
+
+		File									 = Valid;
+		(GetEntry(File, 1).*Section).SizeInBytes = File.size();
+		EXPECT_FALSE(IsValid(File));
+	}
+}
+
+TEST(MeshExport, PartialElementsAreRejected)
+{
+	const std::vector<BYTE> Valid = WriteTestExport(MakeTestScene());
+
+	std::vector<BYTE> File = Valid;
+	GetEntry(File, 0).Vertices.SizeInBytes -= 4;
+	EXPECT_FALSE(IsValid(File));
+
+	File = Valid;
+	GetEntry(File, 0).Indices.SizeInBytes -= 2;
+	EXPECT_FALSE(IsValid(File));
+
+	File = Valid;
+	GetEntry(File, 0).Lods.SizeInBytes -= 1;
+	EXPECT_FALSE(IsValid(File));
+
+	// Any length is a whole string
+	File = Valid;
+	GetEntry(File, 0).Name.SizeInBytes -= 1;
+	EXPECT_TRUE(IsValid(File));
+}
+
+TEST(MeshExport, MisalignedSectionsAreRejected)
+{
+	const std::vector<BYTE> Valid = WriteTestExport(MakeTestScene());
+
+	std::vector<BYTE> File = Valid;
+	GetEntry(File, 0).Vertices.Offset += 2;
+	GetEntry(File, 0).Vertices.SizeInBytes -= sizeof(TestVertex);
+	EXPECT_FALSE(IsValid(File));
+
+	// Page alignment is how Export lays out the file, the reader only needs element alignment
+	File = Valid;
+	GetEntry(File, 0).Vertices.Offset += 4;
+	GetEntry(File, 0).Vertices.SizeInBytes -= sizeof(TestVertex);
+	EXPECT_TRUE(IsValid(File));
+}
+
+TEST(MeshExport, LodsOutsideTheirMeshAreRejected)
+{
+	std::vector<TestMesh> Meshes = MakeTestScene();
+	ASSERT_TRUE(IsValid(WriteTestExport(Meshes)));
+
+	auto WithLod = [&](MeshLod Lod)
+	{
+		std::vector<TestMesh> Copy = Meshes;
+		Copy[0].Lods.push_back(Lod);
+		return WriteTestExport(Copy);
+	};
+
+	uint32_t NumIndices	 = uint32_t(Meshes[0].Indices.size());
+	uint32_t NumMeshlets = uint32_t(Meshes[0].Meshlets.size());
+	EXPECT_TRUE(IsValid(WithLod({ 0, NumIndices, 0, NumMeshlets, 0.0f })));
+	EXPECT_FALSE(IsValid(WithLod({ 3, NumIndices, 0, NumMeshlets, 0.0f })));
+	EXPECT_FALSE(IsValid(WithLod({ 0, NumIndices, 1, NumMeshlets, 0.0f })));
+
+	// Offset + Count would wrap around in 32 bits
+	EXPECT_FALSE(IsValid(WithLod({ UINT32_MAX, 2, 0, NumMeshlets, 0.0f })));
+	EXPECT_FALSE(IsValid(WithLod({ 0, NumIndices, UINT32_MAX, 2, 0.0f })));
+
+	std::vector<TestMesh> TooManyLods = Meshes;
+	TooManyLods[0].Lods.resize(MaxMeshLods + 1, Meshes[0].Lods[0]);
+	EXPECT_FALSE(IsValid(WriteTestExport(TooManyLods)));
+}
+
+TEST(MeshExport, InvalidFileHasNoEntries)
+{
+	std::vector<BYTE> File = WriteTestExport(MakeTestScene());
+	GetEntry(File, 2).Vertices.Offset = UINT64_MAX;
+
+	MeshExportReader Reader(File, TestFormat);
+	EXPECT_FALSE(Reader.IsValid());
+	EXPECT_TRUE(Reader.GetEntries().empty());
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "Core/Asset/MeshExport.h"
+
+// Stand-ins for MeshVertex and the DirectXMesh meshlet types, same sizes as the engine's
+struct TestVertex
+{
+	float Position[3];
+	float TextureCoord[2];
+	float Normal[3];
+};
+
+struct TestMeshlet
+{
+	uint32_t VertCount;
+	uint32_t VertOffset;
+	uint32_t PrimCount;
+	uint32_t PrimOffset;
+};
+
+using TestTriangle = uint32_t;
+
+inline constexpr MeshExportFormat TestFormat = MeshExportFormat::Of<TestVertex, TestMeshlet, TestTriangle>();
+
+struct TestMesh
+{
+	std::string				  Name;
+	std::vector<TestVertex>	  Vertices;
+	std::vector<uint32_t>	  Indices;
+	std::vector<TestMeshlet>  Meshlets;
+	std::vector<uint8_t>	  UniqueVertexIndices;
+	std::vector<TestTriangle> PrimitiveIndices;
+	std::vector<MeshLod>	  Lods;
+};
+
+// Grid of NumQuads x NumQuads quads with a meshlet per row and two LODs, the second skips every other row
+inline TestMesh MakeTestMesh(std::string Name, uint32_t NumQuads)
+{
+	TestMesh Mesh;
+	Mesh.Name = std::move(Name);
+	for (uint32_t y = 0; y <= NumQuads; ++y)
+	{
+		for (uint32_t x = 0; x <= NumQuads; ++x)
+		{
+			Mesh.Vertices.push_back({ { float(x), float(y), 0.0f }, { float(x) / NumQuads, float(y) / NumQuads }, { 0.0f, 0.0f, 1.0f } });
+		}
+	}
+	for (uint32_t y = 0; y < NumQuads; ++y)
+	{
+		for (uint32_t x = 0; x < NumQuads; ++x)
+		{
+			uint32_t i = y * (NumQuads + 1) + x;
+			Mesh.Indices.insert(Mesh.Indices.end(), { i, i + 1, i + NumQuads + 1, i + 1, i + NumQuads + 2, i + NumQuads + 1 });
+		}
+		Mesh.Meshlets.push_back({ 2 * (NumQuads + 1), y * 2 * (NumQuads + 1), 2 * NumQuads, y * 2 * NumQuads });
+	}
+	Mesh.UniqueVertexIndices.resize(Mesh.Meshlets.size() * 2 * (NumQuads + 1) * sizeof(uint32_t));
+	Mesh.PrimitiveIndices.resize(Mesh.Meshlets.size() * 2 * NumQuads);
+
+	uint32_t NumIndices	 = uint32_t(Mesh.Indices.size());
+	uint32_t NumMeshlets = uint32_t(Mesh.Meshlets.size());
+	Mesh.Lods.push_back({ 0, NumIndices, 0, NumMeshlets, 0.0f });
+	Mesh.Lods.push_back({ 0, NumIndices / 2, 0, NumMeshlets / 2, 0.01f });
+	return Mesh;
+}
+
+// Writes Meshes the way AsyncMeshImporter::Export does, into memory instead of a file
+inline std::vector<BYTE> WriteTestExport(std::span<const TestMesh> Meshes)
+{
+	std::vector<MeshExportEntry> Entries(Meshes.size());
+	MeshExportLayout			 Layout(Entries.size());
+	for (size_t i = 0; i < Meshes.size(); ++i)
+	{
+		Entries[i].Name = Layout.Allocate(Meshes[i].Name.size() * sizeof(char), 1);
+	}
+	for (size_t i = 0; i < Meshes.size(); ++i)
+	{
+		const TestMesh* Mesh		   = &Meshes[i];
+		Entries[i].Vertices			   = Layout.Allocate(Mesh->Vertices.size() * sizeof(TestVertex), MeshExportSectionAlignment);
+		Entries[i].Indices			   = Layout.Allocate(Mesh->Indices.size() * sizeof(uint32_t), MeshExportSectionAlignment);
+		Entries[i].Meshlets			   = Layout.Allocate(Mesh->Meshlets.size() * sizeof(TestMeshlet), MeshExportSectionAlignment);
+		Entries[i].UniqueVertexIndices = Layout.Allocate(Mesh->UniqueVertexIndices.size() * sizeof(uint8_t), MeshExportSectionAlignment);
+		Entries[i].PrimitiveIndices	   = Layout.Allocate(Mesh->PrimitiveIndices.size() * sizeof(TestTriangle), MeshExportSectionAlignment);
+		Entries[i].Lods				   = Layout.Allocate(Mesh->Lods.size() * sizeof(MeshLod), alignof(MeshLod));
+	}
+
+	std::vector<BYTE> File(Layout.GetSizeInBytes());
+
+	MeshExportHeader Header = {};
+	Header.Magic			= MeshExportMagic;
+	Header.Version			= MeshExportVersion;
+	Header.NumMeshes		= Meshes.size();
+	Header.FileSize			= File.size();
+	Header.VertexStride		= sizeof(TestVertex);
+	std::memcpy(File.data(), &Header, sizeof(Header));
+	std::memcpy(File.data() + sizeof(Header), Entries.data(), Entries.size() * sizeof(MeshExportEntry));
+
+	auto WriteSection = [&](const MeshExportSection& Section, const void* Data)
+	{
+		if (Section.SizeInBytes > 0)
+		{
+			std::memcpy(File.data() + Section.Offset, Data, Section.SizeInBytes);
+		}
+	};
+	for (size_t i = 0; i < Meshes.size(); ++i)
+	{
+		const TestMesh* Mesh = &Meshes[i];
+		WriteSection(Entries[i].Name, Mesh->Name.data());
+		WriteSection(Entries[i].Vertices, Mesh->Vertices.data());
+		WriteSection(Entries[i].Indices, Mesh->Indices.data());
+		WriteSection(Entries[i].Meshlets, Mesh->Meshlets.data());
+		WriteSection(Entries[i].UniqueVertexIndices, Mesh->UniqueVertexIndices.data());
+		WriteSection(Entries[i].PrimitiveIndices, Mesh->PrimitiveIndices.data());
+		WriteSection(Entries[i].Lods, Mesh->Lods.data());
+	}
+	return File;
+}
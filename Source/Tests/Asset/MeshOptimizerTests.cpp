@@ -0,0 +1,287 @@
+#include "Core/Asset/MeshOptimizer.h"
+
+using namespace DirectX;
+
+struct TestGeometry
+{
+	std::vector<Vertex>	  Vertices;
+	std::vector<uint32_t> Indices;
+};
+
+static Vertex MakeVertex(float x, float y, float z)
+{
+	Vertex Vertex		= {};
+	Vertex.Position		= { x, y, z };
+	Vertex.TextureCoord = { x, y };
+	Vertex.Normal		= { 0.0f, 0.0f, 1.0f };
+	return Vertex;
+}
+
+// Size x Size quads in row order, the order most exporters write grids and terrain in
+static TestGeometry MakeGrid(uint32_t Size)
+{
+	TestGeometry Geometry;
+	for (uint32_t y = 0; y <= Size; ++y)
+	{
+		for (uint32_t x = 0; x <= Size; ++x)
+		{
+			Geometry.Vertices.push_back(MakeVertex(float(x), float(y), 0.0f));
+		}
+	}
+	for (uint32_t y = 0; y < Size; ++y)
+	{
+		for (uint32_t x = 0; x < Size; ++x)
+		{
+			uint32_t i = y * (Size + 1) + x;
+			Geometry.Indices.insert(Geometry.Indices.end(), { i, i + 1, i + Size + 1, i + 1, i + Size + 2, i + Size + 1 });
+		}
+	}
+	return Geometry;
+}
+
+// Triangles in random order, the order of a mesh whose faces were split and merged by an importer
+static TestGeometry Shuffle(TestGeometry Geometry, uint32_t Seed)
+{
+	std::vector<std::array<uint32_t, 3>> Faces(Geometry.Indices.size() / 3);
+	std::memcpy(Faces.data(), Geometry.Indices.data(), Geometry.Indices.size() * sizeof(uint32_t));
+	std::ranges::shuffle(Faces, std::mt19937(Seed));
+	std::memcpy(Geometry.Indices.data(), Faces.data(), Geometry.Indices.size() * sizeof(uint32_t));
+	return Geometry;
+}
+
+// Vertex shader invocations per triangle of a FIFO cache, computed independently of the optimizer
+static float ComputeAcmr(std::span<const uint32_t> Indices)
+{
+	std::deque<uint32_t> Cache;
+
+	size_t Misses = 0;
+	for (uint32_t Index : Indices)
+	{
+		if (std::ranges::find(Cache, Index) == Cache.end())
+		{
+			++Misses;
+			Cache.push_back(Index);
+			if (Cache.size() > MeshOptimizer::VertexCacheSize)
+			{
+				Cache.pop_front();
+			}
+		}
+	}
+	return float(Misses) / float(Indices.size() / 3);
+}
+
+// Every triangle by the positions of its corners, rotated to start at the smallest so the winding is kept
+static std::vector<std::array<float, 9>> GetTriangles(const TestGeometry& Geometry)
+{
+	std::vector<std::array<float, 9>> Triangles;
+	for (size_t i = 0; i < Geometry.Indices.size(); i += 3)
+	{
+		std::array<std::array<float, 3>, 3> Corners;
+		for (size_t Corner = 0; Corner < 3; ++Corner)
+		{
+			const XMFLOAT3& Position = Geometry.Vertices[Geometry.Indices[i + Corner]].Position;
+			Corners[Corner]			 = { Position.x, Position.y, Position.z };
+		}
+		std::ranges::rotate(Corners, std::ranges::min_element(Corners));
+
+		std::array<float, 9> Triangle;
+		std::memcpy(Triangle.data(), Corners.data(), sizeof(Triangle));
+		Triangles.push_back(Triangle);
+	}
+	std::ranges::sort(Triangles);
+	return Triangles;
+}
+
+TEST(MeshOptimizer, ShuffledTrianglesGetCacheFriendlyOrder)
+{
+	TestGeometry Geometry  = Shuffle(MakeGrid(64), 1);
+	TestGeometry Optimized = Geometry;
+
+	MeshOptimizationStats Stats;
+	ASSERT_TRUE(MeshOptimizer::Optimize(Optimized.Vertices, Optimized.Indices, &Stats));
+
+	// Random order loads nearly every corner, a good order around 0.6 to 0.7 vertices per triangle on a grid
+	EXPECT_FLOAT_EQ(Stats.AcmrBefore, ComputeAcmr(Geometry.Indices));
+	EXPECT_FLOAT_EQ(Stats.AcmrAfter, ComputeAcmr(Optimized.Indices));
+	EXPECT_GT(Stats.AcmrBefore, 2.0f);
+	EXPECT_LT(Stats.AcmrAfter, 0.8f);
+	EXPECT_LT(Stats.AtvrAfter, Stats.AtvrBefore);
+	EXPECT_EQ(GetTriangles(Optimized), GetTriangles(Geometry));
+}
+
+TEST(MeshOptimizer, CacheEfficiencyNeverRegresses)
+{
+	std::vector<TestGeometry> Meshes = { MakeGrid(1), MakeGrid(8), MakeGrid(100), Shuffle(MakeGrid(20), 2) };
+
+	// A single row of quads in order is already as good as it gets
+	TestGeometry Strip = MakeGrid(1);
+	for (uint32_t x = 1; x < 64; ++x)
+	{
+		uint32_t i = static_cast<uint32_t>(Strip.Vertices.size());
+		Strip.Vertices.push_back(MakeVertex(float(x + 1), 0.0f, 0.0f));
+		Strip.Vertices.push_back(MakeVertex(float(x + 1), 1.0f, 0.0f));
+		Strip.Indices.insert(Strip.Indices.end(), { i - 2, i, i - 1, i, i + 1, i - 1 });
+	}
+	Meshes.push_back(Strip);
+
+	for (TestGeometry& Geometry : Meshes)
+	{
+		TestGeometry Optimized = Geometry;
+
+		MeshOptimizationStats Stats;
+		ASSERT_TRUE(MeshOptimizer::Optimize(Optimized.Vertices, Optimized.Indices, &Stats));
+		EXPECT_LE(ComputeAcmr(Optimized.Indices), ComputeAcmr(Geometry.Indices));
+		EXPECT_LE(Stats.AcmrAfter, Stats.AcmrBefore);
+		EXPECT_LE(Stats.AtvrAfter, Stats.AtvrBefore);
+		EXPECT_EQ(GetTriangles(Optimized), GetTriangles(Geometry));
+	}
+}
+
+TEST(MeshOptimizer, UnusedVerticesAreRemovedAndIndicesRemapped)
+{
+	TestGeometry Geometry = Shuffle(MakeGrid(16), 3);
+
+	// Every third vertex gets an unused neighbour in front of it, the indices are moved to match
+	TestGeometry		  Padded;
+	std::vector<uint32_t> Remap;
+	for (size_t i = 0; i < Geometry.Vertices.size(); ++i)
+	{
+		if (i % 3 == 0)
+		{
+			Padded.Vertices.push_back(MakeVertex(float(i), -1.0f, 100.0f));
+		}
+		Remap.push_back(static_cast<uint32_t>(Padded.Vertices.size()));
+		Padded.Vertices.push_back(Geometry.Vertices[i]);
+	}
+	for (uint32_t Index : Geometry.Indices)
+	{
+		Padded.Indices.push_back(Remap[Index]);
+	}
+	Padded.Vertices.push_back(MakeVertex(0.0f, 0.0f, -100.0f));
+
+	TestGeometry		  Optimized = Padded;
+	MeshOptimizationStats Stats;
+	ASSERT_TRUE(MeshOptimizer::Optimize(Optimized.Vertices, Optimized.Indices, &Stats));
+
+	EXPECT_EQ(Stats.NumRemovedVertices, Padded.Vertices.size() - Geometry.Vertices.size());
+	EXPECT_EQ(Optimized.Vertices.size(), Geometry.Vertices.size());
+	EXPECT_EQ(Stats.NumRemovedTriangles, 0u);
+	for (const Vertex& Vertex : Optimized.Vertices)
+	{
+		EXPECT_LT(std::abs(Vertex.Position.z), 1.0f);
+	}
+
+	// Vertices are in order of first use, the index buffer walks them front to back
+	uint32_t NextVertex = 0;
+	for (uint32_t Index : Optimized.Indices)
+	{
+		ASSERT_LE(Index, NextVertex);
+		if (Index == NextVertex)
+		{
+			++NextVertex;
+		}
+	}
+	EXPECT_EQ(NextVertex, Optimized.Vertices.size());
+	EXPECT_EQ(GetTriangles(Optimized), GetTriangles(Geometry));
+}
+
+TEST(MeshOptimizer, DegenerateTrianglesAreDropped)
+{
+	TestGeometry Geometry = MakeGrid(16);
+	TestGeometry Degenerate;
+	Degenerate.Vertices = Geometry.Vertices;
+
+	// Collapsed corners in every position of the triangle, one triangle uses a vertex nothing else uses
+	size_t NumDegenerate = 0;
+	for (size_t i = 0; i < Geometry.Indices.size(); i += 3)
+	{
+		Degenerate.Indices.insert(Degenerate.Indices.end(), &Geometry.Indices[i], &Geometry.Indices[i] + 3);
+
+		uint32_t a = Geometry.Indices[i], b = Geometry.Indices[i + 1];
+		switch (i / 3 % 4)
+		{
+		case 0:
+			Degenerate.Indices.insert(Degenerate.Indices.end(), { a, a, b });
+			break;
+		case 1:
+			Degenerate.Indices.insert(Degenerate.Indices.end(), { a, b, b });
+			break;
+		case 2:
+			Degenerate.Indices.insert(Degenerate.Indices.end(), { b, a, b });
+			break;
+		default:
+			continue;
+		}
+		++NumDegenerate;
+	}
+	uint32_t Isolated = static_cast<uint32_t>(Degenerate.Vertices.size());
+	Degenerate.Vertices.push_back(MakeVertex(0.0f, 0.0f, 100.0f));
+	Degenerate.Indices.insert(Degenerate.Indices.end(), { Isolated, Isolated, Isolated });
+	++NumDegenerate;
+
+	TestGeometry		  Optimized = Degenerate;
+	MeshOptimizationStats Stats;
+	ASSERT_TRUE(MeshOptimizer::Optimize(Optimized.Vertices, Optimized.Indices, &Stats));
+
+	EXPECT_EQ(Stats.NumRemovedTriangles, NumDegenerate);
+	EXPECT_EQ(Stats.NumRemovedVertices, 1u);
+	EXPECT_EQ(Optimized.Indices.size(), Geometry.Indices.size());
+	for (size_t i = 0; i < Optimized.Indices.size(); i += 3)
+	{
+		uint32_t a = Optimized.Indices[i], b = Optimized.Indices[i + 1], c = Optimized.Indices[i + 2];
+		EXPECT_TRUE(a != b && b != c && a != c);
+	}
+	EXPECT_EQ(GetTriangles(Optimized), GetTriangles(Geometry));
+
+	// Only the triangle reordering, for the index buffers of LODs
+	std::vector<uint32_t> LodIndices = Degenerate.Indices;
+	ASSERT_TRUE(MeshOptimizer::OptimizeFaces(LodIndices));
+	EXPECT_EQ(LodIndices.size(), Geometry.Indices.size());
+	EXPECT_EQ(GetTriangles({ Degenerate.Vertices, LodIndices }), GetTriangles(Geometry));
+}
+
+TEST(MeshOptimizer, OutputIsDeterministic)
+{
+	TestGeometry Geometry = Shuffle(MakeGrid(48), 4);
+
+	TestGeometry First	= Geometry;
+	TestGeometry Second = Geometry;
+	ASSERT_TRUE(MeshOptimizer::Optimize(First.Vertices, First.Indices));
+	ASSERT_TRUE(MeshOptimizer::Optimize(Second.Vertices, Second.Indices));
+
+	ASSERT_EQ(First.Vertices.size(), Second.Vertices.size());
+	ASSERT_EQ(First.Indices, Second.Indices);
+	EXPECT_EQ(std::memcmp(First.Vertices.data(), Second.Vertices.data(), First.Vertices.size() * sizeof(Vertex)), 0);
+
+	std::vector<uint32_t> FirstFaces  = Geometry.Indices;
+	std::vector<uint32_t> SecondFaces = Geometry.Indices;
+	ASSERT_TRUE(MeshOptimizer::OptimizeFaces(FirstFaces));
+	ASSERT_TRUE(MeshOptimizer::OptimizeFaces(SecondFaces));
+	EXPECT_EQ(FirstFaces, SecondFaces);
+}
+
+TEST(MeshOptimizer, InvalidInputIsLeftUntouched)
+{
+	TestGeometry Geometry = MakeGrid(2);
+
+	// An index past the vertices
+	TestGeometry OutOfRange = Geometry;
+	OutOfRange.Indices[4]	= static_cast<uint32_t>(OutOfRange.Vertices.size());
+	TestGeometry Copy		= OutOfRange;
+	EXPECT_FALSE(MeshOptimizer::Optimize(Copy.Vertices, Copy.Indices));
+	EXPECT_EQ(Copy.Indices, OutOfRange.Indices);
+	EXPECT_EQ(Copy.Vertices.size(), OutOfRange.Vertices.size());
+
+	// Nothing but degenerate triangles
+	TestGeometry Collapsed = Geometry;
+	Collapsed.Indices	   = { 0, 0, 1, 2, 2, 2 };
+	Copy				   = Collapsed;
+	EXPECT_FALSE(MeshOptimizer::Optimize(Copy.Vertices, Copy.Indices));
+	EXPECT_EQ(Copy.Indices, Collapsed.Indices);
+
+	std::vector<Vertex>	  NoVertices;
+	std::vector<uint32_t> NoIndices;
+	EXPECT_FALSE(MeshOptimizer::Optimize(Geometry.Vertices, NoIndices));
+	EXPECT_FALSE(MeshOptimizer::Optimize(NoVertices, Geometry.Indices));
+	EXPECT_FALSE(MeshOptimizer::OptimizeFaces(NoIndices));
+}
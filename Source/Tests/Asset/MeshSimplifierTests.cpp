@@ -0,0 +1,390 @@
+#include "Core/Asset/MeshSimplifier.h"
+
+using namespace DirectX;
+
+struct TestGeometry
+{
+	std::vector<Vertex>	  Vertices;
+	std::vector<uint32_t> Indices;
+};
+
+static Vertex MakeVertex(float x, float y, float z)
+{
+	Vertex Vertex		= {};
+	Vertex.Position		= { x, y, z };
+	Vertex.TextureCoord = { 0.0f, 0.0f };
+	Vertex.Normal		= { 0.0f, 0.0f, 1.0f };
+	return Vertex;
+}
+
+// Closed unit sphere without seams, every vertex can collapse
+static TestGeometry MakeIcosphere(int NumSubdivisions)
+{
+	const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+
+	std::vector<XMFLOAT3> Positions = {
+		{ -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 }, { 0, -1, t }, { 0, 1, t },
+		{ 0, -1, -t }, { 0, 1, -t }, { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 },
+	};
+	std::vector<uint32_t> Indices = {
+		0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+		3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1,
+	};
+
+	for (int Subdivision = 0; Subdivision < NumSubdivisions; ++Subdivision)
+	{
+		std::map<std::pair<uint32_t, uint32_t>, uint32_t> Midpoints;
+
+		auto Midpoint = [&](uint32_t a, uint32_t b)
+		{
+			auto [Iter, Inserted] = Midpoints.try_emplace({ std::min(a, b), std::max(a, b) }, uint32_t(Positions.size()));
+			if (Inserted)
+			{
+				XMFLOAT3 Position = { (Positions[a].x + Positions[b].x) / 2, (Positions[a].y + Positions[b].y) / 2, (Positions[a].z + Positions[b].z) / 2 };
+				Positions.push_back(Position);
+			}
+			return Iter->second;
+		};
+
+		std::vector<uint32_t> Subdivided;
+		for (size_t i = 0; i < Indices.size(); i += 3)
+		{
+			uint32_t a	= Indices[i], b = Indices[i + 1], c = Indices[i + 2];
+			uint32_t ab = Midpoint(a, b), bc = Midpoint(b, c), ca = Midpoint(c, a);
+			Subdivided.insert(Subdivided.end(), { a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca });
+		}
+		Indices = std::move(Subdivided);
+	}
+
+	TestGeometry Geometry;
+	for (XMFLOAT3 Position : Positions)
+	{
+		XMStoreFloat3(&Position, XMVector3Normalize(XMLoadFloat3(&Position)));
+		Geometry.Vertices.push_back(MakeVertex(Position.x, Position.y, Position.z));
+	}
+	Geometry.Indices = std::move(Indices);
+	return Geometry;
+}
+
+// Flat grid of Size x Size quads in the z = 0 plane, its border is open and stays locked
+static TestGeometry MakeGrid(uint32_t Size)
+{
+	TestGeometry Geometry;
+	for (uint32_t y = 0; y <= Size; ++y)
+	{
+		for (uint32_t x = 0; x <= Size; ++x)
+		{
+			Geometry.Vertices.push_back(MakeVertex(float(x), float(y), 0.0f));
+		}
+	}
+	for (uint32_t y = 0; y < Size; ++y)
+	{
+		for (uint32_t x = 0; x < Size; ++x)
+		{
+			uint32_t i = y * (Size + 1) + x;
+			Geometry.Indices.insert(Geometry.Indices.end(), { i, i + 1, i + Size + 1, i + 1, i + Size + 2, i + Size + 1 });
+		}
+	}
+	return Geometry;
+}
+
+static XMFLOAT3 TriangleNormal(const TestGeometry& Geometry, std::span<const uint32_t> Triangle)
+{
+	XMVECTOR p0 = XMLoadFloat3(&Geometry.Vertices[Triangle[0]].Position);
+	XMVECTOR p1 = XMLoadFloat3(&Geometry.Vertices[Triangle[1]].Position);
+	XMVECTOR p2 = XMLoadFloat3(&Geometry.Vertices[Triangle[2]].Position);
+
+	XMFLOAT3 Normal;
+	XMStoreFloat3(&Normal, XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0)));
+	return Normal;
+}
+
+static double TotalArea(const TestGeometry& Geometry, std::span<const uint32_t> Indices)
+{
+	double Area = 0.0;
+	for (size_t i = 0; i + 3 <= Indices.size(); i += 3)
+	{
+		XMFLOAT3 Normal = TriangleNormal(Geometry, Indices.subspan(i, 3));
+		Area += 0.5 * std::sqrt(double(Normal.x) * Normal.x + double(Normal.y) * Normal.y + double(Normal.z) * Normal.z);
+	}
+	return Area;
+}
+
+// Closest point on triangle abc to p, Real-Time Collision Detection 5.1.5
+static XMVECTOR ClosestPointOnTriangle(XMVECTOR p, XMVECTOR a, XMVECTOR b, XMVECTOR c)
+{
+	auto Dot = [](XMVECTOR u, XMVECTOR v)
+	{
+		return XMVectorGetX(XMVector3Dot(u, v));
+	};
+
+	XMVECTOR ab = XMVectorSubtract(b, a), ac = XMVectorSubtract(c, a), ap = XMVectorSubtract(p, a);
+	float	 d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f)
+	{
+		return a;
+	}
+
+	XMVECTOR bp = XMVectorSubtract(p, b);
+	float	 d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3)
+	{
+		return b;
+	}
+
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	{
+		return XMVectorAdd(a, XMVectorScale(ab, d1 / (d1 - d3)));
+	}
+
+	XMVECTOR cp = XMVectorSubtract(p, c);
+	float	 d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6)
+	{
+		return c;
+	}
+
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	{
+		return XMVectorAdd(a, XMVectorScale(ac, d2 / (d2 - d6)));
+	}
+
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f)
+	{
+		return XMVectorAdd(b, XMVectorScale(XMVectorSubtract(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+	}
+
+	float Denominator = 1.0f / (va + vb + vc);
+	return XMVectorAdd(a, XMVectorAdd(XMVectorScale(ab, vb * Denominator), XMVectorScale(ac, vc * Denominator)));
+}
+
+// Distance from the farthest vertex of the source mesh to the simplified surface, relative to the diagonal of the
+// bounds like the errors of the simplifier
+static float MaxDeviation(const TestGeometry& Geometry, std::span<const uint32_t> Simplified)
+{
+	BoundingBox Bounds;
+	BoundingBox::CreateFromPoints(Bounds, Geometry.Vertices.size(), &Geometry.Vertices[0].Position, sizeof(Vertex));
+	const float Diagonal = 2.0f * XMVectorGetX(XMVector3Length(XMLoadFloat3(&Bounds.Extents)));
+
+	float MaxDistance = 0.0f;
+	for (const Vertex& Vertex : Geometry.Vertices)
+	{
+		XMVECTOR p		 = XMLoadFloat3(&Vertex.Position);
+		float	 Nearest = std::numeric_limits<float>::max();
+		for (size_t i = 0; i < Simplified.size(); i += 3)
+		{
+			XMVECTOR Closest = ClosestPointOnTriangle(
+				p,
+				XMLoadFloat3(&Geometry.Vertices[Simplified[i]].Position),
+				XMLoadFloat3(&Geometry.Vertices[Simplified[i + 1]].Position),
+				XMLoadFloat3(&Geometry.Vertices[Simplified[i + 2]].Position));
+			Nearest = std::min(Nearest, XMVectorGetX(XMVector3Length(XMVectorSubtract(p, Closest))));
+		}
+		MaxDistance = std::max(MaxDistance, Nearest);
+	}
+	return MaxDistance / Diagonal;
+}
+
+static void ExpectValidTriangles(const TestGeometry& Geometry, std::span<const uint32_t> Indices)
+{
+	ASSERT_EQ(Indices.size() % 3, 0u);
+	for (size_t i = 0; i < Indices.size(); i += 3)
+	{
+		for (size_t Corner = 0; Corner < 3; ++Corner)
+		{
+			ASSERT_LT(Indices[i + Corner], Geometry.Vertices.size());
+		}
+		EXPECT_NE(Indices[i], Indices[i + 1]);
+		EXPECT_NE(Indices[i + 1], Indices[i + 2]);
+		EXPECT_NE(Indices[i], Indices[i + 2]);
+	}
+}
+
+TEST(MeshSimplifier, ReachesTheTargetIndexCount)
+{
+	TestGeometry Sphere = MakeIcosphere(3);
+	ASSERT_EQ(Sphere.Indices.size(), 1280u * 3);
+
+	for (size_t Target : { 3000, 1920, 960, 480, 120 })
+	{
+		float				  Error		 = -1.0f;
+		std::vector<uint32_t> Simplified = MeshSimplifier::Simplify(Sphere.Vertices, Sphere.Indices, Target, 1.0f, &Error);
+
+		// A collapse removes the two triangles around an edge, so the count lands just below the target
+		EXPECT_LE(Simplified.size(), Target);
+		EXPECT_GT(Simplified.size() + 6, Target);
+		EXPECT_GE(Error, 0.0f);
+		ExpectValidTriangles(Sphere, Simplified);
+	}
+}
+
+TEST(MeshSimplifier, TargetAboveTheInputKeepsEverything)
+{
+	TestGeometry Sphere = MakeIcosphere(2);
+
+	float				  Error		 = -1.0f;
+	std::vector<uint32_t> Simplified = MeshSimplifier::Simplify(Sphere.Vertices, Sphere.Indices, Sphere.Indices.size(), 1.0f, &Error);
+	EXPECT_EQ(Simplified, Sphere.Indices);
+	EXPECT_EQ(Error, 0.0f);
+}
+
+TEST(MeshSimplifier, ErrorBoundStopsSimplification)
+{
+	TestGeometry Sphere = MakeIcosphere(3);
+
+	// Every collapse on a sphere moves the surface, a zero error bound keeps it as is
+	float				  Error		 = -1.0f;
+	std::vector<uint32_t> Simplified = MeshSimplifier::Simplify(Sphere.Vertices, Sphere.Indices, 0, 0.0f, &Error);
+	EXPECT_EQ(Simplified.size(), Sphere.Indices.size());
+	EXPECT_EQ(Error, 0.0f);
+
+	size_t PreviousSize = Sphere.Indices.size();
+	for (float TargetError : { 0.005f, 0.01f, 0.02f, 0.05f })
+	{
+		Simplified = MeshSimplifier::Simplify(Sphere.Vertices, Sphere.Indices, 0, TargetError, &Error);
+
+		// The index target can't be reached, the error bound decides where it stops
+		EXPECT_GT(Simplified.size(), 0u);
+		EXPECT_LE(Error, TargetError);
+		EXPECT_LT(Simplified.size(), PreviousSize) << TargetError;
+		ExpectValidTriangles(Sphere, Simplified);
+
+		// Quadric errors underestimate the distance to the simplified surface, by about 1.7x on a sphere
+		EXPECT_LE(MaxDeviation(Sphere, Simplified), 2.0f * TargetError) << TargetError;
+		PreviousSize = Simplified.size();
+	}
+}
+
+TEST(MeshSimplifier, FlatRegionsCollapseWithoutError)
+{
+	TestGeometry Grid = MakeGrid(8);
+
+	float				  Error		 = -1.0f;
+	std::vector<uint32_t> Simplified = MeshSimplifier::Simplify(Grid.Vertices, Grid.Indices, 0, 0.0f, &Error);
+	EXPECT_LT(Simplified.size(), Grid.Indices.size() / 4);
+	EXPECT_EQ(Error, 0.0f);
+	ExpectValidTriangles(Grid, Simplified);
+
+	// The locked border keeps the outline, so the area is unchanged and no triangle flips
+	EXPECT_NEAR(TotalArea(Grid, Simplified), 64.0, 1e-4);
+	for (size_t i = 0; i < Simplified.size(); i += 3)
+	{
+		EXPECT_GT(TriangleNormal(Grid, std::span(Simplified).subspan(i, 3)).z, 0.0f);
+	}
+}
+
+TEST(MeshSimplifier, BordersAndSeamsAreLocked)
+{
+	TestGeometry Grid = MakeGrid(6);
+
+	// Triangles right of x = 3 get their own copies of the column, like the two sides of a uv seam
+	const uint32_t NumVertices = uint32_t(Grid.Vertices.size());
+	for (uint32_t y = 0; y <= 6; ++y)
+	{
+		Grid.Vertices.push_back(Grid.Vertices[y * 7 + 3]);
+	}
+	for (size_t i = 0; i < Grid.Indices.size(); i += 3)
+	{
+		std::span<uint32_t> Triangle(&Grid.Indices[i], 3);
+		bool				RightSide = true;
+		for (uint32_t Index : Triangle)
+		{
+			RightSide &= Grid.Vertices[Index].Position.x >= 3.0f;
+		}
+		for (uint32_t& Index : Triangle)
+		{
+			Index = RightSide && Index % 7 == 3 ? NumVertices + Index / 7 : Index;
+		}
+	}
+
+	std::vector<uint32_t> Simplified = MeshSimplifier::Simplify(Grid.Vertices, Grid.Indices, 0, 1.0f);
+	ExpectValidTriangles(Grid, Simplified);
+	EXPECT_LT(Simplified.size(), Grid.Indices.size());
+
+	for (uint32_t Index = 0; Index < Grid.Vertices.size(); ++Index)
+	{
+		const XMFLOAT3& Position = Grid.Vertices[Index].Position;
+		if (Position.x == 0.0f || Position.x == 3.0f || Position.x == 6.0f || Position.y == 0.0f || Position.y == 6.0f)
+		{
+			EXPECT_NE(std::ranges::find(Simplified, Index), Simplified.end()) << "vertex " << Index;
+		}
+	}
+
+	// Collapses never pull a triangle across the seam, each side keeps using its own copy of the column
+	for (size_t i = 0; i < Simplified.size(); i += 3)
+	{
+		bool Left = false, UsesCopy = false;
+		for (uint32_t Index : std::span(Simplified).subspan(i, 3))
+		{
+			Left |= Grid.Vertices[Index].Position.x < 3.0f;
+			UsesCopy |= Index >= NumVertices;
+		}
+		EXPECT_FALSE(Left && UsesCopy);
+	}
+}
+
+TEST(MeshSimplifier, EmptyInput)
+{
+	float Error = -1.0f;
+	EXPECT_TRUE(MeshSimplifier::Simplify({}, {}, 0, 1.0f, &Error).empty());
+	EXPECT_EQ(Error, 0.0f);
+
+	TestGeometry Sphere = MakeIcosphere(1);
+	EXPECT_TRUE(MeshSimplifier::Simplify(Sphere.Vertices, {}, 0, 1.0f).empty());
+}
+
+TEST(MeshSimplifier, DegenerateTrianglesAreDropped)
+{
+	TestGeometry Grid = MakeGrid(4);
+	Grid.Indices.insert(Grid.Indices.end(), { 0, 0, 1, 6, 7, 6, 12, 12, 12 });
+
+	std::vector<uint32_t> Simplified = MeshSimplifier::Simplify(Grid.Vertices, Grid.Indices, Grid.Indices.size(), 1.0f);
+	EXPECT_EQ(Simplified, std::vector<uint32_t>(Grid.Indices.begin(), Grid.Indices.end() - 9));
+}
+
+TEST(MeshSimplifier, ZeroAreaTrianglesDoNotProduceNaNs)
+{
+	// Collinear triangles have no normal, they add nothing to the quadrics
+	TestGeometry Grid = MakeGrid(4);
+	Grid.Vertices.push_back(MakeVertex(0.0f, 0.0f, 1.0f));
+	Grid.Vertices.push_back(MakeVertex(0.0f, 0.0f, 2.0f));
+	Grid.Vertices.push_back(MakeVertex(0.0f, 0.0f, 3.0f));
+	uint32_t First = uint32_t(Grid.Vertices.size() - 3);
+	Grid.Indices.insert(Grid.Indices.end(), { First, First + 1, First + 2 });
+
+	float				  Error		 = -1.0f;
+	std::vector<uint32_t> Simplified = MeshSimplifier::Simplify(Grid.Vertices, Grid.Indices, 0, 1.0f, &Error);
+	EXPECT_FALSE(std::isnan(Error));
+	EXPECT_LE(Error, 1.0f);
+	ExpectValidTriangles(Grid, Simplified);
+}
+
+TEST(MeshSimplifier, CoincidentVerticesAreReturnedUnchanged)
+{
+	// All positions equal, the bounds have no diagonal to measure errors against
+	std::vector<Vertex>	  Vertices(4, MakeVertex(1.0f, 2.0f, 3.0f));
+	std::vector<uint32_t> Indices = { 0, 1, 2, 0, 2, 3 };
+	EXPECT_EQ(MeshSimplifier::Simplify(Vertices, Indices, 0, 1.0f), Indices);
+}
+
+TEST(MeshSimplifier, TrailingIndicesAreIgnored)
+{
+	TestGeometry Grid = MakeGrid(2);
+	std::vector<uint32_t> Indices = Grid.Indices;
+	Indices.insert(Indices.end(), { 0, 1 });
+
+	EXPECT_EQ(MeshSimplifier::Simplify(Grid.Vertices, Indices, Indices.size(), 1.0f), Grid.Indices);
+}
+
+TEST(MeshSimplifier, IsDeterministic)
+{
+	TestGeometry		  Sphere = MakeIcosphere(3);
+	std::vector<uint32_t> First	 = MeshSimplifier::Simplify(Sphere.Vertices, Sphere.Indices, 600, 1.0f);
+	for (int i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ(MeshSimplifier::Simplify(Sphere.Vertices, Sphere.Indices, 600, 1.0f), First);
+	}
+}
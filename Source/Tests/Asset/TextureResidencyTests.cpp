@@ -0,0 +1,401 @@
+#include "Core/Asset/TextureResidency.h"
+
+// Block compressed square texture, one byte per texel, mips below 64KiB are packed into the tail
+static std::vector<UINT64> MakeMipSizes(UINT Size, UINT& TailMip)
+{
+	std::vector<UINT64> MipSizes;
+	for (UINT Dimension = Size; Dimension >= 4; Dimension /= 2)
+	{
+		MipSizes.push_back(UINT64(Dimension) * Dimension);
+	}
+	TailMip = 0;
+	while (TailMip + 1 < MipSizes.size() && MipSizes[TailMip] > 64_KiB)
+	{
+		++TailMip;
+	}
+	return MipSizes;
+}
+
+// Size of the chain from Mip to the end
+static UINT64 ChainSize(std::span<const UINT64> MipSizes, UINT Mip)
+{
+	return std::accumulate(MipSizes.begin() + Mip, MipSizes.end(), UINT64(0));
+}
+
+struct TraceRequest
+{
+	UINT  Id;
+	UINT  Mip;
+	float Priority;
+};
+
+struct TraceFrame
+{
+	UINT64					  Budget;
+	std::vector<TraceRequest> Requests;
+};
+
+// Textures placed along a corridor the camera flies through and then stops in, the way the renderer requests them:
+// a mip from the distance and a priority from the screen coverage. The budget drops to half in the middle of the
+// flight as if another application took memory, and recovers later
+struct Trace
+{
+	static constexpr UINT NumTextures = 64;
+
+	Trace()
+	{
+		for (UINT Id = 0; Id < NumTextures; ++Id)
+		{
+			UINT TailMip;
+			MipSizes.push_back(MakeMipSizes(Id % 4 == 0 ? 2048 : 1024, TailMip));
+			TailMips.push_back(TailMip);
+		}
+
+		for (int Frame = 0; Frame < 900; ++Frame)
+		{
+			float Camera = std::min(float(Frame), 640.0f);
+
+			TraceFrame TraceFrame;
+			TraceFrame.Budget = Frame >= 300 && Frame < 500 ? 24_MiB : 48_MiB;
+			for (UINT Id = 0; Id < NumTextures; ++Id)
+			{
+				float Distance = std::abs(float(Id) * 10.0f - Camera);
+				if (Distance > 120.0f)
+				{
+					continue;
+				}
+				UINT Mip = UINT(std::log2(std::max(Distance, 8.0f) / 8.0f));
+				TraceFrame.Requests.push_back({ Id, Mip, 1.0f / (1.0f + Distance) });
+			}
+			Frames.push_back(std::move(TraceFrame));
+		}
+	}
+
+	std::vector<std::vector<UINT64>> MipSizes;
+	std::vector<UINT>				 TailMips;
+	std::vector<TraceFrame>			 Frames;
+};
+
+// Resident mips as the renderer sees them, by applying the returned changes
+struct ResidencyMirror
+{
+	explicit ResidencyMirror(const Trace& Source)
+		: Source(Source)
+		, ResidentMips(Source.TailMips)
+	{
+	}
+
+	void Apply(const TextureResidencyChange& Change)
+	{
+		ASSERT_LT(Change.Id, ResidentMips.size());
+		EXPECT_EQ(Change.OldMip, ResidentMips[Change.Id]) << "texture " << Change.Id;
+		EXPECT_NE(Change.OldMip, Change.NewMip);
+		EXPECT_LE(Change.NewMip, Source.TailMips[Change.Id]);
+		ResidentMips[Change.Id] = Change.NewMip;
+	}
+
+	UINT64 GetResidentSize() const
+	{
+		UINT64 Size = 0;
+		for (UINT Id = 0; Id < ResidentMips.size(); ++Id)
+		{
+			Size += ChainSize(Source.MipSizes[Id], ResidentMips[Id]);
+		}
+		return Size;
+	}
+
+	const Trace&	  Source;
+	std::vector<UINT> ResidentMips;
+};
+
+static void Register(TextureResidencyManager& Manager, const Trace& Trace)
+{
+	for (UINT Id = 0; Id < Trace::NumTextures; ++Id)
+	{
+		Manager.Register(Id, Trace.MipSizes[Id], Trace.TailMips[Id]);
+	}
+}
+
+static std::vector<std::vector<TextureResidencyChange>> Replay(const Trace& Trace, UINT64 MaxStreamInPerUpdate)
+{
+	TextureResidencyManager Manager(Trace.Frames[0].Budget, MaxStreamInPerUpdate);
+	Register(Manager, Trace);
+
+	std::vector<std::vector<TextureResidencyChange>> Changes;
+	for (const TraceFrame& Frame : Trace.Frames)
+	{
+		Manager.SetBudget(Frame.Budget);
+		for (const TraceRequest& Request : Frame.Requests)
+		{
+			Manager.Request(Request.Id, Request.Mip, Request.Priority);
+		}
+		Changes.push_back(Manager.Update());
+	}
+	return Changes;
+}
+
+TEST(TextureResidency, TraceStaysWithinBudget)
+{
+	Trace					Trace;
+	TextureResidencyManager Manager(Trace.Frames[0].Budget, 4_MiB);
+	ResidencyMirror			Mirror(Trace);
+	Register(Manager, Trace);
+
+	UINT64 TailSize		= Mirror.GetResidentSize();
+	UINT64 NumEvictions = 0;
+	ASSERT_LT(TailSize, 24_MiB);
+
+	for (size_t Frame = 0; Frame < Trace.Frames.size(); ++Frame)
+	{
+		Manager.SetBudget(Trace.Frames[Frame].Budget);
+		for (const TraceRequest& Request : Trace.Frames[Frame].Requests)
+		{
+			Manager.Request(Request.Id, Request.Mip, Request.Priority);
+		}
+		for (const TextureResidencyChange& Change : Manager.Update())
+		{
+			Mirror.Apply(Change);
+		}
+
+		const TextureResidencyStats& Stats = Manager.GetStats();
+		if (Trace.Frames[Frame].Budget < Trace.Frames[Frame - (Frame > 0)].Budget)
+		{
+			// The budget drop is met by evicting in the same update
+			EXPECT_GT(Stats.NumEvictions, NumEvictions) << "frame " << Frame;
+		}
+		NumEvictions = Stats.NumEvictions;
+
+		ASSERT_LE(Stats.ResidentSizeInBytes, Trace.Frames[Frame].Budget) << "frame " << Frame;
+		ASSERT_EQ(Stats.ResidentSizeInBytes, Mirror.GetResidentSize()) << "frame " << Frame;
+		ASSERT_GE(Stats.ResidentSizeInBytes, TailSize) << "frame " << Frame;
+		for (UINT Id = 0; Id < Trace::NumTextures; ++Id)
+		{
+			ASSERT_EQ(Manager.GetResidentMip(Id), Mirror.ResidentMips[Id]) << "frame " << Frame << ", texture " << Id;
+		}
+	}
+}
+
+TEST(TextureResidency, TraceHonorsTheStreamInCap)
+{
+	constexpr UINT64 MaxStreamInPerUpdate = 2_MiB;
+
+	Trace									Trace;
+	std::vector<UINT>						ResidentMips = Trace.TailMips;
+	UINT64									NumCapped	 = 0;
+	for (const auto& Changes : Replay(Trace, MaxStreamInPerUpdate))
+	{
+		UINT64 StreamedIn	= 0;
+		size_t NumStreamIns = 0;
+		for (const TextureResidencyChange& Change : Changes)
+		{
+			if (Change.NewMip < Change.OldMip)
+			{
+				StreamedIn += ChainSize(Trace.MipSizes[Change.Id], Change.NewMip) - ChainSize(Trace.MipSizes[Change.Id], Change.OldMip);
+				++NumStreamIns;
+			}
+			ResidentMips[Change.Id] = Change.NewMip;
+		}
+
+		// Over the cap only when a single mip is larger than the cap, it still has to make progress
+		if (StreamedIn > MaxStreamInPerUpdate)
+		{
+			ASSERT_EQ(NumStreamIns, 1u);
+			auto StreamIn = std::ranges::find_if(
+				Changes,
+				[](const TextureResidencyChange& Change)
+				{
+					return Change.NewMip < Change.OldMip;
+				});
+			EXPECT_EQ(StreamIn->OldMip - StreamIn->NewMip, 1u);
+			++NumCapped;
+		}
+	}
+
+	// 2048 textures have a 4MiB top mip, the trace does hit the exception
+	EXPECT_GT(NumCapped, 0u);
+}
+
+TEST(TextureResidency, TraceConvergesOnceTheCameraStops)
+{
+	Trace Trace;
+	auto  Changes = Replay(Trace, 4_MiB);
+
+	// The camera stops at frame 640, by the end of the trace every request is resident and nothing moves
+	for (size_t Frame = 800; Frame < Changes.size(); ++Frame)
+	{
+		EXPECT_TRUE(Changes[Frame].empty()) << "frame " << Frame;
+	}
+
+	TextureResidencyManager Manager(48_MiB, 4_MiB);
+	Register(Manager, Trace);
+	for (const TraceFrame& Frame : Trace.Frames)
+	{
+		for (const TraceRequest& Request : Frame.Requests)
+		{
+			Manager.Request(Request.Id, Request.Mip, Request.Priority);
+		}
+		std::ignore = Manager.Update();
+	}
+	EXPECT_EQ(Manager.GetStats().NumOverBudget, 0u);
+	for (const TraceRequest& Request : Trace.Frames.back().Requests)
+	{
+		// Finer mips streamed in on the way there stay while the budget has room for them
+		EXPECT_LE(Manager.GetResidentMip(Request.Id), Request.Mip) << "texture " << Request.Id;
+	}
+}
+
+TEST(TextureResidency, ReplayIsDeterministic)
+{
+	Trace Trace;
+	auto  First	 = Replay(Trace, 4_MiB);
+	auto  Second = Replay(Trace, 4_MiB);
+	ASSERT_EQ(First.size(), Second.size());
+	for (size_t Frame = 0; Frame < First.size(); ++Frame)
+	{
+		ASSERT_EQ(First[Frame].size(), Second[Frame].size()) << "frame " << Frame;
+		for (size_t i = 0; i < First[Frame].size(); ++i)
+		{
+			EXPECT_EQ(First[Frame][i].Id, Second[Frame][i].Id);
+			EXPECT_EQ(First[Frame][i].NewMip, Second[Frame][i].NewMip);
+		}
+	}
+}
+
+TEST(TextureResidency, EvictionsComeBeforeStreamIns)
+{
+	Trace Trace;
+	for (const auto& Changes : Replay(Trace, 4_MiB))
+	{
+		auto FirstStreamIn = std::ranges::find_if(
+			Changes,
+			[](const TextureResidencyChange& Change)
+			{
+				return Change.NewMip < Change.OldMip;
+			});
+		for (auto Change = FirstStreamIn; Change != Changes.end(); ++Change)
+		{
+			EXPECT_LT(Change->NewMip, Change->OldMip);
+		}
+	}
+}
+
+// Four textures of 4 + 1 + 0.25 + 0.0625 MiB above a 64KiB tail, requested in full with decreasing priority
+class TextureResidencyEviction : public ::testing::Test
+{
+protected:
+	static constexpr UINT NumTextures = 4;
+
+	void SetUp() override
+	{
+		MipSizes = MakeMipSizes(2048, TailMip);
+		for (UINT Id = 0; Id < NumTextures; ++Id)
+		{
+			Manager.Register(Id, MipSizes, TailMip);
+		}
+	}
+
+	void RequestAll(std::array<float, NumTextures> Priorities)
+	{
+		for (UINT Id = 0; Id < NumTextures; ++Id)
+		{
+			Manager.Request(Id, 0, Priorities[Id]);
+		}
+	}
+
+	UINT64 FullSize() const { return ChainSize(MipSizes, 0); }
+	UINT64 TailSize() const { return ChainSize(MipSizes, TailMip); }
+
+	TextureResidencyManager Manager{ UINT64_MAX, UINT64_MAX };
+	std::vector<UINT64>		MipSizes;
+	UINT					TailMip = 0;
+};
+
+TEST_F(TextureResidencyEviction, LowestPriorityIsEvictedFirst)
+{
+	RequestAll({ 4.0f, 3.0f, 2.0f, 1.0f });
+	std::ignore = Manager.Update();
+	for (UINT Id = 0; Id < NumTextures; ++Id)
+	{
+		ASSERT_EQ(Manager.GetResidentMip(Id), 0u);
+	}
+
+	// Shrinking the budget one full texture at a time takes mips from the lowest priority first
+	for (UINT NumFull = NumTextures; NumFull-- > 0;)
+	{
+		Manager.SetBudget(NumFull * FullSize() + (NumTextures - NumFull) * TailSize());
+		RequestAll({ 4.0f, 3.0f, 2.0f, 1.0f });
+
+		std::vector<TextureResidencyChange> Changes = Manager.Update();
+		ASSERT_EQ(Changes.size(), 1u);
+		EXPECT_EQ(Changes[0].Id, NumFull);
+		EXPECT_EQ(Changes[0].OldMip, 0u);
+		EXPECT_EQ(Changes[0].NewMip, TailMip);
+		EXPECT_EQ(Manager.GetStats().NumOverBudget, NumTextures - NumFull);
+	}
+}
+
+TEST_F(TextureResidencyEviction, OverBudgetRequestsGetTheFinestMipThatFits)
+{
+	// Room for one full texture and the second texture's mip 1
+	Manager.SetBudget(FullSize() + ChainSize(MipSizes, 1) + 2 * TailSize());
+	RequestAll({ 4.0f, 3.0f, 2.0f, 1.0f });
+	std::ignore = Manager.Update();
+
+	EXPECT_EQ(Manager.GetResidentMip(0), 0u);
+	EXPECT_EQ(Manager.GetResidentMip(1), 1u);
+	EXPECT_EQ(Manager.GetResidentMip(2), TailMip);
+	EXPECT_EQ(Manager.GetResidentMip(3), TailMip);
+	EXPECT_EQ(Manager.GetStats().NumOverBudget, 3u);
+}
+
+TEST_F(TextureResidencyEviction, PriorityChangesSwapResidency)
+{
+	Manager.SetBudget(2 * FullSize() + 2 * TailSize());
+	RequestAll({ 4.0f, 3.0f, 2.0f, 1.0f });
+	std::ignore = Manager.Update();
+	ASSERT_EQ(Manager.GetResidentMip(0), 0u);
+	ASSERT_EQ(Manager.GetResidentMip(1), 0u);
+
+	// The last texture becomes the most important, the now least important resident one makes room for it, and the
+	// eviction is listed before the stream in so applying the changes in order never exceeds the budget
+	RequestAll({ 4.0f, 3.0f, 2.0f, 5.0f });
+	std::vector<TextureResidencyChange> Changes = Manager.Update();
+	ASSERT_EQ(Changes.size(), 2u);
+	EXPECT_EQ(Changes[0].Id, 1u);
+	EXPECT_EQ(Changes[0].NewMip, TailMip);
+	EXPECT_EQ(Changes[1].Id, 3u);
+	EXPECT_EQ(Changes[1].NewMip, 0u);
+}
+
+TEST_F(TextureResidencyEviction, UnrequestedMipsStayUntilTheBudgetIsNeeded)
+{
+	Manager.SetBudget(2 * FullSize() + 2 * TailSize());
+	RequestAll({ 4.0f, 3.0f, 2.0f, 1.0f });
+	std::ignore = Manager.Update();
+
+	// Requests expire, but with nothing else asking for memory the mips stay resident
+	for (UINT64 i = 0; i < TextureResidencyManager::RequestLifetime + 10; ++i)
+	{
+		EXPECT_TRUE(Manager.Update().empty());
+	}
+	EXPECT_EQ(Manager.GetResidentMip(0), 0u);
+	EXPECT_EQ(Manager.GetResidentMip(1), 0u);
+
+	// A new request takes the memory of the stale ones, the lowest id goes first among equal priorities
+	Manager.Request(2, 0, 1.0f);
+	std::vector<TextureResidencyChange> Changes = Manager.Update();
+	ASSERT_EQ(Changes.size(), 2u);
+	EXPECT_GT(Changes[0].NewMip, Changes[0].OldMip);
+	EXPECT_EQ(Changes[1].Id, 2u);
+	EXPECT_EQ(Changes[1].NewMip, 0u);
+	EXPECT_LE(Manager.GetStats().ResidentSizeInBytes, Manager.GetBudget());
+}
+
+TEST_F(TextureResidencyEviction, BudgetBelowTheTailsKeepsOnlyTails)
+{
+	Manager.SetBudget(TailSize());
+	RequestAll({ 4.0f, 3.0f, 2.0f, 1.0f });
+	EXPECT_TRUE(Manager.Update().empty());
+	EXPECT_EQ(Manager.GetStats().ResidentSizeInBytes, NumTextures * TailSize());
+	EXPECT_EQ(Manager.GetStats().NumOverBudget, NumTextures);
+}
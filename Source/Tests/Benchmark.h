@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// What every benchmark shares, the iteration count from the command line, timing and the result table, so a benchmark
+// only holds its workload. Usage: <benchmark> [iterations]
+
+// argv[1] or DefaultIterations, exits with the usage if the count is not positive
+inline int ParseIterations(int argc, char** argv, int DefaultIterations)
+{
+	int Iterations = argc > 1 ? std::atoi(argv[1]) : DefaultIterations;
+	if (Iterations <= 0)
+	{
+		std::fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+		std::exit(1);
+	}
+	return Iterations;
+}
+
+// Time of one call to Workload in Period (std::milli, std::micro, ...), averaged over Iterations calls
+template<typename Period, typename TWorkload>
+double TimePerIteration(int Iterations, TWorkload&& Workload)
+{
+	auto Begin = std::chrono::steady_clock::now();
+	for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Workload();
+	}
+	auto End = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, Period>(End - Begin).count() / Iterations;
+}
+
+// Keeps the results a workload sums into Checksum from being optimized away
+inline void KeepChecksum(std::size_t Checksum)
+{
+	if (Checksum == 0)
+	{
+		std::printf("\n");
+	}
+}
+
+struct BenchmarkColumn
+{
+	const char* Name;
+	int			Width;			// Negative aligns left, like printf
+	int			Precision = 2;	// Of floating point values
+	const char* Suffix	  = "";	// Printed after the value of a right aligned column, counts towards the width
+};
+
+// Prints the header once constructed, then a row per call to Row with a value per column
+class BenchmarkTable
+{
+public:
+	BenchmarkTable(std::initializer_list<BenchmarkColumn> Columns)
+		: Columns(Columns)
+	{
+		for (std::size_t i = 0; i < this->Columns.size(); ++i)
+		{
+			std::printf(i == 0 ? "%*s" : " %*s", this->Columns[i].Width, this->Columns[i].Name);
+		}
+		std::printf("\n");
+	}
+
+	template<typename... TValues>
+	void Row(const TValues&... Values)
+	{
+		std::size_t i = 0;
+		(Print(i++, Values), ...);
+		std::printf("\n");
+	}
+
+private:
+	template<typename T>
+	void Print(std::size_t i, const T& Value)
+	{
+		const BenchmarkColumn& Column = Columns[i];
+		const int			   Width  = Column.Width - static_cast<int>(std::strlen(Column.Suffix));
+
+		if (i > 0)
+		{
+			std::printf(" ");
+		}
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			std::printf("%*.*f%s", Width, Column.Precision, double(Value), Column.Suffix);
+		}
+		else if constexpr (std::is_integral_v<T>)
+		{
+			std::printf("%*llu%s", Width, static_cast<unsigned long long>(Value), Column.Suffix);
+		}
+		else
+		{
+			std::printf("%*s%s", Width, static_cast<const char*>(Value), Column.Suffix);
+		}
+	}
+
+private:
+	std::vector<BenchmarkColumn> Columns;
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include "DirectXMath.h"
+#include <cstddef>
+
+// The part of DirectXCollision the modules under test use, see DirectXMath.h in this directory
+namespace DirectX
+{
+struct BoundingBox
+{
+	static void CreateFromPoints(BoundingBox& Out, std::size_t Count, const XMFLOAT3* Points, std::size_t Stride) noexcept
+	{
+		XMFLOAT3 Min = *Points;
+		XMFLOAT3 Max = *Points;
+		for (std::size_t i = 1; i < Count; ++i)
+		{
+			const XMFLOAT3& Point = *reinterpret_cast<const XMFLOAT3*>(reinterpret_cast<const std::byte*>(Points) + i * Stride);
+			Min					  = { std::fmin(Min.x, Point.x), std::fmin(Min.y, Point.y), std::fmin(Min.z, Point.z) };
+			Max					  = { std::fmax(Max.x, Point.x), std::fmax(Max.y, Point.y), std::fmax(Max.z, Point.z) };
+		}
+
+		Out.Center	= { (Min.x + Max.x) * 0.5f, (Min.y + Max.y) * 0.5f, (Min.z + Max.z) * 0.5f };
+		Out.Extents = { (Max.x - Min.x) * 0.5f, (Max.y - Min.y) * 0.5f, (Max.z - Min.z) * 0.5f };
+	}
+
+	XMFLOAT3 Center	 = { 0.0f, 0.0f, 0.0f };
+	XMFLOAT3 Extents = { 1.0f, 1.0f, 1.0f };
+};
+} // namespace DirectX
@@ -0,0 +1,117 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// The part of DirectXMath the modules under test use, for platforms without the Windows SDK.
+// Scalar only, results follow the SDK's _XM_NO_INTRINSICS_ path
+namespace DirectX
+{
+struct XMFLOAT2
+{
+	XMFLOAT2() = default;
+	constexpr XMFLOAT2(float x, float y) noexcept
+		: x(x)
+		, y(y)
+	{
+	}
+
+	float x;
+	float y;
+};
+
+struct XMFLOAT3
+{
+	XMFLOAT3() = default;
+	constexpr XMFLOAT3(float x, float y, float z) noexcept
+		: x(x)
+		, y(y)
+		, z(z)
+	{
+	}
+
+	float x;
+	float y;
+	float z;
+};
+
+struct XMVECTOR
+{
+	float v[4];
+};
+
+inline XMVECTOR XMVectorSet(float x, float y, float z, float w) noexcept
+{
+	return { { x, y, z, w } };
+}
+
+inline XMVECTOR XMVectorReplicate(float Value) noexcept
+{
+	return XMVectorSet(Value, Value, Value, Value);
+}
+
+inline float XMVectorGetX(XMVECTOR V) noexcept
+{
+	return V.v[0];
+}
+
+inline XMVECTOR XMLoadFloat2(const XMFLOAT2* Source) noexcept
+{
+	return XMVectorSet(Source->x, Source->y, 0.0f, 0.0f);
+}
+
+inline XMVECTOR XMLoadFloat3(const XMFLOAT3* Source) noexcept
+{
+	return XMVectorSet(Source->x, Source->y, Source->z, 0.0f);
+}
+
+inline void XMStoreFloat2(XMFLOAT2* Destination, XMVECTOR V) noexcept
+{
+	*Destination = { V.v[0], V.v[1] };
+}
+
+inline void XMStoreFloat3(XMFLOAT3* Destination, XMVECTOR V) noexcept
+{
+	*Destination = { V.v[0], V.v[1], V.v[2] };
+}
+
+inline XMVECTOR XMVectorAdd(XMVECTOR V1, XMVECTOR V2) noexcept
+{
+	return XMVectorSet(V1.v[0] + V2.v[0], V1.v[1] + V2.v[1], V1.v[2] + V2.v[2], V1.v[3] + V2.v[3]);
+}
+
+inline XMVECTOR XMVectorSubtract(XMVECTOR V1, XMVECTOR V2) noexcept
+{
+	return XMVectorSet(V1.v[0] - V2.v[0], V1.v[1] - V2.v[1], V1.v[2] - V2.v[2], V1.v[3] - V2.v[3]);
+}
+
+inline XMVECTOR XMVectorScale(XMVECTOR V, float Scale) noexcept
+{
+	return XMVectorSet(V.v[0] * Scale, V.v[1] * Scale, V.v[2] * Scale, V.v[3] * Scale);
+}
+
+inline XMVECTOR XMVector3Dot(XMVECTOR V1, XMVECTOR V2) noexcept
+{
+	return XMVectorReplicate(V1.v[0] * V2.v[0] + V1.v[1] * V2.v[1] + V1.v[2] * V2.v[2]);
+}
+
+inline XMVECTOR XMVector3Cross(XMVECTOR V1, XMVECTOR V2) noexcept
+{
+	return XMVectorSet(
+		V1.v[1] * V2.v[2] - V1.v[2] * V2.v[1],
+		V1.v[2] * V2.v[0] - V1.v[0] * V2.v[2],
+		V1.v[0] * V2.v[1] - V1.v[1] * V2.v[0],
+		0.0f);
+}
+
+inline XMVECTOR XMVector3Length(XMVECTOR V) noexcept
+{
+	return XMVectorReplicate(std::sqrt(XMVectorGetX(XMVector3Dot(V, V))));
+}
+
+// A zero vector stays zero
+inline XMVECTOR XMVector3Normalize(XMVECTOR V) noexcept
+{
+	float Length = XMVectorGetX(XMVector3Length(V));
+	return XMVectorScale(V, Length > 0.0f ? 1.0f / Length : 0.0f);
+}
+} // namespace DirectX
@@ -0,0 +1,125 @@
+#pragma once
+#include "DirectXMath.h"
+#include <bit>
+
+// The packed types of DirectXMath the modules under test use, see DirectXMath.h in this directory
+namespace DirectX::PackedVector
+{
+using HALF = std::uint16_t;
+
+// Rounds to nearest even, too large values become infinity
+inline HALF XMConvertFloatToHalf(float Value) noexcept
+{
+	std::uint32_t Bits = std::bit_cast<std::uint32_t>(Value);
+	std::uint32_t Sign = (Bits & 0x80000000u) >> 16u;
+	Bits &= 0x7FFFFFFFu;
+
+	std::uint32_t Result;
+	if (Bits >= 0x47800000u)
+	{
+		// Infinity, NaN keeps a payload
+		Result = 0x7C00u | (Bits > 0x7F800000u ? 0x200u | ((Bits >> 13u) & 0x3FFu) : 0u);
+	}
+	else if (Bits <= 0x33000000u)
+	{
+		Result = 0;
+	}
+	else if (Bits < 0x38800000u)
+	{
+		// Denormal
+		std::uint32_t Shift = 125u - (Bits >> 23u);
+		Bits				= 0x800000u | (Bits & 0x7FFFFFu);
+		Result				= Bits >> (Shift + 1);
+
+		// Round to nearest even
+		std::uint32_t Sticky = (Bits & ((1u << Shift) - 1)) != 0;
+		Result += (Result | Sticky) & ((Bits >> Shift) & 1u);
+	}
+	else
+	{
+		Bits += 0xC8000000u;
+		Result = ((Bits + 0x0FFFu + ((Bits >> 13u) & 1u)) >> 13u) & 0x7FFFu;
+	}
+	return static_cast<HALF>(Result | Sign);
+}
+
+inline float XMConvertHalfToFloat(HALF Value) noexcept
+{
+	std::uint32_t Mantissa = Value & 0x03FFu;
+	std::uint32_t Exponent = Value & 0x7C00u;
+	if (Exponent == 0x7C00u)
+	{
+		Exponent = 0x8Fu;
+	}
+	else if (Exponent != 0)
+	{
+		Exponent = (Value >> 10u) & 0x1Fu;
+	}
+	else if (Mantissa != 0)
+	{
+		// Denormal, normalized as a float
+		Exponent = 1;
+		do
+		{
+			Exponent--;
+			Mantissa <<= 1u;
+		} while ((Mantissa & 0x0400u) == 0);
+		Mantissa &= 0x03FFu;
+	}
+	else
+	{
+		Exponent = static_cast<std::uint32_t>(-112);
+	}
+
+	std::uint32_t Bits = ((Value & 0x8000u) << 16u) | ((Exponent + 112u) << 23u) | (Mantissa << 13u);
+	return std::bit_cast<float>(Bits);
+}
+
+struct XMHALF2
+{
+	XMHALF2() = default;
+	XMHALF2(float x, float y) noexcept
+		: x(XMConvertFloatToHalf(x))
+		, y(XMConvertFloatToHalf(y))
+	{
+	}
+
+	HALF x;
+	HALF y;
+};
+
+// Signed normalized, [-1, 1] maps to [-32767, 32767]
+struct XMSHORTN2
+{
+	XMSHORTN2() = default;
+	XMSHORTN2(float x, float y) noexcept
+		: x(Quantize(x))
+		, y(Quantize(y))
+	{
+	}
+
+	std::int16_t x;
+	std::int16_t y;
+
+private:
+	static std::int16_t Quantize(float Value) noexcept
+	{
+		Value = Value < -1.0f ? -1.0f : (Value > 1.0f ? 1.0f : Value);
+		return static_cast<std::int16_t>(std::nearbyint(Value * 32767.0f));
+	}
+};
+
+inline XMVECTOR XMLoadHalf2(const XMHALF2* Source) noexcept
+{
+	return XMVectorSet(XMConvertHalfToFloat(Source->x), XMConvertHalfToFloat(Source->y), 0.0f, 0.0f);
+}
+
+inline XMVECTOR XMLoadShortN2(const XMSHORTN2* Source) noexcept
+{
+	return XMVectorSet(
+		Source->x == -32768 ? -1.0f : static_cast<float>(Source->x) * (1.0f / 32767.0f),
+		Source->y == -32768 ? -1.0f : static_cast<float>(Source->y) * (1.0f / 32767.0f),
+		0.0f,
+		0.0f);
+}
+} // namespace DirectX::PackedVector
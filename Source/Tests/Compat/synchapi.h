@@ -0,0 +1,63 @@
+#pragma once
+#include <mutex>
+#include <shared_mutex>
+
+// The part of the Win32 synchronization API Core/Sync.cpp uses, see DirectXMath.h in this directory.
+// A critical section can be entered again by the thread that holds it, an SRW lock can't
+struct CRITICAL_SECTION
+{
+	std::recursive_mutex Mutex;
+};
+
+struct SRWLOCK
+{
+	std::shared_mutex Mutex;
+};
+
+inline int InitializeCriticalSectionEx(CRITICAL_SECTION*, unsigned, unsigned)
+{
+	return 1;
+}
+
+inline void DeleteCriticalSection(CRITICAL_SECTION*)
+{
+}
+
+inline void EnterCriticalSection(CRITICAL_SECTION* CriticalSection)
+{
+	CriticalSection->Mutex.lock();
+}
+
+inline void LeaveCriticalSection(CRITICAL_SECTION* CriticalSection)
+{
+	CriticalSection->Mutex.unlock();
+}
+
+inline int TryEnterCriticalSection(CRITICAL_SECTION* CriticalSection)
+{
+	return CriticalSection->Mutex.try_lock();
+}
+
+inline void InitializeSRWLock(SRWLOCK*)
+{
+}
+
+inline void AcquireSRWLockShared(SRWLOCK* Lock)
+{
+	Lock->Mutex.lock_shared();
+}
+
+inline void ReleaseSRWLockShared(SRWLOCK* Lock)
+{
+	Lock->Mutex.unlock_shared();
+}
+
+inline void AcquireSRWLockExclusive(SRWLOCK* Lock)
+{
+	Lock->Mutex.lock();
+}
+
+inline void ReleaseSRWLockExclusive(SRWLOCK* Lock)
+{
+	Lock->Mutex.unlock();
+}
@@ -0,0 +1,234 @@
+#include "Core/RHI/RingAllocator.h"
+
+TEST(RingAllocator, AllocatesFrontToBack)
+{
+	RingAllocator Ring(1024);
+
+	EXPECT_EQ(Ring.Allocate(100, 1), 0u);
+	EXPECT_EQ(Ring.Allocate(100, 256), 256u);
+	EXPECT_EQ(Ring.Allocate(10, 16), 368u);
+
+	// Padding counts as used, staged only counts what was asked for
+	const RingAllocatorStats& Stats = Ring.GetStats();
+	EXPECT_EQ(Stats.CapacityInBytes, 1024u);
+	EXPECT_EQ(Stats.UsedInBytes, 378u);
+	EXPECT_EQ(Stats.StagedInBytes, 210u);
+	EXPECT_EQ(Stats.NumAllocations, 3u);
+	EXPECT_EQ(Stats.NumWraparounds, 0u);
+}
+
+TEST(RingAllocator, OversizeNeverFits)
+{
+	RingAllocator Ring(1024);
+
+	// The owner stages anything larger than the capacity in its own resource, waiting for the gpu would never help
+	EXPECT_EQ(Ring.Allocate(1025, 1), std::nullopt);
+	EXPECT_EQ(Ring.Allocate(UINT64_MAX, 1), std::nullopt);
+	EXPECT_EQ(Ring.Allocate(0, 1), std::nullopt);
+	EXPECT_EQ(Ring.GetStats().NumAllocations, 0u);
+
+	// Up to the capacity fits once everything is released, wherever the head was left
+	ASSERT_EQ(Ring.Allocate(700, 1), 0u);
+	Ring.Submit(1);
+	EXPECT_EQ(Ring.Allocate(1024, 512), std::nullopt);
+	Ring.Release(1);
+	EXPECT_EQ(Ring.Allocate(1024, 512), 0u);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 1024u);
+}
+
+TEST(RingAllocator, WrapsAroundToTheStart)
+{
+	RingAllocator Ring(1024);
+
+	ASSERT_EQ(Ring.Allocate(400, 1), 0u);
+	Ring.Submit(1);
+	ASSERT_EQ(Ring.Allocate(500, 1), 400u);
+	Ring.Submit(2);
+	Ring.Release(1);
+
+	// 124 bytes left at the end, the allocation goes to the start and the end is skipped
+	EXPECT_EQ(Ring.Allocate(200, 1), 0u);
+	EXPECT_EQ(Ring.GetStats().NumWraparounds, 1u);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 500u + 124u + 200u);
+	Ring.Submit(3);
+
+	// The skipped end is freed with the allocation that skipped it
+	Ring.Release(2);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 124u + 200u);
+	Ring.Release(3);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 0u);
+}
+
+TEST(RingAllocator, WraparoundWaitsForTheTail)
+{
+	RingAllocator Ring(1024);
+
+	ASSERT_EQ(Ring.Allocate(400, 1), 0u);
+	Ring.Submit(1);
+	ASSERT_EQ(Ring.Allocate(500, 1), 400u);
+	Ring.Submit(2);
+
+	// Neither the end nor the start has room until the first batch is freed
+	EXPECT_EQ(Ring.Allocate(200, 1), std::nullopt);
+	EXPECT_EQ(Ring.GetStats().NumWraparounds, 0u);
+	Ring.Release(1);
+	EXPECT_EQ(Ring.Allocate(200, 1), 0u);
+
+	// After the wraparound the head is behind the tail, the space in between is all there is
+	EXPECT_EQ(Ring.Allocate(200, 1), 200u);
+	EXPECT_EQ(Ring.Allocate(1, 1), std::nullopt);
+}
+
+TEST(RingAllocator, ReleasesBatchesInFenceOrder)
+{
+	RingAllocator Ring(1024);
+
+	EXPECT_EQ(Ring.GetOldestFenceValue(), std::nullopt);
+	for (UINT64 FenceValue = 1; FenceValue <= 4; ++FenceValue)
+	{
+		ASSERT_TRUE(Ring.Allocate(100, 1));
+		Ring.Submit(FenceValue * 10);
+	}
+
+	// Submitting without allocating does not form a batch
+	Ring.Submit(50);
+	EXPECT_EQ(Ring.GetOldestFenceValue(), 10u);
+
+	Ring.Release(5);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 400u);
+
+	Ring.Release(25);
+	EXPECT_EQ(Ring.GetOldestFenceValue(), 30u);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 200u);
+
+	// Completing an older value again frees nothing
+	Ring.Release(20);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 200u);
+
+	Ring.Release(40);
+	EXPECT_EQ(Ring.GetOldestFenceValue(), std::nullopt);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 0u);
+}
+
+TEST(RingAllocator, UnsubmittedAllocationsAreNotReleased)
+{
+	RingAllocator Ring(1024);
+
+	ASSERT_TRUE(Ring.Allocate(100, 1));
+	Ring.Submit(1);
+	ASSERT_TRUE(Ring.Allocate(100, 1));
+
+	Ring.Release(UINT64_MAX);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 100u);
+	EXPECT_EQ(Ring.GetOldestFenceValue(), std::nullopt);
+
+	Ring.Submit(2);
+	Ring.Release(2);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 0u);
+}
+
+static bool Overlaps(UINT64 Offset, UINT64 Size, UINT64 OtherOffset, UINT64 OtherSize)
+{
+	return Offset < OtherOffset + OtherSize && OtherOffset < Offset + Size;
+}
+
+// The upload path of D3D12LinkedDevice with a copy queue that lags a few submissions behind: allocate, and when the
+// ring is full record a stall and wait for the oldest batch
+TEST(RingAllocator, LiveAllocationsNeverOverlap)
+{
+	constexpr UINT64 Capacity = 64_KiB;
+
+	struct Allocation
+	{
+		UINT64 Offset;
+		UINT64 Size;
+		UINT64 FenceValue;
+	};
+
+	RingAllocator			Ring(Capacity);
+	std::deque<Allocation>	Live;
+	std::vector<Allocation> Pending;
+	std::mt19937			Random(7);
+	UINT64					FenceValue	   = 0;
+	UINT64					CompletedValue = 0;
+
+	auto Release = [&](UINT64 Value)
+	{
+		Ring.Release(Value);
+		CompletedValue = Value;
+		while (!Live.empty() && Live.front().FenceValue <= Value)
+		{
+			Live.pop_front();
+		}
+	};
+
+	for (int Submission = 0; Submission < 2000; ++Submission)
+	{
+		int NumAllocations = std::uniform_int_distribution(1, 8)(Random);
+		for (int i = 0; i < NumAllocations; ++i)
+		{
+			UINT64 Size		 = std::uniform_int_distribution<UINT64>(1, Capacity / 4)(Random);
+			UINT64 Alignment = UINT64(1) << std::uniform_int_distribution(0, 9)(Random);
+
+			std::optional<UINT64> Offset;
+			while (!(Offset = Ring.Allocate(Size, Alignment)))
+			{
+				Ring.RecordStall();
+				std::optional<UINT64> OldestFenceValue = Ring.GetOldestFenceValue();
+				if (!OldestFenceValue)
+				{
+					// This submission alone fills the ring
+					Ring.Submit(++FenceValue);
+					for (Allocation& Allocation : Pending)
+					{
+						Allocation.FenceValue = FenceValue;
+						Live.push_back(Allocation);
+					}
+					Pending.clear();
+					OldestFenceValue = FenceValue;
+				}
+				ASSERT_GT(*OldestFenceValue, CompletedValue);
+				Release(*OldestFenceValue);
+			}
+
+			ASSERT_EQ(*Offset % Alignment, 0u);
+			ASSERT_LE(*Offset + Size, Capacity);
+			for (const Allocation& Other : Live)
+			{
+				ASSERT_FALSE(Overlaps(*Offset, Size, Other.Offset, Other.Size));
+			}
+			for (const Allocation& Other : Pending)
+			{
+				ASSERT_FALSE(Overlaps(*Offset, Size, Other.Offset, Other.Size));
+			}
+			Pending.push_back({ *Offset, Size, 0 });
+		}
+
+		Ring.Submit(++FenceValue);
+		for (Allocation& Allocation : Pending)
+		{
+			Allocation.FenceValue = FenceValue;
+			Live.push_back(Allocation);
+		}
+		Pending.clear();
+
+		// The gpu is three submissions behind
+		if (FenceValue > 3)
+		{
+			Release(std::max(CompletedValue, FenceValue - 3));
+		}
+
+		UINT64 LiveSize = 0;
+		for (const Allocation& Allocation : Live)
+		{
+			LiveSize += Allocation.Size;
+		}
+		ASSERT_GE(Ring.GetStats().UsedInBytes, LiveSize);
+		ASSERT_LE(Ring.GetStats().UsedInBytes, Capacity);
+	}
+
+	Release(FenceValue);
+	EXPECT_EQ(Ring.GetStats().UsedInBytes, 0u);
+	EXPECT_GT(Ring.GetStats().NumWraparounds, 0u);
+	EXPECT_GT(Ring.GetStats().NumStalls, 0u);
+}
@@ -0,0 +1,274 @@
+#include "Core/RHI/TlsfAllocator.h"
+#include "Benchmark.h"
+
+// Streams mesh geometry in and out of a 64MiB block the way GeometryPool uses it: allocations are made until the block
+// is about three quarters full, then random ones are freed and replaced. Times allocate and free and samples the
+// fragmentation, next to a first fit allocator over a sorted free list as the baseline. Failed is the share of
+// allocations that did not fit although a quarter of the block was free. An iteration is 10000 allocations or frees
+
+constexpr UINT64 BlockSize		 = 64_MiB;
+constexpr UINT64 TargetOccupancy = BlockSize / 4 * 3;
+constexpr int	 OpsPerIteration = 10000;
+
+// Free ranges sorted by offset, the first one large enough is split, freed ranges merge with their neighbours
+class FirstFitAllocator
+{
+public:
+	explicit FirstFitAllocator(UINT64 Capacity)
+	{
+		FreeRanges.emplace(0, Capacity);
+	}
+
+	std::optional<UINT64> Allocate(UINT64 Size)
+	{
+		for (auto Range = FreeRanges.begin(); Range != FreeRanges.end(); ++Range)
+		{
+			if (Range->second >= Size)
+			{
+				UINT64 Offset = Range->first;
+				UINT64 Rest	  = Range->second - Size;
+				FreeRanges.erase(Range);
+				if (Rest > 0)
+				{
+					FreeRanges.emplace(Offset + Size, Rest);
+				}
+				return Offset;
+			}
+		}
+		return std::nullopt;
+	}
+
+	void Free(UINT64 Offset, UINT64 Size)
+	{
+		auto Range = FreeRanges.emplace(Offset, Size).first;
+		if (auto Next = std::next(Range); Next != FreeRanges.end() && Offset + Size == Next->first)
+		{
+			Range->second += Next->second;
+			FreeRanges.erase(Next);
+		}
+		if (Range != FreeRanges.begin())
+		{
+			if (auto Prev = std::prev(Range); Prev->first + Prev->second == Offset)
+			{
+				Prev->second += Range->second;
+				FreeRanges.erase(Range);
+			}
+		}
+	}
+
+	float GetFragmentation() const
+	{
+		UINT64 FreeSize = 0, Largest = 0;
+		for (auto [Offset, Size] : FreeRanges)
+		{
+			FreeSize += Size;
+			Largest = std::max(Largest, Size);
+		}
+		return FreeSize > 0 ? 1.0f - float(Largest) / float(FreeSize) : 0.0f;
+	}
+
+private:
+	std::map<UINT64, UINT64> FreeRanges;
+};
+
+// Both allocators behind the calls the benchmark makes
+struct TlsfBlock
+{
+	struct Allocation
+	{
+		UINT64 Size;
+		UINT   Node;
+	};
+
+	static constexpr const char* Name = "tlsf";
+
+	std::optional<Allocation> Allocate(UINT64 Size)
+	{
+		if (std::optional<TlsfAllocation> Result = Allocator.Allocate(Size))
+		{
+			return Allocation{ Size, Result->Node };
+		}
+		return std::nullopt;
+	}
+
+	void  Free(const Allocation& Allocation) { Allocator.Free(Allocation.Node); }
+	float GetFragmentation() const { return Allocator.GetStats().Fragmentation; }
+
+	TlsfAllocator Allocator{ BlockSize };
+};
+
+struct FirstFitBlock
+{
+	struct Allocation
+	{
+		UINT64 Size;
+		UINT64 Offset;
+	};
+
+	static constexpr const char* Name = "first fit";
+
+	std::optional<Allocation> Allocate(UINT64 Size)
+	{
+		// Rounded like the tlsf allocator so both see the same sizes
+		UINT64 Rounded = AlignUp(Size, TlsfAllocator::Granularity);
+		if (std::optional<UINT64> Offset = Allocator.Allocate(Rounded))
+		{
+			return Allocation{ Rounded, *Offset };
+		}
+		return std::nullopt;
+	}
+
+	void  Free(const Allocation& Allocation) { Allocator.Free(Allocation.Offset, Allocation.Size); }
+	float GetFragmentation() const { return Allocator.GetFragmentation(); }
+
+	FirstFitAllocator Allocator{ BlockSize };
+};
+
+// Vertex and index data of meshes, log uniform between the two sizes
+struct SizeDistribution
+{
+	const char* Name;
+	UINT64		Min;
+	UINT64		Max;
+};
+
+struct BenchmarkResult
+{
+	double NanosecondsPerOp;
+	double MeanFragmentation;
+	double MaxFragmentation;
+	UINT64 NumAllocations;
+	UINT64 NumFailed; // With enough free space in total, the free space was too fragmented
+};
+
+// Allocates Size, or frees the live allocation at Index
+struct Op
+{
+	bool   Allocate;
+	UINT64 Size;
+	size_t Index;
+};
+
+template<typename TBlock>
+static void Free(TBlock& Block, std::vector<typename TBlock::Allocation>& Live, size_t Index)
+{
+	Block.Free(Live[Index]);
+	std::swap(Live[Index], Live.back());
+	Live.pop_back();
+}
+
+template<typename TBlock>
+static BenchmarkResult Run(const SizeDistribution& Sizes, int Iterations)
+{
+	using Allocation = typename TBlock::Allocation;
+
+	BenchmarkResult Result = {};
+
+	// Runs the workload once to sample the fragmentation and record the operations, what is allocated next depends on
+	// which allocations failed
+	std::vector<Op> Ops;
+	{
+		TBlock								   Block;
+		std::vector<Allocation>				   Live;
+		std::mt19937						   Random(11);
+		std::uniform_real_distribution<double> LogSize(std::log2(double(Sizes.Min)), std::log2(double(Sizes.Max)));
+		UINT64								   LiveSize	  = 0;
+		UINT64								   NumSamples = 0;
+
+		while (Ops.size() < size_t(Iterations) * OpsPerIteration)
+		{
+			if (LiveSize < TargetOccupancy)
+			{
+				UINT64					  Size		 = UINT64(std::exp2(LogSize(Random)));
+				std::optional<Allocation> Allocation = Block.Allocate(Size);
+
+				Ops.push_back({ true, Size, 0 });
+				++Result.NumAllocations;
+				if (Allocation)
+				{
+					Live.push_back(*Allocation);
+					LiveSize += Allocation->Size;
+					continue;
+				}
+				++Result.NumFailed;
+			}
+
+			size_t Index = std::uniform_int_distribution<size_t>(0, Live.size() - 1)(Random);
+			Ops.push_back({ false, 0, Index });
+			LiveSize -= Live[Index].Size;
+			Free(Block, Live, Index);
+
+			if (Ops.size() % 64 == 0)
+			{
+				double Fragmentation = Block.GetFragmentation();
+				Result.MeanFragmentation += Fragmentation;
+				Result.MaxFragmentation = std::max(Result.MaxFragmentation, Fragmentation);
+				++NumSamples;
+			}
+		}
+		Result.MeanFragmentation /= std::max(NumSamples, UINT64(1));
+	}
+
+	// Replays them on a new block with nothing else in the loop, the allocator is deterministic so the same ones fail
+	TBlock					Block;
+	std::vector<Allocation> Live;
+	Live.reserve(Ops.size());
+
+	double NanosecondsPerReplay = TimePerIteration<std::nano>(
+		1,
+		[&]()
+		{
+			for (const Op& Op : Ops)
+			{
+				if (!Op.Allocate)
+				{
+					Free(Block, Live, Op.Index);
+				}
+				else if (std::optional<Allocation> Allocation = Block.Allocate(Op.Size))
+				{
+					Live.push_back(*Allocation);
+				}
+			}
+		});
+
+	Result.NanosecondsPerOp = NanosecondsPerReplay / double(Ops.size());
+	return Result;
+}
+
+template<typename TBlock>
+static void Print(BenchmarkTable& Table, const SizeDistribution& Sizes, int Iterations)
+{
+	BenchmarkResult Result = Run<TBlock>(Sizes, Iterations);
+	Table.Row(
+		Sizes.Name,
+		TBlock::Name,
+		Result.NanosecondsPerOp,
+		Result.MeanFragmentation,
+		Result.MaxFragmentation,
+		100.0 * double(Result.NumFailed) / double(std::max(Result.NumAllocations, UINT64(1))));
+}
+
+int main(int argc, char** argv)
+{
+	int Iterations = ParseIterations(argc, argv, 20);
+
+	constexpr SizeDistribution Distributions[] = {
+		{ "small", 1_KiB, 64_KiB },
+		{ "mixed", 1_KiB, 4_MiB },
+	};
+
+	BenchmarkTable Table({
+		{ "Sizes", -10 },
+		{ "Allocator", -10 },
+		{ "ns/op", 10, 1 },
+		{ "frag mean", 10, 3 },
+		{ "frag max", 10, 3 },
+		{ "failed", 10, 3, "%" },
+	});
+	for (const SizeDistribution& Sizes : Distributions)
+	{
+		Print<TlsfBlock>(Table, Sizes, Iterations);
+		Print<FirstFitBlock>(Table, Sizes, Iterations);
+	}
+	return 0;
+}
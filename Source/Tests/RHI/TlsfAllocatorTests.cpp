@@ -0,0 +1,235 @@
+#include "Core/RHI/TlsfAllocator.h"
+
+constexpr UINT64 Granularity = TlsfAllocator::Granularity;
+
+TEST(TlsfAllocator, CapacityIsRoundedDownToTheGranularity)
+{
+	TlsfAllocator Allocator(10 * Granularity + 100);
+	EXPECT_EQ(Allocator.GetCapacity(), 10 * Granularity);
+	EXPECT_TRUE(Allocator.IsEmpty());
+
+	TlsfAllocatorStats Stats = Allocator.GetStats();
+	EXPECT_EQ(Stats.LargestFreeInBytes, 10 * Granularity);
+	EXPECT_EQ(Stats.NumFreeBlocks, 1u);
+	EXPECT_EQ(Stats.Fragmentation, 0.0f);
+
+	TlsfAllocator Empty(Granularity - 1);
+	EXPECT_EQ(Empty.GetCapacity(), 0u);
+	EXPECT_EQ(Empty.Allocate(1), std::nullopt);
+	EXPECT_EQ(Empty.GetStats().NumFreeBlocks, 0u);
+}
+
+TEST(TlsfAllocator, AllocatesGranules)
+{
+	TlsfAllocator Allocator(1_MiB);
+
+	std::optional<TlsfAllocation> First	 = Allocator.Allocate(1);
+	std::optional<TlsfAllocation> Second = Allocator.Allocate(Granularity + 1);
+	std::optional<TlsfAllocation> Third	 = Allocator.Allocate(Granularity);
+	ASSERT_TRUE(First && Second && Third);
+
+	// Blocks are split front to back, the size is the one asked for and the rounding counts as used
+	EXPECT_EQ(First->Offset, 0u);
+	EXPECT_EQ(First->Size, 1u);
+	EXPECT_EQ(Second->Offset, Granularity);
+	EXPECT_EQ(Second->Size, Granularity + 1);
+	EXPECT_EQ(Third->Offset, 3 * Granularity);
+
+	TlsfAllocatorStats Stats = Allocator.GetStats();
+	EXPECT_EQ(Stats.UsedInBytes, 4 * Granularity);
+	EXPECT_EQ(Stats.NumAllocations, 3u);
+	EXPECT_EQ(Stats.NumFreeBlocks, 1u);
+	EXPECT_EQ(Stats.LargestFreeInBytes, 1_MiB - 4 * Granularity);
+}
+
+TEST(TlsfAllocator, RejectsWhatDoesNotFit)
+{
+	TlsfAllocator Allocator(16 * Granularity);
+
+	EXPECT_EQ(Allocator.Allocate(0), std::nullopt);
+	EXPECT_EQ(Allocator.Allocate(16 * Granularity + 1), std::nullopt);
+	EXPECT_EQ(Allocator.Allocate(UINT64_MAX), std::nullopt);
+
+	std::optional<TlsfAllocation> All = Allocator.Allocate(16 * Granularity);
+	ASSERT_TRUE(All);
+	EXPECT_EQ(Allocator.Allocate(1), std::nullopt);
+	EXPECT_EQ(Allocator.GetStats().NumFreeBlocks, 0u);
+	EXPECT_EQ(Allocator.GetStats().Fragmentation, 0.0f);
+
+	Allocator.Free(All->Node);
+	EXPECT_TRUE(Allocator.IsEmpty());
+	EXPECT_TRUE(Allocator.Allocate(16 * Granularity));
+}
+
+TEST(TlsfAllocator, FreeBlocksCoalesceInAnyOrder)
+{
+	constexpr UINT NumBlocks = 5;
+
+	std::array<UINT, NumBlocks> Order;
+	std::iota(Order.begin(), Order.end(), 0);
+	do
+	{
+		TlsfAllocator Allocator(NumBlocks * 4 * Granularity);
+
+		std::array<TlsfAllocation, NumBlocks> Allocations;
+		for (UINT i = 0; i < NumBlocks; ++i)
+		{
+			std::optional<TlsfAllocation> Allocation = Allocator.Allocate(4 * Granularity);
+			ASSERT_TRUE(Allocation);
+			Allocations[i] = *Allocation;
+		}
+
+		std::array<bool, NumBlocks> Freed{};
+		for (UINT i : Order)
+		{
+			Allocator.Free(Allocations[i].Node);
+			Freed[i] = true;
+
+			// Every run of freed neighbours is a single block
+			UINT NumRuns = 0;
+			UINT Longest = 0;
+			for (UINT j = 0, Run = 0; j < NumBlocks; ++j)
+			{
+				Run		= Freed[j] ? Run + 1 : 0;
+				NumRuns += Freed[j] && (j == 0 || !Freed[j - 1]);
+				Longest = std::max(Longest, Run);
+			}
+
+			TlsfAllocatorStats Stats = Allocator.GetStats();
+			ASSERT_EQ(Stats.NumFreeBlocks, NumRuns);
+			ASSERT_EQ(Stats.LargestFreeInBytes, Longest * 4 * Granularity);
+		}
+
+		EXPECT_TRUE(Allocator.IsEmpty());
+		EXPECT_EQ(Allocator.GetStats().Fragmentation, 0.0f);
+		EXPECT_EQ(Allocator.Allocate(NumBlocks * 4 * Granularity)->Offset, 0u);
+	} while (std::next_permutation(Order.begin(), Order.end()));
+}
+
+TEST(TlsfAllocator, HolesAreReused)
+{
+	TlsfAllocator Allocator(64 * Granularity);
+
+	std::vector<TlsfAllocation> Allocations;
+	for (UINT64 Size : { 8, 3, 8, 17, 8 })
+	{
+		Allocations.push_back(*Allocator.Allocate(Size * Granularity));
+	}
+
+	// Holes of 3 and 17 granules between allocations, 20 free at the end
+	Allocator.Free(Allocations[1].Node);
+	Allocator.Free(Allocations[3].Node);
+
+	TlsfAllocatorStats Stats = Allocator.GetStats();
+	EXPECT_EQ(Stats.NumFreeBlocks, 3u);
+	EXPECT_EQ(Stats.LargestFreeInBytes, 20 * Granularity);
+	EXPECT_FLOAT_EQ(Stats.Fragmentation, 1.0f - 20.0f / 40.0f);
+
+	// 18 only fits at the end, 17 fits its own hole exactly and 3 is the only block left that fits it
+	EXPECT_EQ(Allocator.Allocate(18 * Granularity)->Offset, 44 * Granularity);
+	EXPECT_EQ(Allocator.Allocate(17 * Granularity)->Offset, 19 * Granularity);
+	EXPECT_EQ(Allocator.Allocate(3 * Granularity)->Offset, 8 * Granularity);
+	EXPECT_EQ(Allocator.Allocate(2 * Granularity)->Offset, 62 * Granularity);
+	EXPECT_EQ(Allocator.Allocate(1), std::nullopt);
+}
+
+// Free space of a reference model that keeps the live allocations sorted by offset
+struct FreeSpace
+{
+	UINT64 Largest	 = 0;
+	UINT   NumBlocks = 0;
+};
+
+static FreeSpace GetFreeSpace(const std::map<UINT64, UINT64>& Live, UINT64 Capacity)
+{
+	FreeSpace FreeSpace;
+	UINT64	  End = 0;
+	for (auto [Offset, Size] : Live)
+	{
+		if (Offset > End)
+		{
+			FreeSpace.Largest = std::max(FreeSpace.Largest, Offset - End);
+			++FreeSpace.NumBlocks;
+		}
+		End = Offset + Size;
+	}
+	if (Capacity > End)
+	{
+		FreeSpace.Largest = std::max(FreeSpace.Largest, Capacity - End);
+		++FreeSpace.NumBlocks;
+	}
+	return FreeSpace;
+}
+
+TEST(TlsfAllocator, MatchesAReferenceModel)
+{
+	constexpr UINT64 Capacity = 16_MiB;
+
+	TlsfAllocator				Allocator(Capacity);
+	std::map<UINT64, UINT64>	Live; // Offset to size rounded to the granularity
+	std::vector<TlsfAllocation> Allocations;
+	std::mt19937				Random(23);
+	UINT64						LiveSize  = 0;
+	UINT64						NumFailed = 0;
+
+	for (int Step = 0; Step < 20000; ++Step)
+	{
+		if (Allocations.empty() || std::uniform_int_distribution(0, 99)(Random) < 55)
+		{
+			// Sizes spread over the size classes, from a few bytes to a few MiB
+			UINT64 Size = std::uniform_int_distribution<UINT64>(1, 64)(Random) << std::uniform_int_distribution(0, 15)(Random);
+			UINT64 Used = AlignUp(Size, Granularity);
+
+			FreeSpace					  Before	 = GetFreeSpace(Live, Capacity);
+			std::optional<TlsfAllocation> Allocation = Allocator.Allocate(Size);
+
+			// Good fit, the allocation only fails when no free block is large enough
+			ASSERT_EQ(Allocation.has_value(), Used <= Before.Largest) << "step " << Step;
+			if (!Allocation)
+			{
+				++NumFailed;
+				continue;
+			}
+
+			ASSERT_EQ(Allocation->Offset % Granularity, 0u);
+			ASSERT_EQ(Allocation->Size, Size);
+			ASSERT_LE(Allocation->Offset + Used, Capacity);
+
+			auto Next = Live.lower_bound(Allocation->Offset);
+			ASSERT_TRUE(Next == Live.end() || Allocation->Offset + Used <= Next->first) << "step " << Step;
+			ASSERT_TRUE(Next == Live.begin() || std::prev(Next)->first + std::prev(Next)->second <= Allocation->Offset) << "step " << Step;
+
+			Live.emplace(Allocation->Offset, Used);
+			LiveSize += Used;
+			Allocations.push_back(*Allocation);
+		}
+		else
+		{
+			size_t Index = std::uniform_int_distribution<size_t>(0, Allocations.size() - 1)(Random);
+			Allocator.Free(Allocations[Index].Node);
+			LiveSize -= Live[Allocations[Index].Offset];
+			Live.erase(Allocations[Index].Offset);
+			std::swap(Allocations[Index], Allocations.back());
+			Allocations.pop_back();
+		}
+
+		// Free blocks coalesce right away, so they are exactly the gaps between live allocations
+		FreeSpace		   Expected = GetFreeSpace(Live, Capacity);
+		TlsfAllocatorStats Stats	= Allocator.GetStats();
+		ASSERT_EQ(Stats.NumAllocations, Live.size()) << "step " << Step;
+		ASSERT_EQ(Stats.NumFreeBlocks, Expected.NumBlocks) << "step " << Step;
+		ASSERT_EQ(Stats.LargestFreeInBytes, Expected.Largest) << "step " << Step;
+		ASSERT_EQ(Stats.UsedInBytes, LiveSize) << "step " << Step;
+	}
+
+	// The trace runs the allocator full often enough to exercise the failure path
+	EXPECT_GT(NumFailed, 0u);
+
+	for (const TlsfAllocation& Allocation : Allocations)
+	{
+		Allocator.Free(Allocation.Node);
+	}
+	EXPECT_TRUE(Allocator.IsEmpty());
+	EXPECT_EQ(Allocator.GetStats().NumFreeBlocks, 1u);
+	EXPECT_EQ(Allocator.GetStats().LargestFreeInBytes, Capacity);
+}
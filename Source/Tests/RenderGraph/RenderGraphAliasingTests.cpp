@@ -0,0 +1,244 @@
+#include "RenderGraph/RenderGraphAliasing.h"
+#include <random>
+
+static RgAliasingRequest MakeRequest(std::size_t Begin, std::size_t End, std::uint64_t SizeInBytes, std::uint64_t Alignment = 1)
+{
+	RgAliasingRequest Request = {};
+	Request.Lifetime.Extend(Begin);
+	Request.Lifetime.Extend(End);
+	Request.SizeInBytes = SizeInBytes;
+	Request.Alignment	= Alignment;
+	return Request;
+}
+
+// Resources with overlapping lifetimes must not share memory, and every offset must honor its alignment
+static void ExpectValidPlan(std::span<const RgAliasingRequest> Requests, const RgAliasingPlan& Plan)
+{
+	ASSERT_EQ(Plan.Offsets.size(), Requests.size());
+	for (std::size_t i = 0; i < Requests.size(); ++i)
+	{
+		EXPECT_EQ(Plan.Offsets[i] % Requests[i].Alignment, 0u) << "request " << i;
+		EXPECT_LE(Plan.Offsets[i] + Requests[i].SizeInBytes, Plan.AliasedSizeInBytes) << "request " << i;
+
+		for (std::size_t j = i + 1; j < Requests.size(); ++j)
+		{
+			if (!Requests[i].Lifetime.Overlaps(Requests[j].Lifetime))
+			{
+				continue;
+			}
+			bool Disjoint = Plan.Offsets[i] + Requests[i].SizeInBytes <= Plan.Offsets[j] ||
+							Plan.Offsets[j] + Requests[j].SizeInBytes <= Plan.Offsets[i];
+			EXPECT_TRUE(Disjoint) << "requests " << i << " and " << j << " are alive together";
+		}
+	}
+}
+
+TEST(RenderGraphAliasing, EmptyPlan)
+{
+	RgAliasingPlan Plan = RgResourceAliaser::Plan({});
+	EXPECT_TRUE(Plan.Offsets.empty());
+	EXPECT_EQ(Plan.NonAliasedSizeInBytes, 0u);
+	EXPECT_EQ(Plan.AliasedSizeInBytes, 0u);
+	EXPECT_EQ(Plan.PeakLiveSizeInBytes, 0u);
+}
+
+TEST(RenderGraphAliasing, DisjointLifetimesShareMemory)
+{
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(0, 1, 1024),
+		MakeRequest(2, 3, 1024),
+		MakeRequest(4, 5, 512),
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	ExpectValidPlan(Requests, Plan);
+	EXPECT_EQ(Plan.Offsets[0], 0u);
+	EXPECT_EQ(Plan.Offsets[1], 0u);
+	EXPECT_EQ(Plan.Offsets[2], 0u);
+	EXPECT_EQ(Plan.AliasedSizeInBytes, 1024u);
+}
+
+TEST(RenderGraphAliasing, OverlappingLifetimesAreStacked)
+{
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(0, 2, 1024),
+		MakeRequest(1, 3, 1024),
+		MakeRequest(2, 2, 256),
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	ExpectValidPlan(Requests, Plan);
+	EXPECT_EQ(Plan.AliasedSizeInBytes, 2304u);
+	EXPECT_EQ(Plan.AliasedSizeInBytes, Plan.NonAliasedSizeInBytes);
+}
+
+TEST(RenderGraphAliasing, LargestResourcesArePlacedFirst)
+{
+	// The small resource is requested first but must not push the large one to a higher offset
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(0, 0, 256),
+		MakeRequest(1, 1, 4096),
+		MakeRequest(0, 1, 1024),
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	ExpectValidPlan(Requests, Plan);
+	EXPECT_EQ(Plan.Offsets[1], 0u);
+	EXPECT_EQ(Plan.Offsets[2], 4096u);
+	EXPECT_EQ(Plan.Offsets[0], 0u);
+	EXPECT_EQ(Plan.AliasedSizeInBytes, 5120u);
+}
+
+TEST(RenderGraphAliasing, ShortLivedResourcesShareMemory)
+{
+	// 1 dies before 2 is born so they share the memory above 0, 3 overlaps 0 and 1 and goes above both
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(0, 3, 4096),
+		MakeRequest(0, 1, 2048),
+		MakeRequest(2, 3, 3072),
+		MakeRequest(1, 1, 1024),
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	ExpectValidPlan(Requests, Plan);
+	EXPECT_EQ(Plan.Offsets[0], 0u);
+	EXPECT_EQ(Plan.Offsets[2], 4096u);
+	EXPECT_EQ(Plan.Offsets[1], 4096u);
+	EXPECT_EQ(Plan.Offsets[3], 6144u);
+	EXPECT_EQ(Plan.AliasedSizeInBytes, 7168u);
+}
+
+TEST(RenderGraphAliasing, FirstFitFillsGaps)
+{
+	// 2 is only alive together with 1, the first gap below it is large enough
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(1, 1, 4096),
+		MakeRequest(0, 1, 2048),
+		MakeRequest(0, 0, 1024),
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	ExpectValidPlan(Requests, Plan);
+	EXPECT_EQ(Plan.Offsets[0], 0u);
+	EXPECT_EQ(Plan.Offsets[1], 4096u);
+	EXPECT_EQ(Plan.Offsets[2], 0u);
+	EXPECT_EQ(Plan.AliasedSizeInBytes, 6144u);
+}
+
+TEST(RenderGraphAliasing, OffsetsHonorAlignment)
+{
+	constexpr std::uint64_t PlacementAlignment = 64 * 1024;
+
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(0, 1, 1000, 256),
+		MakeRequest(0, 1, 70000, PlacementAlignment),
+		MakeRequest(0, 1, 300, 512),
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	ExpectValidPlan(Requests, Plan);
+	EXPECT_EQ(Plan.Offsets[1], 0u);
+	EXPECT_EQ(Plan.Offsets[0], 70144u); // 70000 aligned up to 256
+	EXPECT_EQ(Plan.Offsets[2], 71168u); // 71144 aligned up to 512
+}
+
+TEST(RenderGraphAliasing, AlignmentSkipsGapsThatAreTooSmall)
+{
+	// 3 conflicts with 1 and 2, the gap between them at [8192, 67584) is large enough for its size
+	// but not once the offset is aligned
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(1, 1, 67584),
+		MakeRequest(0, 1, 65536),
+		MakeRequest(0, 0, 8192),
+		MakeRequest(0, 0, 4096, 65536),
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	ExpectValidPlan(Requests, Plan);
+	EXPECT_EQ(Plan.Offsets[1], 67584u);
+	EXPECT_EQ(Plan.Offsets[2], 0u);
+	EXPECT_EQ(Plan.Offsets[3], 196608u);
+}
+
+TEST(RenderGraphAliasing, ZeroAlignmentIsTreatedAsOne)
+{
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(0, 0, 100, 0),
+		MakeRequest(0, 0, 10, 0),
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	EXPECT_EQ(Plan.Offsets[0], 0u);
+	EXPECT_EQ(Plan.Offsets[1], 100u);
+	EXPECT_EQ(Plan.AliasedSizeInBytes, 110u);
+}
+
+TEST(RenderGraphAliasing, PeakBytesBeforeAndAfterAliasing)
+{
+	// Shaped like a frame, gbuffer targets die after lighting and the post chain ping pongs
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(0, 1, 8 << 20), // Albedo
+		MakeRequest(0, 1, 8 << 20), // Normal
+		MakeRequest(0, 1, 4 << 20), // Depth
+		MakeRequest(1, 2, 8 << 20), // Lighting
+		MakeRequest(2, 3, 8 << 20), // Bloom
+		MakeRequest(3, 4, 8 << 20), // Tonemap
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	ExpectValidPlan(Requests, Plan);
+
+	EXPECT_EQ(Plan.NonAliasedSizeInBytes, 44u << 20);
+	EXPECT_EQ(Plan.PeakLiveSizeInBytes, 28u << 20); // Level 1, gbuffer + lighting
+	EXPECT_EQ(Plan.AliasedSizeInBytes, 28u << 20);
+}
+
+TEST(RenderGraphAliasing, PeakIgnoresInvalidLifetimes)
+{
+	RgAliasingRequest Unused = {};
+	Unused.SizeInBytes		 = 1 << 20;
+
+	const RgAliasingRequest Requests[] = {
+		MakeRequest(0, 0, 1024),
+		Unused,
+	};
+
+	RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+	EXPECT_EQ(Plan.PeakLiveSizeInBytes, 1024u);
+	EXPECT_EQ(Plan.NonAliasedSizeInBytes, 1024u + (1 << 20));
+}
+
+TEST(RenderGraphAliasing, OnlyGraphLocalGraphicsResourcesAreTransient)
+{
+	RgResourceUsage Usage = {};
+	EXPECT_FALSE(Usage.IsTransient()); // Never accessed
+
+	Usage.Lifetime.Extend(2);
+	EXPECT_TRUE(Usage.IsTransient());
+
+	for (bool RgResourceUsage::*Flag : { &RgResourceUsage::Persistent, &RgResourceUsage::Exported, &RgResourceUsage::AsyncCompute })
+	{
+		RgResourceUsage Excluded = Usage;
+		Excluded.*Flag			 = true;
+		EXPECT_FALSE(Excluded.IsTransient());
+	}
+}
+
+TEST(RenderGraphAliasing, RandomGraphsProduceValidPlans)
+{
+	std::mt19937_64 Random(7);
+	for (int Iteration = 0; Iteration < 50; ++Iteration)
+	{
+		std::vector<RgAliasingRequest> Requests(1 + Random() % 64);
+		for (auto& Request : Requests)
+		{
+			std::size_t Begin = Random() % 16;
+			Request			  = MakeRequest(Begin, Begin + Random() % 8, 256 + Random() % (4 << 20), std::uint64_t(1) << (Random() % 17));
+		}
+
+		RgAliasingPlan Plan = RgResourceAliaser::Plan(Requests);
+		ExpectValidPlan(Requests, Plan);
+		EXPECT_LE(Plan.PeakLiveSizeInBytes, Plan.AliasedSizeInBytes);
+		EXPECT_LE(Plan.AliasedSizeInBytes, Plan.NonAliasedSizeInBytes + Requests.size() * (64 * 1024));
+	}
+}
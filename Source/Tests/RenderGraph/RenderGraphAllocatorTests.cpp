@@ -0,0 +1,139 @@
+#include "RenderGraph/RenderGraphAllocator.h"
+
+static bool IsAligned(const void* Ptr, size_t Alignment)
+{
+	return reinterpret_cast<std::uintptr_t>(Ptr) % Alignment == 0;
+}
+
+TEST(RenderGraphAllocator, AllocationsAreAlignedAndDisjoint)
+{
+	RenderGraphAllocator Allocator(1024);
+
+	auto* a = static_cast<BYTE*>(Allocator.Allocate(3, 1));
+	auto* b = static_cast<BYTE*>(Allocator.Allocate(8, 8));
+	auto* c = static_cast<BYTE*>(Allocator.Allocate(64, 64));
+
+	EXPECT_TRUE(IsAligned(b, 8));
+	EXPECT_TRUE(IsAligned(c, 64));
+	EXPECT_GE(b, a + 3);
+	EXPECT_GE(c, b + 8);
+	EXPECT_EQ(Allocator.GetNumBlocks(), 1u);
+}
+
+TEST(RenderGraphAllocator, FullBlockChainsANewOne)
+{
+	RenderGraphAllocator Allocator(256);
+
+	std::vector<BYTE*> Allocations;
+	for (int i = 0; i < 64; ++i)
+	{
+		auto* Allocation = static_cast<BYTE*>(Allocator.Allocate(48, 16));
+		std::memset(Allocation, i, 48);
+		Allocations.push_back(Allocation);
+	}
+
+	EXPECT_GT(Allocator.GetNumBlocks(), 1u);
+	EXPECT_GE(Allocator.GetCapacity(), 64u * 48);
+	EXPECT_EQ(Allocator.GetMemoryUsage(), 64u * 48);
+
+	// Chaining must not move or overwrite earlier allocations
+	for (int i = 0; i < 64; ++i)
+	{
+		EXPECT_TRUE(IsAligned(Allocations[i], 16));
+		EXPECT_EQ(Allocations[i][0], BYTE(i));
+		EXPECT_EQ(Allocations[i][47], BYTE(i));
+	}
+}
+
+TEST(RenderGraphAllocator, OversizedAllocationGetsItsOwnBlock)
+{
+	RenderGraphAllocator Allocator(256);
+
+	std::ignore	  = Allocator.Allocate(16, 16);
+	auto* Large	  = static_cast<BYTE*>(Allocator.Allocate(4096, 256));
+	std::memset(Large, 0xff, 4096);
+
+	EXPECT_TRUE(IsAligned(Large, 256));
+	EXPECT_EQ(Allocator.GetNumBlocks(), 2u);
+	EXPECT_GE(Allocator.GetCapacity(), 256u + 4096);
+}
+
+TEST(RenderGraphAllocator, ResetMergesTheChain)
+{
+	RenderGraphAllocator Allocator(256);
+	for (int i = 0; i < 32; ++i)
+	{
+		std::ignore = Allocator.Allocate(100, 4);
+	}
+	ASSERT_GT(Allocator.GetNumBlocks(), 1u);
+	size_t Capacity = Allocator.GetCapacity();
+
+	Allocator.Reset();
+	EXPECT_EQ(Allocator.GetNumBlocks(), 1u);
+	EXPECT_EQ(Allocator.GetCapacity(), Capacity);
+	EXPECT_EQ(Allocator.GetMemoryUsage(), 0u);
+
+	// The same frame fits without chaining again
+	for (int i = 0; i < 32; ++i)
+	{
+		std::ignore = Allocator.Allocate(100, 4);
+	}
+	EXPECT_EQ(Allocator.GetNumBlocks(), 1u);
+}
+
+TEST(RenderGraphAllocator, ResetReusesTheBlock)
+{
+	RenderGraphAllocator Allocator(1024);
+	void*				 First = Allocator.Allocate(64, 16);
+	Allocator.Reset();
+	EXPECT_EQ(Allocator.Allocate(64, 16), First);
+}
+
+TEST(RenderGraphAllocator, VectorsGrowAcrossBlocks)
+{
+	RenderGraphAllocator Allocator(128);
+
+	RgVector<UINT64> Vector(Allocator);
+	for (UINT64 i = 0; i < 1000; ++i)
+	{
+		Vector.push_back(i);
+	}
+
+	EXPECT_GT(Allocator.GetNumBlocks(), 1u);
+	for (UINT64 i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(Vector[i], i);
+	}
+}
+
+TEST(RenderGraphAllocator, ConstructAndDestruct)
+{
+	struct Counted
+	{
+		explicit Counted(int& Count)
+			: Count(Count)
+		{
+			Count++;
+		}
+		~Counted() { Count--; }
+
+		int& Count;
+	};
+
+	RenderGraphAllocator Allocator(64);
+	int					 Count = 0;
+
+	std::vector<Counted*> Objects;
+	for (int i = 0; i < 16; ++i)
+	{
+		Objects.push_back(Allocator.Construct<Counted>(Count));
+		EXPECT_TRUE(IsAligned(Objects.back(), 16));
+	}
+	EXPECT_EQ(Count, 16);
+
+	for (auto Object : Objects)
+	{
+		RenderGraphAllocator::Destruct(Object);
+	}
+	EXPECT_EQ(Count, 0);
+}
@@ -0,0 +1,209 @@
+#include "RenderGraph/RenderGraphAllocator.h"
+#include "RenderGraph/RenderGraphCompiler.h"
+#include "Benchmark.h"
+
+// Declares and compiles frames of 10, 100 and 1000 passes without a device, the same way RenderGraph::Setup does:
+// passes and their reads/writes are allocated from RenderGraphAllocator, then culled and ordered through the producer table.
+
+struct BenchmarkPass
+{
+	explicit BenchmarkPass(RenderGraphAllocator& Allocator)
+		: Reads(Allocator)
+		, Writes(Allocator)
+	{
+	}
+
+	RgVector<RgResourceVersion> Reads;
+	RgVector<RgResourceVersion> Writes;
+};
+
+struct BenchmarkFrame
+{
+	std::vector<BenchmarkPass*> Passes;
+	std::vector<std::size_t>	Versions; // Latest version of every resource
+
+	std::size_t Create()
+	{
+		Versions.push_back(0);
+		return Versions.size() - 1;
+	}
+
+	RgResourceVersion Read(std::size_t Resource) const { return { Resource, Versions[Resource] }; }
+	RgResourceVersion Write(std::size_t Resource) { return { Resource, ++Versions[Resource] }; }
+};
+
+// Shaped like a deferred frame: a gbuffer, per light shadow passes read by lighting,
+// a per mip bloom chain and a few post passes, with some debug passes nothing reads that get culled
+static void DeclareFrame(RenderGraphAllocator& Allocator, BenchmarkFrame& Frame, std::size_t NumPasses)
+{
+	auto AddPass = [&]() -> BenchmarkPass&
+	{
+		BenchmarkPass* Pass = Allocator.Construct<BenchmarkPass>(Allocator);
+		Frame.Passes.push_back(Pass);
+		return *Pass;
+	};
+
+	std::size_t Albedo = Frame.Create(), Normal = Frame.Create(), Depth = Frame.Create();
+	{
+		BenchmarkPass& GBuffer = AddPass();
+		GBuffer.Writes.push_back(Frame.Write(Albedo));
+		GBuffer.Writes.push_back(Frame.Write(Normal));
+		GBuffer.Writes.push_back(Frame.Write(Depth));
+	}
+
+	std::size_t NumFixed   = 4;
+	std::size_t NumDebug   = NumPasses / 20;
+	std::size_t NumShadows = (NumPasses - std::min(NumPasses, NumFixed + NumDebug)) / 2;
+	std::size_t NumBloom   = NumPasses - std::min(NumPasses, NumFixed + NumDebug + NumShadows);
+
+	std::vector<std::size_t> ShadowMaps;
+	for (std::size_t i = 0; i < NumShadows; ++i)
+	{
+		std::size_t ShadowMap = ShadowMaps.emplace_back(Frame.Create());
+		AddPass().Writes.push_back(Frame.Write(ShadowMap));
+	}
+
+	std::size_t Lighting = Frame.Create();
+	{
+		BenchmarkPass& Pass = AddPass();
+		Pass.Reads.push_back(Frame.Read(Albedo));
+		Pass.Reads.push_back(Frame.Read(Normal));
+		Pass.Reads.push_back(Frame.Read(Depth));
+		for (std::size_t ShadowMap : ShadowMaps)
+		{
+			Pass.Reads.push_back(Frame.Read(ShadowMap));
+		}
+		Pass.Writes.push_back(Frame.Write(Lighting));
+	}
+
+	std::size_t Bloom = Frame.Create();
+	for (std::size_t i = 0; i < NumBloom; ++i)
+	{
+		BenchmarkPass& Pass = AddPass();
+		Pass.Reads.push_back(Frame.Read(i == 0 ? Lighting : Bloom));
+		Pass.Writes.push_back(Frame.Write(Bloom));
+	}
+
+	for (std::size_t i = 0; i < NumDebug; ++i)
+	{
+		BenchmarkPass& Pass = AddPass();
+		Pass.Reads.push_back(Frame.Read(Depth));
+		Pass.Writes.push_back(Frame.Write(Frame.Create()));
+	}
+
+	std::size_t Output = Frame.Create();
+	{
+		BenchmarkPass& Tonemap = AddPass();
+		Tonemap.Reads.push_back(Frame.Read(Lighting));
+		Tonemap.Reads.push_back(Frame.Read(Bloom));
+		Tonemap.Writes.push_back(Frame.Write(Output));
+	}
+	{
+		BenchmarkPass& Epilogue = AddPass();
+		Epilogue.Reads.push_back(Frame.Read(Output));
+	}
+}
+
+struct BenchmarkResult
+{
+	std::size_t NumPasses;
+	std::size_t NumAlive;
+	std::size_t NumEdges;
+	int			NumLevels;
+	std::size_t NumBlocks;
+	double		MicrosecondsPerFrame;
+};
+
+static BenchmarkResult Run(std::size_t NumPasses, int Iterations)
+{
+	// Same block size as the renderer
+	RenderGraphAllocator Allocator(64 * 1024);
+	RgProducerTable		 Producers;
+	BenchmarkResult		 Result = {};
+
+	Result.MicrosecondsPerFrame = TimePerIteration<std::micro>(
+		Iterations,
+		[&]()
+		{
+			Allocator.Reset();
+
+			BenchmarkFrame Frame;
+			DeclareFrame(Allocator, Frame, NumPasses);
+			Result.NumBlocks = Allocator.GetNumBlocks();
+
+			auto ForEachRead = [&](std::size_t i, auto&& Callback)
+			{
+				for (auto Read : Frame.Passes[i]->Reads)
+				{
+					Callback(Read);
+				}
+			};
+			auto ForEachWrite = [&](std::size_t i, auto&& Callback)
+			{
+				for (auto Write : Frame.Passes[i]->Writes)
+				{
+					Callback(Write);
+				}
+			};
+
+			// Cull, then compile the passes that are left
+			Producers.Build(Frame.Versions.size(), Frame.Passes.size(), ForEachWrite);
+			std::vector<bool> Alive(Frame.Passes.size(), false);
+			Alive.back() = true;
+			Producers.PropagateAlive(Alive, ForEachRead);
+
+			std::vector<BenchmarkPass*> AlivePasses;
+			for (std::size_t i = 0; i < Frame.Passes.size(); ++i)
+			{
+				if (Alive[i])
+				{
+					AlivePasses.push_back(Frame.Passes[i]);
+				}
+			}
+			Frame.Passes = std::move(AlivePasses);
+
+			Producers.Build(Frame.Versions.size(), Frame.Passes.size(), ForEachWrite);
+			RgDependencyGraph Graph = RgDependencyGraph::Build(Producers, Frame.Passes.size(), ForEachRead);
+
+			Result.NumPasses = Alive.size();
+			Result.NumAlive	 = Frame.Passes.size();
+			Result.NumEdges	 = 0;
+			for (const auto& Edges : Graph.AdjacencyLists)
+			{
+				Result.NumEdges += Edges.size();
+			}
+			Result.NumLevels = *std::ranges::max_element(Graph.Distances) + 1;
+
+			for (auto Pass : Frame.Passes)
+			{
+				RenderGraphAllocator::Destruct(Pass);
+			}
+		});
+	return Result;
+}
+
+int main(int argc, char** argv)
+{
+	int Iterations = ParseIterations(argc, argv, 1000);
+
+	BenchmarkTable Table({
+		{ "Passes", 8 },
+		{ "Alive", 8 },
+		{ "Edges", 8 },
+		{ "Levels", 8 },
+		{ "Blocks", 8 },
+		{ "us/frame", 14 },
+	});
+	for (std::size_t NumPasses : { 10, 100, 1000 })
+	{
+		BenchmarkResult Result = Run(NumPasses, Iterations);
+		Table.Row(
+			Result.NumPasses,
+			Result.NumAlive,
+			Result.NumEdges,
+			Result.NumLevels,
+			Result.NumBlocks,
+			Result.MicrosecondsPerFrame);
+	}
+	return 0;
+}
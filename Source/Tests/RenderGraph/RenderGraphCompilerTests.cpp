@@ -0,0 +1,153 @@
+#include "RenderGraph/RenderGraphCompiler.h"
+
+struct TestPass
+{
+	std::vector<RgResourceVersion> Reads;
+	std::vector<RgResourceVersion> Writes;
+};
+
+static auto ForEachRead(const std::vector<TestPass>& Passes)
+{
+	return [&Passes](std::size_t i, auto&& Callback)
+	{
+		for (auto Read : Passes[i].Reads)
+		{
+			Callback(Read);
+		}
+	};
+}
+
+static auto ForEachWrite(const std::vector<TestPass>& Passes)
+{
+	return [&Passes](std::size_t i, auto&& Callback)
+	{
+		for (auto Write : Passes[i].Writes)
+		{
+			Callback(Write);
+		}
+	};
+}
+
+static RgDependencyGraph Compile(const std::vector<TestPass>& Passes, std::size_t NumResources)
+{
+	RgProducerTable Producers;
+	Producers.Build(NumResources, Passes.size(), ForEachWrite(Passes));
+	return RgDependencyGraph::Build(Producers, Passes.size(), ForEachRead(Passes));
+}
+
+TEST(RenderGraphCompiler, ProducersAreFoundPerVersion)
+{
+	std::vector<TestPass> Passes = {
+		{ {}, { { 0, 1 } } },
+		{ { { 0, 1 } }, { { 0, 2 }, { 1, 1 } } },
+		{ { { 0, 2 } }, { { 0, 3 } } },
+	};
+
+	RgProducerTable Producers;
+	Producers.Build(3, Passes.size(), ForEachWrite(Passes));
+
+	EXPECT_EQ(Producers.GetProducer({ 0, 0 }), SIZE_MAX); // Imported, never written
+	EXPECT_EQ(Producers.GetProducer({ 0, 1 }), 0u);
+	EXPECT_EQ(Producers.GetProducer({ 0, 2 }), 1u);
+	EXPECT_EQ(Producers.GetProducer({ 0, 3 }), 2u);
+	EXPECT_EQ(Producers.GetProducer({ 0, 4 }), SIZE_MAX);
+	EXPECT_EQ(Producers.GetProducer({ 1, 1 }), 1u);
+	EXPECT_EQ(Producers.GetProducer({ 2, 0 }), SIZE_MAX);
+	EXPECT_EQ(Producers.GetProducer({ 2, 5 }), SIZE_MAX);
+}
+
+TEST(RenderGraphCompiler, EdgesComeFromProducers)
+{
+	// 0 writes A, 1 writes B, 2 reads A and B twice, 3 reads what 2 wrote
+	std::vector<TestPass> Passes = {
+		{ {}, { { 0, 1 } } },
+		{ {}, { { 1, 1 } } },
+		{ { { 0, 1 }, { 1, 1 }, { 1, 1 } }, { { 2, 1 } } },
+		{ { { 2, 1 } }, {} },
+	};
+
+	RgDependencyGraph Graph = Compile(Passes, 3);
+	EXPECT_EQ(Graph.AdjacencyLists[0], std::vector<std::size_t>{ 2 });
+	EXPECT_EQ(Graph.AdjacencyLists[1], std::vector<std::size_t>{ 2 });
+	EXPECT_EQ(Graph.AdjacencyLists[2], std::vector<std::size_t>{ 3 });
+	EXPECT_TRUE(Graph.AdjacencyLists[3].empty());
+	EXPECT_EQ(Graph.Distances, (std::vector<int>{ 0, 0, 1, 2 }));
+}
+
+TEST(RenderGraphCompiler, ReadingOwnWriteIsNotAnEdge)
+{
+	std::vector<TestPass> Passes = {
+		{ { { 0, 1 } }, { { 0, 1 } } },
+	};
+
+	RgDependencyGraph Graph = Compile(Passes, 1);
+	EXPECT_TRUE(Graph.AdjacencyLists[0].empty());
+	EXPECT_EQ(Graph.Distances[0], 0);
+}
+
+TEST(RenderGraphCompiler, TopologicalOrderRespectsEveryEdge)
+{
+	// Declared out of order, 3 -> 1 -> 0 -> 2
+	std::vector<TestPass> Passes = {
+		{ { { 1, 1 } }, { { 2, 1 } } },
+		{ { { 0, 1 } }, { { 1, 1 } } },
+		{ { { 2, 1 } }, {} },
+		{ {}, { { 0, 1 } } },
+	};
+
+	RgDependencyGraph Graph = Compile(Passes, 3);
+	EXPECT_EQ(Graph.TopologicalOrder, (std::vector<std::size_t>{ 3, 1, 0, 2 }));
+	EXPECT_EQ(Graph.Distances, (std::vector<int>{ 2, 1, 3, 0 }));
+}
+
+TEST(RenderGraphCompiler, DistancesAreLongestPaths)
+{
+	// 0 -> 1 -> 2 -> 3 and 0 -> 3, 3 is at level 3, not 1
+	std::vector<TestPass> Passes = {
+		{ {}, { { 0, 1 } } },
+		{ { { 0, 1 } }, { { 1, 1 } } },
+		{ { { 1, 1 } }, { { 2, 1 } } },
+		{ { { 0, 1 }, { 2, 1 } }, {} },
+	};
+
+	RgDependencyGraph Graph = Compile(Passes, 3);
+	EXPECT_EQ(Graph.Distances, (std::vector<int>{ 0, 1, 2, 3 }));
+}
+
+TEST(RenderGraphCompiler, LongChainsDoNotRecurse)
+{
+	constexpr std::size_t NumPasses = 100000;
+
+	std::vector<TestPass> Passes(NumPasses);
+	Passes[0].Writes = { { 0, 1 } };
+	for (std::size_t i = 1; i < NumPasses; ++i)
+	{
+		Passes[i].Reads	 = { { 0, i } };
+		Passes[i].Writes = { { 0, i + 1 } };
+	}
+
+	RgDependencyGraph Graph = Compile(Passes, 1);
+	ASSERT_EQ(Graph.TopologicalOrder.size(), NumPasses);
+	EXPECT_EQ(Graph.TopologicalOrder.front(), 0u);
+	EXPECT_EQ(Graph.TopologicalOrder.back(), NumPasses - 1);
+	EXPECT_EQ(Graph.Distances.back(), int(NumPasses - 1));
+}
+
+TEST(RenderGraphCompiler, PropagateAliveFollowsReads)
+{
+	// 0 -> 2 -> 3 (root), 1 is only read by 4 which is not a root
+	std::vector<TestPass> Passes = {
+		{ {}, { { 0, 1 } } },
+		{ {}, { { 1, 1 } } },
+		{ { { 0, 1 } }, { { 2, 1 } } },
+		{ { { 2, 1 } }, {} },
+		{ { { 1, 1 } }, {} },
+	};
+
+	RgProducerTable Producers;
+	Producers.Build(3, Passes.size(), ForEachWrite(Passes));
+
+	std::vector<bool> Alive = { false, false, false, true, false };
+	Producers.PropagateAlive(Alive, ForEachRead(Passes));
+	EXPECT_EQ(Alive, (std::vector<bool>{ true, false, true, true, false }));
+}
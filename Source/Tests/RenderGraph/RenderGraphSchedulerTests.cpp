@@ -0,0 +1,211 @@
+#include "RenderGraph/RenderGraphScheduler.h"
+
+// Stands in for the worker command contexts, every bucket records its passes into a command list of its own
+// and EndRecording submits the lists in bucket order like RgLevelRecorder does
+class MockRecorder final : public IRgCommandRecorder
+{
+public:
+	void BeginRecording(std::size_t NumBuckets) override
+	{
+		BeginThread = std::this_thread::get_id();
+		CommandLists.assign(NumBuckets, {});
+		RecordThreads.assign(NumBuckets, {});
+		RecordCounts = std::vector<std::atomic<int>>(NumBuckets);
+		NumBegins++;
+	}
+
+	void RecordBucket(std::size_t BucketIndex, RgPassBucket Bucket) override
+	{
+		ASSERT_LT(BucketIndex, CommandLists.size());
+		RecordCounts[BucketIndex]++;
+		RecordThreads[BucketIndex] = std::this_thread::get_id();
+		for (std::size_t Pass = Bucket.Begin; Pass < Bucket.End; ++Pass)
+		{
+			CommandLists[BucketIndex].push_back(Pass);
+		}
+	}
+
+	void EndRecording(std::size_t NumBuckets) override
+	{
+		EndThread = std::this_thread::get_id();
+		EXPECT_EQ(NumBuckets, CommandLists.size());
+		for (const auto& CommandList : CommandLists)
+		{
+			Submitted.insert(Submitted.end(), CommandList.begin(), CommandList.end());
+		}
+		NumEnds++;
+	}
+
+	std::thread::id						  BeginThread;
+	std::thread::id						  EndThread;
+	std::vector<std::vector<std::size_t>> CommandLists;
+	std::vector<std::thread::id>		  RecordThreads;
+	std::vector<std::atomic<int>>		  RecordCounts;
+	std::vector<std::size_t>			  Submitted; // Passes in the order the queue executes them
+	int									  NumBegins = 0;
+	int									  NumEnds   = 0;
+};
+
+static std::vector<std::size_t> Iota(std::size_t Count)
+{
+	std::vector<std::size_t> Result(Count);
+	std::iota(Result.begin(), Result.end(), 0);
+	return Result;
+}
+
+TEST(RenderGraphScheduler, PartitionCoversPassesContiguously)
+{
+	for (std::size_t NumPasses = 1; NumPasses < 64; ++NumPasses)
+	{
+		for (std::size_t MaxBuckets = 1; MaxBuckets < 10; ++MaxBuckets)
+		{
+			std::vector<RgPassBucket> Buckets = RgScheduler::Partition(NumPasses, MaxBuckets);
+			ASSERT_FALSE(Buckets.empty());
+			EXPECT_LE(Buckets.size(), MaxBuckets);
+			EXPECT_EQ(Buckets.size(), std::min(NumPasses, MaxBuckets));
+
+			EXPECT_EQ(Buckets.front().Begin, 0u);
+			EXPECT_EQ(Buckets.back().End, NumPasses);
+			auto [Smallest, Largest] = std::ranges::minmax(Buckets, {}, &RgPassBucket::Size);
+			EXPECT_LE(Largest.Size() - Smallest.Size(), 1u);
+			for (std::size_t i = 0; i < Buckets.size(); ++i)
+			{
+				EXPECT_GT(Buckets[i].Size(), 0u);
+				if (i > 0)
+				{
+					EXPECT_EQ(Buckets[i].Begin, Buckets[i - 1].End);
+				}
+			}
+		}
+	}
+}
+
+TEST(RenderGraphScheduler, PartitionPutsTheRemainderFirst)
+{
+	std::vector<RgPassBucket> Buckets = RgScheduler::Partition(11, 4);
+	ASSERT_EQ(Buckets.size(), 4u);
+	EXPECT_EQ(Buckets[0].Size(), 3u);
+	EXPECT_EQ(Buckets[1].Size(), 3u);
+	EXPECT_EQ(Buckets[2].Size(), 3u);
+	EXPECT_EQ(Buckets[3].Size(), 2u);
+}
+
+TEST(RenderGraphScheduler, PartitionHonorsMinPassesPerBucket)
+{
+	// Too few passes to be worth a worker command list each
+	EXPECT_EQ(RgScheduler::Partition(7, 8, 4).size(), 1u);
+	EXPECT_EQ(RgScheduler::Partition(8, 8, 4).size(), 2u);
+	EXPECT_EQ(RgScheduler::Partition(100, 8, 4).size(), 8u);
+
+	for (const auto& Bucket : RgScheduler::Partition(17, 8, 4))
+	{
+		EXPECT_GE(Bucket.Size(), 4u);
+	}
+}
+
+TEST(RenderGraphScheduler, PartitionEdgeCases)
+{
+	EXPECT_TRUE(RgScheduler::Partition(0, 4).empty());
+	EXPECT_EQ(RgScheduler::Partition(5, 0).size(), 1u);
+	EXPECT_EQ(RgScheduler::Partition(5, 4, 0).size(), 4u);
+}
+
+TEST(RenderGraphScheduler, ExecuteWithoutPassesRecordsNothing)
+{
+	RgScheduler	 Scheduler(3);
+	MockRecorder Recorder;
+	EXPECT_EQ(Scheduler.Execute(Recorder, 0), 0u);
+	EXPECT_EQ(Recorder.NumBegins, 0);
+	EXPECT_EQ(Recorder.NumEnds, 0);
+}
+
+TEST(RenderGraphScheduler, ExecuteRecordsEveryBucketOnce)
+{
+	RgScheduler Scheduler(3);
+	ASSERT_EQ(Scheduler.GetMaxConcurrency(), 4u);
+
+	MockRecorder Recorder;
+	std::size_t	 NumBuckets = Scheduler.Execute(Recorder, 10);
+
+	EXPECT_EQ(NumBuckets, 4u);
+	EXPECT_EQ(Recorder.NumBegins, 1);
+	EXPECT_EQ(Recorder.NumEnds, 1);
+	for (std::size_t i = 0; i < NumBuckets; ++i)
+	{
+		EXPECT_EQ(Recorder.RecordCounts[i], 1) << "bucket " << i;
+	}
+
+	// Worker command lists hold the contiguous buckets Partition produces
+	std::vector<RgPassBucket> Buckets = RgScheduler::Partition(10, 4);
+	for (std::size_t i = 0; i < NumBuckets; ++i)
+	{
+		std::vector<std::size_t> Expected(Buckets[i].Size());
+		std::iota(Expected.begin(), Expected.end(), Buckets[i].Begin);
+		EXPECT_EQ(Recorder.CommandLists[i], Expected) << "bucket " << i;
+	}
+}
+
+TEST(RenderGraphScheduler, ExecuteKeepsBeginEndAndTheFirstBucketOnTheCallingThread)
+{
+	RgScheduler	 Scheduler(3);
+	MockRecorder Recorder;
+	std::ignore = Scheduler.Execute(Recorder, 16);
+
+	std::thread::id Caller = std::this_thread::get_id();
+	EXPECT_EQ(Recorder.BeginThread, Caller);
+	EXPECT_EQ(Recorder.EndThread, Caller);
+	EXPECT_EQ(Recorder.RecordThreads[0], Caller);
+	for (std::size_t i = 1; i < Recorder.RecordThreads.size(); ++i)
+	{
+		EXPECT_NE(Recorder.RecordThreads[i], Caller) << "bucket " << i;
+	}
+}
+
+TEST(RenderGraphScheduler, SubmissionPreservesPassOrder)
+{
+	RgScheduler Scheduler(5);
+	for (std::size_t NumPasses : { 1, 2, 5, 6, 7, 31, 100 })
+	{
+		for (std::size_t MinPassesPerBucket : { 1, 2, 4 })
+		{
+			MockRecorder Recorder;
+			std::ignore = Scheduler.Execute(Recorder, NumPasses, MinPassesPerBucket);
+			EXPECT_EQ(Recorder.Submitted, Iota(NumPasses)) << NumPasses << " passes, at least " << MinPassesPerBucket << " per bucket";
+		}
+	}
+}
+
+TEST(RenderGraphScheduler, SingleBucketStaysOnTheCallingThread)
+{
+	RgScheduler	 Scheduler(3);
+	MockRecorder Recorder;
+	EXPECT_EQ(Scheduler.Execute(Recorder, 3, 4), 1u);
+	EXPECT_EQ(Recorder.RecordThreads[0], std::this_thread::get_id());
+	EXPECT_EQ(Recorder.Submitted, Iota(3));
+}
+
+TEST(RenderGraphScheduler, WithoutWorkersEverythingIsRecordedInline)
+{
+	RgScheduler	 Scheduler(0);
+	MockRecorder Recorder;
+	EXPECT_EQ(Scheduler.Execute(Recorder, 50), 1u);
+	EXPECT_EQ(Recorder.Submitted, Iota(50));
+}
+
+TEST(RenderGraphScheduler, RepeatedLevelsDoNotLoseOrRepeatBuckets)
+{
+	// Alternating bucket counts leave some workers idle every other level
+	RgScheduler Scheduler(7);
+	for (int Level = 0; Level < 2000; ++Level)
+	{
+		std::size_t	 NumPasses = Level % 2 == 0 ? 3 : 64;
+		MockRecorder Recorder;
+		std::size_t	 NumBuckets = Scheduler.Execute(Recorder, NumPasses);
+		ASSERT_EQ(NumBuckets, std::min<std::size_t>(NumPasses, 8));
+		for (std::size_t i = 0; i < NumBuckets; ++i)
+		{
+			ASSERT_EQ(Recorder.RecordCounts[i], 1) << "level " << Level << ", bucket " << i;
+		}
+		ASSERT_EQ(Recorder.Submitted, Iota(NumPasses)) << "level " << Level;
+	}
+}
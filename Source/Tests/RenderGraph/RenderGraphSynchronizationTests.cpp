@@ -0,0 +1,236 @@
+#include "RenderGraph/RenderGraphSynchronization.h"
+
+static RgSyncNode MakeNode(std::size_t Queue, std::vector<std::size_t> Predecessors = {})
+{
+	return { Queue, std::move(Predecessors) };
+}
+
+static std::size_t NumSignals(const RgSyncPlan& Plan)
+{
+	return std::ranges::count(Plan.Signals, true);
+}
+
+TEST(RenderGraphSynchronization, SameQueueEdgesNeedNoSync)
+{
+	const RgSyncNode Nodes[] = {
+		MakeNode(0),
+		MakeNode(0, { 0 }),
+		MakeNode(1),
+		MakeNode(1, { 2 }),
+	};
+
+	RgSyncPlan Plan = RgSyncPlanner::Plan(Nodes, 2);
+	EXPECT_EQ(Plan.NumCrossQueueEdges, 0u);
+	EXPECT_EQ(Plan.NumWaits, 0u);
+	EXPECT_EQ(NumSignals(Plan), 0u);
+}
+
+TEST(RenderGraphSynchronization, CrossQueueEdgeSignalsThePredecessor)
+{
+	const RgSyncNode Nodes[] = {
+		MakeNode(0),
+		MakeNode(1, { 0 }),
+	};
+
+	RgSyncPlan Plan = RgSyncPlanner::Plan(Nodes, 2);
+	EXPECT_EQ(Plan.NumCrossQueueEdges, 1u);
+	EXPECT_EQ(Plan.NumWaits, 1u);
+	EXPECT_EQ(Plan.Signals, (std::vector<bool>{ true, false }));
+	ASSERT_EQ(Plan.Waits[1].size(), 1u);
+	EXPECT_EQ(Plan.Waits[1][0].Queue, 0u);
+	EXPECT_EQ(Plan.Waits[1][0].Node, 0u);
+	EXPECT_TRUE(Plan.Waits[0].empty());
+}
+
+TEST(RenderGraphSynchronization, EarlierWaitCoversLaterEdges)
+{
+	// 2 already waited for 1, 3 runs after 2 on the same queue so its edge to 1 is covered
+	const RgSyncNode Nodes[] = {
+		MakeNode(0),
+		MakeNode(1),
+		MakeNode(0, { 1 }),
+		MakeNode(0, { 1 }),
+	};
+
+	RgSyncPlan Plan = RgSyncPlanner::Plan(Nodes, 2);
+	EXPECT_EQ(Plan.NumCrossQueueEdges, 2u);
+	EXPECT_EQ(Plan.NumWaits, 1u);
+	EXPECT_EQ(Plan.Waits[2].size(), 1u);
+	EXPECT_TRUE(Plan.Waits[3].empty());
+}
+
+TEST(RenderGraphSynchronization, WaitingOnALaterNodeCoversEarlierOnes)
+{
+	// Nodes of a queue complete in order, 3 only waits on the latest node of queue 1 it depends on
+	const RgSyncNode Nodes[] = {
+		MakeNode(1),
+		MakeNode(1),
+		MakeNode(0),
+		MakeNode(0, { 0, 1 }),
+	};
+
+	RgSyncPlan Plan = RgSyncPlanner::Plan(Nodes, 2);
+	EXPECT_EQ(Plan.NumCrossQueueEdges, 2u);
+	EXPECT_EQ(Plan.NumWaits, 1u);
+	ASSERT_EQ(Plan.Waits[3].size(), 1u);
+	EXPECT_EQ(Plan.Waits[3][0].Node, 1u);
+	EXPECT_EQ(Plan.Signals, (std::vector<bool>{ false, true, false, false }));
+}
+
+TEST(RenderGraphSynchronization, TransitiveWaitsAreEliminated)
+{
+	// 1 waits for 0 on queue 0, 2 on queue 2 depends on both 0 and 1, waiting for 1 covers 0 through its clock
+	const RgSyncNode Nodes[] = {
+		MakeNode(0),
+		MakeNode(1, { 0 }),
+		MakeNode(2, { 0, 1 }),
+	};
+
+	RgSyncPlan Plan = RgSyncPlanner::Plan(Nodes, 3);
+	EXPECT_EQ(Plan.NumCrossQueueEdges, 3u);
+	EXPECT_EQ(Plan.NumWaits, 2u);
+	ASSERT_EQ(Plan.Waits[2].size(), 1u);
+	EXPECT_EQ(Plan.Waits[2][0].Node, 1u);
+}
+
+TEST(RenderGraphSynchronization, TransitiveWaitsThroughTheOtherQueue)
+{
+	// Queue 1 waited for 1 which is after 0 on queue 0, so 3 on queue 1 does not need to wait for 0 again
+	const RgSyncNode Nodes[] = {
+		MakeNode(0),
+		MakeNode(0),
+		MakeNode(1, { 1 }),
+		MakeNode(1, { 0 }),
+	};
+
+	RgSyncPlan Plan = RgSyncPlanner::Plan(Nodes, 2);
+	EXPECT_EQ(Plan.NumWaits, 1u);
+	EXPECT_TRUE(Plan.Waits[3].empty());
+	EXPECT_EQ(Plan.Signals, (std::vector<bool>{ false, true, false, false }));
+}
+
+TEST(RenderGraphSynchronization, WaitsDoNotLeakAcrossQueues)
+{
+	// Queue 0 waited for 1, that says nothing about queue 2 which still has to wait for it
+	const RgSyncNode Nodes[] = {
+		MakeNode(1),
+		MakeNode(0, { 0 }),
+		MakeNode(2, { 0 }),
+	};
+
+	RgSyncPlan Plan = RgSyncPlanner::Plan(Nodes, 3);
+	EXPECT_EQ(Plan.NumWaits, 2u);
+	EXPECT_EQ(Plan.Waits[1].size(), 1u);
+	EXPECT_EQ(Plan.Waits[2].size(), 1u);
+	EXPECT_EQ(NumSignals(Plan), 1u);
+}
+
+TEST(RenderGraphSynchronization, LevelNodesFollowTheRecordingOrder)
+{
+	std::vector<RgSyncLevel> Levels(2);
+	Levels[0].HasAsyncCompute = true;
+
+	std::vector<RgSyncNode> Nodes = RgSyncPlanner::BuildLevelNodes(Levels, 0);
+	ASSERT_EQ(Nodes.size(), 2 * RgSyncPlanner::LevelNode_Count + 1);
+
+	for (std::size_t i = 0; i < Levels.size(); ++i)
+	{
+		const RgSyncNode& Barriers	   = Nodes[RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_Barriers)];
+		const RgSyncNode& AsyncCompute = Nodes[RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_AsyncCompute)];
+		const RgSyncNode& Graphics	   = Nodes[RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_Graphics)];
+		EXPECT_EQ(Barriers.Queue, RgSyncQueue_Graphics);
+		EXPECT_EQ(AsyncCompute.Queue, RgSyncQueue_AsyncCompute);
+		EXPECT_EQ(Graphics.Queue, RgSyncQueue_Graphics);
+
+		// Both queues run a level's passes after its barriers
+		std::size_t BarrierNode = RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_Barriers);
+		EXPECT_EQ(Graphics.Predecessors, std::vector<std::size_t>{ BarrierNode });
+		EXPECT_EQ(AsyncCompute.Predecessors.size(), Levels[i].HasAsyncCompute ? 1u : 0u);
+	}
+
+	EXPECT_EQ(Nodes.back().Queue, RgSyncQueue_Graphics);
+	EXPECT_EQ(RgSyncPlanner::GetFrameEndNode(Levels.size()), Nodes.size() - 1);
+}
+
+TEST(RenderGraphSynchronization, BarriersWaitForTheLastAsyncComputeUse)
+{
+	// Resource 0 is used on the async compute queue in levels 0 and 1, then transitioned in level 2
+	std::vector<RgSyncLevel> Levels(3);
+	Levels[0]				   = { {}, { 0 }, true };
+	Levels[1]				   = { {}, { 0, 1 }, true };
+	Levels[2].BarrierResources = { 0 };
+
+	std::vector<RgSyncNode> Nodes		= RgSyncPlanner::BuildLevelNodes(Levels, 2);
+	std::size_t				BarrierNode = RgSyncPlanner::GetLevelNode(2, RgSyncPlanner::LevelNode_Barriers);
+	EXPECT_EQ(Nodes[BarrierNode].Predecessors, std::vector<std::size_t>{ RgSyncPlanner::GetLevelNode(1, RgSyncPlanner::LevelNode_AsyncCompute) });
+
+	// Barriers of resources the async compute queue never touched do not wait
+	EXPECT_TRUE(Nodes[RgSyncPlanner::GetLevelNode(1, RgSyncPlanner::LevelNode_Barriers)].Predecessors.empty());
+}
+
+TEST(RenderGraphSynchronization, AsyncComputeJoinsAtFrameEnd)
+{
+	// Nothing on the graphics queue depends on the async compute work, it is still waited on before the frame ends
+	std::vector<RgSyncLevel> Levels(2);
+	Levels[0] = { {}, { 0 }, true };
+
+	std::vector<RgSyncNode> Nodes	 = RgSyncPlanner::BuildLevelNodes(Levels, 1);
+	RgSyncPlan				Plan	 = RgSyncPlanner::Plan(Nodes, RgSyncQueue_Count);
+	std::size_t				FrameEnd = RgSyncPlanner::GetFrameEndNode(Levels.size());
+	std::size_t				Async	 = RgSyncPlanner::GetLevelNode(0, RgSyncPlanner::LevelNode_AsyncCompute);
+
+	ASSERT_EQ(Plan.Waits[FrameEnd].size(), 1u);
+	EXPECT_EQ(Plan.Waits[FrameEnd][0].Queue, RgSyncQueue_AsyncCompute);
+	EXPECT_EQ(Plan.Waits[FrameEnd][0].Node, Async);
+	EXPECT_TRUE(Plan.Signals[Async]);
+}
+
+TEST(RenderGraphSynchronization, FrameEndJoinIsElidedOnceTheGraphicsQueueWaited)
+{
+	// The barriers of level 1 already wait for the last async compute node
+	std::vector<RgSyncLevel> Levels(2);
+	Levels[0]				   = { {}, { 0 }, true };
+	Levels[1].BarrierResources = { 0 };
+
+	std::vector<RgSyncNode> Nodes = RgSyncPlanner::BuildLevelNodes(Levels, 1);
+	RgSyncPlan				Plan  = RgSyncPlanner::Plan(Nodes, RgSyncQueue_Count);
+
+	EXPECT_EQ(Plan.Waits[RgSyncPlanner::GetLevelNode(1, RgSyncPlanner::LevelNode_Barriers)].size(), 1u);
+	EXPECT_TRUE(Plan.Waits[RgSyncPlanner::GetFrameEndNode(Levels.size())].empty());
+}
+
+TEST(RenderGraphSynchronization, NoJoinWithoutAsyncCompute)
+{
+	std::vector<RgSyncLevel> Levels(3);
+	Levels[1].BarrierResources = { 0 };
+
+	RgSyncPlan Plan = RgSyncPlanner::Plan(RgSyncPlanner::BuildLevelNodes(Levels, 1), RgSyncQueue_Count);
+	EXPECT_EQ(Plan.NumCrossQueueEdges, 0u);
+	EXPECT_EQ(Plan.NumWaits, 0u);
+	EXPECT_EQ(NumSignals(Plan), 0u);
+}
+
+TEST(RenderGraphSynchronization, AsyncComputeWaitsForItsLevelsBarriersOnce)
+{
+	// Every level transitions resources for its async compute passes on the graphics queue,
+	// the async compute queue waits for each level's barriers but never twice for the same one
+	std::vector<RgSyncLevel> Levels(4);
+	for (auto& Level : Levels)
+	{
+		Level = { { 0 }, { 0 }, true };
+	}
+
+	std::vector<RgSyncNode> Nodes = RgSyncPlanner::BuildLevelNodes(Levels, 1);
+	RgSyncPlan				Plan  = RgSyncPlanner::Plan(Nodes, RgSyncQueue_Count);
+
+	for (std::size_t i = 0; i < Levels.size(); ++i)
+	{
+		std::size_t Async = RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_AsyncCompute);
+		ASSERT_EQ(Plan.Waits[Async].size(), 1u);
+		EXPECT_EQ(Plan.Waits[Async][0].Node, RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_Barriers));
+		EXPECT_TRUE(Plan.Signals[RgSyncPlanner::GetLevelNode(i, RgSyncPlanner::LevelNode_Barriers)]);
+	}
+	// Besides those, the barriers of every later level wait for the previous level's async compute work
+	// and the frame end joins the last one
+	EXPECT_EQ(Plan.NumWaits, 2 * Levels.size());
+}
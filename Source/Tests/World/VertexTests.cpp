@@ -0,0 +1,226 @@
+#include "World/Vertex.h"
+
+using namespace DirectX;
+
+// Angle between two unit vectors in radians, atan2 stays accurate for nearly parallel vectors where acos does not
+static double AngleBetween(const XMFLOAT3& a, const XMFLOAT3& b)
+{
+	double Cross[3] = {
+		double(a.y) * b.z - double(a.z) * b.y,
+		double(a.z) * b.x - double(a.x) * b.z,
+		double(a.x) * b.y - double(a.y) * b.x,
+	};
+	double Dot = double(a.x) * b.x + double(a.y) * b.y + double(a.z) * b.z;
+	return std::atan2(std::sqrt(Cross[0] * Cross[0] + Cross[1] * Cross[1] + Cross[2] * Cross[2]), Dot);
+}
+
+static XMFLOAT3 Normalize(XMFLOAT3 v)
+{
+	XMStoreFloat3(&v, XMVector3Normalize(XMLoadFloat3(&v)));
+	return v;
+}
+
+// Spread evenly over the sphere, plus the axes and the octahedron's edges and corners where the fold is discontinuous
+static std::vector<XMFLOAT3> MakeNormals()
+{
+	std::vector<XMFLOAT3> Normals;
+
+	constexpr int	 NumSpiral	 = 20000;
+	constexpr double GoldenAngle = 2.39996322972865332;
+	for (int i = 0; i < NumSpiral; ++i)
+	{
+		double z = 1.0 - 2.0 * (i + 0.5) / NumSpiral;
+		double r = std::sqrt(1.0 - z * z);
+		Normals.emplace_back(float(r * std::cos(GoldenAngle * i)), float(r * std::sin(GoldenAngle * i)), float(z));
+	}
+
+	for (float x : { -1.0f, 0.0f, 1.0f })
+	{
+		for (float y : { -1.0f, 0.0f, 1.0f })
+		{
+			for (float z : { -1.0f, 0.0f, 1.0f })
+			{
+				if (x != 0.0f || y != 0.0f || z != 0.0f)
+				{
+					Normals.push_back(Normalize({ x, y, z }));
+				}
+			}
+		}
+	}
+
+	// Just below the equator, folded right at the border of the square
+	Normals.push_back(Normalize({ 1.0f, 1.0f, -1e-4f }));
+	Normals.push_back(Normalize({ -1.0f, 0.25f, -1e-6f }));
+	return Normals;
+}
+
+TEST(Vertex, OctahedralRoundTripIsExactBeforeQuantization)
+{
+	double MaxError = 0.0;
+	for (const XMFLOAT3& Normal : MakeNormals())
+	{
+		MaxError = std::max(MaxError, AngleBetween(Normal, OctahedralDecode(OctahedralEncode(Normal))));
+	}
+	EXPECT_LT(MaxError, 1e-5);
+}
+
+TEST(Vertex, EncodedNormalsStayInTheSquare)
+{
+	for (const XMFLOAT3& Normal : MakeNormals())
+	{
+		XMFLOAT2 Encoded = OctahedralEncode(Normal);
+		ASSERT_LE(std::abs(Encoded.x), 1.0f);
+		ASSERT_LE(std::abs(Encoded.y), 1.0f);
+	}
+}
+
+TEST(Vertex, UpperHemisphereMapsInsideTheDiamond)
+{
+	for (const XMFLOAT3& Normal : MakeNormals())
+	{
+		if (Normal.z < 0.0f)
+		{
+			continue;
+		}
+
+		// Projected onto the octahedron without folding, x and y keep their signs
+		XMFLOAT2 Encoded = OctahedralEncode(Normal);
+		float	 Sum	 = std::abs(Normal.x) + std::abs(Normal.y) + std::abs(Normal.z);
+		EXPECT_NEAR(Encoded.x, Normal.x / Sum, 1e-6f);
+		EXPECT_NEAR(Encoded.y, Normal.y / Sum, 1e-6f);
+		EXPECT_LE(std::abs(Encoded.x) + std::abs(Encoded.y), 1.0f + 1e-6f);
+	}
+}
+
+TEST(Vertex, LowerHemisphereIsFoldedOverTheDiagonals)
+{
+	for (const XMFLOAT3& Normal : MakeNormals())
+	{
+		if (Normal.z >= 0.0f)
+		{
+			continue;
+		}
+
+		// The fold reflects the projection over the edge of the diamond, into the corner of its quadrant
+		XMFLOAT2 Encoded = OctahedralEncode(Normal);
+		float	 Sum	 = std::abs(Normal.x) + std::abs(Normal.y) + std::abs(Normal.z);
+		EXPECT_NEAR(std::abs(Encoded.x), 1.0f - std::abs(Normal.y) / Sum, 1e-6f);
+		EXPECT_NEAR(std::abs(Encoded.y), 1.0f - std::abs(Normal.x) / Sum, 1e-6f);
+		EXPECT_GE(std::abs(Encoded.x) + std::abs(Encoded.y), 1.0f - 1e-6f);
+		EXPECT_EQ(Encoded.x >= 0.0f, Normal.x >= 0.0f);
+		EXPECT_EQ(Encoded.y >= 0.0f, Normal.y >= 0.0f);
+
+		EXPECT_LE(OctahedralDecode(Encoded).z, 0.0f);
+	}
+
+	// -Z lands on a corner
+	XMFLOAT2 Down = OctahedralEncode({ 0.0f, 0.0f, -1.0f });
+	EXPECT_EQ(std::abs(Down.x), 1.0f);
+	EXPECT_EQ(std::abs(Down.y), 1.0f);
+	EXPECT_NEAR(AngleBetween(OctahedralDecode(Down), { 0.0f, 0.0f, -1.0f }), 0.0, 1e-6);
+
+	// Every corner decodes to -Z
+	for (XMFLOAT2 Corner : { XMFLOAT2(1.0f, 1.0f), XMFLOAT2(-1.0f, 1.0f), XMFLOAT2(1.0f, -1.0f), XMFLOAT2(-1.0f, -1.0f) })
+	{
+		EXPECT_NEAR(AngleBetween(OctahedralDecode(Corner), { 0.0f, 0.0f, -1.0f }), 0.0, 1e-6);
+	}
+}
+
+TEST(Vertex, ZeroNormalDecodesToUp)
+{
+	XMFLOAT2 Encoded = OctahedralEncode({ 0.0f, 0.0f, 0.0f });
+	EXPECT_EQ(Encoded.x, 0.0f);
+	EXPECT_EQ(Encoded.y, 0.0f);
+
+	XMFLOAT3 Decoded = OctahedralDecode(Encoded);
+	EXPECT_EQ(Decoded.x, 0.0f);
+	EXPECT_EQ(Decoded.y, 0.0f);
+	EXPECT_EQ(Decoded.z, 1.0f);
+
+	Vertex Source = {};
+	Source.Normal = { 0.0f, 0.0f, 0.0f };
+
+	Vertex Unpacked = UnpackVertex(PackVertex(Source));
+	EXPECT_FALSE(std::isnan(Unpacked.Normal.x) || std::isnan(Unpacked.Normal.y) || std::isnan(Unpacked.Normal.z));
+	EXPECT_EQ(Unpacked.Normal.z, 1.0f);
+}
+
+TEST(Vertex, PackedNormalAngularError)
+{
+	// 16 bit snorm components step 2 / 65534 across the square, about 1e-4 radians on the sphere at worst
+	constexpr double MaxAllowedError = 1e-4;
+
+	double MaxError = 0.0, SumError = 0.0;
+	for (const XMFLOAT3& Normal : MakeNormals())
+	{
+		Vertex Source = {};
+		Source.Normal = Normal;
+
+		double Error = AngleBetween(Normal, UnpackVertex(PackVertex(Source)).Normal);
+		MaxError	 = std::max(MaxError, Error);
+		SumError += Error;
+	}
+	EXPECT_LT(MaxError, MaxAllowedError);
+	EXPECT_LT(SumError / MakeNormals().size(), MaxAllowedError / 2);
+}
+
+TEST(Vertex, UnpackedNormalsAreUnitLength)
+{
+	for (const XMFLOAT3& Normal : MakeNormals())
+	{
+		Vertex Source = {};
+		Source.Normal = Normal;
+
+		XMFLOAT3 Unpacked = UnpackVertex(PackVertex(Source)).Normal;
+		EXPECT_NEAR(std::sqrt(Unpacked.x * Unpacked.x + Unpacked.y * Unpacked.y + Unpacked.z * Unpacked.z), 1.0f, 1e-6f);
+	}
+}
+
+TEST(Vertex, PackedTextureCoordError)
+{
+	// A half has an 11 bit significand, rounding is off by at most half a unit in the last place, 2^-11 of the value
+	constexpr float MaxRelativeError = 1.0f / 2048.0f;
+
+	float MaxErrorInUnitRange = 0.0f;
+	for (int i = -4096; i <= 4096; ++i)
+	{
+		float u = float(i) / 1024.0f + 0.000123f;
+		float v = 1.0f - float(i) / 4096.0f;
+
+		Vertex Source		= {};
+		Source.TextureCoord = { u, v };
+		XMFLOAT2 Unpacked	= UnpackVertex(PackVertex(Source)).TextureCoord;
+
+		EXPECT_LE(std::abs(Unpacked.x - u), std::abs(u) * MaxRelativeError) << u;
+		EXPECT_LE(std::abs(Unpacked.y - v), std::abs(v) * MaxRelativeError) << v;
+		if (v >= 0.0f && v <= 1.0f)
+		{
+			MaxErrorInUnitRange = std::max(MaxErrorInUnitRange, std::abs(Unpacked.y - v));
+		}
+	}
+
+	// Within [0, 1] the error is at most half a unit in the last place of [0.5, 1)
+	EXPECT_LE(MaxErrorInUnitRange, 1.0f / 4096.0f);
+
+	// Exactly representable coordinates survive unchanged
+	for (float Exact : { 0.0f, 0.5f, 1.0f, 0.25f, 3.0f, -2.0f })
+	{
+		Vertex Source		= {};
+		Source.TextureCoord = { Exact, Exact };
+		XMFLOAT2 Unpacked	= UnpackVertex(PackVertex(Source)).TextureCoord;
+		EXPECT_EQ(Unpacked.x, Exact);
+		EXPECT_EQ(Unpacked.y, Exact);
+	}
+}
+
+TEST(Vertex, PackedPositionIsExact)
+{
+	Vertex Source	= {};
+	Source.Position = { 1234.5678f, -0.000123f, 1e6f };
+
+	PackedVertex Packed = PackVertex(Source);
+	EXPECT_EQ(std::memcmp(&Packed.Position, &Source.Position, sizeof(XMFLOAT3)), 0);
+
+	Vertex Unpacked = UnpackVertex(Packed);
+	EXPECT_EQ(std::memcmp(&Unpacked.Position, &Source.Position, sizeof(XMFLOAT3)), 0);
+}
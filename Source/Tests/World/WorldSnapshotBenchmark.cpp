@@ -0,0 +1,86 @@
+#include "WorldSnapshotWorld.h"
+#include "Benchmark.h"
+
+// Writes worlds of 1000, 10000 and 50000 actors to .khworld files in memory and loads them back the way
+// WorldArchive::LoadSnapshot does: validates the file, then reads every column from its attribute arrays. Validation
+// is timed on its own as well, it is the part of a load that doesn't depend on the component types.
+
+struct BenchmarkResult
+{
+	uint32_t NumActors;
+	double	 FileSizeInMiB;
+	double	 MillisecondsPerWrite;
+	double	 MillisecondsPerValidate;
+	double	 MillisecondsPerLoad;
+};
+
+static BenchmarkResult Run(uint32_t NumActors, int Iterations)
+{
+	const TestWorld World = MakeTestWorld(NumActors);
+
+	BenchmarkResult Result = {};
+	Result.NumActors	   = NumActors;
+
+	std::size_t Checksum = 0;
+
+	std::vector<BYTE> File;
+
+	Result.MillisecondsPerWrite = TimePerIteration<std::milli>(
+		Iterations,
+		[&]()
+		{
+			File = WriteTestWorld(World);
+			Checksum += File.size();
+		});
+	Result.FileSizeInMiB = double(File.size()) / (1024 * 1024);
+
+	Result.MillisecondsPerValidate = TimePerIteration<std::milli>(
+		Iterations,
+		[&]()
+		{
+			WorldSnapshotReader Reader(File);
+			Checksum += Reader.GetColumns().size();
+		});
+
+	Result.MillisecondsPerLoad = TimePerIteration<std::milli>(
+		Iterations,
+		[&]()
+		{
+			WorldSnapshotReader Reader(File);
+			if (!Reader.IsValid())
+			{
+				std::fprintf(stderr, "Generated file is not valid\n");
+				std::exit(1);
+			}
+
+			TestWorld Loaded = ReadTestWorld(Reader);
+			Checksum += Loaded.Cores.back().Name.size();
+		});
+
+	KeepChecksum(Checksum);
+	return Result;
+}
+
+int main(int argc, char** argv)
+{
+	int Iterations = ParseIterations(argc, argv, 100);
+
+	BenchmarkTable Table({
+		{ "Actors", 8 },
+		{ "MiB", 10 },
+		{ "ms/write", 14, 3 },
+		{ "ms/validate", 14, 3 },
+		{ "ms/load", 14, 3 },
+	});
+	for (uint32_t NumActors : { 1000, 10000, 50000 })
+	{
+		BenchmarkResult Result = Run(NumActors, NumActors >= 50000 ? std::max(Iterations / 10, 1) : Iterations);
+		Table.Row(
+			Result.NumActors,
+			Result.FileSizeInMiB,
+			Result.MillisecondsPerWrite,
+			Result.MillisecondsPerValidate,
+			Result.MillisecondsPerLoad);
+	}
+	return 0;
+}
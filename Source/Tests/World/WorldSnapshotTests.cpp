@@ -0,0 +1,347 @@
+#include "WorldSnapshotWorld.h"
+
+template<typename T>
+static T Peek(const std::vector<BYTE>& File, uint64_t Offset)
+{
+	T Value;
+	std::memcpy(&Value, File.data() + Offset, sizeof(T));
+	return Value;
+}
+
+template<typename T>
+static void Poke(std::vector<BYTE>& File, uint64_t Offset, const T& Value)
+{
+	std::memcpy(File.data() + Offset, &Value, sizeof(T));
+}
+
+static WorldSnapshotHeader GetHeader(const std::vector<BYTE>& File)
+{
+	return Peek<WorldSnapshotHeader>(File, 0);
+}
+
+// Offset of the Index-th column, or of an attribute, within the file
+static uint64_t ColumnOffset(const std::vector<BYTE>& File, uint32_t Index)
+{
+	return GetHeader(File).Columns.Offset + Index * sizeof(WorldSnapshotColumn);
+}
+
+static uint64_t AttributeOffset(const std::vector<BYTE>& File, uint32_t Index)
+{
+	return GetHeader(File).Attributes.Offset + Index * sizeof(WorldSnapshotAttribute);
+}
+
+TEST(WorldSnapshot, RoundTrip)
+{
+	TestWorld				World = MakeTestWorld(1000);
+	const std::vector<BYTE> File  = WriteTestWorld(World);
+
+	WorldSnapshotReader Reader(File);
+	ASSERT_TRUE(Reader.IsValid());
+	EXPECT_EQ(Reader.GetNumActors(), 1000u);
+	EXPECT_EQ(Reader.GetColumns().size(), 3u);
+	EXPECT_TRUE(ReadTestWorld(Reader) == World);
+
+	for (size_t i = 0; i < Reader.GetTextures().size(); ++i)
+	{
+		EXPECT_EQ(Reader.GetTextures()[i].OptionFlags, i % 8);
+	}
+}
+
+TEST(WorldSnapshot, RoundTripEmptyWorld)
+{
+	TestWorld				World = MakeTestWorld(0);
+	const std::vector<BYTE> File  = WriteTestWorld(World);
+
+	WorldSnapshotReader Reader(File);
+	ASSERT_TRUE(Reader.IsValid());
+	EXPECT_EQ(Reader.GetNumActors(), 0u);
+	EXPECT_TRUE(ReadTestWorld(Reader) == World);
+}
+
+TEST(WorldSnapshot, WritingIsDeterministic)
+{
+	TestWorld World = MakeTestWorld(500);
+	EXPECT_EQ(WriteTestWorld(World), WriteTestWorld(World));
+
+	// Finish hands over the file and starts the next one
+	WorldSnapshotWriter Writer;
+	Writer.AddMesh("Mesh");
+	std::vector<BYTE> First	 = Writer.Finish(0);
+	std::vector<BYTE> Second = Writer.Finish(0);
+	EXPECT_TRUE(WorldSnapshotReader(First).IsValid());
+	EXPECT_EQ(WorldSnapshotReader(First).GetMeshes().size(), 1u);
+	EXPECT_TRUE(WorldSnapshotReader(Second).IsValid());
+	EXPECT_TRUE(WorldSnapshotReader(Second).GetMeshes().empty());
+}
+
+TEST(WorldSnapshot, AttributesAreStoredPerColumn)
+{
+	TestWorld				World = MakeTestWorld(300);
+	const std::vector<BYTE> File  = WriteTestWorld(World);
+	WorldSnapshotReader		Reader(File);
+	ASSERT_TRUE(Reader.IsValid());
+
+	const WorldSnapshotColumn* Core = Reader.FindColumn("Core");
+	ASSERT_NE(Core, nullptr);
+	EXPECT_EQ(Core->NumComponents, 300u);
+
+	// Nested classes are flattened into one array per leaf attribute, named by its path
+	std::vector<std::string> Paths;
+	for (uint32_t i = 0; i < Core->NumAttributes; ++i)
+	{
+		Paths.emplace_back(Reader.MapString(Peek<WorldSnapshotAttribute>(File, AttributeOffset(File, Core->FirstAttribute + i)).Path));
+	}
+	EXPECT_EQ(Paths, std::vector<std::string>({ "Name", "Transform.Position", "Transform.Scale", "Transform.Orientation" }));
+
+	// Positions are one contiguous, aligned array in actor order, loading them is a copy
+	const WorldSnapshotAttribute* Position = Reader.FindAttribute(*Core, { "Transform.Position", sizeof(Float3), false });
+	ASSERT_NE(Position, nullptr);
+	EXPECT_EQ(Position->Data.Offset % WorldSnapshotArrayAlignment, 0u);
+
+	std::span<const Float3> Positions = Reader.Map<Float3>(Position->Data);
+	ASSERT_EQ(Positions.size(), 300u);
+	for (size_t i = 0; i < Positions.size(); ++i)
+	{
+		EXPECT_EQ(Positions[i], World.Cores[i].Transform.Position);
+	}
+
+	// A column holds only the actors that have the component
+	const WorldSnapshotColumn* Light = Reader.FindColumn("Light");
+	ASSERT_NE(Light, nullptr);
+	for (uint32_t ActorIndex : Reader.Map<uint32_t>(Light->Actors))
+	{
+		EXPECT_TRUE(World.Lights[ActorIndex].has_value());
+	}
+	EXPECT_EQ(Light->NumComponents, static_cast<uint32_t>(std::ranges::count_if(
+										World.Lights,
+										[](const std::optional<TestLight>& Light)
+										{
+											return Light.has_value();
+										})));
+
+	// The attribute lookups at load time find nested handle ids by path
+	const WorldSnapshotColumn* Mesh = Reader.FindColumn("Static Mesh");
+	ASSERT_NE(Mesh, nullptr);
+	EXPECT_NE(Reader.FindAttribute(*Mesh, { "Material.Albedo.HandleId", sizeof(uint32_t), false }), nullptr);
+	EXPECT_EQ(Reader.FindColumn("Camera"), nullptr);
+}
+
+// The Light of a later build, Intensity became a double and Range was added, Type was removed
+struct TestLightV2
+{
+	Float3 Color	 = { 0.0f, 0.0f, 0.0f };
+	double Intensity = -1.0;
+	float  Range	 = 10.0f;
+};
+
+REGISTER_CLASS_ATTRIBUTES(
+	TestLightV2,
+	"Light",
+	CLASS_ATTRIBUTE(TestLightV2, Color),
+	CLASS_ATTRIBUTE(TestLightV2, Intensity),
+	CLASS_ATTRIBUTE(TestLightV2, Range))
+
+TEST(WorldSnapshot, MissingAttributesKeepTheirDefaults)
+{
+	TestWorld				World = MakeTestWorld(100);
+	const std::vector<BYTE> File  = WriteTestWorld(World);
+	WorldSnapshotReader		Reader(File);
+	ASSERT_TRUE(Reader.IsValid());
+
+	// Matched by path, size and kind, anything else is not stored as far as this build is concerned
+	const WorldSnapshotColumn*				  Column = Reader.FindColumn(GetClass<TestLightV2>());
+	std::vector<WorldSnapshotSchemaAttribute> Schema;
+	std::vector<const BYTE*>				  Arrays = Reader.GetAttributeArrays<TestLightV2>(*Column, Schema);
+	ASSERT_EQ(Schema.size(), 3u);
+	EXPECT_NE(Arrays[0], nullptr);
+	EXPECT_EQ(Arrays[1], nullptr);
+	EXPECT_EQ(Arrays[2], nullptr);
+
+	std::span<const uint32_t> ActorIndices = Reader.Map<uint32_t>(Column->Actors);
+	for (size_t i = 0; i < ActorIndices.size(); ++i)
+	{
+		TestLightV2 Light;
+		Reader.ReadComponent(Arrays, i, Light);
+		EXPECT_EQ(Light.Color, World.Lights[ActorIndices[i]]->Color);
+		EXPECT_EQ(Light.Intensity, -1.0);
+		EXPECT_EQ(Light.Range, 10.0f);
+	}
+}
+
+TEST(WorldSnapshot, RejectsTruncatedFiles)
+{
+	const std::vector<BYTE> File = WriteTestWorld(MakeTestWorld(20));
+	for (size_t Size = 0; Size < File.size(); ++Size)
+	{
+		std::vector<BYTE> Truncated(File.begin(), File.begin() + Size);
+		ASSERT_FALSE(WorldSnapshotReader(Truncated).IsValid()) << Size;
+	}
+}
+
+TEST(WorldSnapshot, RejectsMalformedHeaders)
+{
+	const std::vector<BYTE> File = WriteTestWorld(MakeTestWorld(20));
+	ASSERT_TRUE(WorldSnapshotReader(File).IsValid());
+
+	auto IsValidWith = [&](auto&& Patch)
+	{
+		std::vector<BYTE>	Patched = File;
+		WorldSnapshotHeader Header	= GetHeader(Patched);
+		Patch(Header);
+		Poke(Patched, 0, Header);
+		return WorldSnapshotReader(Patched).IsValid();
+	};
+
+	EXPECT_FALSE(IsValidWith(
+		[](WorldSnapshotHeader& Header)
+		{
+			Header.Magic = 0;
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](WorldSnapshotHeader& Header)
+		{
+			Header.Version = WorldSnapshotVersion + 1;
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](WorldSnapshotHeader& Header)
+		{
+			Header.FileSize += 1;
+		}));
+
+	// Sections past the end, sizes that overflow the offset and tables not aligned for their entries
+	EXPECT_FALSE(IsValidWith(
+		[&](WorldSnapshotHeader& Header)
+		{
+			Header.Columns.Offset = File.size();
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](WorldSnapshotHeader& Header)
+		{
+			Header.Attributes.SizeInBytes = UINT64_MAX - Header.Attributes.Offset + 1 + sizeof(WorldSnapshotAttribute);
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](WorldSnapshotHeader& Header)
+		{
+			Header.Textures.Offset += 4;
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](WorldSnapshotHeader& Header)
+		{
+			Header.Meshes.SizeInBytes -= 1;
+		}));
+
+	// Fewer actors than the columns index
+	EXPECT_FALSE(IsValidWith(
+		[](WorldSnapshotHeader& Header)
+		{
+			Header.NumActors -= 1;
+		}));
+
+	// More actors than the columns hold is fine, they have no components
+	EXPECT_TRUE(IsValidWith(
+		[](WorldSnapshotHeader& Header)
+		{
+			Header.NumActors += 1;
+		}));
+}
+
+TEST(WorldSnapshot, RejectsMalformedColumns)
+{
+	const std::vector<BYTE> File = WriteTestWorld(MakeTestWorld(20));
+
+	// Light is the second column, its first actor is actor 0 and the second actor 7
+	auto IsValidWith = [&](auto&& Patch)
+	{
+		std::vector<BYTE>	Patched = File;
+		WorldSnapshotColumn Column	= Peek<WorldSnapshotColumn>(Patched, ColumnOffset(Patched, 1));
+		Patch(Patched, Column);
+		Poke(Patched, ColumnOffset(Patched, 1), Column);
+		return WorldSnapshotReader(Patched).IsValid();
+	};
+
+	EXPECT_FALSE(IsValidWith(
+		[](std::vector<BYTE>& File, WorldSnapshotColumn& Column)
+		{
+			Poke<uint32_t>(File, Column.Actors.Offset, 20);
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](std::vector<BYTE>& File, WorldSnapshotColumn& Column)
+		{
+			Poke<uint32_t>(File, Column.Actors.Offset, 7);
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](std::vector<BYTE>&, WorldSnapshotColumn& Column)
+		{
+			Column.NumComponents += 1;
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](std::vector<BYTE>&, WorldSnapshotColumn& Column)
+		{
+			Column.FirstAttribute = UINT32_MAX;
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](std::vector<BYTE>&, WorldSnapshotColumn& Column)
+		{
+			Column.Name.Offset = UINT64_MAX;
+		}));
+
+	// Attribute arrays must hold an element per component at an aligned offset
+	EXPECT_FALSE(IsValidWith(
+		[](std::vector<BYTE>& File, WorldSnapshotColumn& Column)
+		{
+			auto Attribute = Peek<WorldSnapshotAttribute>(File, AttributeOffset(File, Column.FirstAttribute));
+			Attribute.ElementSize += 1;
+			Poke(File, AttributeOffset(File, Column.FirstAttribute), Attribute);
+		}));
+	EXPECT_FALSE(IsValidWith(
+		[](std::vector<BYTE>& File, WorldSnapshotColumn& Column)
+		{
+			auto Attribute = Peek<WorldSnapshotAttribute>(File, AttributeOffset(File, Column.FirstAttribute));
+			Attribute.Data.Offset += 4;
+			Poke(File, AttributeOffset(File, Column.FirstAttribute), Attribute);
+		}));
+}
+
+TEST(WorldSnapshot, RejectsStringsOutsideTheFile)
+{
+	std::vector<BYTE> File = WriteTestWorld(MakeTestWorld(20));
+
+	// Names are the first attribute of the core column, every element is the section of a string
+	WorldSnapshotColumn	   Core = Peek<WorldSnapshotColumn>(File, ColumnOffset(File, 0));
+	WorldSnapshotAttribute Name = Peek<WorldSnapshotAttribute>(File, AttributeOffset(File, Core.FirstAttribute));
+	ASSERT_TRUE(Name.IsString);
+
+	uint64_t			 Element = Name.Data.Offset + 19 * sizeof(WorldSnapshotSection);
+	WorldSnapshotSection String	 = Peek<WorldSnapshotSection>(File, Element);
+	String.SizeInBytes			 = File.size();
+	Poke(File, Element, String);
+	EXPECT_FALSE(WorldSnapshotReader(File).IsValid());
+}
+
+TEST(WorldSnapshot, CorruptedFilesAreRejectedOrReadInBounds)
+{
+	const std::vector<BYTE> File = WriteTestWorld(MakeTestWorld(50));
+	std::mt19937			Random(5);
+
+	size_t NumValid = 0;
+	for (int i = 0; i < 2000; ++i)
+	{
+		std::vector<BYTE> Corrupted = File;
+		size_t			  Offset	= std::uniform_int_distribution<size_t>(0, File.size() - 1)(Random);
+		Corrupted[Offset] ^= BYTE(1u << std::uniform_int_distribution(0, 7)(Random));
+
+		// A flip in the attribute data still reads, one in a table or a section either fails or stays in the file. A
+		// larger actor count is valid too, the test world just doesn't allocate billions of actors for it
+		WorldSnapshotReader Reader(Corrupted);
+		if (Reader.IsValid())
+		{
+			if (Reader.GetNumActors() <= 1024)
+			{
+				std::ignore = ReadTestWorld(Reader);
+			}
+			++NumValid;
+		}
+	}
+	EXPECT_GT(NumValid, 0u);
+	EXPECT_LT(NumValid, 2000u);
+}
@@ -0,0 +1,246 @@
+#pragma once
+#include "World/WorldSnapshot.h"
+
+// Components shaped like the engine's, a name, a transform of nested attributes, a light and a mesh whose material
+// nests two levels deep, without the world, entt or DirectXMath behind them
+struct Float3
+{
+	float x, y, z;
+
+	bool operator==(const Float3&) const = default;
+};
+
+struct Quaternion
+{
+	float x, y, z, w;
+
+	bool operator==(const Quaternion&) const = default;
+};
+
+struct TestTransform
+{
+	Float3	   Position	   = { 0.0f, 0.0f, 0.0f };
+	Float3	   Scale	   = { 1.0f, 1.0f, 1.0f };
+	Quaternion Orientation = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+	bool operator==(const TestTransform&) const = default;
+};
+
+struct TestCore
+{
+	std::string	  Name;
+	TestTransform Transform;
+
+	bool operator==(const TestCore&) const = default;
+};
+
+struct TestLight
+{
+	int	   Type		 = 0;
+	Float3 Color	 = { 1.0f, 1.0f, 1.0f };
+	float  Intensity = 1.0f;
+
+	bool operator==(const TestLight&) const = default;
+};
+
+struct TestMaterialTexture
+{
+	uint32_t HandleId = UINT_MAX;
+
+	bool operator==(const TestMaterialTexture&) const = default;
+};
+
+struct TestMaterial
+{
+	TestMaterialTexture Albedo;
+	float				Roughness = 0.5f;
+
+	bool operator==(const TestMaterial&) const = default;
+};
+
+struct TestStaticMesh
+{
+	uint32_t	 HandleId = UINT_MAX;
+	TestMaterial Material;
+
+	bool operator==(const TestStaticMesh&) const = default;
+};
+
+REGISTER_CLASS_ATTRIBUTES(
+	TestTransform,
+	"Transform",
+	CLASS_ATTRIBUTE(TestTransform, Position),
+	CLASS_ATTRIBUTE(TestTransform, Scale),
+	CLASS_ATTRIBUTE(TestTransform, Orientation))
+
+REGISTER_CLASS_ATTRIBUTES(
+	TestCore,
+	"Core",
+	CLASS_ATTRIBUTE(TestCore, Name),
+	CLASS_ATTRIBUTE(TestCore, Transform))
+
+REGISTER_CLASS_ATTRIBUTES(
+	TestLight,
+	"Light",
+	CLASS_ATTRIBUTE(TestLight, Type),
+	CLASS_ATTRIBUTE(TestLight, Color),
+	CLASS_ATTRIBUTE(TestLight, Intensity))
+
+REGISTER_CLASS_ATTRIBUTES(TestMaterialTexture, "MaterialTexture", CLASS_ATTRIBUTE(TestMaterialTexture, HandleId))
+
+REGISTER_CLASS_ATTRIBUTES(
+	TestMaterial,
+	"Material",
+	CLASS_ATTRIBUTE(TestMaterial, Albedo),
+	CLASS_ATTRIBUTE(TestMaterial, Roughness))
+
+REGISTER_CLASS_ATTRIBUTES(
+	TestStaticMesh,
+	"Static Mesh",
+	CLASS_ATTRIBUTE(TestStaticMesh, HandleId),
+	CLASS_ATTRIBUTE(TestStaticMesh, Material))
+
+template<>
+inline constexpr bool IsSnapshotNestedClass<TestTransform> = true;
+template<>
+inline constexpr bool IsSnapshotNestedClass<TestMaterial> = true;
+template<>
+inline constexpr bool IsSnapshotNestedClass<TestMaterialTexture> = true;
+
+// Component per actor of each type, std::nullopt where the actor has none
+struct TestWorld
+{
+	std::vector<std::string>				   Textures;
+	std::vector<std::string>				   Meshes;
+	std::vector<TestCore>					   Cores;
+	std::vector<std::optional<TestLight>>	   Lights;
+	std::vector<std::optional<TestStaticMesh>> StaticMeshes;
+
+	bool operator==(const TestWorld&) const = default;
+};
+
+// Every actor has a name and a transform, most have a mesh and every seventh is a light
+inline TestWorld MakeTestWorld(uint32_t NumActors)
+{
+	TestWorld World;
+	for (uint32_t i = 0; i < 64; ++i)
+	{
+		World.Textures.push_back("Assets/Textures/Texture" + std::to_string(i) + ".dds");
+	}
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		World.Meshes.push_back("Assets/Models/Model" + std::to_string(i) + ".gltf");
+	}
+
+	World.Cores.resize(NumActors);
+	World.Lights.resize(NumActors);
+	World.StaticMeshes.resize(NumActors);
+	for (uint32_t i = 0; i < NumActors; ++i)
+	{
+		float x = float(i % 100), z = float(i / 100);
+
+		TestCore& Core			   = World.Cores[i];
+		Core.Name				   = "Actor" + std::to_string(i);
+		Core.Transform.Position	   = { x * 4.0f, float(i % 7) * 0.5f, z * 4.0f };
+		Core.Transform.Scale	   = { 1.0f + float(i % 3), 1.0f, 1.0f + float(i % 5) };
+		Core.Transform.Orientation = { 0.0f, std::sin(x * 0.1f), 0.0f, std::cos(x * 0.1f) };
+
+		if (i % 7 == 0)
+		{
+			World.Lights[i] = TestLight{ int(i % 2), { 1.0f, 0.9f, float(i % 10) / 10.0f }, float(i) };
+		}
+		if (i % 5 != 4)
+		{
+			TestStaticMesh Mesh			  = {};
+			Mesh.HandleId				  = i % 16;
+			Mesh.Material.Albedo.HandleId = i % 64;
+			Mesh.Material.Roughness		  = float(i % 11) / 10.0f;
+			World.StaticMeshes[i]		  = Mesh;
+		}
+	}
+	return World;
+}
+
+template<typename T>
+void AddTestColumn(WorldSnapshotWriter& Writer, const std::vector<std::optional<T>>& Components)
+{
+	std::vector<uint32_t> ActorIndices;
+	std::vector<const T*> Pointers;
+	for (uint32_t i = 0; i < Components.size(); ++i)
+	{
+		if (Components[i])
+		{
+			ActorIndices.push_back(i);
+			Pointers.push_back(&*Components[i]);
+		}
+	}
+	Writer.AddColumn<T>(ActorIndices, Pointers);
+}
+
+inline std::vector<BYTE> WriteTestWorld(const TestWorld& World)
+{
+	WorldSnapshotWriter Writer;
+	for (size_t i = 0; i < World.Textures.size(); ++i)
+	{
+		Writer.AddTexture(World.Textures[i], uint32_t(i % 8));
+	}
+	for (const std::string& Mesh : World.Meshes)
+	{
+		Writer.AddMesh(Mesh);
+	}
+
+	std::vector<uint32_t>		 ActorIndices(World.Cores.size());
+	std::vector<const TestCore*> Cores;
+	for (uint32_t i = 0; i < World.Cores.size(); ++i)
+	{
+		ActorIndices[i] = i;
+		Cores.push_back(&World.Cores[i]);
+	}
+	Writer.AddColumn<TestCore>(ActorIndices, Cores);
+	AddTestColumn(Writer, World.Lights);
+	AddTestColumn(Writer, World.StaticMeshes);
+	return Writer.Finish(static_cast<uint32_t>(World.Cores.size()));
+}
+
+// Reads the components of a column the way WorldArchive::LoadSnapshot does, std::nullopt for actors without one
+template<typename T>
+std::vector<std::optional<T>> ReadTestColumn(const WorldSnapshotReader& Reader)
+{
+	std::vector<std::optional<T>> Components(Reader.GetNumActors());
+
+	const WorldSnapshotColumn* Column = Reader.FindColumn(GetClass<T>());
+	if (!Column)
+	{
+		return Components;
+	}
+
+	std::vector<WorldSnapshotSchemaAttribute> Schema;
+	std::vector<const BYTE*>				  Arrays	   = Reader.GetAttributeArrays<T>(*Column, Schema);
+	std::span<const uint32_t>				  ActorIndices = Reader.Map<uint32_t>(Column->Actors);
+	for (size_t i = 0; i < ActorIndices.size(); ++i)
+	{
+		Reader.ReadComponent(Arrays, i, Components[ActorIndices[i]].emplace());
+	}
+	return Components;
+}
+
+inline TestWorld ReadTestWorld(const WorldSnapshotReader& Reader)
+{
+	TestWorld World;
+	for (const WorldSnapshotTexture& Texture : Reader.GetTextures())
+	{
+		World.Textures.emplace_back(Reader.MapString(Texture.Path));
+	}
+	for (const WorldSnapshotSection& Mesh : Reader.GetMeshes())
+	{
+		World.Meshes.emplace_back(Reader.MapString(Mesh));
+	}
+
+	for (std::optional<TestCore>& Core : ReadTestColumn<TestCore>(Reader))
+	{
+		World.Cores.push_back(Core.value_or(TestCore()));
+	}
+	World.Lights	   = ReadTestColumn<TestLight>(Reader);
+	World.StaticMeshes = ReadTestColumn<TestStaticMesh>(Reader);
+	return World;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// c++ std
+#include <stdexcept>
+#include <exception>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <optional>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <span>
+#include <ranges>
+#include <chrono>
+#include <random>
+
+// c++ stl
+#include <array>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <map>
+#include <unordered_map>
+
+// win32, only the types used by the modules under test
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+using BYTE	 = std::uint8_t;
+using INT	 = std::int32_t;
+using UINT	 = std::uint32_t;
+using INT64	 = std::int64_t;
+using UINT64 = std::uint64_t;
+
+// Compat/ stands in for the synchronization API as well
+#include <synchapi.h>
+#endif
+
+// DirectXMath comes with the Windows SDK, Compat/ stands in for it elsewhere
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <DirectXCollision.h>
+
+#include <city.h>
+
+#include <Core/CoreDefines.h>
+
+#include <gtest/gtest.h>